@@ -1,16 +1,22 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
+#include "qmreader.h"
 #include "translator.h"
+#include "tsreader.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QTranslator>
 #include <QtCore/QLibraryInfo>
 
 #include <iostream>
+#include <optional>
 
 QT_USE_NAMESPACE
 
@@ -31,7 +37,9 @@ static int usage(const QStringList &args)
         "stand-alone tool to convert and filter translation data files.\n"
         "The following file formats are supported:\n\n%1\n"
         "If multiple input files are specified, they are merged with\n"
-        "translations from later files taking precedence.\n\n"
+        "translations from later files taking precedence.\n"
+        "A single TS or QM file is converted without loading all of its\n"
+        "messages at once if the output format allows for it.\n\n"
         "Options:\n"
         "    -h\n"
         "    -help  Display this information and exit.\n\n"
@@ -97,6 +105,179 @@ struct File
     QString format;
 };
 
+// Options that apply to each message on its own.
+struct MessageFilter
+{
+    bool noObsolete = false;
+    bool noFinished = false;
+    bool noUntranslated = false;
+    bool dropTranslations = false;
+    bool noUiLines = false;
+    bool pluralOnly = false;
+};
+
+// Applies a MessageFilter and normalizes the translations of the messages
+// of a stream, just like the corresponding Translator functions do.
+class FilteredMessageStream : public TranslatorMessageStream
+{
+public:
+    FilteredMessageStream(TranslatorMessageStream &source, const MessageFilter &filter)
+        : m_source(source), m_filter(filter)
+    {}
+
+    bool rewind() override { return m_source.rewind(); }
+
+    bool next(TranslatorMessage *msg) override
+    {
+        while (m_source.next(msg)) {
+            if (filter(msg))
+                return true;
+        }
+        return false;
+    }
+
+    bool filter(TranslatorMessage *msg);
+
+    void setLanguageCode(const QString &languageCode)
+    {
+        m_numPlurals = Translator::numerusFormCount(languageCode);
+    }
+    bool hasLanguageCode() const { return m_numPlurals > 0; }
+    bool truncatedTranslations() const { return m_truncated; }
+
+private:
+    TranslatorMessageStream &m_source;
+    MessageFilter m_filter;
+    int m_numPlurals = 0;
+    bool m_truncated = false;
+};
+
+bool FilteredMessageStream::filter(TranslatorMessage *msg)
+{
+    if (m_filter.noObsolete && Translator::isObsolete(*msg))
+        return false;
+    if (m_filter.noFinished && msg->type() == TranslatorMessage::Finished)
+        return false;
+    if (m_filter.noUntranslated && !msg->isTranslated())
+        return false;
+    if (m_filter.dropTranslations)
+        Translator::dropTranslation(*msg);
+    if (m_filter.noUiLines)
+        Translator::dropUiLines(*msg);
+    if (m_filter.pluralOnly && !msg->isPlural())
+        return false;
+
+    if (msg->translations().size() > (msg->isPlural() ? m_numPlurals : 1))
+        m_truncated = true;
+    msg->setTranslations(Translator::normalizedTranslations(*msg, m_numPlurals));
+    return true;
+}
+
+/*
+  Converts a single TS or QM file without loading all of its messages. This
+  works if the file has no duplicates that would need to be merged, and if
+  the output format can write the messages in the order they are read.
+  Otherwise nothing is written, and the file has to be loaded.
+*/
+template <typename Reader>
+static std::optional<int> convertStreamed(Reader &reader, const File &inFile,
+                                          const QString &outFileName, const QString &outFormat,
+                                          const QString &targetLanguage,
+                                          const QString &sourceLanguage,
+                                          Translator::LocationsType locations,
+                                          const MessageFilter &filter, ConversionData &cd)
+{
+    FilteredMessageStream messages(reader, filter);
+
+    // Duplicates are detected by hash only; a collision merely means that
+    // the file is loaded after all.
+    QSet<size_t> idHashes;
+    QSet<size_t> keyHashes;
+    bool duplicates = false;
+    TranslatorMessage msg;
+    while (reader.next(&msg)) {
+        if (!messages.hasLanguageCode())
+            messages.setLanguageCode(targetLanguage.isEmpty() ? reader.languageCode()
+                                                              : targetLanguage);
+        if (!msg.id().isEmpty()) {
+            const size_t hash = qHash(msg.id());
+            duplicates |= idHashes.contains(hash);
+            idHashes.insert(hash);
+        }
+        const size_t hash = qHash(TMMKey(msg));
+        duplicates |= keyHashes.contains(hash);
+        keyHashes.insert(hash);
+        messages.filter(&msg);
+    }
+    if (reader.hasError()) {
+        std::cerr << qPrintable(cd.error());
+        return 2;
+    }
+    if (duplicates)
+        return std::nullopt;
+
+    Translator header;
+    header.setLanguageCode(Translator::guessLanguageCodeFromFileName(inFile.name));
+    reader.applyHeader(&header);
+    header.satisfyDependency(inFile.name, inFile.format);
+    if (!targetLanguage.isEmpty())
+        header.setLanguageCode(targetLanguage);
+    if (!sourceLanguage.isEmpty())
+        header.setSourceLanguageCode(sourceLanguage);
+    if (locations != Translator::DefaultLocations)
+        header.setLocationsType(locations);
+
+    if (!header.canSaveStreamed(outFileName, messages, cd, outFormat))
+        return std::nullopt;
+
+    if (messages.truncatedTranslations())
+        Translator::reportTruncatedTranslations(cd);
+    if (!cd.errors().isEmpty()) {
+        std::cerr << qPrintable(cd.error());
+        cd.clearErrors();
+    }
+    if (!header.saveStreamed(outFileName, messages, cd, outFormat)) {
+        std::cerr << qPrintable(cd.error());
+        return 3;
+    }
+    return 0;
+}
+
+static std::optional<int> convertStreamed(const File &inFile, const QString &outFileName,
+                                          const QString &outFormat,
+                                          const QString &targetLanguage,
+                                          const QString &sourceLanguage,
+                                          Translator::LocationsType locations,
+                                          const MessageFilter &filter, ConversionData &cd)
+{
+    if (inFile.name.isEmpty() || inFile.name == "-"_L1)
+        return std::nullopt;
+    const QString format = Translator::guessFormat(inFile.name, inFile.format);
+    if (format != "ts"_L1 && format != "qm"_L1)
+        return std::nullopt;
+
+    QFile file(inFile.name);
+    if (!file.open(QIODevice::ReadOnly))
+        return std::nullopt; // reported by the regular load
+    cd.m_sourceDir = QFileInfo(inFile.name).absoluteDir();
+    cd.m_sourceFileName = inFile.name;
+
+    if (format == "qm"_L1) {
+        // The records are read in place; no Translator is built.
+        QmStreamReader reader(file, cd,
+                              Translator::guessLanguageCodeFromFileName(inFile.name));
+        if (reader.hasError()) {
+            cd.clearErrors(); // reported by the regular load
+            return std::nullopt;
+        }
+        return convertStreamed(reader, inFile, outFileName, outFormat, targetLanguage,
+                               sourceLanguage, locations, filter, cd);
+    }
+    TSStreamReader reader(file, cd);
+    return convertStreamed(reader, inFile, outFileName, outFormat, targetLanguage,
+                           sourceLanguage, locations, filter, cd);
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
@@ -120,13 +301,8 @@ int main(int argc, char *argv[])
     QString outFormat("auto"_L1);
     QString targetLanguage;
     QString sourceLanguage;
-    bool dropTranslations = false;
-    bool noObsolete = false;
-    bool noFinished = false;
-    bool noUntranslated = false;
+    MessageFilter filter;
     bool verbose = false;
-    bool noUiLines = false;
-    bool pluralOnly = false;
     Translator::LocationsType locations = Translator::DefaultLocations;
 
     ConversionData cd;
@@ -160,7 +336,7 @@ int main(int argc, char *argv[])
                 return usage(args);
             cd.m_dropTags.append(args[i]);
         } else if (arg == "-drop-translations"_L1) {
-            dropTranslations = true;
+            filter.dropTranslations = true;
         } else if (arg == "-target-language"_L1) {
             if (++i >= args.size())
                 return usage(args);
@@ -173,11 +349,11 @@ int main(int argc, char *argv[])
             usage(args);
             return 0;
         } else if (arg == "-no-obsolete"_L1) {
-            noObsolete = true;
+            filter.noObsolete = true;
         } else if (arg == "-no-finished"_L1) {
-            noFinished = true;
+            filter.noFinished = true;
         } else if (arg == "-no-untranslated"_L1) {
-            noUntranslated = true;
+            filter.noUntranslated = true;
         } else if (arg == "-sort-contexts"_L1) {
             cd.m_sortContexts = true;
         } else if (arg == "-sort-messages"_L1) {
@@ -194,9 +370,9 @@ int main(int argc, char *argv[])
             else
                 return usage(args);
         } else if (arg == "-no-ui-lines"_L1) {
-            noUiLines = true;
+            filter.noUiLines = true;
         } else if (arg == "-pluralonly"_L1) {
-            pluralOnly = true;
+            filter.pluralOnly = true;
         } else if (arg == "-verbose"_L1) {
             verbose = true;
         } else if (arg.startsWith(u'-')) {
@@ -212,6 +388,13 @@ int main(int argc, char *argv[])
     if (inFiles.isEmpty())
         return usage(args);
 
+    if (inFiles.size() == 1) {
+        if (const auto result = convertStreamed(inFiles[0], outFileName, outFormat, targetLanguage,
+                                                sourceLanguage, locations, filter, cd)) {
+            return *result;
+        }
+    }
+
     tr.setLanguageCode(Translator::guessLanguageCodeFromFileName(inFiles[0].name));
 
     if (!tr.load(inFiles[0].name, cd, inFiles[0].format)) {
@@ -241,17 +424,17 @@ int main(int argc, char *argv[])
         tr.setLanguageCode(targetLanguage);
     if (!sourceLanguage.isEmpty())
         tr.setSourceLanguageCode(sourceLanguage);
-    if (noObsolete)
+    if (filter.noObsolete)
         tr.stripObsoleteMessages();
-    if (noFinished)
+    if (filter.noFinished)
         tr.stripFinishedMessages();
-    if (noUntranslated)
+    if (filter.noUntranslated)
         tr.stripUntranslatedMessages();
-    if (dropTranslations)
+    if (filter.dropTranslations)
         tr.dropTranslations();
-    if (noUiLines)
+    if (filter.noUiLines)
         tr.dropUiLines();
-    if (pluralOnly)
+    if (filter.pluralOnly)
         tr.stripNonPluralForms();
     if (locations != Translator::DefaultLocations)
         tr.setLocationsType(locations);
@@ -22,8 +22,115 @@ Qt::ItemFlags CheckableListModel::flags(const QModelIndex &index) const
     return Qt::ItemIsUserCheckable | Qt::ItemIsEnabled | Qt::ItemIsSelectable;
 }
 
+// Contexts are handed to the workers in chunks of about this many messages.
+static const int ChunkMessageCount = 2000;
+
+BatchTranslator::BatchTranslator(MultiDataModel *dataModel, QObject *parent)
+    : QObject(parent), m_dataModel(dataModel)
+{
+}
+
+BatchTranslator::~BatchTranslator()
+{
+    m_canceled = true;
+    m_pool.waitForDone();
+}
+
+void BatchTranslator::start(int model, const QList<PhraseBook *> &phraseBooks,
+                            bool translateTranslated, bool translateFinished, bool markFinished)
+{
+    cancel();
+    m_canceled = false;
+    ++m_run;
+    m_running = true;
+    m_markFinished = markFinished;
+    m_pendingChunks = 0;
+    m_processedCount = 0;
+    m_translatedCount = 0;
+
+    // The first phrase book that has a source text provides its translation.
+    QHash<QString, QString> targets;
+    for (const PhraseBook *pb : phraseBooks) {
+        const auto phrases = pb->phrases();
+        for (const Phrase *ph : phrases) {
+            if (!targets.contains(ph->source()))
+                targets.insert(ph->source(), ph->target());
+        }
+    }
+
+    const int contextCount = m_dataModel->contextCount();
+    for (int first = 0, last = 0; first < contextCount; first = last) {
+        for (int messageCount = 0; last < contextCount && messageCount < ChunkMessageCount; ++last)
+            messageCount += m_dataModel->multiContextItem(last)->messageCount();
+
+        ++m_pendingChunks;
+        m_pool.start([this, run = m_run, model, first, last, targets, translateTranslated,
+                      translateFinished] {
+            QList<Result> results;
+            int messageCount = 0;
+            for (int c = first; c < last && !m_canceled.load(std::memory_order_relaxed); ++c) {
+                const MultiContextItem *mc = m_dataModel->multiContextItem(c);
+                for (int i = 0; i < mc->messageCount(); ++i) {
+                    ++messageCount;
+                    const MessageItem *m = mc->messageItem(model, i);
+                    if (!m || m->isObsolete()
+                        || (!translateTranslated && !m->translation().isEmpty())
+                        || (!translateFinished && m->isFinished())) {
+                        continue;
+                    }
+                    const auto target = targets.constFind(m->text());
+                    if (target != targets.constEnd())
+                        results.append({ MultiDataIndex(model, c, i), *target });
+                }
+            }
+            QMetaObject::invokeMethod(
+                    this,
+                    [this, run, results = std::move(results), messageCount] {
+                        applyResults(run, results, messageCount);
+                    },
+                    Qt::QueuedConnection);
+        });
+    }
+
+    if (!m_pendingChunks) {
+        m_running = false;
+        emit finished(0, false);
+    }
+}
+
+// Keeps the translations applied so far.
+void BatchTranslator::cancel()
+{
+    if (!m_running)
+        return;
+    m_canceled = true;
+    m_pool.waitForDone();
+    ++m_run;
+    m_running = false;
+    emit finished(m_translatedCount, true);
+}
+
+void BatchTranslator::applyResults(int run, const QList<Result> &results, int messageCount)
+{
+    if (run != m_run)
+        return;
+
+    for (const Result &result : results) {
+        m_dataModel->setTranslation(result.first, result.second);
+        m_dataModel->setFinished(result.first, m_markFinished);
+    }
+    m_translatedCount += results.size();
+    m_processedCount += messageCount;
+    emit progressChanged(m_processedCount);
+
+    if (!--m_pendingChunks) {
+        m_running = false;
+        emit finished(m_translatedCount, false);
+    }
+}
+
 BatchTranslationDialog::BatchTranslationDialog(MultiDataModel *dataModel, QWidget *w)
- : QDialog(w), m_model(this), m_dataModel(dataModel)
+ : QDialog(w), m_model(this), m_dataModel(dataModel), m_translator(dataModel)
 {
     m_ui.setupUi(this);
     connect(m_ui.runButton, &QAbstractButton::clicked,
@@ -32,6 +139,8 @@ BatchTranslationDialog::BatchTranslationDialog(MultiDataModel *dataModel, QWidge
             this, &BatchTranslationDialog::movePhraseBookUp);
     connect(m_ui.moveDownButton, &QAbstractButton::clicked,
             this, &BatchTranslationDialog::movePhraseBookDown);
+    connect(&m_translator, &BatchTranslator::finished,
+            this, &BatchTranslationDialog::translationFinished);
 
     m_ui.phrasebookList->setModel(&m_model);
     m_ui.phrasebookList->setSelectionBehavior(QAbstractItemView::SelectItems);
@@ -73,57 +182,47 @@ void BatchTranslationDialog::setPhraseBooks(const QList<PhraseBook *> &phraseboo
 
 void BatchTranslationDialog::startTranslation()
 {
-    int translatedcount = 0;
-    QCursor oldCursor = cursor();
-    setCursor(Qt::BusyCursor);
-    int messageCount = m_dataModel->messageCount();
-
-    QProgressDialog *dlgProgress;
-    dlgProgress = new QProgressDialog(tr("Searching, please wait..."), tr("&Cancel"), 0, messageCount, this);
-    dlgProgress->show();
-
-    int msgidx = 0;
-    const bool translateTranslated = m_ui.ckTranslateTranslated->isChecked();
-    const bool translateFinished = m_ui.ckTranslateFinished->isChecked();
-    for (MultiDataModelIterator it(m_dataModel, m_modelIndex); it.isValid(); ++it) {
-        if (MessageItem *m = it.current()) {
-            if (!m->isObsolete()
-                && (translateTranslated || m->translation().isEmpty())
-                && (translateFinished || !m->isFinished())) {
-
-                // Go through them in the order the user specified in the phrasebookList
-                for (int b = 0; b < m_model.rowCount(); ++b) {
-                    QModelIndex idx(m_model.index(b, 0));
-                    QVariant checkState = m_model.data(idx, Qt::CheckStateRole);
-                    if (checkState == Qt::Checked) {
-                        PhraseBook *pb = m_phrasebooks[m_model.data(idx, Qt::UserRole).toInt()];
-                        const auto phrases = pb->phrases();
-                        for (const Phrase *ph : phrases) {
-                            if (ph->source() == m->text()) {
-                                m_dataModel->setTranslation(it, ph->target());
-                                m_dataModel->setFinished(it, m_ui.ckMarkFinished->isChecked());
-                                ++translatedcount;
-                                goto done; // break 2;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-      done:
-        ++msgidx;
-        if (!(msgidx & 15))
-            dlgProgress->setValue(msgidx);
-        qApp->processEvents();
-        if (dlgProgress->wasCanceled())
-            break;
+    // Go through them in the order the user specified in the phrasebookList
+    QList<PhraseBook *> phraseBooks;
+    for (int b = 0; b < m_model.rowCount(); ++b) {
+        QModelIndex idx(m_model.index(b, 0));
+        if (m_model.data(idx, Qt::CheckStateRole) == Qt::Checked)
+            phraseBooks.append(m_phrasebooks[m_model.data(idx, Qt::UserRole).toInt()]);
     }
-    dlgProgress->hide();
 
-    setCursor(oldCursor);
+    setCursor(Qt::BusyCursor);
+    m_ui.runButton->setEnabled(false);
+
+    m_progressDialog = new QProgressDialog(tr("Searching, please wait..."), tr("&Cancel"), 0,
+                                           m_dataModel->messageCount(), this);
+    m_progressDialog->setWindowModality(Qt::WindowModal);
+    connect(&m_translator, &BatchTranslator::progressChanged,
+            m_progressDialog, &QProgressDialog::setValue);
+    connect(m_progressDialog, &QProgressDialog::canceled,
+            &m_translator, &BatchTranslator::cancel);
+    m_progressDialog->show();
+
+    m_translator.start(m_modelIndex, phraseBooks, m_ui.ckTranslateTranslated->isChecked(),
+                       m_ui.ckTranslateFinished->isChecked(), m_ui.ckMarkFinished->isChecked());
+}
+
+void BatchTranslationDialog::translationFinished(int translatedCount)
+{
+    m_progressDialog->hide();
+    m_progressDialog->deleteLater();
+    m_progressDialog = nullptr;
+    m_ui.runButton->setEnabled(true);
+    unsetCursor();
+
     emit finished();
     QMessageBox::information(this, tr("Linguist batch translator"),
-        tr("Batch translated %n entries", "", translatedcount), QMessageBox::Ok);
+        tr("Batch translated %n entries", "", translatedCount), QMessageBox::Ok);
+}
+
+void BatchTranslationDialog::reject()
+{
+    m_translator.cancel();
+    QDialog::reject();
 }
 
 void BatchTranslationDialog::movePhraseBookUp()
@@ -7,12 +7,18 @@
 #include "ui_batchtranslation.h"
 #include "phrase.h"
 
+#include <QtCore/QThreadPool>
 #include <QtWidgets/QDialog>
 #include <QtGui/QStandardItemModel>
 
+#include <atomic>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
+class MultiDataIndex;
 class MultiDataModel;
+class QProgressDialog;
 
 class CheckableListModel : public QStandardItemModel
 {
@@ -21,6 +27,48 @@ public:
     Qt::ItemFlags flags(const QModelIndex &index) const override;
 };
 
+/*
+  Translates the messages of one model whose source text equals the source
+  of a phrase, in the background.
+
+  The phrase books are merged into one hash up front. The messages are then
+  looked up in chunks of contexts on a thread pool, and the translations
+  found are applied to the model in the GUI thread, one chunk at a time.
+  The workers read the messages directly, so they must not be edited or
+  removed while the translator runs; the modal dialog ensures that.
+*/
+class BatchTranslator : public QObject
+{
+    Q_OBJECT
+public:
+    BatchTranslator(MultiDataModel *dataModel, QObject *parent = nullptr);
+    ~BatchTranslator();
+
+    void start(int model, const QList<PhraseBook *> &phraseBooks, bool translateTranslated,
+               bool translateFinished, bool markFinished);
+    void cancel();
+    bool isRunning() const { return m_running; }
+
+signals:
+    void progressChanged(int processedCount);
+    void finished(int translatedCount, bool canceled);
+
+private:
+    using Result = std::pair<MultiDataIndex, QString>;
+
+    void applyResults(int run, const QList<Result> &results, int messageCount);
+
+    MultiDataModel *m_dataModel;
+    QThreadPool m_pool;
+    std::atomic<bool> m_canceled = false;
+    int m_run = 0; // results of earlier runs are dropped
+    bool m_running = false;
+    bool m_markFinished = false;
+    int m_pendingChunks = 0;
+    int m_processedCount = 0;
+    int m_translatedCount = 0;
+};
+
 class BatchTranslationDialog : public QDialog
 {
     Q_OBJECT
@@ -28,11 +76,14 @@ public:
     BatchTranslationDialog(MultiDataModel *model, QWidget *w = 0);
     void setPhraseBooks(const QList<PhraseBook *> &phrasebooks, int modelIndex);
 
+    void reject() override;
+
 signals:
     void finished();
 
 private slots:
     void startTranslation();
+    void translationFinished(int translatedCount);
     void movePhraseBookUp();
     void movePhraseBookDown();
 
@@ -40,6 +91,8 @@ private:
     Ui::BatchTranslationDialog m_ui;
     CheckableListModel m_model;
     MultiDataModel *m_dataModel;
+    BatchTranslator m_translator;
+    QProgressDialog *m_progressDialog = nullptr;
     QList<PhraseBook *> m_phrasebooks;
     int m_modelIndex;
 };
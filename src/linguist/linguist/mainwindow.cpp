@@ -61,243 +61,9 @@
 #include <QPrinter>
 #endif
 
-#include <ctype.h>
-
 using namespace Qt::Literals::StringLiterals;
 namespace {
 
-enum Ending {
-    End_None,
-    End_FullStop,
-    End_Interrobang,
-    End_Colon,
-    End_Ellipsis
-};
-
-static QString leadingWhitespace(const QString &str)
-{
-    int i = 0;
-    for (; i < str.size(); i++) {
-        if (!str[i].isSpace()) {
-            break;
-        }
-    }
-    return str.left(i);
-}
-
-static QString trailingWhitespace(const QString &str)
-{
-    int i = str.size();
-    while (--i >= 0) {
-        if (!str[i].isSpace()) {
-            break;
-        }
-    }
-    return str.mid(i + 1);
-}
-
-static Ending ending(QString str, QLocale::Language lang)
-{
-    str = str.simplified();
-    if (str.isEmpty())
-        return End_None;
-
-    switch (str.at(str.size() - 1).unicode()) {
-    case 0x002e: // full stop
-        if (str.endsWith("..."_L1))
-            return End_Ellipsis;
-        else
-            return End_FullStop;
-    case 0x0589: // armenian full stop
-    case 0x06d4: // arabic full stop
-    case 0x3002: // ideographic full stop
-        return End_FullStop;
-    case 0x0021: // exclamation mark
-    case 0x003f: // question mark
-    case 0x00a1: // inverted exclamation mark
-    case 0x00bf: // inverted question mark
-    case 0x01c3: // latin letter retroflex click
-    case 0x037e: // greek question mark
-    case 0x061f: // arabic question mark
-    case 0x203c: // double exclamation mark
-    case 0x203d: // interrobang
-    case 0x2048: // question exclamation mark
-    case 0x2049: // exclamation question mark
-    case 0x2762: // heavy exclamation mark ornament
-    case 0xff01: // full width exclamation mark
-    case 0xff1f: // full width question mark
-        return End_Interrobang;
-    case 0x003b: // greek 'compatibility' questionmark
-        return lang == QLocale::Greek ? End_Interrobang : End_None;
-    case 0x003a: // colon
-    case 0xff1a: // full width colon
-        return End_Colon;
-    case 0x2026: // horizontal ellipsis
-        return End_Ellipsis;
-    default:
-        return End_None;
-    }
-}
-
-static bool haveMnemonic(const QString &str)
-{
-    for (const ushort *p = (ushort *)str.constData();;) { // Assume null-termination
-        ushort c = *p++;
-        if (!c)
-            break;
-        if (c == '&') {
-            c = *p++;
-            if (!c)
-                return false;
-            // Matches QKeySequence::mnemonic(), except for
-            // '&#' - most likely the start of an NCR
-            // '& ' - too many false positives
-            if (c != '&' && c != ' ' && c != '#' && QChar(c).isPrint()) {
-                const ushort *pp = p;
-                for (; *p < 256 && isalpha(*p); p++)
-                    ;
-                if (pp == p || *p != ';')
-                    return true;
-                // This looks like a HTML &entity;, so ignore it. As a HTML string
-                // won't contain accels anyway, we can stop scanning here.
-                break;
-            }
-        }
-    }
-    return false;
-}
-
-static QHash<int, int> countPlaceMarkers(const QString &str)
-{
-    QHash<int, int> counts;
-    const QChar *c = str.unicode();
-    const QChar *cend = c + str.size();
-    while (c < cend) {
-        if (c->unicode() == '%') {
-            const QChar *escape_start = ++c;
-            while (c->isDigit())
-                ++c;
-            const QChar *escape_end = c;
-            bool ok = true;
-            int markerIndex =
-                    QString::fromRawData(escape_start, escape_end - escape_start).toInt(&ok);
-            if (ok)
-                counts[markerIndex]++;
-        } else {
-            ++c;
-        }
-    }
-    return counts;
-}
-
-struct Validator
-{
-
-    static Validator fromSource(const QString &source, const Ui::MainWindow &ui,
-                                const QLocale::Language &locale,
-                                const QHash<QString, QList<Phrase *>> &phrases)
-    {
-        Validator v;
-        if (ui.actionAccelerators->isChecked())
-            v.m_haveMnemonic.emplace(haveMnemonic(source));
-        if (ui.actionEndingPunctuation->isChecked())
-            v.m_ending.emplace(ending(source, locale));
-        if (ui.actionPlaceMarkerMatches->isChecked())
-            v.m_placeMarkerCounts.emplace(countPlaceMarkers(source));
-        if (ui.actionSurroundingWhitespace->isChecked()) {
-            v.m_leadingWhiteSpace.emplace(leadingWhitespace(source));
-            v.m_trailingWhiteSpace.emplace(trailingWhitespace(source));
-        }
-        if (ui.actionPhraseMatches->isChecked()) {
-            v.m_matchingPhraseTargets.emplace();
-            QString fsource = MainWindow::friendlyString(source);
-            QStringList lookupWords = fsource.split(QLatin1Char(' '));
-
-            for (const QString &s : std::as_const(lookupWords))
-                if (auto wordPhrases = phrases.find(s); wordPhrases != phrases.constEnd())
-                    for (const Phrase *p : *wordPhrases)
-                        if (fsource == MainWindow::friendlyString(p->source()))
-                            v.m_matchingPhraseTargets.value()[s].append(
-                                    MainWindow::friendlyString(p->target()));
-        }
-
-        return v;
-    }
-
-    bool validate(const QString &translation, const QLocale::Language &locale, int modelId,
-                  bool needsRef, bool verbose, ErrorsView *errorsView)
-    {
-        bool danger = false;
-        if (m_haveMnemonic) {
-            if (*m_haveMnemonic != haveMnemonic(translation)) {
-                danger = true;
-                if (verbose)
-                    errorsView->addError(modelId,
-                                         *m_haveMnemonic ? ErrorsView::MissingAccelerator
-                                                         : ErrorsView::SuperfluousAccelerator);
-            }
-        }
-        if (m_placeMarkerCounts) {
-            if (*m_placeMarkerCounts != countPlaceMarkers(translation)) {
-                danger = true;
-                if (verbose)
-                    errorsView->addError(modelId, ErrorsView::PlaceMarkersDiffer);
-            }
-            if (needsRef && !translation.contains(QLatin1String("%n"))
-                && !translation.contains(QLatin1String("%Ln"))) {
-                danger = true;
-                if (verbose)
-                    errorsView->addError(modelId, ErrorsView::NumerusMarkerMissing);
-            }
-        }
-        if (m_ending) {
-            if (*m_ending != ending(translation, locale)) {
-                danger = true;
-                if (verbose)
-                    errorsView->addError(modelId, ErrorsView::PunctuationDiffers);
-            }
-        }
-        if (m_leadingWhiteSpace) {
-            Q_ASSERT(m_trailingWhiteSpace);
-            if (*m_leadingWhiteSpace != leadingWhitespace(translation)
-                || *m_trailingWhiteSpace != trailingWhitespace(translation)) {
-                danger = true;
-                if (verbose)
-                    errorsView->addError(modelId, ErrorsView::SurroundingWhitespaceDiffers);
-            }
-        }
-        if (m_matchingPhraseTargets) {
-            const QString ftranslation = MainWindow::friendlyString(translation);
-            for (auto itr = m_matchingPhraseTargets->cbegin();
-                 itr != m_matchingPhraseTargets->cend(); itr++) {
-                bool found = false;
-                for (const QString &target : itr.value()) {
-                    if (ftranslation.indexOf(target) >= 0) {
-                        found = true;
-                        break;
-                    }
-                }
-                if (!found) {
-                    danger = true;
-                    if (verbose)
-                        errorsView->addError(modelId, ErrorsView::IgnoredPhrasebook, itr.key());
-                }
-            }
-        }
-
-        return danger;
-    }
-
-private:
-    Validator() = default;
-    std::optional<bool> m_haveMnemonic;
-    std::optional<QString> m_leadingWhiteSpace;
-    std::optional<QString> m_trailingWhiteSpace;
-    std::optional<Ending> m_ending;
-    std::optional<QHash<QString, QStringList>> m_matchingPhraseTargets;
-    std::optional<QHash<int, int>> m_placeMarkerCounts;
-};
-
 static const int MessageMS = 2500;
 
 static bool hasFormPreview(const QString &fileName)
@@ -305,6 +71,13 @@ static bool hasFormPreview(const QString &fileName)
     return fileName.endsWith(".ui"_L1) || fileName.endsWith(".jui"_L1);
 }
 
+// The views fetch the messages of a context on demand, navigation needs all of them.
+static void fetchAllMessages(QAbstractItemModel *model, const QModelIndex &context)
+{
+    while (model->canFetchMore(context))
+        model->fetchMore(context);
+}
+
 } // namespace
 
 QT_BEGIN_NAMESPACE
@@ -429,6 +202,7 @@ MainWindow::MainWindow()
 #endif
 
     m_dataModel = new MultiDataModel(this);
+    m_validationEngine = new ValidationEngine(m_dataModel, &m_modelPhraseBooks, this);
     m_messageModel = new MessageModel(this, m_dataModel);
 
     // Set up the context dock widget
@@ -502,7 +276,7 @@ MainWindow::MainWindow()
     m_phrasesDock->setAllowedAreas(Qt::AllDockWidgetAreas);
     m_phrasesDock->setWindowTitle(tr("Phrases and guesses"));
 
-    m_phraseView = new PhraseView(m_dataModel, &m_phraseDict, this);
+    m_phraseView = new PhraseView(m_dataModel, &m_modelPhraseBooks, this);
     m_phrasesDock->setWidget(m_phraseView);
 
     // Set up source code and form preview dock widget
@@ -652,6 +426,7 @@ MainWindow::~MainWindow()
         m_assistantProcess->terminate();
         m_assistantProcess->waitForFinished(3000);
     }
+    delete m_validationEngine;
     qDeleteAll(m_phraseBooks);
     delete m_dataModel;
     delete m_statistics;
@@ -835,10 +610,10 @@ bool MainWindow::openFiles(const QStringList &names, bool globalReadWrite)
     m_messageView->setUpdatesEnabled(false);
     int totalCount = 0;
     for (const OpenedFile &op : std::as_const(opened)) {
-        m_phraseDict.append(QHash<QString, QList<Phrase *> >());
+        m_modelPhraseBooks.append(QList<PhraseBook *>());
         m_dataModel->append(op.dataModel, op.readWrite);
         if (op.readWrite)
-            updatePhraseDictInternal(m_phraseDict.size() - 1);
+            updatePhraseDictInternal(m_modelPhraseBooks.size() - 1);
         totalCount += op.dataModel->messageCount();
     }
     statusBar()->showMessage(tr("%n translation unit(s) loaded.", 0, totalCount), MessageMS);
@@ -864,7 +639,7 @@ void MainWindow::closeFile()
 {
     int model = m_currentIndex.model();
     if (model >= 0 && maybeSave(model)) {
-        m_phraseDict.removeAt(model);
+        m_modelPhraseBooks.removeAt(model);
         m_contextView->setUpdatesEnabled(false);
         m_messageView->setUpdatesEnabled(false);
         m_dataModel->close(model);
@@ -875,7 +650,7 @@ void MainWindow::closeFile()
 bool MainWindow::closeAll()
 {
     if (maybeSaveAll()) {
-        m_phraseDict.clear();
+        m_modelPhraseBooks.clear();
         m_contextView->setUpdatesEnabled(false);
         m_messageView->setUpdatesEnabled(false);
         m_dataModel->closeAll();
@@ -1128,7 +903,7 @@ void MainWindow::findAgain(FindDirection direction)
     if (m_dataModel->contextCount() == 0)
         return;
 
-    const QModelIndex &startIndex = m_messageView->currentIndex();
+    const QModelIndex startIndex = fetchContextMessages(m_messageView->currentIndex());
     QModelIndex index = (direction == FindNext
             ? nextMessage(startIndex)
             : prevMessage(startIndex));
@@ -1669,7 +1444,7 @@ void MainWindow::selectedMessageChanged(const QModelIndex &sortedIndex, const QM
             m_phraseView->setSourceText(-1, QString());
         }
         m_errorsView->setEnabled(m != 0);
-        updateDanger(m_currentIndex, true);
+        updateDanger(m_currentIndex);
     } else {
         m_currentIndex = MultiDataIndex();
         m_messageEditor->showNothing();
@@ -1685,11 +1460,12 @@ void MainWindow::translationChanged(const MultiDataIndex &index)
 {
     // We get that as a result of batch translation or search & translate,
     // so the current model is known to match.
+    m_validationEngine->validateLater();
     if (index != m_currentIndex)
         return;
 
     m_messageEditor->showMessage(index);
-    updateDanger(index, true);
+    updateDanger(index);
 
     MessageItem *m = m_dataModel->messageItem(index);
     if (hasFormPreview(m->fileName()))
@@ -1709,12 +1485,14 @@ void MainWindow::updateTranslation(const QStringList &translations)
     m->setTranslations(translations);
     if (!m->fileName().isEmpty() && hasFormPreview(m->fileName()))
         m_formPreviewView->setSourceContext(m_currentIndex.model(), m);
-    updateDanger(m_currentIndex, true);
+    updateDanger(m_currentIndex);
 
-    if (m->isFinished())
+    if (m->isFinished()) {
         m_dataModel->setFinished(m_currentIndex, false);
-    else
+    } else {
+        m_dataModel->model(m_currentIndex.model())->updateMessageStatistics(m);
         m_dataModel->setModified(m_currentIndex.model(), true);
+    }
 }
 
 void MainWindow::updateTranslatorComment(const QString &comment)
@@ -1776,6 +1554,22 @@ void MainWindow::toggleFinished(const QModelIndex &index)
  * logical context index in the same model, based on the sort order of the
  * contexts in the sorted contexts model.
  */
+/*
+ * Fetches all messages of the context of the given index in the sorted messages
+ * model. The returned index refers to the same item, which may have moved.
+ */
+QModelIndex MainWindow::fetchContextMessages(const QModelIndex &index) const
+{
+    if (!index.isValid())
+        return index;
+    const QModelIndex context = index.parent().isValid() ? index.parent() : index;
+    if (!m_sortedMessagesModel->canFetchMore(context))
+        return index;
+    const QPersistentModelIndex item(index);
+    fetchAllMessages(m_sortedMessagesModel, context);
+    return item;
+}
+
 QModelIndex MainWindow::nextContext(const QModelIndex &index) const
 {
     QModelIndex sortedContextIndex = m_sortedContextsModel->mapFromSource(
@@ -1806,8 +1600,9 @@ QModelIndex MainWindow::prevContext(const QModelIndex &index) const
             m_sortedContextsModel->mapToSource(sortedContextIndex));
 }
 
-QModelIndex MainWindow::nextMessage(const QModelIndex &currentIndex, bool checkUnfinished) const
+QModelIndex MainWindow::nextMessage(const QModelIndex &index, bool checkUnfinished) const
 {
+    const QModelIndex currentIndex = fetchContextMessages(index);
     QModelIndex idx = currentIndex.isValid() ? currentIndex : m_sortedMessagesModel->index(0, 0);
     do {
         int row = 0;
@@ -1816,10 +1611,12 @@ QModelIndex MainWindow::nextMessage(const QModelIndex &currentIndex, bool checkU
             row = idx.row() + 1;
         } else {        // In case we are located on a top-level node
             par = idx;
+            fetchAllMessages(m_sortedMessagesModel, par);
         }
 
         if (row >= m_sortedMessagesModel->rowCount(par)) {
             par = nextContext(par);
+            fetchAllMessages(m_sortedMessagesModel, par);
             row = 0;
         }
         idx = m_sortedMessagesModel->index(row, idx.column(), par);
@@ -1835,8 +1632,9 @@ QModelIndex MainWindow::nextMessage(const QModelIndex &currentIndex, bool checkU
     return QModelIndex();
 }
 
-QModelIndex MainWindow::prevMessage(const QModelIndex &currentIndex, bool checkUnfinished) const
+QModelIndex MainWindow::prevMessage(const QModelIndex &index, bool checkUnfinished) const
 {
+    const QModelIndex currentIndex = fetchContextMessages(index);
     QModelIndex idx = currentIndex.isValid() ? currentIndex : m_sortedMessagesModel->index(0, 0);
     do {
         int row = idx.row() - 1;
@@ -1848,6 +1646,7 @@ QModelIndex MainWindow::prevMessage(const QModelIndex &currentIndex, bool checkU
 
         if (row < 0) {
             par = prevContext(par);
+            fetchAllMessages(m_sortedMessagesModel, par);
             row = m_sortedMessagesModel->rowCount(par) - 1;
         }
         idx = m_sortedMessagesModel->index(row, idx.column(), par);
@@ -1942,20 +1741,16 @@ void MainWindow::findNext(const QString &text, DataModel::FindLocation where,
 
 void MainWindow::revalidate()
 {
-    for (MultiDataModelIterator it(m_dataModel, -1); it.isValid(); ++it)
-        updateDanger(it, false);
+    m_validationEngine->setChecks(validationChecks());
+    m_validationEngine->validate();
 
     if (m_currentIndex.isValid())
-        updateDanger(m_currentIndex, true);
+        updateDanger(m_currentIndex);
 }
 
 QString MainWindow::friendlyString(const QString& str)
 {
-    QString f = str.toLower();
-    static QRegularExpression re("[.,:;!?()-]"_L1);
-    f.replace(re, " "_L1);
-    f.remove(u'&');
-    return f.simplified();
+    return PhraseIndex::friendlyString(str);
 }
 
 void MainWindow::setupMenuBar()
@@ -2541,9 +2336,10 @@ void MainWindow::updatePhraseBookActions()
 
 void MainWindow::updatePhraseDictInternal(int model)
 {
-    QHash<QString, QList<Phrase *> > &pd = m_phraseDict[model];
+    QList<PhraseBook *> &books = m_modelPhraseBooks[model];
 
-    pd.clear();
+    books.clear();
+    int preferred = 0;
     for (PhraseBook *pb : std::as_const(m_phraseBooks)) {
         bool before;
         if (pb->language() != QLocale::C && m_dataModel->language(model) != QLocale::C) {
@@ -2553,20 +2349,10 @@ void MainWindow::updatePhraseDictInternal(int model)
         } else {
             before = false;
         }
-        const auto phrases = pb->phrases();
-        for (Phrase *p : phrases) {
-            QString f = friendlyString(p->source());
-            if (f.size() > 0) {
-                f = f.split(u' ').first();
-                if (!pd.contains(f)) {
-                    pd.insert(f, QList<Phrase *>());
-                }
-                if (before)
-                    pd[f].prepend(p);
-                else
-                    pd[f].append(p);
-            }
-        }
+        if (before)
+            books.insert(preferred++, pb);
+        else
+            books.append(pb);
     }
 }
 
@@ -2578,65 +2364,39 @@ void MainWindow::updatePhraseDict(int model)
 
 void MainWindow::updatePhraseDicts()
 {
-    for (int i = 0; i < m_phraseDict.size(); ++i)
+    for (int i = 0; i < m_modelPhraseBooks.size(); ++i)
         if (!m_dataModel->isModelWritable(i))
-            m_phraseDict[i].clear();
+            m_modelPhraseBooks[i].clear();
         else
             updatePhraseDictInternal(i);
+    m_validationEngine->invalidate();
     revalidate();
     m_phraseView->update();
 }
 
-void MainWindow::updateDanger(const MultiDataIndex &index, bool verbose)
+ValidationEngine::Checks MainWindow::validationChecks() const
 {
-    MultiDataIndex curIdx = index;
-    m_errorsView->clear();
-
-    QString source;
-    for (int mi = 0; mi < m_dataModel->modelCount(); ++mi) {
-        if (!m_dataModel->isModelWritable(mi))
-            continue;
-        curIdx.setModel(mi);
-        MessageItem *m = m_dataModel->messageItem(curIdx);
-        if (!m || m->isObsolete())
-            continue;
-
-        bool danger = false;
-        if (m->message().isTranslated()) {
-            if (source.isEmpty()) {
-                source = m->pluralText();
-                if (source.isEmpty())
-                    source = m->text();
-            }
-
-            Validator validator = Validator::fromSource(
-                    source, m_ui, m_dataModel->sourceLanguage(mi), m_phraseDict[mi]);
-            QStringList translations = m->translations();
-
-            int i = 0;
-            for (QStringView translation : std::as_const(translations)) {
-                while (!translation.isEmpty()) {
-                    auto sep = translation.indexOf(Translator::BinaryVariantSeparator);
-                    if (sep < 0)
-                        sep = translation.size();
-                    const QString trans = translation.first(sep).toString();
-
-                    const bool needsRef = m->message().isPlural()
-                            && m_dataModel->model(mi)->countRefNeeds().at(i++);
-                    danger |= validator.validate(trans, m_dataModel->language(mi), mi, needsRef,
-                                                 verbose, m_errorsView);
-
-                    translation.slice(std::min(sep + 1, translation.size()));
-                }
-            }
-        }
-
-        if (danger != m->danger())
-            m_dataModel->setDanger(curIdx, danger);
-    }
+    ValidationEngine::Checks checks;
+    if (m_ui.actionAccelerators->isChecked())
+        checks |= ValidationEngine::AcceleratorCheck;
+    if (m_ui.actionEndingPunctuation->isChecked())
+        checks |= ValidationEngine::PunctuationCheck;
+    if (m_ui.actionPlaceMarkerMatches->isChecked())
+        checks |= ValidationEngine::PlaceMarkerCheck;
+    if (m_ui.actionSurroundingWhitespace->isChecked())
+        checks |= ValidationEngine::WhitespaceCheck;
+    if (m_ui.actionPhraseMatches->isChecked())
+        checks |= ValidationEngine::PhraseCheck;
+    return checks;
+}
 
-    if (verbose)
-        statusBar()->showMessage(m_errorsView->firstError());
+// Checks the current message right away, the others are left to the validation engine.
+void MainWindow::updateDanger(const MultiDataIndex &index)
+{
+    m_errorsView->clear();
+    m_validationEngine->setChecks(validationChecks());
+    m_validationEngine->validateNow(index, m_errorsView);
+    statusBar()->showMessage(m_errorsView->firstError());
 }
 
 void MainWindow::readConfig()
@@ -2738,7 +2498,7 @@ void MainWindow::showStatistics()
 {
     if (!m_statistics) {
         m_statistics = new Statistics(this);
-        connect(m_dataModel, &MultiDataModel::statsChanged, m_statistics, &Statistics::updateStats);
+        connect(m_dataModel, &MultiDataModel::statsChanged, this, &MainWindow::updateStats);
     }
     m_statistics->show();
     updateStatistics();
@@ -2765,6 +2525,13 @@ void MainWindow::updateStatistics()
     m_dataModel->model(m_currentIndex.model())->updateStatistics();
 }
 
+void MainWindow::updateStats(int model, const StatisticalData &newStats)
+{
+    // Edits in the other open files must not show up as the current one's
+    if (model == m_currentIndex.model())
+        m_statistics->updateStats(newStats);
+}
+
 void MainWindow::doShowTranslationSettings(int model)
 {
     if (!m_translationSettingsDialog)
@@ -9,6 +9,7 @@
 #include "recentfiles.h"
 #include "messagemodel.h"
 #include "finddialog.h"
+#include "validationengine.h"
 
 #include <QtCore/private/qconfig_p.h>
 
@@ -109,6 +110,7 @@ private slots:
     bool maybeSave(int model);
     void updateProgress();
     void maybeUpdateStatistics(const MultiDataIndex &);
+    void updateStats(int model, const StatisticalData &newStats);
     void translationChanged(const MultiDataIndex &);
     void updateCaption();
     void updateLatestModel(const QModelIndex &index);
@@ -140,6 +142,7 @@ private slots:
 #endif
 
 private:
+    QModelIndex fetchContextMessages(const QModelIndex &index) const;
     QModelIndex nextContext(const QModelIndex &index) const;
     QModelIndex prevContext(const QModelIndex &index) const;
     QModelIndex nextMessage(const QModelIndex &currentIndex, bool checkUnfinished = false) const;
@@ -176,8 +179,8 @@ private:
     QPrinter *printer();
 #endif
 
-    // FIXME: move to DataModel
-    void updateDanger(const MultiDataIndex &index, bool verbose);
+    ValidationEngine::Checks validationChecks() const;
+    void updateDanger(const MultiDataIndex &index);
 
     bool searchItem(DataModel::FindLocation where, const QString &searchWhat);
 
@@ -185,6 +188,7 @@ private:
     QTreeView *m_contextView;
     QTreeView *m_messageView;
     MultiDataModel *m_dataModel;
+    ValidationEngine *m_validationEngine;
     MessageModel *m_messageModel;
     QSortFilterProxyModel *m_sortedContextsModel;
     QSortFilterProxyModel *m_sortedMessagesModel;
@@ -198,8 +202,8 @@ private:
     QLabel *m_modifiedLabel;
     FocusWatcher *m_focusWatcher;
     QString m_phraseBookDir;
-    // model : keyword -> list of appropriate phrases in the phrasebooks
-    QList<QHash<QString, QList<Phrase *> > > m_phraseDict;
+    // model : phrase books of its language, those of its territory first
+    QList<QList<PhraseBook *> > m_modelPhraseBooks;
     QList<PhraseBook *> m_phraseBooks;
     QMap<QAction *, PhraseBook *> m_phraseBookMenu[3];
 #if QT_CONFIG(printsupport)
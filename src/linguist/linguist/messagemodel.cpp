@@ -85,6 +85,12 @@ static QString adjustNcrVisibility(const QString &str, bool ncrMode)
 
 QT_BEGIN_NAMESPACE
 
+// Messages are indexed by the hash of their key; candidates are compared in full.
+static size_t messageKey(const QString &text, const QString &comment)
+{
+    return qHashMulti(0, text, comment);
+}
+
 /******************************************************************************
  *
  * MessageItem
@@ -92,7 +98,11 @@ QT_BEGIN_NAMESPACE
  *****************************************************************************/
 
 MessageItem::MessageItem(const TranslatorMessage &message)
-    : m_message(message), m_danger(false), m_ncrMode(false)
+    : m_message(message),
+      m_revision(0), m_validatedRevision(-1), m_validatedChecks(-1),
+      m_countedWords(0), m_countedChars(0), m_countedCharsSpc(0),
+      m_countedType(TranslatorMessage::Unfinished), m_countedDanger(false),
+      m_danger(false), m_ncrMode(false)
 {
     if (m_message.translation().isEmpty())
         m_message.setTranslation(QString());
@@ -110,6 +120,7 @@ bool MessageItem::compare(const QString &findText, bool matchSubstring,
 void MessageItem::setTranslation(const QString &translation)
 {
     m_message.setTranslation(resolveNcr(translation));
+    ++m_revision;
 }
 
 QString MessageItem::text() const
@@ -144,6 +155,7 @@ void MessageItem::setTranslations(const QStringList &translations)
         trans.append(resolveNcr(t));
 
     m_message.setTranslations(trans);
+    ++m_revision;
 }
 
 /******************************************************************************
@@ -167,6 +179,18 @@ void ContextItem::appendToComment(const QString &str)
     m_comment += str;
 }
 
+void ContextItem::appendMessage(const MessageItem &msg)
+{
+    m_messageIndex.insert(messageKey(msg.text(), msg.comment()), msgItemList.size());
+    msgItemList.append(msg);
+}
+
+void ContextItem::reserve(int count)
+{
+    msgItemList.reserve(count);
+    m_messageIndex.reserve(count);
+}
+
 MessageItem *ContextItem::messageItem(int i) const
 {
     if (i >= 0 && i < msgItemList.size())
@@ -177,12 +201,14 @@ MessageItem *ContextItem::messageItem(int i) const
 
 MessageItem *ContextItem::findMessage(const QString &sourcetext, const QString &comment) const
 {
-    for (int i = 0; i < messageCount(); ++i) {
-        MessageItem *mi = messageItem(i);
-        if (mi->text() == sourcetext && mi->comment() == comment)
-            return mi;
+    int found = -1;
+    const auto range = m_messageIndex.equal_range(messageKey(sourcetext, comment));
+    for (auto it = range.first; it != range.second; ++it) {
+        const MessageItem &mi = msgItemList.at(*it);
+        if ((found < 0 || *it < found) && mi.text() == sourcetext && mi.comment() == comment)
+            found = *it;
     }
-    return 0;
+    return found >= 0 ? messageItem(found) : 0;
 }
 
 /******************************************************************************
@@ -204,6 +230,8 @@ DataModel::DataModel(QObject *parent)
     m_sourceTerritory(QLocale::Territory(-1))
 {}
 
+DataModel::~DataModel() = default;
+
 QStringList DataModel::normalizedTranslations(const MessageItem &m) const
 {
     QStringList translations =
@@ -232,12 +260,8 @@ MessageItem *DataModel::messageItem(const DataIndex &index) const
 
 ContextItem *DataModel::findContext(const QString &context) const
 {
-    for (int c = 0; c < m_contextList.size(); ++c) {
-        ContextItem *ctx = contextItem(c);
-        if (ctx->context() == context)
-            return ctx;
-    }
-    return 0;
+    const auto it = m_contextIndex.constFind(context);
+    return it != m_contextIndex.cend() ? contextItem(*it) : 0;
 }
 
 MessageItem *DataModel::findMessage(const QString &context,
@@ -319,21 +343,34 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
     m_relativeLocations = (tor.locationsType() == Translator::RelativeLocations);
     m_extra = tor.extras();
     m_contextList.clear();
+    m_contextIndex.clear();
     m_numMessages = 0;
 
-    QHash<QString, int> contexts;
-
     m_srcWords = 0;
     m_srcChars = 0;
     m_srcCharsSpc = 0;
+    m_stats.reset();
 
+    // Collect the contexts first, so that their message lists can be allocated
+    // at their final size. Grown lists leave up to half of their capacity
+    // unused, which adds up for large files.
+    QList<int> contextSizes;
     for (const TranslatorMessage &msg : tor.messages()) {
-        if (!contexts.contains(msg.context())) {
-            contexts.insert(msg.context(), m_contextList.size());
+        auto it = m_contextIndex.constFind(msg.context());
+        if (it == m_contextIndex.cend()) {
+            it = m_contextIndex.insert(msg.context(), m_contextList.size());
             m_contextList.append(ContextItem(msg.context()));
+            contextSizes.append(0);
         }
+        if (msg.sourceText() != QLatin1String(ContextComment))
+            ++contextSizes[*it];
+    }
+    m_contextList.squeeze();
+    for (int i = 0; i < m_contextList.size(); ++i)
+        m_contextList[i].reserve(contextSizes.at(i));
 
-        ContextItem *c = contextItem(contexts.value(msg.context()));
+    for (const TranslatorMessage &msg : tor.messages()) {
+        ContextItem *c = contextItem(m_contextIndex.value(msg.context()));
         if (msg.sourceText() == QLatin1String(ContextComment)) {
             c->appendToComment(msg.comment());
         } else {
@@ -523,35 +560,78 @@ void DataModel::setSourceLanguageAndTerritory(QLocale::Language lang, QLocale::T
     setModified(true);
 }
 
+void DataModel::countMessage(MessageItem *m)
+{
+    m->m_countedType = m->type();
+    m->m_countedDanger = false;
+    m->m_countedWords = 0;
+    m->m_countedChars = 0;
+    m->m_countedCharsSpc = 0;
+    if (m->isObsolete())
+        return;
+    for (const QString &trnsl : m->translations()) {
+        doCharCounting(trnsl, m->m_countedWords, m->m_countedChars, m->m_countedCharsSpc);
+        m->m_countedDanger |= m->danger();
+    }
+}
+
+// Adds (sign 1) or removes (sign -1) what was counted for a message.
+void DataModel::addCountedMessage(const MessageItem *m, int sign)
+{
+    StatisticalData &stats = *m_stats;
+    switch (m->m_countedType) {
+    case TranslatorMessage::Finished:
+        stats.wordsFinished += sign * m->m_countedWords;
+        stats.charsFinished += sign * m->m_countedChars;
+        stats.charsSpacesFinished += sign * m->m_countedCharsSpc;
+        if (m->m_countedDanger)
+            stats.translatedMsgDanger += sign;
+        else
+            stats.translatedMsgNoDanger += sign;
+        break;
+    case TranslatorMessage::Unfinished:
+        stats.wordsUnfinished += sign * m->m_countedWords;
+        stats.charsUnfinished += sign * m->m_countedChars;
+        stats.charsSpacesUnfinished += sign * m->m_countedCharsSpc;
+        if (m->m_countedDanger)
+            stats.unfinishedMsgDanger += sign;
+        else
+            stats.unfinishedMsgNoDanger += sign;
+        break;
+    default:
+        stats.obsoleteMsg += sign;
+        break;
+    }
+}
+
+// All messages are counted the first time only, later edits are
+// accounted for by updateMessageStatistics().
 void DataModel::updateStatistics()
 {
-    StatisticalData stats {};
-    for (DataModelIterator it(this); it.isValid(); ++it) {
-        const MessageItem *mi = it.current();
-        if (mi->isObsolete()) {
-            stats.obsoleteMsg++;
-        } else if (mi->isFinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsFinished, stats.charsFinished, stats.charsSpacesFinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
-                stats.translatedMsgDanger++;
-            else
-                stats.translatedMsgNoDanger++;
-        } else if (mi->isUnfinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsUnfinished, stats.charsUnfinished, stats.charsSpacesUnfinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
-                stats.unfinishedMsgDanger++;
-            else
-                stats.unfinishedMsgNoDanger++;
+    if (!m_stats) {
+        m_stats = std::make_unique<StatisticalData>();
+        for (DataModelIterator it(this); it.isValid(); ++it) {
+            MessageItem *m = it.current();
+            countMessage(m);
+            addCountedMessage(m, 1);
         }
     }
+    emitStatistics();
+}
+
+void DataModel::updateMessageStatistics(MessageItem *m)
+{
+    if (!m_stats)
+        return;
+    addCountedMessage(m, -1);
+    countMessage(m);
+    addCountedMessage(m, 1);
+    emitStatistics();
+}
+
+void DataModel::emitStatistics()
+{
+    StatisticalData stats = *m_stats;
     stats.wordsSource = m_srcWords;
     stats.charsSource = m_srcChars;
     stats.charsSpacesSource = m_srcCharsSpc;
@@ -641,10 +721,15 @@ MultiContextItem::MultiContextItem(int oldCount, ContextItem *ctx, bool writable
       m_comment(ctx->comment()),
       m_finishedCount(0),
       m_editableCount(0),
-      m_nonobsoleteCount(0)
+      m_nonobsoleteCount(0),
+      m_indexedCount(0),
+      m_fetchedCount(0)
 {
     QList<MessageItem *> mList;
     QList<MessageItem *> eList;
+    mList.reserve(ctx->messageCount());
+    eList.reserve(ctx->messageCount());
+    m_multiMessageList.reserve(ctx->messageCount());
     for (int j = 0; j < ctx->messageCount(); ++j) {
         MessageItem *m = ctx->messageItem(j);
         mList.append(m);
@@ -663,10 +748,7 @@ MultiContextItem::MultiContextItem(int oldCount, ContextItem *ctx, bool writable
 
 void MultiContextItem::appendEmptyModel()
 {
-    QList<MessageItem *> eList;
-    for (int j = 0; j < messageCount(); ++j)
-        eList.append(0);
-    m_messageLists.append(eList);
+    m_messageLists.append(QList<MessageItem *>(messageCount(), nullptr));
     m_writableMessageLists.append(0);
     m_contextList.append(0);
 }
@@ -716,6 +798,19 @@ void MultiContextItem::removeMultiMessageItem(int pos)
     for (int i = 0; i < m_messageLists.size(); ++i)
         m_messageLists[i].removeAt(pos);
     m_multiMessageList.removeAt(pos);
+    m_messageIndex.clear();
+    m_idIndex.clear();
+    m_indexedCount = 0;
+}
+
+void MultiContextItem::updateIndex() const
+{
+    for (int i = m_indexedCount; i < m_multiMessageList.size(); ++i) {
+        const MultiMessageItem &m = m_multiMessageList.at(i);
+        m_messageIndex.insert(messageKey(m.text(), m.comment()), i);
+        m_idIndex.insert(qHash(m.id()), i);
+    }
+    m_indexedCount = m_multiMessageList.size();
 }
 
 int MultiContextItem::firstNonobsoleteMessageIndex(int msgIdx) const
@@ -728,22 +823,27 @@ int MultiContextItem::firstNonobsoleteMessageIndex(int msgIdx) const
 
 int MultiContextItem::findMessage(const QString &sourcetext, const QString &comment) const
 {
-    for (int i = 0, cnt = messageCount(); i < cnt; ++i) {
-        MultiMessageItem *m = multiMessageItem(i);
-        if (m->text() == sourcetext && m->comment() == comment)
-            return i;
+    updateIndex();
+    int found = -1;
+    const auto range = m_messageIndex.equal_range(messageKey(sourcetext, comment));
+    for (auto it = range.first; it != range.second; ++it) {
+        const MultiMessageItem &m = m_multiMessageList.at(*it);
+        if ((found < 0 || *it < found) && m.text() == sourcetext && m.comment() == comment)
+            found = *it;
     }
-    return -1;
+    return found;
 }
 
 int MultiContextItem::findMessageById(const QString &id) const
 {
-    for (int i = 0, cnt = messageCount(); i < cnt; ++i) {
-        MultiMessageItem *m = multiMessageItem(i);
-        if (m->id() == id)
-            return i;
+    updateIndex();
+    int found = -1;
+    const auto range = m_idIndex.equal_range(qHash(id));
+    for (auto it = range.first; it != range.second; ++it) {
+        if ((found < 0 || *it < found) && m_multiMessageList.at(*it).id() == id)
+            found = *it;
     }
-    return -1;
+    return found;
 }
 
 /******************************************************************************
@@ -877,14 +977,22 @@ void MultiDataModel::append(DataModel *dm, bool readWrite)
                     appendItems << m;
             }
             if (!appendItems.isEmpty()) {
+                // Unless the context was fetched completely, the new messages
+                // are fetched along with the rest.
                 int msgCnt = mc->messageCount();
-                m_msgModel->beginInsertRows(m_msgModel->createIndex(mcx, 0),
-                                            msgCnt, msgCnt + appendItems.size() - 1);
-                mc->appendMessageItems(appendItems);
-                m_msgModel->endInsertRows();
+                if (mc->fetchedCount() < msgCnt) {
+                    mc->appendMessageItems(appendItems);
+                } else {
+                    m_msgModel->beginInsertRows(m_msgModel->createIndex(mcx, 0),
+                                                msgCnt, msgCnt + appendItems.size() - 1);
+                    mc->appendMessageItems(appendItems);
+                    mc->m_fetchedCount = mc->messageCount();
+                    m_msgModel->endInsertRows();
+                }
                 m_numMessages += appendItems.size();
             }
         } else {
+            m_contextIndex.insert(c->context(), m_multiContextList.size());
             m_multiContextList << MultiContextItem(modelCount() - 1, c, readWrite);
             m_numMessages += c->messageCount();
             ++appendedContexts;
@@ -904,7 +1012,7 @@ void MultiDataModel::append(DataModel *dm, bool readWrite)
     connect(dm, &DataModel::languageChanged,
             this, &MultiDataModel::onLanguageChanged);
     connect(dm, &DataModel::statsChanged,
-            this, &MultiDataModel::statsChanged);
+            this, &MultiDataModel::onStatsChanged);
     emit modelAppended();
 }
 
@@ -924,22 +1032,31 @@ void MultiDataModel::close(int model)
         delete m_dataModels.takeAt(model);
         m_msgModel->endRemoveColumns();
         emit modelDeleted(model);
+        bool contextsRemoved = false;
         for (int i = m_multiContextList.size(); --i >= 0;) {
             MultiContextItem &mc = m_multiContextList[i];
             QModelIndex contextIdx = m_msgModel->createIndex(i, 0);
             for (int j = mc.messageCount(); --j >= 0;)
                 if (mc.multiMessageItem(j)->isEmpty()) {
-                    m_msgModel->beginRemoveRows(contextIdx, j, j);
-                    mc.removeMultiMessageItem(j);
-                    m_msgModel->endRemoveRows();
+                    if (j < mc.fetchedCount()) {
+                        m_msgModel->beginRemoveRows(contextIdx, j, j);
+                        mc.removeMultiMessageItem(j);
+                        --mc.m_fetchedCount;
+                        m_msgModel->endRemoveRows();
+                    } else {
+                        mc.removeMultiMessageItem(j);
+                    }
                     --m_numMessages;
                 }
             if (!mc.messageCount()) {
                 m_msgModel->beginRemoveRows(QModelIndex(), i, i);
                 m_multiContextList.removeAt(i);
                 m_msgModel->endRemoveRows();
+                contextsRemoved = true;
             }
         }
+        if (contextsRemoved)
+            rebuildContextIndex();
         onModifiedChanged();
     }
 }
@@ -953,6 +1070,7 @@ void MultiDataModel::closeAll()
     qDeleteAll(m_dataModels);
     m_dataModels.clear();
     m_multiContextList.clear();
+    m_contextIndex.clear();
     m_msgModel->endResetModel();
     emit allModelsDeleted();
     onModifiedChanged();
@@ -1072,6 +1190,14 @@ void MultiDataModel::onLanguageChanged()
     emit languageChanged(i);
 }
 
+void MultiDataModel::onStatsChanged(const StatisticalData &newStats)
+{
+    int i = 0;
+    while (sender() != m_dataModels[i])
+        ++i;
+    emit statsChanged(i, newStats);
+}
+
 int MultiDataModel::isFileLoaded(const QString &name) const
 {
     for (int i = 0; i < m_dataModels.size(); ++i)
@@ -1082,22 +1208,21 @@ int MultiDataModel::isFileLoaded(const QString &name) const
 
 int MultiDataModel::findContextIndex(const QString &context) const
 {
-    for (int i = 0; i < m_multiContextList.size(); ++i) {
-        const MultiContextItem &mc = m_multiContextList[i];
-        if (mc.context() == context)
-            return i;
-    }
-    return -1;
+    return m_contextIndex.value(context, -1);
 }
 
 MultiContextItem *MultiDataModel::findContext(const QString &context) const
 {
-    for (int i = 0; i < m_multiContextList.size(); ++i) {
-        const MultiContextItem &mc = m_multiContextList[i];
-        if (mc.context() == context)
-            return const_cast<MultiContextItem *>(&mc);
-    }
-    return 0;
+    const int i = findContextIndex(context);
+    return i >= 0 ? multiContextItem(i) : 0;
+}
+
+void MultiDataModel::rebuildContextIndex()
+{
+    m_contextIndex.clear();
+    m_contextIndex.reserve(m_multiContextList.size());
+    for (int i = 0; i < m_multiContextList.size(); ++i)
+        m_contextIndex.insert(m_multiContextList.at(i).context(), i);
 }
 
 MessageItem *MultiDataModel::messageItem(const MultiDataIndex &index, int model) const
@@ -1119,6 +1244,7 @@ void MultiDataModel::setTranslation(const MultiDataIndex &index, const QString &
     if (translation == m->translation())
         return;
     m->setTranslation(translation);
+    m_dataModels[index.model()]->updateMessageStatistics(m);
     setModified(index.model(), true);
     emit translationChanged(index);
 }
@@ -1132,6 +1258,7 @@ void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
     TranslatorMessage::Type type = m->type();
     if (type == TranslatorMessage::Unfinished && finished) {
         m->setType(TranslatorMessage::Finished);
+        m_dataModels[index.model()]->updateMessageStatistics(m);
         mm->decrementUnfinishedCount();
         if (!mm->countUnfinished()) {
             incrementFinishedCount();
@@ -1152,6 +1279,7 @@ void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
         setModified(index.model(), true);
     } else if (type == TranslatorMessage::Finished && !finished) {
         m->setType(TranslatorMessage::Unfinished);
+        m_dataModels[index.model()]->updateMessageStatistics(m);
         mm->incrementUnfinishedCount();
         if (mm->countUnfinished() == 1) {
             decrementFinishedCount();
@@ -1187,8 +1315,9 @@ void MultiDataModel::setDanger(const MultiDataIndex &index, bool danger)
             if (c->unfinishedDangerCount() == 1)
                 emit contextDataChanged(index);
         }
-        emit messageDataChanged(index);
         m->setDanger(danger);
+        m_dataModels[index.model()]->updateMessageStatistics(m);
+        emit messageDataChanged(index);
     } else if (m->danger() && !danger) {
         if (m->isFinished()) {
             c->decrementFinishedDangerCount();
@@ -1199,8 +1328,9 @@ void MultiDataModel::setDanger(const MultiDataIndex &index, bool danger)
             if (!c->unfinishedDangerCount())
                 emit contextDataChanged(index);
         }
-        emit messageDataChanged(index);
         m->setDanger(danger);
+        m_dataModels[index.model()]->updateMessageStatistics(m);
+        emit messageDataChanged(index);
     }
 }
 
@@ -1312,6 +1442,8 @@ MessageItem *MultiDataModelIterator::current() const
  *
  *****************************************************************************/
 
+static const int MessageFetchCount = 500;
+
 MessageModel::MessageModel(QObject *parent, MultiDataModel *data)
   : QAbstractItemModel(parent), m_data(data)
 {
@@ -1354,6 +1486,8 @@ void MessageModel::contextItemChanged(const MultiDataIndex &index)
 
 void MessageModel::messageItemChanged(const MultiDataIndex &index)
 {
+    if (index.message() >= m_data->multiContextItem(index.context())->fetchedCount())
+        return;
     QModelIndex idx = createIndex(index.message(), index.model() + 1, index.context() + 1);
     emit dataChanged(idx, idx);
 }
@@ -1362,6 +1496,9 @@ QModelIndex MessageModel::modelIndex(const MultiDataIndex &index)
 {
     if (index.message() < 0) // Should be unused case
         return createIndex(index.context(), index.model() + 1);
+    const int fetched = m_data->multiContextItem(index.context())->fetchedCount();
+    if (index.message() >= fetched)
+        fetchMessages(index.context(), index.message() + 1 - fetched);
     return createIndex(index.message(), index.model() + 1, index.context() + 1);
 }
 
@@ -1370,10 +1507,47 @@ int MessageModel::rowCount(const QModelIndex &parent) const
     if (!parent.isValid())
         return m_data->contextCount(); // contexts
     if (!parent.internalId()) // messages
-        return m_data->multiContextItem(parent.row())->messageCount();
+        return m_data->multiContextItem(parent.row())->fetchedCount();
     return 0;
 }
 
+bool MessageModel::hasChildren(const QModelIndex &parent) const
+{
+    if (!parent.isValid())
+        return m_data->contextCount() > 0;
+    if (!parent.internalId())
+        return m_data->multiContextItem(parent.row())->messageCount() > 0;
+    return false;
+}
+
+// The messages of a context are reported in chunks as the views ask for them,
+// so that huge contexts need not be laid out and sorted as a whole upfront.
+bool MessageModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (!parent.isValid() || parent.internalId())
+        return false;
+    const MultiContextItem *mc = m_data->multiContextItem(parent.row());
+    return mc->fetchedCount() < mc->messageCount();
+}
+
+void MessageModel::fetchMore(const QModelIndex &parent)
+{
+    if (canFetchMore(parent))
+        fetchMessages(parent.row(), MessageFetchCount);
+}
+
+void MessageModel::fetchMessages(int context, int count)
+{
+    MultiContextItem *mc = m_data->multiContextItem(context);
+    const int first = mc->m_fetchedCount;
+    const int last = qMin(first + count, mc->messageCount()) - 1;
+    if (last < first)
+        return;
+    beginInsertRows(createIndex(context, 0), first, last);
+    mc->m_fetchedCount = last + 1;
+    endInsertRows();
+}
+
 int MessageModel::columnCount(const QModelIndex &parent) const
 {
     if (!parent.isValid())
@@ -13,6 +13,8 @@
 #include <QtGui/QColor>
 #include <QtGui/QBitmap>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class DataModel;
@@ -27,7 +29,7 @@ public:
     bool danger() const { return m_danger; }
     void setDanger(bool danger) { m_danger = danger; }
     bool ncrMode() const { return m_ncrMode; }
-    void setNcrMode(bool mode) { m_ncrMode = mode; }
+    void setNcrMode(bool mode) { m_ncrMode = mode; ++m_revision; }
 
     void setTranslation(const QString &translation);
 
@@ -46,7 +48,7 @@ public:
     void setTranslations(const QStringList &translations);
 
     TranslatorMessage::Type type() const { return m_message.type(); }
-    void setType(TranslatorMessage::Type type) { m_message.setType(type); }
+    void setType(TranslatorMessage::Type type) { m_message.setType(type); ++m_revision; }
 
     bool isFinished() const { return type() == TranslatorMessage::Finished; }
     bool isUnfinished() const { return type() == TranslatorMessage::Unfinished; }
@@ -57,13 +59,40 @@ public:
     bool compare(const QString &findText, bool matchSubstring,
         Qt::CaseSensitivity cs) const;
 
+    // Bumped whenever the outcome of the danger checks may change
+    int revision() const { return m_revision; }
+    bool isValidated(int checksRevision) const
+        { return m_validatedRevision == m_revision && m_validatedChecks == checksRevision; }
+    void setValidated(int revision, int checksRevision)
+        { m_validatedRevision = revision; m_validatedChecks = checksRevision; }
+
 private:
+    friend class DataModel;
+
+    // Kept in this order so that the flags share the padding after the
+    // counters; there is one item per message.
     TranslatorMessage m_message;
+    int m_revision;
+    int m_validatedRevision;
+    int m_validatedChecks;
+    // What the statistics of the DataModel count for this message
+    int m_countedWords;
+    int m_countedChars;
+    int m_countedCharsSpc;
+    TranslatorMessage::Type m_countedType : 8;
+    bool m_countedDanger;
     bool m_danger;
     bool m_ncrMode;
 };
 
 
+/*
+  The items of all messages are created when a file is loaded. Creating them
+  on demand would not save much: a MessageItem is its TranslatorMessage plus
+  a few counters, and the validation started after loading visits every
+  message anyway. What large files do gain from is allocating the per-context
+  lists at their final size, see DataModel::load().
+*/
 class ContextItem
 {
 public:
@@ -92,7 +121,8 @@ public:
 private:
     friend class DataModel;
     friend class MultiDataModel;
-    void appendMessage(const MessageItem &msg) { msgItemList.append(msg); }
+    void appendMessage(const MessageItem &msg);
+    void reserve(int count);
     void appendToComment(const QString &x);
     void incrementFinishedCount() { ++m_finishedCount; }
     void decrementFinishedCount() { --m_finishedCount; }
@@ -109,6 +139,7 @@ private:
     int m_unfinishedDangerCount;
     int m_nonobsoleteCount;
     QList<MessageItem> msgItemList;
+    QMultiHash<size_t, int> m_messageIndex; // by text and comment, when appended
 };
 
 
@@ -144,6 +175,7 @@ class DataModel : public QObject
     Q_OBJECT
 public:
     DataModel(QObject *parent = 0);
+    ~DataModel();
 
     enum FindLocation { NoLocation = 0, SourceText = 0x1, Translations = 0x2, Comments = 0x4 };
 
@@ -189,6 +221,7 @@ public:
     QStringList normalizedTranslations(const MessageItem &m) const;
     void doCharCounting(const QString& text, int& trW, int& trC, int& trCS);
     void updateStatistics();
+    void updateMessageStatistics(MessageItem *m);
 
     int getSrcWords() const { return m_srcWords; }
     int getSrcChars() const { return m_srcChars; }
@@ -203,9 +236,13 @@ signals:
 private:
     friend class DataModelIterator;
     QList<ContextItem> m_contextList;
+    QHash<QString, int> m_contextIndex;
 
     bool save(const QString &fileName, QWidget *parent);
     void updateLocale();
+    void countMessage(MessageItem *m);
+    void addCountedMessage(const MessageItem *m, int sign);
+    void emitStatistics();
 
     bool m_writable;
     bool m_modified;
@@ -216,6 +253,8 @@ private:
     int m_srcWords;
     int m_srcChars;
     int m_srcCharsSpc;
+    // Totals of the translations, counted once and then updated per message
+    std::unique_ptr<StatisticalData> m_stats;
 
     QString m_srcFileName;
     QLocale::Language m_language;
@@ -291,9 +330,12 @@ public:
     int getNumEditable() const { return m_editableCount; }
     // For background in context list
     bool isObsolete() const { return messageCount() && !m_nonobsoleteCount; }
+    // Messages the MessageModel reports as rows so far
+    int fetchedCount() const { return m_fetchedCount; }
 
 private:
     friend class MultiDataModel;
+    friend class MessageModel;
     void appendEmptyModel();
     void assignLastModel(ContextItem *ctx, bool writable);
     void removeModel(int pos);
@@ -301,6 +343,7 @@ private:
     void putMessageItem(int pos, MessageItem *m);
     void appendMessageItems(const QList<MessageItem *> &m);
     void removeMultiMessageItem(int pos);
+    void updateIndex() const;
     void incrementFinishedCount() { ++m_finishedCount; }
     void decrementFinishedCount() { --m_finishedCount; }
     void incrementEditableCount() { ++m_editableCount; }
@@ -318,6 +361,11 @@ private:
     int m_finishedCount; // read-write
     int m_editableCount; // read-write
     int m_nonobsoleteCount; // all (note: this counts messages, not multi-messages)
+    // Built on demand, as messages are removed only in bulk
+    mutable QMultiHash<size_t, int> m_messageIndex; // by text and comment
+    mutable QMultiHash<size_t, int> m_idIndex;
+    mutable int m_indexedCount;
+    int m_fetchedCount;
 };
 
 
@@ -423,7 +471,7 @@ signals:
     void modelDeleted(int model);
     void allModelsDeleted();
     void languageChanged(int model);
-    void statsChanged(const StatisticalData &newStats);
+    void statsChanged(int model, const StatisticalData &newStats);
     void modifiedChanged(bool);
     void multiContextDataChanged(const MultiDataIndex &index);
     void contextDataChanged(const MultiDataIndex &index);
@@ -433,6 +481,7 @@ signals:
 private slots:
     void onModifiedChanged();
     void onLanguageChanged();
+    void onStatsChanged(const StatisticalData &newStats);
 
 private:
     friend class MultiDataModelIterator;
@@ -441,6 +490,7 @@ private:
     ContextItem *contextItem(const MultiDataIndex &index) const
         { return multiContextItem(index.context())->contextItem(index.model()); }
 
+    void rebuildContextIndex();
     void updateCountsOnAdd(int model, bool writable);
     void updateCountsOnRemove(int model, bool writable);
     void incrementFinishedCount() { ++m_numFinished; }
@@ -455,6 +505,7 @@ private:
     bool m_modified;
 
     QList<MultiContextItem> m_multiContextList;
+    QHash<QString, int> m_contextIndex;
     QList<DataModel *> m_dataModels;
 
     MessageModel *m_msgModel;
@@ -478,6 +529,9 @@ public:
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
 
     // Convenience
     MultiDataIndex dataIndex(const QModelIndex &index, int model) const;
@@ -493,6 +547,8 @@ private slots:
 private:
     friend class MultiDataModel;
 
+    void fetchMessages(int context, int count);
+
     MultiDataModel *m_data; // not owned
 };
 
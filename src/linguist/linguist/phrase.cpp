@@ -164,6 +164,7 @@ bool QphHandler::fatalError(qint64 line, qint64 column, const QString &message)
 
 PhraseBook::PhraseBook() :
     m_changed(false),
+    m_indexValid(false),
     m_language(QLocale::C),
     m_sourceLanguage(QLocale::C),
     m_territory(QLocale::AnyTerritory),
@@ -226,6 +227,7 @@ bool PhraseBook::load(const QString &fileName, bool *langGuessed)
 
     delete hand;
     f.close();
+    m_indexValid = false;
     if (!ok) {
         qDeleteAll(m_phrases);
         m_phrases.clear();
@@ -272,6 +274,8 @@ void PhraseBook::append(Phrase *phrase)
 {
     m_phrases.append(phrase);
     phrase->setPhraseBook(this);
+    if (m_indexValid)
+        m_index.insert(phrase);
     setModified(true);
     emit listChanged();
 }
@@ -280,6 +284,8 @@ void PhraseBook::remove(Phrase *phrase)
 {
     m_phrases.removeOne(phrase);
     phrase->setPhraseBook(0);
+    if (m_indexValid)
+        m_index.remove(phrase);
     setModified(true);
     emit listChanged();
 }
@@ -294,11 +300,21 @@ void PhraseBook::setModified(bool modified)
 
 void PhraseBook::phraseChanged(Phrase *p)
 {
-    Q_UNUSED(p);
+    if (m_indexValid)
+        m_index.update(p);
 
     setModified(true);
 }
 
+const PhraseIndex &PhraseBook::index() const
+{
+    if (!m_indexValid) {
+        m_index.build(m_phrases);
+        m_indexValid = true;
+    }
+    return m_index;
+}
+
 QString PhraseBook::friendlyPhraseBookName() const
 {
     if (!m_fileName.isEmpty())
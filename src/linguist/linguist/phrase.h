@@ -9,6 +9,7 @@
 #include <QList>
 #include <QtCore/QLocale>
 
+#include "phraseindex.h"
 #include "simtexth.h"
 
 QT_BEGIN_NAMESPACE
@@ -65,6 +66,7 @@ public:
     void remove(Phrase *phrase);
     QString fileName() const { return m_fileName; }
     QString friendlyPhraseBookName() const;
+    const PhraseIndex &index() const;
     bool isModified() const { return m_changed; }
 
     void setLanguageAndTerritory(QLocale::Language lang, QLocale::Territory territory);
@@ -89,6 +91,9 @@ private:
     QList<Phrase *> m_phrases;
     QString m_fileName;
     bool m_changed;
+    // Built on demand, then kept up to date phrase by phrase
+    mutable PhraseIndex m_index;
+    mutable bool m_indexValid;
 
     QLocale::Language m_language;
     QLocale::Language m_sourceLanguage;
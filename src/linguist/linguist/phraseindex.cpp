@@ -0,0 +1,195 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "phraseindex.h"
+
+#include "phrase.h"
+
+#include <QtCore/QRegularExpression>
+
+#include <algorithm>
+#include <numeric>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::Literals::StringLiterals;
+
+static quint64 transitionKey(int node, int word)
+{
+    return (quint64(quint32(node)) << 32) | quint32(word);
+}
+
+QString PhraseIndex::friendlyString(const QString &str)
+{
+    QString f = str.toLower();
+    static QRegularExpression re("[.,:;!?()-]"_L1);
+    f.replace(re, " "_L1);
+    f.remove(u'&');
+    return f.simplified();
+}
+
+void PhraseIndex::build(const QList<Phrase *> &phrases)
+{
+    clear();
+    m_entries.reserve(phrases.size());
+    for (Phrase *p : phrases)
+        insert(p);
+}
+
+void PhraseIndex::clear()
+{
+    m_wordIds.clear();
+    m_transitions.clear();
+    m_nodes.clear();
+    m_entries.clear();
+    m_entryIndex.clear();
+    m_removedCount = 0;
+    m_fail.clear();
+    m_outputLink.clear();
+    m_linksValid = false;
+}
+
+int PhraseIndex::transition(int node, int word) const
+{
+    return m_transitions.value(transitionKey(node, word), -1);
+}
+
+void PhraseIndex::insert(Phrase *phrase)
+{
+    Entry entry{ phrase, friendlyString(phrase->source()), QString(), 0, 0, -1 };
+    if (entry.source.isEmpty())
+        return;
+    entry.target = friendlyString(phrase->target());
+
+    if (m_nodes.isEmpty())
+        m_nodes.append(Node{ -1, -1, 0, -1 });
+
+    const QStringList words = entry.source.split(u' ');
+    for (const QString &word : words) {
+        auto wordId = m_wordIds.constFind(word);
+        if (wordId == m_wordIds.constEnd())
+            wordId = m_wordIds.insert(word, int(m_wordIds.size()));
+        int next = transition(entry.node, *wordId);
+        if (next < 0) {
+            next = int(m_nodes.size());
+            m_nodes.append(Node{ entry.node, *wordId, m_nodes.at(entry.node).depth + 1, -1 });
+            m_transitions.insert(transitionKey(entry.node, *wordId), next);
+        }
+        entry.node = next;
+    }
+    entry.wordCount = int(words.size());
+    entry.next = m_nodes.at(entry.node).firstEntry;
+
+    const int index = int(m_entries.size());
+    m_nodes[entry.node].firstEntry = index;
+    m_entryIndex.insert(phrase, index);
+    m_entries.append(std::move(entry));
+    m_linksValid = false;
+}
+
+void PhraseIndex::remove(const Phrase *phrase)
+{
+    const auto it = m_entryIndex.constFind(phrase);
+    if (it == m_entryIndex.constEnd())
+        return;
+    const int index = *it;
+    m_entryIndex.erase(it);
+
+    Entry &entry = m_entries[index];
+    int *link = &m_nodes[entry.node].firstEntry;
+    while (*link != index)
+        link = &m_entries[*link].next;
+    *link = entry.next;
+    entry.phrase = nullptr;
+    entry.source.clear();
+    entry.target.clear();
+    m_linksValid = false;
+
+    // The words and nodes of removed phrases stay, so start over once they dominate.
+    if (++m_removedCount > m_entries.size() / 2) {
+        QList<Phrase *> phrases;
+        phrases.reserve(m_entryIndex.size());
+        for (const Entry &e : std::as_const(m_entries)) {
+            if (e.phrase)
+                phrases.append(e.phrase);
+        }
+        build(phrases);
+    }
+}
+
+// Nodes are visited by depth, so the links of shorter prefixes are known already.
+void PhraseIndex::updateLinks() const
+{
+    if (m_linksValid)
+        return;
+    m_linksValid = true;
+
+    const int nodeCount = int(m_nodes.size());
+    m_fail.fill(0, nodeCount);
+    m_outputLink.fill(0, nodeCount);
+
+    QList<int> order(nodeCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        return m_nodes.at(a).depth < m_nodes.at(b).depth;
+    });
+
+    for (int node : std::as_const(order)) {
+        const Node &n = m_nodes.at(node);
+        if (n.depth < 2)
+            continue;
+        int fail = m_fail.at(n.parent);
+        int next;
+        while ((next = transition(fail, n.word)) < 0 && fail)
+            fail = m_fail.at(fail);
+        fail = qMax(next, 0);
+        m_fail[node] = fail;
+        m_outputLink[node] = m_nodes.at(fail).firstEntry >= 0 ? fail : m_outputLink.at(fail);
+    }
+}
+
+QList<Phrase *> PhraseIndex::findPhrases(const QStringList &friendlyWords) const
+{
+    QList<Phrase *> phrases;
+    if (m_entryIndex.isEmpty())
+        return phrases;
+    updateLinks();
+
+    QList<std::pair<int, int>> matches; // start word and entry
+    int state = 0;
+    for (int i = 0; i < friendlyWords.size(); ++i) {
+        const auto wordId = m_wordIds.constFind(friendlyWords.at(i));
+        if (wordId == m_wordIds.constEnd()) {
+            state = 0;
+            continue;
+        }
+        int next;
+        while ((next = transition(state, *wordId)) < 0 && state)
+            state = m_fail.at(state);
+        state = qMax(next, 0);
+
+        for (int node = state; node > 0; node = m_outputLink.at(node)) {
+            for (int e = m_nodes.at(node).firstEntry; e >= 0; e = m_entries.at(e).next)
+                matches.append({ i - m_entries.at(e).wordCount + 1, e });
+        }
+    }
+
+    std::sort(matches.begin(), matches.end());
+    phrases.reserve(matches.size());
+    for (const auto &match : std::as_const(matches))
+        phrases.append(m_entries.at(match.second).phrase);
+    return phrases;
+}
+
+QList<std::pair<QString, QString>> PhraseIndex::friendlyTexts() const
+{
+    QList<std::pair<QString, QString>> texts;
+    texts.reserve(m_entryIndex.size());
+    for (const Entry &entry : m_entries) {
+        if (entry.phrase)
+            texts.append({ entry.source, entry.target });
+    }
+    return texts;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,82 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef PHRASEINDEX_H
+#define PHRASEINDEX_H
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+class Phrase;
+
+/*
+  Finds the phrases that occur in a text.
+
+  Texts and phrase sources are compared in their friendly form (see
+  friendlyString()), word by word. The words of all phrases
+  form an Aho-Corasick automaton, so a text is matched against every
+  phrase in a single pass over its words.
+
+  Phrases can be inserted and removed one by one. Only the failure links
+  are recomputed then, lazily, on the next lookup.
+*/
+class PhraseIndex
+{
+public:
+    // Lower case, without punctuation and with simplified white space
+    static QString friendlyString(const QString &str);
+
+    void build(const QList<Phrase *> &phrases);
+    void clear();
+    void insert(Phrase *phrase);
+    void remove(const Phrase *phrase);
+    void update(Phrase *phrase) { remove(phrase); insert(phrase); }
+
+    // In the order of their first word in the text, then of insertion
+    QList<Phrase *> findPhrases(const QStringList &friendlyWords) const;
+    // Friendly source and target texts of all phrases
+    QList<std::pair<QString, QString>> friendlyTexts() const;
+
+private:
+    struct Node
+    {
+        int parent;
+        int word;
+        int depth;
+        int firstEntry; // -1 if no phrase ends here
+    };
+
+    struct Entry
+    {
+        Phrase *phrase; // nullptr once removed
+        QString source;
+        QString target;
+        int node;
+        int wordCount;
+        int next; // next entry of the same node
+    };
+
+    int transition(int node, int word) const;
+    void updateLinks() const;
+
+    QHash<QString, int> m_wordIds;
+    QHash<quint64, int> m_transitions; // by node and word id
+    QList<Node> m_nodes;
+    QList<Entry> m_entries;
+    QHash<const Phrase *, int> m_entryIndex;
+    int m_removedCount = 0;
+
+    mutable QList<int> m_fail;
+    mutable QList<int> m_outputLink; // next node along the failure links that has entries
+    mutable bool m_linksValid = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // PHRASEINDEX_H
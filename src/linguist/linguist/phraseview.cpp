@@ -27,10 +27,10 @@ static QString phraseViewHeaderKey()
     return settingPath("PhraseViewHeader");
 }
 
-PhraseView::PhraseView(MultiDataModel *model, QList<QHash<QString, QList<Phrase *> > > *phraseDict, QWidget *parent)
+PhraseView::PhraseView(MultiDataModel *model, QList<QList<PhraseBook *> > *modelPhraseBooks, QWidget *parent)
     : QTreeView(parent),
       m_dataModel(model),
-      m_phraseDict(phraseDict),
+      m_modelPhraseBooks(modelPhraseBooks),
       m_modelIndex(-1),
       m_doGuesses(true)
 {
@@ -58,6 +58,17 @@ PhraseView::PhraseView(MultiDataModel *model, QList<QHash<QString, QList<Phrase
 
     connect(this, &QAbstractItemView::activated,
             this, &PhraseView::selectPhrase);
+
+    connect(m_dataModel, &MultiDataModel::modelAppended,
+            this, &PhraseView::invalidateGuessIndexes);
+    connect(m_dataModel, &MultiDataModel::modelDeleted,
+            this, &PhraseView::invalidateGuessIndexes);
+    connect(m_dataModel, &MultiDataModel::allModelsDeleted,
+            this, &PhraseView::invalidateGuessIndexes);
+    connect(m_dataModel, &MultiDataModel::messageDataChanged,
+            this, &PhraseView::updateGuessIndex);
+    connect(m_dataModel, &MultiDataModel::translationChanged,
+            this, &PhraseView::updateGuessIndex);
 }
 
 PhraseView::~PhraseView()
@@ -174,51 +185,53 @@ void PhraseView::resetNumGuesses()
     setSourceText(m_modelIndex, m_sourceText);
 }
 
-static CandidateList similarTextHeuristicCandidates(MultiDataModel *model, int mi,
-    const char *text, int maxCandidates)
+static bool isGuessCandidate(const MessageItem *m)
 {
-    QList<int> scores;
-    CandidateList candidates;
-
-    StringSimilarityMatcher stringmatcher(QString::fromLatin1(text));
-
-    for (MultiDataModelIterator it(model, mi); it.isValid(); ++it) {
-        MessageItem *m = it.current();
-        if (!m)
-            continue;
-
-        TranslatorMessage mtm = m->message();
-        if (mtm.type() == TranslatorMessage::Unfinished
-            || mtm.translation().isEmpty())
-            continue;
-
-        QString s = m->text();
-
-        int score = stringmatcher.getSimilarityScore(s);
-
-        if (candidates.size() == maxCandidates && score > scores[maxCandidates - 1])
-            candidates.removeLast();
-        if (candidates.size() < maxCandidates && score >= textSimilarityThreshold ) {
-            Candidate cand(mtm.context(), s, mtm.comment(), mtm.translation());
-
-            int i;
-            for (i = 0; i < candidates.size(); ++i) {
-                if (score >= scores.at(i)) {
-                    if (score == scores.at(i)) {
-                        if (candidates.at(i) == cand)
-                            goto continue_outer_loop;
-                    } else {
-                        break;
-                    }
-                }
-            }
-            scores.insert(i, score);
-            candidates.insert(i, cand);
+    return m->message().type() != TranslatorMessage::Unfinished
+        && !m->translation().isEmpty();
+}
+
+static Candidate guessCandidate(const MessageItem *m)
+{
+    return Candidate(m->context(), m->text(), m->comment(), m->translation());
+}
+
+const SimilarTextIndex &PhraseView::guessIndex(int model)
+{
+    GuessIndex &gi = m_guessIndexes[m_dataModel->model(model)];
+    if (!gi.contextOffsets.isEmpty() || !m_dataModel->contextCount())
+        return gi.index;
+
+    // Every message slot gets an entry, so that an entry can be found again
+    // from the context and message numbers of a MultiDataIndex.
+    gi.contextOffsets.reserve(m_dataModel->contextCount());
+    for (int ctx = 0; ctx < m_dataModel->contextCount(); ++ctx) {
+        gi.contextOffsets.append(gi.index.size());
+        const MultiContextItem *mc = m_dataModel->multiContextItem(ctx);
+        for (int msg = 0; msg < mc->messageCount(); ++msg) {
+            if (const MessageItem *m = mc->messageItem(model, msg))
+                gi.index.append(guessCandidate(m), isGuessCandidate(m));
+            else
+                gi.index.append(Candidate(), false);
         }
-        continue_outer_loop:
-        ;
     }
-    return candidates;
+    return gi.index;
+}
+
+void PhraseView::invalidateGuessIndexes()
+{
+    m_guessIndexes.clear();
+}
+
+void PhraseView::updateGuessIndex(const MultiDataIndex &index)
+{
+    auto it = m_guessIndexes.find(m_dataModel->model(index.model()));
+    if (it == m_guessIndexes.end() || it->contextOffsets.isEmpty())
+        return;
+    if (const MessageItem *m = m_dataModel->messageItem(index)) {
+        it->index.setCandidate(it->contextOffsets.at(index.context()) + index.message(),
+                               guessCandidate(m), isGuessCandidate(m));
+    }
 }
 
 
@@ -237,8 +250,8 @@ void PhraseView::setSourceText(int model, const QString &sourceText)
         m_phraseModel->addPhrase(p);
 
     if (!sourceText.isEmpty() && m_doGuesses) {
-        const CandidateList cl = similarTextHeuristicCandidates(m_dataModel, model,
-            sourceText.toLatin1(), m_maxCandidates);
+        const CandidateList cl = guessIndex(model).candidates(
+            QString::fromLatin1(sourceText.toLatin1()), m_maxCandidates);
         int n = 0;
         for (const Candidate &candidate : cl) {
             QString def;
@@ -259,18 +272,9 @@ void PhraseView::setSourceText(int model, const QString &sourceText)
 QList<Phrase *> PhraseView::getPhrases(int model, const QString &source)
 {
     QList<Phrase *> phrases;
-    const QString f = MainWindow::friendlyString(source);
-    const QStringList lookupWords = f.split(u' ');
-
-    for (const QString &s : lookupWords) {
-        if (m_phraseDict->at(model).contains(s)) {
-            const auto phraseList = m_phraseDict->at(model).value(s);
-            for (Phrase *p : phraseList) {
-                if (f.contains(MainWindow::friendlyString(p->source())))
-                    phrases.append(p);
-            }
-        }
-    }
+    const QStringList words = MainWindow::friendlyString(source).split(u' ');
+    for (const PhraseBook *pb : m_modelPhraseBooks->at(model))
+        phrases += pb->index().findPhrases(words);
     return phrases;
 }
 
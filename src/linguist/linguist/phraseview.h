@@ -4,6 +4,7 @@
 #ifndef PHRASEVIEW_H
 #define PHRASEVIEW_H
 
+#include <QHash>
 #include <QList>
 #include <QTreeView>
 #include "phrase.h"
@@ -12,6 +13,8 @@ QT_BEGIN_NAMESPACE
 
 static const int DefaultMaxCandidates = 5;
 
+class DataModel;
+class MultiDataIndex;
 class MultiDataModel;
 class PhraseModel;
 
@@ -20,7 +23,7 @@ class PhraseView : public QTreeView
     Q_OBJECT
 
 public:
-    PhraseView(MultiDataModel *model, QList<QHash<QString, QList<Phrase *> > > *phraseDict, QWidget *parent = 0);
+    PhraseView(MultiDataModel *model, QList<QList<PhraseBook *> > *modelPhraseBooks, QWidget *parent = 0);
     ~PhraseView();
     void setSourceText(int model, const QString &sourceText);
 
@@ -51,14 +54,24 @@ private slots:
     void selectCurrentPhrase();
     void editPhrase();
     void gotoMessageFromGuess();
+    void invalidateGuessIndexes();
+    void updateGuessIndex(const MultiDataIndex &index);
 
 private:
+    struct GuessIndex
+    {
+        SimilarTextIndex index;
+        QList<int> contextOffsets; // index entry id of each context's first message
+    };
+
     QList<Phrase *> getPhrases(int model, const QString &sourceText);
+    const SimilarTextIndex &guessIndex(int model);
     void deleteGuesses();
 
     MultiDataModel *m_dataModel;
-    QList<QHash<QString, QList<Phrase *> > > *m_phraseDict;
+    QList<QList<PhraseBook *> > *m_modelPhraseBooks;
     QList<Phrase *> m_guesses;
+    QHash<const DataModel *, GuessIndex> m_guessIndexes;
     PhraseModel *m_phraseModel;
     QString m_sourceText;
     int m_modelIndex;
@@ -0,0 +1,472 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "validationengine.h"
+
+#include "errorsview.h"
+#include "mainwindow.h"
+
+#include <QtCore/QTimer>
+
+#include <ctype.h>
+#include <optional>
+
+using namespace Qt::Literals::StringLiterals;
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+enum Ending {
+    End_None,
+    End_FullStop,
+    End_Interrobang,
+    End_Colon,
+    End_Ellipsis
+};
+
+static QString leadingWhitespace(const QString &str)
+{
+    int i = 0;
+    for (; i < str.size(); i++) {
+        if (!str[i].isSpace()) {
+            break;
+        }
+    }
+    return str.left(i);
+}
+
+static QString trailingWhitespace(const QString &str)
+{
+    int i = str.size();
+    while (--i >= 0) {
+        if (!str[i].isSpace()) {
+            break;
+        }
+    }
+    return str.mid(i + 1);
+}
+
+static Ending ending(QString str, QLocale::Language lang)
+{
+    str = str.simplified();
+    if (str.isEmpty())
+        return End_None;
+
+    switch (str.at(str.size() - 1).unicode()) {
+    case 0x002e: // full stop
+        if (str.endsWith("..."_L1))
+            return End_Ellipsis;
+        else
+            return End_FullStop;
+    case 0x0589: // armenian full stop
+    case 0x06d4: // arabic full stop
+    case 0x3002: // ideographic full stop
+        return End_FullStop;
+    case 0x0021: // exclamation mark
+    case 0x003f: // question mark
+    case 0x00a1: // inverted exclamation mark
+    case 0x00bf: // inverted question mark
+    case 0x01c3: // latin letter retroflex click
+    case 0x037e: // greek question mark
+    case 0x061f: // arabic question mark
+    case 0x203c: // double exclamation mark
+    case 0x203d: // interrobang
+    case 0x2048: // question exclamation mark
+    case 0x2049: // exclamation question mark
+    case 0x2762: // heavy exclamation mark ornament
+    case 0xff01: // full width exclamation mark
+    case 0xff1f: // full width question mark
+        return End_Interrobang;
+    case 0x003b: // greek 'compatibility' questionmark
+        return lang == QLocale::Greek ? End_Interrobang : End_None;
+    case 0x003a: // colon
+    case 0xff1a: // full width colon
+        return End_Colon;
+    case 0x2026: // horizontal ellipsis
+        return End_Ellipsis;
+    default:
+        return End_None;
+    }
+}
+
+static bool haveMnemonic(const QString &str)
+{
+    for (const ushort *p = (ushort *)str.constData();;) { // Assume null-termination
+        ushort c = *p++;
+        if (!c)
+            break;
+        if (c == '&') {
+            c = *p++;
+            if (!c)
+                return false;
+            // Matches QKeySequence::mnemonic(), except for
+            // '&#' - most likely the start of an NCR
+            // '& ' - too many false positives
+            if (c != '&' && c != ' ' && c != '#' && QChar(c).isPrint()) {
+                const ushort *pp = p;
+                for (; *p < 256 && isalpha(*p); p++)
+                    ;
+                if (pp == p || *p != ';')
+                    return true;
+                // This looks like a HTML &entity;, so ignore it. As a HTML string
+                // won't contain accels anyway, we can stop scanning here.
+                break;
+            }
+        }
+    }
+    return false;
+}
+
+static QHash<int, int> countPlaceMarkers(const QString &str)
+{
+    QHash<int, int> counts;
+    const QChar *c = str.unicode();
+    const QChar *cend = c + str.size();
+    while (c < cend) {
+        if (c->unicode() == '%') {
+            const QChar *escape_start = ++c;
+            while (c->isDigit())
+                ++c;
+            const QChar *escape_end = c;
+            bool ok = true;
+            int markerIndex =
+                    QString::fromRawData(escape_start, escape_end - escape_start).toInt(&ok);
+            if (ok)
+                counts[markerIndex]++;
+        } else {
+            ++c;
+        }
+    }
+    return counts;
+}
+
+struct Validator
+{
+    static Validator fromSource(const QString &source, ValidationEngine::Checks checks,
+                                QLocale::Language locale,
+                                const ValidationEngine::PhraseTargets &phrases)
+    {
+        Validator v;
+        if (checks.testFlag(ValidationEngine::AcceleratorCheck))
+            v.m_haveMnemonic.emplace(haveMnemonic(source));
+        if (checks.testFlag(ValidationEngine::PunctuationCheck))
+            v.m_ending.emplace(ending(source, locale));
+        if (checks.testFlag(ValidationEngine::PlaceMarkerCheck))
+            v.m_placeMarkerCounts.emplace(countPlaceMarkers(source));
+        if (checks.testFlag(ValidationEngine::WhitespaceCheck)) {
+            v.m_leadingWhiteSpace.emplace(leadingWhitespace(source));
+            v.m_trailingWhiteSpace.emplace(trailingWhitespace(source));
+        }
+        if (checks.testFlag(ValidationEngine::PhraseCheck)) {
+            v.m_matchingPhraseTargets.emplace();
+            QString fsource = MainWindow::friendlyString(source);
+            if (auto targets = phrases.find(fsource); targets != phrases.constEnd())
+                v.m_matchingPhraseTargets->insert(fsource.section(u' ', 0, 0), *targets);
+        }
+
+        return v;
+    }
+
+    bool validate(const QString &translation, QLocale::Language locale, int modelId,
+                  bool needsRef, bool verbose, ErrorsView *errorsView)
+    {
+        bool danger = false;
+        if (m_haveMnemonic) {
+            if (*m_haveMnemonic != haveMnemonic(translation)) {
+                danger = true;
+                if (verbose)
+                    errorsView->addError(modelId,
+                                         *m_haveMnemonic ? ErrorsView::MissingAccelerator
+                                                         : ErrorsView::SuperfluousAccelerator);
+            }
+        }
+        if (m_placeMarkerCounts) {
+            if (*m_placeMarkerCounts != countPlaceMarkers(translation)) {
+                danger = true;
+                if (verbose)
+                    errorsView->addError(modelId, ErrorsView::PlaceMarkersDiffer);
+            }
+            if (needsRef && !translation.contains(QLatin1String("%n"))
+                && !translation.contains(QLatin1String("%Ln"))) {
+                danger = true;
+                if (verbose)
+                    errorsView->addError(modelId, ErrorsView::NumerusMarkerMissing);
+            }
+        }
+        if (m_ending) {
+            if (*m_ending != ending(translation, locale)) {
+                danger = true;
+                if (verbose)
+                    errorsView->addError(modelId, ErrorsView::PunctuationDiffers);
+            }
+        }
+        if (m_leadingWhiteSpace) {
+            Q_ASSERT(m_trailingWhiteSpace);
+            if (*m_leadingWhiteSpace != leadingWhitespace(translation)
+                || *m_trailingWhiteSpace != trailingWhitespace(translation)) {
+                danger = true;
+                if (verbose)
+                    errorsView->addError(modelId, ErrorsView::SurroundingWhitespaceDiffers);
+            }
+        }
+        if (m_matchingPhraseTargets) {
+            const QString ftranslation = MainWindow::friendlyString(translation);
+            for (auto itr = m_matchingPhraseTargets->cbegin();
+                 itr != m_matchingPhraseTargets->cend(); itr++) {
+                bool found = false;
+                for (const QString &target : itr.value()) {
+                    if (ftranslation.indexOf(target) >= 0) {
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found) {
+                    danger = true;
+                    if (verbose)
+                        errorsView->addError(modelId, ErrorsView::IgnoredPhrasebook, itr.key());
+                }
+            }
+        }
+
+        return danger;
+    }
+
+private:
+    Validator() = default;
+    std::optional<bool> m_haveMnemonic;
+    std::optional<QString> m_leadingWhiteSpace;
+    std::optional<QString> m_trailingWhiteSpace;
+    std::optional<Ending> m_ending;
+    std::optional<QHash<QString, QStringList>> m_matchingPhraseTargets;
+    std::optional<QHash<int, int>> m_placeMarkerCounts;
+};
+
+} // namespace
+
+// Results are handed to the GUI thread in batches of this many messages.
+static const int ResultBatchSize = 256;
+
+ValidationEngine::ValidationEngine(MultiDataModel *dataModel,
+                                   const QList<QList<PhraseBook *>> *modelPhraseBooks,
+                                   QObject *parent)
+    : QObject(parent), m_dataModel(dataModel), m_modelPhraseBooks(modelPhraseBooks)
+{
+    connect(m_dataModel, &MultiDataModel::modelAppended, this,
+            [this] { m_settingsValid = false; });
+    connect(m_dataModel, &MultiDataModel::modelDeleted, this, &ValidationEngine::modelsChanged);
+    connect(m_dataModel, &MultiDataModel::allModelsDeleted, this,
+            &ValidationEngine::modelsChanged);
+    connect(m_dataModel, &MultiDataModel::languageChanged, this, [this] {
+        invalidate();
+        validateLater();
+    });
+
+    m_worker.moveToThread(&m_thread);
+    m_thread.start(QThread::LowPriority);
+}
+
+ValidationEngine::~ValidationEngine()
+{
+    ++m_batch;
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void ValidationEngine::setChecks(Checks checks)
+{
+    if (checks == m_checks)
+        return;
+    m_checks = checks;
+    invalidate();
+}
+
+// Marks the danger state of all messages as outdated.
+void ValidationEngine::invalidate()
+{
+    ++m_checksRevision;
+    ++m_batch;
+    m_settingsValid = false;
+}
+
+// The indices of pending jobs and results may no longer be valid.
+void ValidationEngine::modelsChanged()
+{
+    ++m_layout;
+    ++m_batch;
+    m_settingsValid = false;
+    validateLater();
+}
+
+void ValidationEngine::updateSettings()
+{
+    if (m_settingsValid)
+        return;
+    m_settingsValid = true;
+
+    m_settings.clear();
+    m_settings.reserve(m_dataModel->modelCount());
+    for (int mi = 0; mi < m_dataModel->modelCount(); ++mi) {
+        ModelSettings settings;
+        settings.writable = m_dataModel->isModelWritable(mi);
+        if (settings.writable) {
+            settings.sourceLanguage = m_dataModel->sourceLanguage(mi);
+            settings.language = m_dataModel->language(mi);
+            settings.countRefNeeds = m_dataModel->model(mi)->countRefNeeds();
+            // The phrase books may be closed while the worker runs, so copy the texts.
+            if (m_checks.testFlag(PhraseCheck) && mi < m_modelPhraseBooks->size()) {
+                for (const PhraseBook *pb : m_modelPhraseBooks->at(mi)) {
+                    const auto texts = pb->index().friendlyTexts();
+                    for (const auto &[source, target] : texts)
+                        settings.phrases[source].append(target);
+                }
+            }
+        }
+        m_settings.append(settings);
+    }
+}
+
+ValidationEngine::Job ValidationEngine::makeJob(const MultiDataIndex &index,
+                                                const MessageItem *m) const
+{
+    Job job{ index, m, m->revision(), m->pluralText(), QStringList(), m->message().isPlural() };
+    if (job.source.isEmpty())
+        job.source = m->text();
+    if (m->message().isTranslated())
+        job.translations = m->translations();
+    return job;
+}
+
+bool ValidationEngine::check(const Job &job, Checks checks, const ModelSettings &settings,
+                             ErrorsView *errorsView)
+{
+    if (job.translations.isEmpty())
+        return false;
+
+    const int mi = job.index.model();
+    Validator validator =
+            Validator::fromSource(job.source, checks, settings.sourceLanguage, settings.phrases);
+
+    bool danger = false;
+    int i = 0;
+    for (QStringView translation : job.translations) {
+        while (!translation.isEmpty()) {
+            auto sep = translation.indexOf(Translator::BinaryVariantSeparator);
+            if (sep < 0)
+                sep = translation.size();
+            const QString trans = translation.first(sep).toString();
+
+            const bool needsRef = job.plural && settings.countRefNeeds.at(i++);
+            danger |= validator.validate(trans, settings.language, mi, needsRef,
+                                         errorsView != nullptr, errorsView);
+
+            translation.slice(std::min(sep + 1, translation.size()));
+        }
+    }
+    return danger;
+}
+
+// Queues all messages whose danger state is outdated for the worker.
+void ValidationEngine::validate()
+{
+    m_validateScheduled = false;
+    ++m_batch;
+    updateSettings();
+
+    QList<Job> jobs;
+    for (int c = 0; c < m_dataModel->contextCount(); ++c) {
+        const MultiContextItem *mc = m_dataModel->multiContextItem(c);
+        for (int i = 0; i < mc->messageCount(); ++i) {
+            for (int mi = 0; mi < m_dataModel->modelCount(); ++mi) {
+                if (!m_settings.at(mi).writable)
+                    continue;
+                const MessageItem *m = mc->messageItem(mi, i);
+                if (!m || m->isObsolete() || m->isValidated(m_checksRevision))
+                    continue;
+                jobs.append(makeJob(MultiDataIndex(mi, c, i), m));
+            }
+        }
+    }
+    if (jobs.isEmpty())
+        return;
+
+    QMetaObject::invokeMethod(
+            &m_worker,
+            [this, jobs = std::move(jobs), settings = m_settings, checks = m_checks,
+             checksRevision = m_checksRevision, layout = m_layout, batch = m_batch.load()] {
+                runJobs(jobs, settings, checks, checksRevision, layout, batch);
+            },
+            Qt::QueuedConnection);
+}
+
+// Coalesces the requests made while the event loop is busy, e.g. by a batch translation.
+void ValidationEngine::validateLater()
+{
+    if (m_validateScheduled)
+        return;
+    m_validateScheduled = true;
+    QTimer::singleShot(0, this, &ValidationEngine::validate);
+}
+
+// Runs in the worker thread.
+void ValidationEngine::runJobs(const QList<Job> &jobs, const QList<ModelSettings> &settings,
+                               Checks checks, int checksRevision, int layout, int batch)
+{
+    QList<Result> results;
+    const auto deliver = [&] {
+        QMetaObject::invokeMethod(
+                this,
+                [this, batchResults = std::exchange(results, {}), checksRevision, layout] {
+                    applyResults(batchResults, checksRevision, layout);
+                },
+                Qt::QueuedConnection);
+    };
+
+    for (const Job &job : jobs) {
+        if (m_batch.load(std::memory_order_relaxed) != batch)
+            break;
+        const bool danger = check(job, checks, settings.at(job.index.model()), nullptr);
+        results.append({ job.index, job.item, job.revision, danger });
+        if (results.size() == ResultBatchSize)
+            deliver();
+    }
+    if (!results.isEmpty())
+        deliver();
+}
+
+void ValidationEngine::applyResults(const QList<Result> &results, int checksRevision, int layout)
+{
+    if (checksRevision != m_checksRevision || layout != m_layout)
+        return;
+
+    for (const Result &result : results) {
+        MessageItem *m = m_dataModel->messageItem(result.index);
+        if (m != result.item || m->revision() != result.revision)
+            continue;
+        m->setValidated(result.revision, checksRevision);
+        if (result.danger != m->danger())
+            m_dataModel->setDanger(result.index, result.danger);
+    }
+}
+
+void ValidationEngine::validateNow(const MultiDataIndex &index, ErrorsView *errorsView)
+{
+    updateSettings();
+
+    MultiDataIndex curIdx = index;
+    for (int mi = 0; mi < m_dataModel->modelCount(); ++mi) {
+        if (!m_settings.at(mi).writable)
+            continue;
+        curIdx.setModel(mi);
+        MessageItem *m = m_dataModel->messageItem(curIdx);
+        if (!m || m->isObsolete())
+            continue;
+
+        const bool danger = check(makeJob(curIdx, m), m_checks, m_settings.at(mi), errorsView);
+        m->setValidated(m->revision(), m_checksRevision);
+        if (danger != m->danger())
+            m_dataModel->setDanger(curIdx, danger);
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,124 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef VALIDATIONENGINE_H
+#define VALIDATIONENGINE_H
+
+#include "messagemodel.h"
+#include "phrase.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QLocale>
+#include <QtCore/QObject>
+#include <QtCore/QStringList>
+#include <QtCore/QThread>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+class ErrorsView;
+
+/*
+  Runs the danger checks of the messages of all writable models.
+
+  The checks of the whole file set run in a worker thread. The worker only
+  sees copies of the messages and settings; the results are handed back in
+  batches and applied in the GUI thread, unless the message was edited in
+  the meantime. Each message remembers the revision it was last checked at,
+  so validate() only queues messages that changed since. invalidate() must
+  be called when anything else the checks depend on changes.
+
+  validateNow() checks the messages of one index synchronously and reports
+  the errors it finds, as needed for the current message.
+*/
+class ValidationEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Check {
+        AcceleratorCheck = 0x1,
+        PunctuationCheck = 0x2,
+        PlaceMarkerCheck = 0x4,
+        WhitespaceCheck = 0x8,
+        PhraseCheck = 0x10
+    };
+    Q_DECLARE_FLAGS(Checks, Check)
+
+    ValidationEngine(MultiDataModel *dataModel,
+                     const QList<QList<PhraseBook *>> *modelPhraseBooks,
+                     QObject *parent = nullptr);
+    ~ValidationEngine();
+
+    Checks checks() const { return m_checks; }
+    void setChecks(Checks checks);
+
+    void invalidate();
+    void validate();
+    void validateLater();
+    void validateNow(const MultiDataIndex &index, ErrorsView *errorsView);
+
+    // Friendly target texts of the phrases, by friendly source text
+    using PhraseTargets = QHash<QString, QStringList>;
+
+private:
+    struct ModelSettings
+    {
+        bool writable = false;
+        QLocale::Language sourceLanguage = QLocale::C;
+        QLocale::Language language = QLocale::C;
+        QList<bool> countRefNeeds;
+        PhraseTargets phrases;
+    };
+
+    struct Job
+    {
+        MultiDataIndex index;
+        const MessageItem *item; // Identifies the message, never dereferenced by the worker
+        int revision;
+        QString source;
+        QStringList translations;
+        bool plural;
+    };
+
+    struct Result
+    {
+        MultiDataIndex index;
+        const MessageItem *item;
+        int revision;
+        bool danger;
+    };
+
+    void modelsChanged();
+    void updateSettings();
+    Job makeJob(const MultiDataIndex &index, const MessageItem *m) const;
+    void runJobs(const QList<Job> &jobs, const QList<ModelSettings> &settings, Checks checks,
+                 int checksRevision, int layout, int batch);
+    void applyResults(const QList<Result> &results, int checksRevision, int layout);
+    static bool check(const Job &job, Checks checks, const ModelSettings &settings,
+                      ErrorsView *errorsView);
+
+    MultiDataModel *m_dataModel;
+    const QList<QList<PhraseBook *>> *m_modelPhraseBooks;
+    Checks m_checks;
+    QList<ModelSettings> m_settings;
+    bool m_settingsValid = false;
+    bool m_validateScheduled = false;
+    // Results computed for an older revision of the checks are dropped.
+    int m_checksRevision = 0;
+    // Bumped when models are removed, as message indices shift then.
+    int m_layout = 0;
+    // Bumped to make the worker abandon the jobs it was given.
+    std::atomic<int> m_batch = 0;
+
+    QThread m_thread;
+    QObject m_worker;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(ValidationEngine::Checks)
+
+QT_END_NAMESPACE
+
+#endif // VALIDATIONENGINE_H
@@ -22,7 +22,14 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace Qt::StringLiterals;
 
@@ -80,19 +87,26 @@ Options:
            Name of the output file.
     -translations-variables <variable_1>[,<variable_2>,...]
            Comma-separated list of QMake variables containing .ts files.
+    -j <n>
+           Evaluate the subprojects of a project in <n> parallel threads.
+           With 0, one thread per available core is used. The output is the
+           same as with a single thread. Ignored together with -pro-debug.
+           Default: 1.
+    -cache-dir <directory>
+           Store the parsed .pro, .pri and .prf files in <directory> and
+           reuse them in later runs for files that did not change.
     -version
            Display the version of lprodump and exit.
 )"_s);
 }
 
-static void print(const QString &fileName, int lineNo, const QString &msg)
+static QString warningText(const QString &fileName, int lineNo, const QString &msg)
 {
     if (lineNo > 0)
-        printErr(QString::fromLatin1("WARNING: %1:%2: %3\n").arg(fileName, QString::number(lineNo), msg));
-    else if (lineNo)
-        printErr(QString::fromLatin1("WARNING: %1: %2\n").arg(fileName, msg));
-    else
-        printErr(QString::fromLatin1("WARNING: %1\n").arg(msg));
+        return QString::fromLatin1("WARNING: %1:%2: %3\n").arg(fileName, QString::number(lineNo), msg);
+    if (lineNo)
+        return QString::fromLatin1("WARNING: %1: %2\n").arg(fileName, msg);
+    return QString::fromLatin1("WARNING: %1\n").arg(msg);
 }
 
 class EvalHandler : public QMakeHandler {
@@ -100,26 +114,38 @@ public:
     void message(int type, const QString &msg, const QString &fileName, int lineNo) override
     {
         if (verbose && !(type & CumulativeEvalMessage) && (type & CategoryMask) == ErrorMessage)
-            print(fileName, lineNo, msg);
+            report(warningText(fileName, lineNo, msg));
     }
 
     void fileMessage(int type, const QString &msg) override
     {
         if (verbose && !(type & CumulativeEvalMessage) && (type & CategoryMask) == ErrorMessage) {
             // "Downgrade" errors, as we don't really care for them
-            printErr("WARNING: "_L1 + msg + u'\n');
+            report("WARNING: "_L1 + msg + u'\n');
         }
     }
 
     void aboutToEval(ProFile *, ProFile *, EvalFileType) override {}
     void doneWithEval(ProFile *) override {}
 
+    // Prints to stderr, or appends to log if set.
+    void report(const QString &text)
+    {
+        if (log)
+            *log += text;
+        else
+            printErr(text);
+    }
+
     bool verbose = true;
+    QString *log = nullptr;
 };
 
 static EvalHandler evalHandler;
+static int jobCount = 1; // number of evaluator threads, 0 means one per core
 
-static QStringList getResources(const QString &resourceFile, QMakeVfs *vfs)
+static QStringList getResources(const QString &resourceFile, QMakeVfs *vfs,
+                                EvalHandler &handler)
 {
     Q_ASSERT(vfs);
     if (!vfs->exists(resourceFile, QMakeVfs::VfsCumulative))
@@ -128,13 +154,14 @@ static QStringList getResources(const QString &resourceFile, QMakeVfs *vfs)
     QString errStr;
     if (vfs->readFile(vfs->idForFileName(resourceFile, QMakeVfs::VfsCumulative),
                       &content, &errStr) != QMakeVfs::ReadOk) {
-        printErr(QStringLiteral("lprodump error: Cannot read %1: %2\n").arg(resourceFile, errStr));
+        handler.report(QStringLiteral("lprodump error: Cannot read %1: %2\n")
+                       .arg(resourceFile, errStr));
         return QStringList();
     }
     const ReadQrcResult rqr = readQrcFile(resourceFile, content);
     if (rqr.hasError()) {
-        printErr(QStringLiteral("lprodump error: %1:%2: %3\n")
-                 .arg(resourceFile, QString::number(rqr.line), rqr.errorString));
+        handler.report(QStringLiteral("lprodump error: %1:%2: %3\n")
+                       .arg(resourceFile, QString::number(rqr.line), rqr.errorString));
     }
     return rqr.files;
 }
@@ -149,7 +176,7 @@ static QStringList getSources(const char *var, const char *vvar, const QStringLi
 }
 
 static QStringList getSources(const ProFileEvaluator &visitor, const QString &projectDir,
-                              QMakeVfs *vfs)
+                              QMakeVfs *vfs, EvalHandler &handler)
 {
     QStringList baseVPaths;
     baseVPaths += visitor.absolutePathValues("VPATH"_L1, projectDir);
@@ -166,7 +193,7 @@ static QStringList getSources(const ProFileEvaluator &visitor, const QString &pr
 
     const QStringList resourceFiles = getSources("RESOURCES", "VPATH_RESOURCES", baseVPaths, projectDir, visitor);
     for (const QString &resource : resourceFiles)
-        sourceFiles += getResources(resource, vfs);
+        sourceFiles += getResources(resource, vfs, handler);
 
     QStringList installs = visitor.values("INSTALLS"_L1) + visitor.values("DEPLOYMENT"_L1);
     installs.removeDuplicates();
@@ -227,15 +254,10 @@ static void excludeProjects(const ProFileEvaluator &visitor, QStringList *subPro
     }
 }
 
-static QJsonArray processProjects(bool topLevel, const QStringList &proFiles,
-        const QStringList &translationsVariables,
-        const QHash<QString, QString> &outDirMap,
-        ProFileGlobals *option, QMakeVfs *vfs, QMakeParser *parser,
-        bool *fail);
-
-static QJsonObject processProject(const QString &proFile, const QStringList &translationsVariables,
-                                  ProFileGlobals *option, QMakeVfs *vfs,
-                                  QMakeParser *parser, ProFileEvaluator &visitor)
+// Returns the project description of proFile without its subprojects, whose
+// .pro files are appended to subProFiles instead.
+static QJsonObject processProject(const QString &proFile, ProFileEvaluator &visitor,
+                                  QMakeVfs *vfs, EvalHandler &handler, QStringList *subProFiles)
 {
     QJsonObject result;
     QStringList tmp = visitor.values("CODECFORSRC"_L1);
@@ -245,7 +267,6 @@ static QJsonObject processProject(const QString &proFile, const QStringList &tra
     if (visitor.templateType() == ProFileEvaluator::TT_Subdirs) {
         QStringList subProjects = visitor.values("SUBDIRS"_L1);
         excludeProjects(visitor, &subProjects);
-        QStringList subProFiles;
         QDir proDir(proPath);
         for (const QString &subdir : std::as_const(subProjects)) {
             QString realdir = visitor.value(subdir + ".subdir"_L1);
@@ -256,18 +277,13 @@ static QJsonObject processProject(const QString &proFile, const QStringList &tra
             QString subPro = QDir::cleanPath(proDir.absoluteFilePath(realdir));
             QFileInfo subInfo(subPro);
             if (subInfo.isDir()) {
-                subProFiles << (subPro + u'/' + subInfo.fileName() + ".pro"_L1);
+                *subProFiles << (subPro + u'/' + subInfo.fileName() + ".pro"_L1);
             } else {
-                subProFiles << subPro;
+                *subProFiles << subPro;
             }
         }
-        QJsonArray subResults = processProjects(false, subProFiles, translationsVariables,
-                                                QHash<QString, QString>(), option, vfs, parser,
-                                                nullptr);
-        if (!subResults.isEmpty())
-            setValue(result, "subProjects", subResults);
     } else {
-        const QStringList sourceFiles = getSources(visitor, proPath, vfs);
+        const QStringList sourceFiles = getSources(visitor, proPath, vfs, handler);
         setValue(result, "includePaths", visitor.absolutePathValues("INCLUDEPATH"_L1, proPath));
         setValue(result, "excluded", getExcludes(visitor, proPath));
         setValue(result, "sources", sourceFiles);
@@ -275,41 +291,125 @@ static QJsonObject processProject(const QString &proFile, const QStringList &tra
     return result;
 }
 
-static QJsonArray processProjects(bool topLevel, const QStringList &proFiles,
-        const QStringList &translationsVariables,
-        const QHash<QString, QString> &outDirMap,
-        ProFileGlobals *option, QMakeVfs *vfs, QMakeParser *parser, bool *fail)
+struct ProjectNode
 {
-    QJsonArray result;
-    for (const QString &proFile : proFiles) {
-        if (!outDirMap.isEmpty())
-            option->setDirectories(QFileInfo(proFile).path(), outDirMap[proFile]);
+    explicit ProjectNode(const QString &proFile) : proFile(proFile) {}
+
+    QString proFile;
+    bool ok = false;
+    QJsonObject project;
+    std::vector<ProjectNode *> subProjects;
+    QString log;
+};
+
+/*
+  Evaluates a project and, recursively, its subprojects.
+
+  Every project gets its own parser and evaluator; the parsed .pri and .prf
+  files are shared through the ProFileCache. Workers take projects from a
+  common queue, so sibling subprojects are evaluated concurrently. Their
+  messages are buffered and printed, like the description is assembled, in
+  the order of the SUBDIRS, so the results do not depend on the scheduling.
+*/
+class ProjectTreeEvaluator
+{
+public:
+    ProjectTreeEvaluator(const QStringList &translationsVariables, ProFileGlobals *option,
+                         QMakeVfs *vfs, ProFileCache *cache, const ProFileDiskCache *diskCache)
+        : m_translationsVariables(translationsVariables), m_option(option), m_vfs(vfs),
+          m_cache(cache), m_diskCache(diskCache)
+    {
+    }
+
+    // Appends the description of proFile to result. Returns false if the
+    // project itself could not be evaluated.
+    bool evaluate(const QString &proFile, size_t threadCount, QJsonArray *result)
+    {
+        m_nodes.clear();
+        m_pending.clear();
+        m_active = 0;
+        ProjectNode *root = &m_nodes.emplace_back(proFile);
+        m_pending.push_back(root);
+
+        if (threadCount <= 1) {
+            work(false);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(threadCount);
+            for (size_t i = 0; i < threadCount; ++i)
+                workers.emplace_back([this] { work(true); });
+            for (std::thread &worker : workers)
+                worker.join();
+        }
+
+        collect(*root, result);
+        return root->ok;
+    }
+
+private:
+    void work(bool buffered)
+    {
+        for (;;) {
+            ProjectNode *node;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cond.wait(lock, [this] { return !m_pending.empty() || !m_active; });
+                if (m_pending.empty())
+                    return;
+                node = m_pending.front();
+                m_pending.pop_front();
+                ++m_active;
+            }
+
+            EvalHandler handler;
+            handler.verbose = evalHandler.verbose;
+            if (buffered)
+                handler.log = &node->log;
+            const QStringList subProFiles = evaluateProject(node, &handler);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                // Queued in front so that a single worker goes depth-first,
+                // just like the recursion this replaces.
+                auto pos = m_pending.begin();
+                for (const QString &subProFile : subProFiles) {
+                    ProjectNode *sub = &m_nodes.emplace_back(subProFile);
+                    node->subProjects.push_back(sub);
+                    pos = m_pending.insert(pos, sub) + 1;
+                }
+                --m_active;
+            }
+            m_cond.notify_all();
+        }
+    }
 
+    QStringList evaluateProject(ProjectNode *node, EvalHandler *handler)
+    {
+        const bool topLevel = node == &m_nodes.front();
+        QMakeParser parser(m_cache, m_vfs, handler);
+        parser.setDiskCache(m_diskCache);
         ProFile *pro;
-        if (!(pro = parser->parsedProFile(proFile, topLevel ? QMakeParser::ParseReportMissing
-                                                            : QMakeParser::ParseDefault))) {
-            if (topLevel)
-                *fail = true;
-            continue;
+        if (!(pro = parser.parsedProFile(node->proFile, topLevel ? QMakeParser::ParseReportMissing
+                                                                 : QMakeParser::ParseDefault))) {
+            return QStringList();
         }
-        ProFileEvaluator visitor(option, parser, vfs, &evalHandler);
+        ProFileEvaluator visitor(m_option, &parser, m_vfs, handler);
         visitor.setCumulative(true);
-        visitor.setOutputDir(option->shadowedPath(pro->directoryName()));
+        visitor.setOutputDir(m_option->shadowedPath(pro->directoryName()));
         if (!visitor.accept(pro)) {
-            if (topLevel)
-                *fail = true;
             pro->deref();
-            continue;
+            return QStringList();
         }
 
-        QJsonObject prj = processProject(proFile, translationsVariables, option, vfs, parser,
-                                         visitor);
-        setValue(prj, "projectFile", proFile);
+        QStringList subProFiles;
+        QJsonObject &prj = node->project;
+        prj = processProject(node->proFile, visitor, m_vfs, *handler, &subProFiles);
+        setValue(prj, "projectFile", node->proFile);
         QStringList tsFiles;
-        for (const QString &varName : translationsVariables) {
+        for (const QString &varName : m_translationsVariables) {
             if (!visitor.contains(varName))
                 continue;
-            QDir proDir(QFileInfo(proFile).path());
+            QDir proDir(QFileInfo(node->proFile).path());
             const QStringList translations = visitor.values(varName);
             for (const QString &tsFile : translations)
                 tsFiles << proDir.filePath(tsFile);
@@ -320,8 +420,54 @@ static QJsonArray processProjects(bool topLevel, const QStringList &proFiles,
             const QStringList thepathjson = visitor.values("LUPDATE_COMPILE_COMMANDS_PATH"_L1);
             setValue(prj, "compileCommands", thepathjson.value(0));
         }
-        result.append(prj);
+        node->ok = true;
         pro->deref();
+        return subProFiles;
+    }
+
+    static void collect(const ProjectNode &node, QJsonArray *result)
+    {
+        if (!node.log.isEmpty())
+            printErr(node.log);
+        if (!node.ok)
+            return;
+        QJsonObject prj = node.project;
+        QJsonArray subResults;
+        for (const ProjectNode *sub : node.subProjects)
+            collect(*sub, &subResults);
+        if (!subResults.isEmpty())
+            setValue(prj, "subProjects", subResults);
+        result->append(prj);
+    }
+
+    const QStringList &m_translationsVariables;
+    ProFileGlobals *m_option;
+    QMakeVfs *m_vfs;
+    ProFileCache *m_cache;
+    const ProFileDiskCache *m_diskCache;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::deque<ProjectNode> m_nodes; // keeps the addresses stable; the root comes first
+    std::deque<ProjectNode *> m_pending;
+    int m_active = 0;
+};
+
+static QJsonArray processProjects(const QStringList &proFiles,
+        const QStringList &translationsVariables,
+        const QHash<QString, QString> &outDirMap,
+        ProFileGlobals *option, QMakeVfs *vfs, ProFileCache *cache,
+        const ProFileDiskCache *diskCache, size_t threadCount, bool *fail)
+{
+    QJsonArray result;
+    ProjectTreeEvaluator evaluator(translationsVariables, option, vfs, cache, diskCache);
+    for (const QString &proFile : proFiles) {
+        // The directories are global, so only the projects below one top-level
+        // project can be evaluated at the same time.
+        if (!outDirMap.isEmpty())
+            option->setDirectories(QFileInfo(proFile).path(), outDirMap[proFile]);
+        if (!evaluator.evaluate(proFile, threadCount, &result))
+            *fail = true;
     }
     return result;
 }
@@ -335,6 +481,7 @@ int main(int argc, char **argv)
     QString outDir = QDir::currentPath();
     QHash<QString, QString> outDirMap;
     QString outputFilePath;
+    QString cacheDir;
     int proDebug = 0;
 
     for (int i = 1; i < args.size(); ++i) {
@@ -353,6 +500,25 @@ int main(int argc, char **argv)
             evalHandler.verbose = false;
         } else if (arg == "-pro-debug"_L1) {
             proDebug++;
+        } else if (arg == "-j"_L1) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The option -j requires a parameter.\n"_s);
+                return 1;
+            }
+            bool ok = false;
+            jobCount = args[i].toInt(&ok);
+            if (!ok || jobCount < 0) {
+                printErr(u"Invalid parameter passed to -j.\n"_s);
+                return 1;
+            }
+        } else if (arg == "-cache-dir"_L1) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The option -cache-dir requires a parameter.\n"_s);
+                return 1;
+            }
+            cacheDir = args[i];
         } else if (arg == "-version"_L1) {
             printOut(QStringLiteral("lprodump version %1\n").arg(QLatin1String(QT_VERSION_STR)));
             return 0;
@@ -415,10 +581,28 @@ int main(int argc, char **argv)
     option.initProperties();
     option.setCommandLineArguments(QDir::currentPath(), { "CONFIG+=lupdate_run"_L1 });
     QMakeVfs vfs;
-    QMakeParser parser(0, &vfs, &evalHandler);
+    ProFileCache cache;
+    std::unique_ptr<ProFileDiskCache> diskCache;
+    if (!cacheDir.isEmpty()) {
+        diskCache = std::make_unique<ProFileDiskCache>(cacheDir);
+        if (!diskCache->isValid()) {
+            printErr(QStringLiteral("lprodump error: Cannot create cache directory %1.\n")
+                     .arg(cacheDir));
+            return 1;
+        }
+    }
+    QMakeParser::initialize();
+    ProFileEvaluator::initialize();
+
+    // The traces of -pro-debug are not buffered, so they need a single thread.
+    size_t threadCount = 1;
+    if (!proDebug) {
+        threadCount = jobCount > 0 ? size_t(jobCount)
+                                   : std::max(1u, std::thread::hardware_concurrency());
+    }
 
-    QJsonArray results = processProjects(true, proFiles, translationsVariables, outDirMap, &option,
-                                         &vfs, &parser, &fail);
+    QJsonArray results = processProjects(proFiles, translationsVariables, outDirMap, &option,
+                                         &vfs, &cache, diskCache.get(), threadCount, &fail);
     if (fail)
         return 1;
 
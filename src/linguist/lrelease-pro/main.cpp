@@ -40,6 +40,12 @@ Options:
     -keep  Keep the temporary project dump around
     -silent
            Do not explain what is being done
+    -j <n>
+           Evaluate subprojects and run lrelease in <n> parallel threads.
+           With 0, one thread per available core is used. Default: 1
+    -cache-dir <directory>
+           Store the parsed project files in <directory> and reuse them
+           in later runs
     -version
            Display the version of lrelease-pro and exit
 )"_s);
@@ -81,6 +87,23 @@ int main(int argc, char **argv)
         } else if (!strcmp(argv[i], "-help")) {
             printUsage();
             return 0;
+        } else if (!strcmp(argv[i], "-j")) {
+            if (i == argc - 1) {
+                printErr(u"The option -j requires a parameter.\n"_s);
+                return 1;
+            }
+            const QStringList jobOptions = { QString::fromLocal8Bit(argv[i]),
+                                             QString::fromLocal8Bit(argv[i + 1]) };
+            lprodumpOptions << jobOptions;
+            lreleaseOptions << jobOptions;
+            ++i;
+        } else if (!strcmp(argv[i], "-cache-dir")) {
+            if (i == argc - 1) {
+                printErr(u"The option -cache-dir requires a parameter.\n"_s);
+                return 1;
+            }
+            lprodumpOptions << QString::fromLocal8Bit(argv[i]) << QString::fromLocal8Bit(argv[i + 1]);
+            ++i;
         } else if (strlen(argv[i]) > 0 && argv[i][0] == '-') {
             lreleaseOptions << QString::fromLocal8Bit(argv[i]);
         } else {
@@ -20,6 +20,12 @@
 #include <QtCore/QTextStream>
 #include <QtCore/QLibraryInfo>
 
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 QT_USE_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -69,6 +75,13 @@ Options:
     -project <filename>
            Name of a file containing the project's description in JSON format.
            Such a file may be generated from a .pro file using the lprodump tool.
+    -j <n>
+           Release <n> TS files in parallel. With 0, one thread per available
+           core is used. The generated files and the reported messages are the
+           same as with a single thread. Has no effect together with -qm.
+           In either case, a file that fails to be released does not stop
+           the release of the others.
+           Default: 1.
     -silent
            Do not explain what is being done
     -verbose
@@ -78,42 +91,103 @@ Options:
 )"_s);
 }
 
-static bool loadTsFile(Translator &tor, const QString &tsFileName)
+/*
+  Collects what releasing a file prints, so that files released in parallel
+  can report in input order. An unbuffered log prints right away.
+*/
+class ReleaseLog
+{
+public:
+    explicit ReleaseLog(bool buffered = false) : m_buffered(buffered) {}
+
+    void printOut(const QString &out) { append(false, out); }
+    void printErr(const QString &out) { append(true, out); }
+    void reportDuplicates(Translator &tor, const QString &fileName, bool verbose);
+    void flush();
+
+private:
+    struct Chunk
+    {
+        bool isError;
+        QString text;
+    };
+
+    void append(bool isError, const QString &text);
+
+    bool m_buffered;
+    QList<Chunk> m_chunks;
+};
+
+void ReleaseLog::append(bool isError, const QString &text)
+{
+    if (m_buffered)
+        m_chunks.append({ isError, text });
+    else if (isError)
+        ::printErr(text);
+    else
+        ::printOut(text);
+}
+
+void ReleaseLog::reportDuplicates(Translator &tor, const QString &fileName, bool verbose)
+{
+    if (!m_buffered) {
+        tor.reportDuplicates(tor.resolveDuplicates(), fileName, verbose);
+        return;
+    }
+    std::ostringstream out;
+    tor.reportDuplicates(tor.resolveDuplicates(), fileName, verbose, out);
+    const std::string report = out.str();
+    if (!report.empty())
+        printErr(QString::fromLocal8Bit(report.data(), qsizetype(report.size())));
+}
+
+void ReleaseLog::flush()
+{
+    for (const Chunk &chunk : std::as_const(m_chunks)) {
+        if (chunk.isError)
+            ::printErr(chunk.text);
+        else
+            ::printOut(chunk.text);
+    }
+    m_chunks.clear();
+}
+
+static bool loadTsFile(Translator &tor, const QString &tsFileName, ReleaseLog &log)
 {
     ConversionData cd;
     bool ok = tor.load(tsFileName, cd, "auto"_L1);
     if (!ok) {
-        printErr("lrelease error: %1"_L1.arg(cd.error()));
+        log.printErr("lrelease error: %1"_L1.arg(cd.error()));
     } else {
         if (!cd.errors().isEmpty())
-            printOut(cd.error());
+            log.printOut(cd.error());
     }
     cd.clearErrors();
     return ok;
 }
 
 static bool releaseTranslator(Translator &tor, const QString &qmFileName, ConversionData &cd,
-                              bool removeIdentical, bool failOnUnfinished)
+                              bool removeIdentical, bool failOnUnfinished, ReleaseLog &log)
 {
     if (failOnUnfinished && tor.unfinishedTranslationsExist()) {
-        printErr("lrelease error: cannot create '%1': existing unfinished translation(s) "
-                 "found (-fail-on-unfinished)"_L1.arg(qmFileName));
+        log.printErr("lrelease error: cannot create '%1': existing unfinished translation(s) "
+                     "found (-fail-on-unfinished)"_L1.arg(qmFileName));
         return false;
     }
 
-    tor.reportDuplicates(tor.resolveDuplicates(), qmFileName, cd.isVerbose());
+    log.reportDuplicates(tor, qmFileName, cd.isVerbose());
 
     if (cd.isVerbose())
-        printOut("Updating '%1'...\n"_L1.arg(qmFileName));
+        log.printOut("Updating '%1'...\n"_L1.arg(qmFileName));
     if (removeIdentical) {
         if (cd.isVerbose())
-            printOut("Removing translations equal to source text in '%1'...\n"_L1.arg(qmFileName));
+            log.printOut("Removing translations equal to source text in '%1'...\n"_L1.arg(qmFileName));
         tor.stripIdenticalSourceTranslations();
     }
 
     QFile file(qmFileName);
     if (!file.open(QIODevice::WriteOnly)) {
-        printErr("lrelease error: cannot create '%1': %2\n"_L1.arg(qmFileName, file.errorString()));
+        log.printErr("lrelease error: cannot create '%1': %2\n"_L1.arg(qmFileName, file.errorString()));
         return false;
     }
 
@@ -122,19 +196,19 @@ static bool releaseTranslator(Translator &tor, const QString &qmFileName, Conver
     file.close();
 
     if (!ok) {
-        printErr("lrelease error: cannot save '%1': %2"_L1.arg(qmFileName, cd.error()));
+        log.printErr("lrelease error: cannot save '%1': %2"_L1.arg(qmFileName, cd.error()));
     } else if (!cd.errors().isEmpty()) {
-        printOut(cd.error());
+        log.printOut(cd.error());
     }
     cd.clearErrors();
     return ok;
 }
 
 static bool releaseTsFile(const QString &tsFileName, ConversionData &cd, bool removeIdentical,
-                          bool failOnUnfinished)
+                          bool failOnUnfinished, ReleaseLog &log)
 {
     Translator tor;
-    if (!loadTsFile(tor, tsFileName))
+    if (!loadTsFile(tor, tsFileName, log))
         return false;
 
     QString qmFileName = tsFileName;
@@ -146,7 +220,59 @@ static bool releaseTsFile(const QString &tsFileName, ConversionData &cd, bool re
     }
     qmFileName += ".qm"_L1;
 
-    return releaseTranslator(tor, qmFileName, cd, removeIdentical, failOnUnfinished);
+    return releaseTranslator(tor, qmFileName, cd, removeIdentical, failOnUnfinished, log);
+}
+
+static bool releaseTsFiles(const QStringList &tsFileNames, ConversionData &cd,
+                           bool removeIdentical, bool failOnUnfinished, int jobCount)
+{
+    size_t threadCount = jobCount > 0 ? size_t(jobCount)
+                                      : size_t(std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, size_t(tsFileNames.size()));
+
+    // A failure does not stop the release of the other files, so that a run
+    // reports all errors and writes the same files, however many threads it
+    // uses. Jobs that are running when a file fails could not be stopped anyway.
+    if (threadCount <= 1) {
+        ReleaseLog log;
+        bool ok = true;
+        for (const QString &tsFileName : tsFileNames) {
+            if (!releaseTsFile(tsFileName, cd, removeIdentical, failOnUnfinished, log))
+                ok = false;
+        }
+        return ok;
+    }
+
+    // Every file is loaded, squeezed and written by one thread with its own
+    // ConversionData. What a file reports is replayed in input order.
+    const qsizetype count = tsFileNames.size();
+    std::vector<ReleaseLog> logs(count, ReleaseLog(true));
+    std::vector<char> succeeded(count, false);
+    std::atomic<qsizetype> nextIndex = 0;
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back([&]() {
+            for (;;) {
+                const qsizetype index = nextIndex.fetch_add(1);
+                if (index >= count)
+                    break;
+                ConversionData fileCd = cd;
+                succeeded[index] = releaseTsFile(tsFileNames.at(index), fileCd, removeIdentical,
+                                                 failOnUnfinished, logs[index]);
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+
+    bool ok = true;
+    for (qsizetype i = 0; i < count; ++i) {
+        logs[i].flush();
+        if (!succeeded[i])
+            ok = false;
+    }
+    return ok;
 }
 
 static QStringList translationsFromProjects(const Projects &projects, bool topLevel);
@@ -180,6 +306,7 @@ int main(int argc, char **argv)
     cd.m_verbose = true; // the default is true starting with Qt 4.2
     bool removeIdentical = false;
     bool failOnUnfinished = false;
+    int jobCount = 1;
     Translator tor;
     QStringList inputFiles;
     QString outputFile;
@@ -221,6 +348,17 @@ int main(int argc, char **argv)
                 return 1;
             }
             projectDescriptionFile = QString::fromLocal8Bit(argv[++i]);
+        } else if (!strcmp(arg, "-j")) {
+            if (i == argc - 1) {
+                printErr("The option -j requires a parameter.\n"_L1);
+                return 1;
+            }
+            bool ok = false;
+            jobCount = QString::fromLocal8Bit(argv[++i]).toInt(&ok);
+            if (!ok || jobCount < 0) {
+                printErr("Invalid parameter passed to -j.\n"_L1);
+                return 1;
+            }
         } else if (!strcmp(arg, "-silent")) {
             cd.m_verbose = false;
             continue;
@@ -272,18 +410,13 @@ int main(int argc, char **argv)
         inputFiles = translationsFromProjects(projectDescription);
     }
 
+    if (outputFile.isEmpty())
+        return releaseTsFiles(inputFiles, cd, removeIdentical, failOnUnfinished, jobCount) ? 0 : 1;
+
+    ReleaseLog log;
     for (const QString &inputFile : std::as_const(inputFiles)) {
-        if (outputFile.isEmpty()) {
-            if (!releaseTsFile(inputFile, cd, removeIdentical, failOnUnfinished))
-                return 1;
-        } else {
-            if (!loadTsFile(tor, inputFile))
-                return 1;
-        }
+        if (!loadTsFile(tor, inputFile, log))
+            return 1;
     }
-
-    if (!outputFile.isEmpty())
-        return releaseTranslator(tor, outputFile, cd, removeIdentical, failOnUnfinished) ? 0 : 1;
-
-    return 0;
+    return releaseTranslator(tor, outputFile, cd, removeIdentical, failOnUnfinished, log) ? 0 : 1;
 }
@@ -50,6 +50,13 @@ Options:
            Virtual output directory for processing subsequent .pro files.
     -pro-debug
            Trace processing .pro files. Specify twice for more verbosity.
+    -j <n>
+           Evaluate subprojects and run lupdate in <n> parallel threads.
+           With 0, one thread per available core is used. Default: 1.
+    -cache-dir <directory>
+           Let lupdate and the evaluation of the projects store their parse
+           results in the subdirectories lupdate and lprodump of <directory>
+           and reuse them in later runs.
     -version
            Display the version of lupdate-pro and exit.
 )"_s);
@@ -90,6 +97,24 @@ int main(int argc, char **argv)
             lprodumpOptions << arg;
         } else if (arg == "-pro-debug"_L1) {
             lprodumpOptions << arg;
+        } else if (arg == "-j"_L1) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The option -j requires a parameter.\n"_s);
+                return 1;
+            }
+            lupdateOptions << arg << args[i];
+            lprodumpOptions << arg << args[i];
+        } else if (arg == "-cache-dir"_L1) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The option -cache-dir requires a parameter.\n"_s);
+                return 1;
+            }
+            // The tools store different things, each in its own directory.
+            const QDir cacheDir(args[i]);
+            lupdateOptions << arg << cacheDir.filePath(u"lupdate"_s);
+            lprodumpOptions << arg << cacheDir.filePath(u"lprodump"_s);
         } else if (arg == "-version"_L1) {
             printOut(QStringLiteral("lupdate-pro version %1\n").arg(QLatin1String(QT_VERSION_STR)));
             return 0;
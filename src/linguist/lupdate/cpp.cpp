@@ -3,10 +3,27 @@
 
 #include "cpp.h"
 
+#include "synchronized.h"
+
 #include <translator.h>
 #include <QtCore/QBitArray>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QMutex>
+#include <QtCore/QSaveFile>
 #include <QtCore/QTextStream>
+#include <QtCore/QThread>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QWaitCondition>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -47,13 +64,67 @@ QDebug operator<<(QDebug debug, const HashStringList &lst)
     return debug << lst.m_list;
 }
 
-static int nextFileId;
+// Ids are handed out by all parser threads; a result's id is assigned before the
+// result is published through CppFiles, so every reachable id is below the counter.
+static std::atomic<int> nextFileId = 0;
+
+// Namespaces of shared header results are visible to all parser threads.
+// Their lazily computed trQualification must be accessed under this lock.
+// Parser threads do not set the complained flag, see CppMessageLog.
+static QMutex namespaceAnnotationMutex;
+
+// The diagnostics of parsing a file in a parser thread. They are held back,
+// and printed after all threads finished in the order a serial run prints
+// them: a header's diagnostics where it is first included, and a complaint
+// about a class only the first time.
+class CppMessageLog {
+public:
+    std::ostream &stream() { return m_text; }
+    void addInclude(const ResultsCacheKey &key)
+    {
+        flush();
+        m_entries.push_back({ {}, key, nullptr });
+    }
+    void addComplaint(Namespace *classDef, const QString &text)
+    {
+        flush();
+        m_entries.push_back({ text.toStdString(), std::nullopt, classDef });
+    }
+    bool hasComplaints() const
+    {
+        return std::any_of(m_entries.cbegin(), m_entries.cend(),
+                           [](const Entry &entry) { return entry.complaintAbout; });
+    }
+    // Keeps the results of a file that are not shared alive until the
+    // complaints about their classes are printed.
+    void keepAlive(ParseResults *results) { m_results.reset(results); }
+    void print(QSet<ResultsCacheKey> *printedIncludes);
+
+private:
+    struct Entry {
+        std::string text;
+        std::optional<ResultsCacheKey> include;
+        Namespace *complaintAbout;
+    };
+
+    void flush()
+    {
+        if (m_text.tellp() > 0) {
+            m_entries.push_back({ m_text.str(), std::nullopt, nullptr });
+            m_text.str(std::string());
+        }
+    }
+
+    std::ostringstream m_text;
+    std::vector<Entry> m_entries;
+    std::unique_ptr<ParseResults> m_results;
+};
 
 class VisitRecorder {
 public:
     VisitRecorder()
     {
-        m_ba.resize(nextFileId);
+        m_ba.resize(nextFileId.load(std::memory_order_acquire));
     }
     bool tryVisit(int fileId)
     {
@@ -73,12 +144,15 @@ public:
     void setInput(const QString &in);
     void setInput(QTextStream &ts, const QString &fileName);
     void setTranslator(Translator *_tor) { tor = _tor; }
+    const Translator *translator() const { return tor; }
     void parse(ConversionData &cd, const QStringList &includeStack, QSet<QString> &inclusions);
     bool parseTranslate(QString &prefix);
     void parseInternal(ConversionData &cd, const QStringList &includeStack,
                        QSet<QString> &inclusions);
     const ParseResults *recordResults(bool isHeader);
     void deleteResults() { delete results; }
+    void setCacheKey(const QByteArray &key);
+    void setMessageLog(CppMessageLog *log) { messageLog = log; }
 
 private:
     struct IfdefState {
@@ -134,6 +208,7 @@ private:
     };
 
     std::ostream &yyMsg(int line = 0);
+    void complainLacksQObject(Namespace *classDef, const QString &context);
 
     int getChar();
     TokenType lookAheadToSemicolonOrLeftBrace();
@@ -231,6 +306,7 @@ private:
     QString prospectiveContext;
     ParseResults *results;
     Translator *tor;
+    CppMessageLog *messageLog = nullptr; // Diagnostics go to stderr directly if not set
     bool directInclude;
 
     CppParserState savedState;
@@ -263,7 +339,23 @@ CppParser::CppParser(ParseResults *_results)
 
 std::ostream &CppParser::yyMsg(int line)
 {
-    return std::cerr << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
+    std::ostream &out = messageLog ? messageLog->stream() : std::cerr;
+    return out << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
+}
+
+void CppParser::complainLacksQObject(Namespace *classDef, const QString &context)
+{
+    const QString message = QStringLiteral("%1:%2: Class '%3' lacks Q_OBJECT macro\n")
+                                    .arg(yyFileName).arg(yyLineNo).arg(context);
+    if (messageLog) {
+        // Whether this is the first complaint is known when printing the log.
+        messageLog->addComplaint(classDef, message);
+        return;
+    }
+    if (!classDef->complained) {
+        std::cerr << qPrintable(message);
+        classDef->complained = true;
+    }
 }
 
 void CppParser::setInput(const QString &in)
@@ -1186,6 +1278,13 @@ Namespace *CppParser::findNamespace(const NamespaceList &namespaces, int nsCount
     return ns;
 }
 
+static bool isOwnNamespace(const ParseResults *results, const Namespace *ns)
+{
+    while (ns->parent)
+        ns = ns->parent;
+    return ns == &results->rootNamespace;
+}
+
 void CppParser::enterNamespace(NamespaceList *namespaces, const HashString &name)
 {
     *namespaces << name;
@@ -1193,7 +1292,11 @@ void CppParser::enterNamespace(NamespaceList *namespaces, const HashString &name
     if (!(ns = findNamespace(*namespaces)))
         ns = modifyNamespace(namespaces, false);
 
-    ns->usings << ns->parent->usings;
+    // A namespace found in an included file inherited all of its parent's
+    // usings when that file's results were recorded. Do not touch it, as the
+    // results of other files are shared and must stay immutable.
+    if (isOwnNamespace(results, ns))
+        ns->usings << ns->parent->usings;
 }
 
 void CppParser::truncateNamespaces(NamespaceList *namespaces, int length)
@@ -1224,6 +1327,52 @@ size_t qHash(const ResultsCacheKey &key, size_t seed)
     return seed;
 }
 
+// Guards the CppFiles caches, which are shared by all parser threads.
+static QMutex cppFilesMutex;
+
+// The results that parser threads are parsing, and the claim each waiting thread
+// waits for to be released. A thread may claim the same results again while it
+// holds them, when a header includes itself under the same parser state.
+struct ResultsClaimState {
+    Qt::HANDLE owner = nullptr;
+    int depth = 0;
+};
+static QHash<ResultsCacheKey, ResultsClaimState> resultsClaims;
+static QHash<Qt::HANDLE, const ResultsCacheKey *> claimWaits;
+static QWaitCondition resultsReleased;
+
+// The diagnostics of the headers that parser threads parsed stand-alone.
+static QHash<ResultsCacheKey, std::shared_ptr<CppMessageLog>> headerMessageLogs;
+
+static void setHeaderMessageLog(const ResultsCacheKey &key, std::shared_ptr<CppMessageLog> log)
+{
+    QMutexLocker locker(&cppFilesMutex);
+    headerMessageLogs.insert(key, std::move(log));
+}
+
+// Prints the log, unless it was printed before. Must not be called before all
+// parser threads finished.
+void CppMessageLog::print(QSet<ResultsCacheKey> *printedIncludes)
+{
+    flush();
+    for (const Entry &entry : m_entries) {
+        if (entry.include) {
+            if (printedIncludes->contains(*entry.include))
+                continue;
+            printedIncludes->insert(*entry.include);
+            if (const std::shared_ptr<CppMessageLog> log = headerMessageLogs.value(*entry.include))
+                log->print(printedIncludes);
+        } else if (entry.complaintAbout) {
+            if (entry.complaintAbout->complained)
+                continue;
+            entry.complaintAbout->complained = true;
+            std::cerr << entry.text;
+        } else {
+            std::cerr << entry.text;
+        }
+    }
+}
+
 IncludeCycleHash &CppFiles::includeCycles()
 {
     static IncludeCycleHash cycles;
@@ -1238,6 +1387,13 @@ TranslatorHash &CppFiles::translatedFiles()
     return tors;
 }
 
+QList<const Translator *> &CppFiles::replacedTranslators()
+{
+    static QList<const Translator *> tors;
+
+    return tors;
+}
+
 QSet<QString> &CppFiles::blacklistedFiles()
 {
     static QSet<QString> blacklisted;
@@ -1247,6 +1403,7 @@ QSet<QString> &CppFiles::blacklistedFiles()
 
 QSet<const ParseResults *> CppFiles::getResults(const ResultsCacheKey &key)
 {
+    QMutexLocker locker(&cppFilesMutex);
     IncludeCycle * const cycle = includeCycles().value(key);
 
     if (cycle)
@@ -1257,6 +1414,7 @@ QSet<const ParseResults *> CppFiles::getResults(const ResultsCacheKey &key)
 
 void CppFiles::setResults(const ResultsCacheKey &key, const ParseResults *results)
 {
+    QMutexLocker locker(&cppFilesMutex);
     IncludeCycle *cycle = includeCycles().value(key);
 
     if (!cycle) {
@@ -1268,28 +1426,108 @@ void CppFiles::setResults(const ResultsCacheKey &key, const ParseResults *result
     cycle->results.insert(results);
 }
 
+/*
+  Returns ResultsAvailable with the \a results if they are set for \a key.
+  Otherwise, claims them for the calling thread to parse them. If another thread
+  holds the claim, waits for it to be released first.
+*/
+CppFiles::ResultsClaim CppFiles::claimResults(const ResultsCacheKey &key,
+                                              QSet<const ParseResults *> *results)
+{
+    const Qt::HANDLE self = QThread::currentThreadId();
+    QMutexLocker locker(&cppFilesMutex);
+    forever {
+        if (IncludeCycle * const cycle = includeCycles().value(key)) {
+            if (!cycle->results.isEmpty()) {
+                *results = cycle->results;
+                return ResultsAvailable;
+            }
+        }
+
+        const auto claim = resultsClaims.find(key);
+        if (claim == resultsClaims.end()) {
+            resultsClaims.insert(key, { self, 1 });
+            return ResultsClaimed;
+        }
+        if (claim->owner == self) {
+            ++claim->depth;
+            return ResultsClaimed;
+        }
+
+        // The owner may wait for a claim of this thread, through other threads.
+        // That is an include cycle spanning threads, which a serial run would
+        // have cut too.
+        for (Qt::HANDLE owner = claim->owner;;) {
+            const ResultsCacheKey *awaited = claimWaits.value(owner);
+            if (!awaited)
+                break;
+            owner = resultsClaims.value(*awaited).owner;
+            if (owner == self)
+                return ResultsCyclic;
+        }
+
+        claimWaits.insert(self, &key);
+        resultsReleased.wait(&cppFilesMutex);
+        claimWaits.remove(self);
+    }
+}
+
+/*
+  Releases the claim on the results of \a key, after setting them.
+*/
+void CppFiles::releaseResults(const ResultsCacheKey &key)
+{
+    QMutexLocker locker(&cppFilesMutex);
+    const auto claim = resultsClaims.find(key);
+    if (claim != resultsClaims.end() && --claim->depth == 0) {
+        resultsClaims.erase(claim);
+        resultsReleased.wakeAll();
+    }
+}
+
 const Translator *CppFiles::getTranslator(const QString &cleanFile)
 {
+    QMutexLocker locker(&cppFilesMutex);
     return translatedFiles().value(cleanFile);
 }
 
 void CppFiles::setTranslator(const QString &cleanFile, const Translator *tor)
 {
-    translatedFiles().insert(cleanFile, tor);
+    QMutexLocker locker(&cppFilesMutex);
+    // A file parsed again under another parser state replaces its messages.
+    // The thread that parsed it before may still be storing them in the cache.
+    const Translator *&entry = translatedFiles()[cleanFile];
+    if (entry && entry != tor)
+        replacedTranslators().append(entry);
+    entry = tor;
+}
+
+/*
+  Deletes the translators that setTranslator() replaced. Must not be called
+  before all parser threads finished.
+*/
+void CppFiles::deleteReplacedTranslators()
+{
+    QMutexLocker locker(&cppFilesMutex);
+    qDeleteAll(replacedTranslators());
+    replacedTranslators().clear();
 }
 
 bool CppFiles::isBlacklisted(const QString &cleanFile)
 {
+    QMutexLocker locker(&cppFilesMutex);
     return blacklistedFiles().contains(cleanFile);
 }
 
 void CppFiles::setBlacklisted(const QString &cleanFile)
 {
+    QMutexLocker locker(&cppFilesMutex);
     blacklistedFiles().insert(cleanFile);
 }
 
 void CppFiles::addIncludeCycle(const QSet<QString> &fileNames, const CppParserState &parserState)
 {
+    QMutexLocker locker(&cppFilesMutex);
     IncludeCycle * const cycle = new IncludeCycle;
     cycle->fileNames = fileNames;
 
@@ -1311,6 +1549,394 @@ void CppFiles::addIncludeCycle(const QSet<QString> &fileNames, const CppParserSt
         includeCycles().insert({ fileName, parserState }, cycle);
 }
 
+const ParseResults *CppFiles::getCachedResults(const QByteArray &cacheKey)
+{
+    QMutexLocker locker(&cppFilesMutex);
+    return cachedResults().value(cacheKey);
+}
+
+void CppFiles::setCachedResults(const QByteArray &cacheKey, const ParseResults *results)
+{
+    QMutexLocker locker(&cppFilesMutex);
+    cachedResults().insert(cacheKey, results);
+}
+
+CachedResultsHash &CppFiles::cachedResults()
+{
+    static CachedResultsHash results;
+
+    return results;
+}
+
+/*
+  Functions for the persistent results cache.
+*/
+
+static constexpr quint32 CacheMagic = 0x4c555043; // "LUPC"
+static constexpr quint32 CacheVersion = 2;
+
+static QString cacheDirectory;
+static QByteArray cacheConfigHash;
+
+static QDataStream &operator<<(QDataStream &out, const NamespaceList &namespaces)
+{
+    out << qint32(namespaces.size());
+    for (const HashString &ns : namespaces)
+        out << ns.value();
+    return out;
+}
+
+static QDataStream &operator>>(QDataStream &in, NamespaceList &namespaces)
+{
+    qint32 size;
+    in >> size;
+    namespaces.clear();
+    for (qint32 i = 0; i < size && in.status() == QDataStream::Ok; ++i) {
+        QString ns;
+        in >> ns;
+        namespaces << HashString(ns);
+    }
+    return in;
+}
+
+void CppResultsCache::setDirectory(const QString &directory, const ConversionData &cd)
+{
+    cacheDirectory = directory;
+    if (directory.isEmpty() || !QDir().mkpath(directory)) {
+        cacheDirectory.clear();
+        return;
+    }
+
+    // Everything besides the file itself that determines the results of parsing it.
+    QByteArray config;
+    QDataStream out(&config, QIODevice::WriteOnly);
+    out << CacheVersion << cd.m_sourceIsUtf16 << cd.m_includePath;
+    QStringList projectRoots(cd.m_projectRoots.cbegin(), cd.m_projectRoots.cend());
+    projectRoots.sort();
+    out << projectRoots;
+    for (const QRegularExpression &rx : cd.m_excludes)
+        out << rx.pattern();
+    QStringList cSources;
+    for (auto it = cd.m_allCSources.cbegin(), end = cd.m_allCSources.cend(); it != end; ++it)
+        cSources << it.key() + u'=' + it.value();
+    cSources.sort();
+    out << cSources;
+    out << trFunctionAliasManager.availableFunctionsWithAliases();
+    cacheConfigHash = QCryptographicHash::hash(config, QCryptographicHash::Sha1);
+}
+
+bool CppResultsCache::isEnabled()
+{
+    return !cacheDirectory.isEmpty();
+}
+
+QByteArray CppResultsCache::key(const QString &cleanFile, const CppParserState &parserState)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out << cleanFile << parserState.namespaces
+        << static_cast<const QList<qsizetype> &>(parserState.namespaceDepths)
+        << parserState.functionContext << parserState.functionContextUnresolved
+        << parserState.pendingContext;
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(cacheConfigHash);
+    hash.addData(data);
+    return hash.result().toHex();
+}
+
+static QString cacheFilePath(const QByteArray &key)
+{
+    return cacheDirectory + u'/' + QString::fromLatin1(key);
+}
+
+static QByteArray fileContentHash(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    return hash.result();
+}
+
+static QStringList namespacePath(const Namespace *ns)
+{
+    QStringList path;
+    for (; ns->parent; ns = ns->parent) {
+        for (auto it = ns->parent->children.cbegin(), end = ns->parent->children.cend();
+             it != end; ++it) {
+            if (it.value() == ns) {
+                path.prepend(it.key().value());
+                break;
+            }
+        }
+    }
+    return path;
+}
+
+static const ParseResults *owningResults(const Namespace *ns, const ParseResults *results)
+{
+    while (ns->parent)
+        ns = ns->parent;
+    QSet<const ParseResults *> visited;
+    QList<const ParseResults *> pending{ results };
+    while (!pending.isEmpty()) {
+        const ParseResults *pr = pending.takeLast();
+        if (&pr->rootNamespace == ns)
+            return pr;
+        for (const ParseResults *inc : pr->includes) {
+            if (!visited.contains(inc)) {
+                visited.insert(inc);
+                pending << inc;
+            }
+        }
+    }
+    return nullptr;
+}
+
+// Collects the keys of the results owning the class definitions referenced
+// from other results. Returns false if one of them is not in the cache.
+static bool collectReferences(const Namespace *ns, const ParseResults *results,
+                              QList<const ParseResults *> *references)
+{
+    if (ns->classDef != ns) {
+        const ParseResults *owner = owningResults(ns->classDef, results);
+        if (!owner || (owner != results && owner->cacheKey.isEmpty()))
+            return false;
+        if (owner != results && !references->contains(owner))
+            references->append(owner);
+    }
+    for (const Namespace *child : ns->children) {
+        if (!collectReferences(child, results, references))
+            return false;
+    }
+    return true;
+}
+
+static void writeNamespace(QDataStream &out, const Namespace *ns, const ParseResults *results,
+                           const QList<const ParseResults *> &references)
+{
+    out << ns->hasTrFunctions;
+    if (ns->classDef == ns) {
+        out << qint32(-1);
+    } else {
+        const ParseResults *owner = owningResults(ns->classDef, results);
+        out << qint32(owner == results ? 0 : references.indexOf(owner) + 1)
+            << namespacePath(ns->classDef);
+    }
+    out << qint32(ns->aliases.size());
+    for (auto it = ns->aliases.cbegin(), end = ns->aliases.cend(); it != end; ++it)
+        out << it.key().value() << it.value();
+    out << qint32(ns->usings.size());
+    for (const HashStringList &use : ns->usings)
+        out << use.value();
+    out << qint32(ns->children.size());
+    for (auto it = ns->children.cbegin(), end = ns->children.cend(); it != end; ++it) {
+        out << it.key().value();
+        writeNamespace(out, it.value(), results, references);
+    }
+}
+
+struct ClassDefFixup {
+    Namespace *ns;
+    qint32 owner;
+    QStringList path;
+};
+
+static bool readNamespace(QDataStream &in, Namespace *ns, QList<ClassDefFixup> *fixups)
+{
+    qint32 owner;
+    in >> ns->hasTrFunctions >> owner;
+    if (owner >= 0) {
+        ClassDefFixup fixup{ ns, owner, {} };
+        in >> fixup.path;
+        fixups->append(fixup);
+    }
+    qint32 count;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString name;
+        NamespaceList target;
+        in >> name >> target;
+        ns->aliases.insert(HashString(name), target);
+    }
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        NamespaceList use;
+        in >> use;
+        ns->usings << HashStringList(use);
+    }
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString name;
+        in >> name;
+        Namespace *child = new Namespace;
+        child->parent = ns;
+        ns->children.insert(HashString(name), child);
+        if (!readNamespace(in, child, fixups))
+            return false;
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+static void writeTranslator(QDataStream &out, const Translator *tor)
+{
+    out << bool(tor);
+    if (!tor)
+        return;
+    out << tor->extras() << qint32(tor->messageCount());
+    for (const TranslatorMessage &msg : tor->messages()) {
+        out << msg.context() << msg.sourceText() << msg.comment() << msg.extraComment()
+            << msg.id() << msg.fileName() << qint32(msg.lineNumber()) << qint32(msg.type())
+            << msg.isPlural() << msg.extras();
+    }
+}
+
+static Translator *readTranslator(QDataStream &in)
+{
+    bool hasTranslator;
+    in >> hasTranslator;
+    if (!hasTranslator)
+        return nullptr;
+    auto tor = std::make_unique<Translator>();
+    Translator::ExtraData extras;
+    qint32 count;
+    in >> extras >> count;
+    tor->setExtras(extras);
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString context, sourceText, comment, extraComment, id, fileName;
+        qint32 lineNumber, type;
+        bool plural;
+        TranslatorMessage::ExtraData msgExtras;
+        in >> context >> sourceText >> comment >> extraComment >> id >> fileName >> lineNumber
+            >> type >> plural >> msgExtras;
+        TranslatorMessage msg(context, sourceText, comment, QString(), fileName, lineNumber,
+                              QStringList(), TranslatorMessage::Type(type), plural);
+        msg.setExtraComment(extraComment);
+        msg.setId(id);
+        msg.setExtras(msgExtras);
+        tor->append(msg);
+    }
+    return in.status() == QDataStream::Ok ? tor.release() : nullptr;
+}
+
+const ParseResults *CppResultsCache::load(const QByteArray &key)
+{
+    if (const ParseResults *pr = CppFiles::getCachedResults(key))
+        return pr;
+
+    QFile file(cacheFilePath(key));
+    if (!file.open(QIODevice::ReadOnly))
+        return nullptr;
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic, version;
+    in >> magic >> version;
+    if (magic != CacheMagic || version != CacheVersion)
+        return nullptr;
+
+    QString cleanFile;
+    QByteArray contentHash, forwardKey;
+    in >> cleanFile >> contentHash >> forwardKey;
+    if (in.status() != QDataStream::Ok || contentHash != fileContentHash(cleanFile))
+        return nullptr;
+
+    if (!forwardKey.isEmpty()) {
+        const ParseResults *pr = load(forwardKey);
+        if (pr)
+            CppFiles::setCachedResults(key, pr);
+        return pr;
+    }
+
+    QList<QByteArray> includeKeys, referenceKeys;
+    in >> includeKeys >> referenceKeys;
+    auto results = std::make_unique<ParseResults>();
+    for (const QByteArray &includeKey : std::as_const(includeKeys)) {
+        const ParseResults *inc = load(includeKey);
+        if (!inc)
+            return nullptr;
+        results->includes.insert(inc);
+    }
+    QList<const ParseResults *> references;
+    for (const QByteArray &referenceKey : std::as_const(referenceKeys)) {
+        const ParseResults *ref = load(referenceKey);
+        if (!ref)
+            return nullptr;
+        references << ref;
+    }
+
+    QList<ClassDefFixup> fixups;
+    if (!readNamespace(in, &results->rootNamespace, &fixups))
+        return nullptr;
+    for (const ClassDefFixup &fixup : std::as_const(fixups)) {
+        if (fixup.owner > references.size())
+            return nullptr;
+        const ParseResults *owner = fixup.owner ? references.at(fixup.owner - 1) : results.get();
+        Namespace *ns = const_cast<Namespace *>(&owner->rootNamespace);
+        for (const QString &name : fixup.path) {
+            if (!(ns = ns->children.value(HashString(name))))
+                return nullptr;
+        }
+        fixup.ns->classDef = ns;
+    }
+    std::unique_ptr<Translator> tor(readTranslator(in));
+    if (in.status() != QDataStream::Ok)
+        return nullptr;
+
+    results->fileId = nextFileId.fetch_add(1, std::memory_order_release);
+    results->cacheKey = key;
+    if (tor)
+        CppFiles::setTranslator(cleanFile, tor.release());
+    const ParseResults *pr = results.release();
+    CppFiles::setCachedResults(key, pr);
+    return pr;
+}
+
+bool CppResultsCache::canStore(const ParseResults *results)
+{
+    if (!results->cacheable)
+        return false;
+    for (const ParseResults *inc : results->includes) {
+        if (inc->cacheKey.isEmpty())
+            return false;
+    }
+    QList<const ParseResults *> references;
+    return collectReferences(&results->rootNamespace, results, &references);
+}
+
+void CppResultsCache::store(const QByteArray &key, const QString &cleanFile,
+                            const ParseResults *results, const Translator *tor)
+{
+    QByteArray forwardKey;
+    QList<QByteArray> includeKeys, referenceKeys;
+    QList<const ParseResults *> references;
+    if (results->cacheKey != key) {
+        // A forwarding header. Refer to the header it forwards to.
+        if (results->cacheKey.isEmpty())
+            return;
+        forwardKey = results->cacheKey;
+    } else {
+        for (const ParseResults *inc : results->includes)
+            includeKeys << inc->cacheKey;
+        collectReferences(&results->rootNamespace, results, &references);
+        for (const ParseResults *ref : std::as_const(references))
+            referenceKeys << ref->cacheKey;
+    }
+
+    QSaveFile file(cacheFilePath(key));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << CacheMagic << CacheVersion << cleanFile << fileContentHash(cleanFile) << forwardKey;
+    if (forwardKey.isEmpty()) {
+        out << includeKeys << referenceKeys;
+        writeNamespace(out, &results->rootNamespace, results, references);
+        writeTranslator(out, tor);
+    }
+    file.commit();
+}
+
 static bool isHeader(const QString &name)
 {
     QString fileExt = QFileInfo(name).suffix();
@@ -1331,6 +1957,7 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
     if (index != -1) {
         CppFiles::addIncludeCycle(QSet<QString>(includeStack.cbegin() + index, includeStack.cend()),
                                   *this);
+        results->cacheable = false;
         return;
     }
 
@@ -1339,13 +1966,36 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
     // it. Otherwise it is safe to process it stand-alone and re-use the parsed
     // namespace data for inclusion into other files.
     bool isIndirect = false;
+    QByteArray cacheKey;
+    const ResultsCacheKey resultsKey(cleanFile, *this);
     if (!CppFiles::isBlacklisted(cleanFile)
         && isHeader(cleanFile)) {
 
-        QSet<const ParseResults *> res = CppFiles::getResults(ResultsCacheKey(cleanFile, *this));
-        if (!res.isEmpty()) {
+        // Only one thread parses a header; the others wait for its results.
+        QSet<const ParseResults *> res;
+        switch (CppFiles::claimResults(resultsKey, &res)) {
+        case CppFiles::ResultsAvailable:
             results->includes.unite(res);
+            if (messageLog)
+                messageLog->addInclude(resultsKey);
             return;
+        case CppFiles::ResultsCyclic:
+            results->cacheable = false;
+            return;
+        case CppFiles::ResultsClaimed:
+            break;
+        }
+
+        if (CppResultsCache::isEnabled()) {
+            cacheKey = CppResultsCache::key(cleanFile, *this);
+            if (const ParseResults *pr = CppResultsCache::load(cacheKey)) {
+                CppFiles::setResults(resultsKey, pr);
+                CppFiles::releaseResults(resultsKey);
+                results->includes.insert(pr);
+                prospectiveContext.clear();
+                pendingContext.clear();
+                return;
+            }
         }
 
         isIndirect = true;
@@ -1355,6 +2005,8 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
     if (!f.open(QIODevice::ReadOnly)) {
         yyMsg() << qPrintable(
             QStringLiteral("Cannot open %1: %2\n").arg(cleanFile, f.errorString()));
+        if (isIndirect)
+            CppFiles::releaseResults(resultsKey);
         return;
     }
 
@@ -1370,13 +2022,28 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
                 parser.setTranslator(new Translator);
                 break;
             }
+        std::shared_ptr<CppMessageLog> log;
+        if (messageLog) {
+            log = std::make_shared<CppMessageLog>();
+            parser.setMessageLog(log.get());
+        }
         parser.setInput(ts, cleanFile);
         QStringList stack = includeStack;
         stack << cleanFile;
         parser.parse(cd, stack, inclusions);
-        results->includes.insert(parser.recordResults(true));
+        parser.setCacheKey(cacheKey);
+        const ParseResults *pr = parser.recordResults(true);
+        results->includes.insert(pr);
+        if (!cacheKey.isEmpty())
+            CppResultsCache::store(cacheKey, cleanFile, pr, parser.translator());
+        if (log) {
+            setHeaderMessageLog(resultsKey, std::move(log));
+            messageLog->addInclude(resultsKey);
+        }
+        CppFiles::releaseResults(resultsKey);
     } else {
         CppParser parser(results);
+        parser.setMessageLog(messageLog);
         parser.namespaces = namespaces;
         parser.functionContext = functionContext;
         parser.functionContextUnresolved = functionContextUnresolved;
@@ -1387,6 +2054,7 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
         parser.parseInternal(cd, stack, inclusions);
         // Avoid that messages obtained by direct scanning are used
         CppFiles::setBlacklisted(cleanFile);
+        results->cacheable = false;
     }
     inclusions.remove(cleanFile);
 
@@ -1566,15 +2234,12 @@ void CppParser::handleTr(QString &prefix, bool plural)
                     if (idx == 1) {
                         context = stringifyNamespace(functionContext);
                         fctx = findNamespace(functionContext)->classDef;
-                        if (!fctx->complained) {
-                            yyMsg() << qPrintable(
-                                QStringLiteral("Class '%1' lacks Q_OBJECT macro\n").arg(context));
-                            fctx->complained = true;
-                        }
+                        complainLacksQObject(fctx, context);
                         goto gotctx;
                     }
                     --idx;
                 }
+                QMutexLocker locker(&namespaceAnnotationMutex);
                 if (fctx->trQualification.isEmpty()) {
                     context.clear();
                     for (int i = 1;;) {
@@ -1596,17 +2261,15 @@ void CppParser::handleTr(QString &prefix, bool plural)
             NamespaceList unresolved;
             if (fullyQualify(functionContext, prefix, false, &nsl, &unresolved)) {
                 Namespace *fctx = findNamespace(nsl)->classDef;
+                QMutexLocker locker(&namespaceAnnotationMutex);
                 if (fctx->trQualification.isEmpty()) {
                     context = stringifyNamespace(nsl);
                     fctx->trQualification = context;
                 } else {
                     context = fctx->trQualification;
                 }
-                if (!fctx->hasTrFunctions && !fctx->complained) {
-                    yyMsg() << qPrintable(QStringLiteral("Class '%1' lacks Q_OBJECT macro\n")
-                                          .arg(context));
-                    fctx->complained = true;
-                }
+                if (!fctx->hasTrFunctions)
+                    complainLacksQObject(fctx, context);
             } else {
                 context = joinNamespaces(stringifyNamespace(nsl), stringifyNamespace(0, unresolved));
             }
@@ -2327,6 +2990,19 @@ void CppParser::processComment()
     }
 }
 
+// Lets the namespaces of a header inherit the usings that their parents got
+// after them, as reopening them in an including file would.
+static void inheritLateUsings(Namespace *ns)
+{
+    for (Namespace *child : std::as_const(ns->children)) {
+        for (const HashStringList &use : std::as_const(ns->usings)) {
+            if (!child->usings.contains(use))
+                child->usings << use;
+        }
+        inheritLateUsings(child);
+    }
+}
+
 const ParseResults *CppParser::recordResults(bool isHeader)
 {
     if (tor) {
@@ -2347,42 +3023,145 @@ const ParseResults *CppParser::recordResults(bool isHeader)
             pr = *results->includes.cbegin();
             delete results;
         } else {
-            results->fileId = nextFileId++;
+            inheritLateUsings(&results->rootNamespace);
+            results->fileId = nextFileId.fetch_add(1, std::memory_order_release);
             pr = results;
         }
         CppFiles::setResults(ResultsCacheKey(yyFileName, *this), pr);
         return pr;
     } else {
-        delete results;
+        if (messageLog && messageLog->hasComplaints())
+            messageLog->keepAlive(results);
+        else
+            delete results;
         return 0;
     }
 }
 
+void CppParser::setCacheKey(const QByteArray &key)
+{
+    // Must happen before the results are published by recordResults().
+    if (!key.isEmpty() && CppResultsCache::canStore(results))
+        results->cacheKey = key;
+}
+
+// Parses a top-level file. In a parser thread, the diagnostics go to \a log.
+static bool parseCppFile(const QString &filename, QStringConverter::Encoding e,
+                         ConversionData &cd, QString *errorString, CppMessageLog *log = nullptr)
+{
+    if (CppFiles::isBlacklisted(filename))
+        return true;
+
+    const bool header = isHeader(filename);
+    const ResultsCacheKey resultsKey(filename);
+    if (header) {
+        QSet<const ParseResults *> res;
+        if (CppFiles::claimResults(resultsKey, &res) != CppFiles::ResultsClaimed) {
+            if (log)
+                log->addInclude(resultsKey);
+            return true;
+        }
+    } else if (!CppFiles::getResults(resultsKey).isEmpty()) {
+        return true;
+    }
+
+    QByteArray cacheKey;
+    if (header && CppResultsCache::isEnabled()) {
+        cacheKey = CppResultsCache::key(filename, CppParserState());
+        if (const ParseResults *pr = CppResultsCache::load(cacheKey)) {
+            CppFiles::setResults(resultsKey, pr);
+            CppFiles::releaseResults(resultsKey);
+            return true;
+        }
+    }
+
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *errorString = QStringLiteral("Cannot open %1: %2").arg(filename, file.errorString());
+        if (header)
+            CppFiles::releaseResults(resultsKey);
+        return false;
+    }
+
+    std::shared_ptr<CppMessageLog> headerLog;
+    CppParser parser;
+    if (log && header) {
+        // Printed where the header is first included, or here if it is not.
+        headerLog = std::make_shared<CppMessageLog>();
+        parser.setMessageLog(headerLog.get());
+    } else {
+        parser.setMessageLog(log);
+    }
+    QTextStream ts(&file);
+    ts.setEncoding(e);
+    ts.setAutoDetectUnicode(true);
+    parser.setInput(ts, filename);
+    Translator *tor = new Translator;
+    parser.setTranslator(tor);
+    QSet<QString> inclusions;
+    parser.parse(cd, QStringList(), inclusions);
+    parser.setCacheKey(cacheKey);
+    const ParseResults *pr = parser.recordResults(header);
+    if (!cacheKey.isEmpty())
+        CppResultsCache::store(cacheKey, filename, pr, parser.translator());
+    if (headerLog) {
+        setHeaderMessageLog(resultsKey, std::move(headerLog));
+        log->addInclude(resultsKey);
+    }
+    if (header)
+        CppFiles::releaseResults(resultsKey);
+    return true;
+}
+
 void loadCPP(Translator &translator, const QStringList &filenames, ConversionData &cd)
 {
     QStringConverter::Encoding e = cd.m_sourceIsUtf16 ? QStringConverter::Utf16 : QStringConverter::Utf8;
+    CppResultsCache::setDirectory(cd.m_cacheDir, cd);
 
-    for (const QString &filename : filenames) {
-        if (!CppFiles::getResults(ResultsCacheKey(filename)).isEmpty() || CppFiles::isBlacklisted(filename))
-            continue;
+    size_t threadCount = cd.m_jobCount > 0 ? size_t(cd.m_jobCount)
+                                           : size_t(std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, size_t(filenames.size()));
 
-        QFile file(filename);
-        if (!file.open(QIODevice::ReadOnly)) {
-            cd.appendError(QStringLiteral("Cannot open %1: %2").arg(filename,
-                                                                    file.errorString()));
-            continue;
+    if (threadCount <= 1) {
+        for (const QString &filename : filenames) {
+            QString errorString;
+            if (!parseCppFile(filename, e, cd, &errorString))
+                cd.appendError(errorString);
+        }
+    } else {
+        // The alias lookup hash is built lazily; build it before the threads share it.
+        trFunctionAliasManager.nameToTrFunctionMap();
+
+        // The top-level files are handed out to the threads one by one. Headers are parsed
+        // by whichever thread includes them first and are shared through CppFiles.
+        // Errors and diagnostics are collected per file so that they are reported in
+        // input order, the way a serial run reports them.
+        std::vector<qsizetype> indexes(filenames.size());
+        std::iota(indexes.begin(), indexes.end(), 0);
+        std::vector<QString> errors(filenames.size());
+        std::vector<CppMessageLog> logs(filenames.size());
+        ReadSynchronizedRef<qsizetype> sources(indexes);
+        std::vector<std::thread> parsers;
+        parsers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            parsers.emplace_back([&sources, &filenames, &errors, &logs, &cd, e]() {
+                qsizetype index;
+                while (sources.next(&index))
+                    parseCppFile(filenames.at(index), e, cd, &errors[index], &logs[index]);
+            });
         }
+        for (std::thread &parser : parsers)
+            parser.join();
 
-        CppParser parser;
-        QTextStream ts(&file);
-        ts.setEncoding(e);
-        ts.setAutoDetectUnicode(true);
-        parser.setInput(ts, filename);
-        Translator *tor = new Translator;
-        parser.setTranslator(tor);
-        QSet<QString> inclusions;
-        parser.parse(cd, QStringList(), inclusions);
-        parser.recordResults(isHeader(filename));
+        QSet<ResultsCacheKey> printedIncludes;
+        for (CppMessageLog &log : logs)
+            log.print(&printedIncludes);
+        headerMessageLogs.clear();
+
+        for (const QString &error : errors) {
+            if (!error.isEmpty())
+                cd.appendError(error);
+        }
     }
 
     for (const QString &filename : filenames) {
@@ -2393,6 +3172,7 @@ void loadCPP(Translator &translator, const QStringList &filenames, ConversionDat
             }
         }
     }
+    CppFiles::deleteReplacedTranslators();
 }
 
 QT_END_NAMESPACE
@@ -75,6 +75,8 @@ struct ParseResults {
     int fileId;
     Namespace rootNamespace;
     QSet<const ParseResults *> includes;
+    QByteArray cacheKey; // Key in the persistent results cache, empty if not stored there
+    bool cacheable = true; // Cleared if parsing had side effects the cache cannot replay
 };
 
 struct IncludeCycle {
@@ -129,21 +131,52 @@ size_t qHash(const ResultsCacheKey &key, size_t seed);
 
 typedef QHash<ResultsCacheKey, IncludeCycle *> IncludeCycleHash;
 typedef QHash<QString, const Translator *> TranslatorHash;
+typedef QHash<QByteArray, const ParseResults *> CachedResultsHash;
 
 class CppFiles {
 public:
+    enum ResultsClaim {
+        ResultsAvailable, // Results are set, use them
+        ResultsClaimed, // Parse the file and set the results, then release the claim
+        ResultsCyclic // Waiting for the results would deadlock, skip the file
+    };
+
     static QSet<const ParseResults *> getResults(const ResultsCacheKey &key);
     static void setResults(const ResultsCacheKey &key, const ParseResults *results);
+    static ResultsClaim claimResults(const ResultsCacheKey &key,
+                                     QSet<const ParseResults *> *results);
+    static void releaseResults(const ResultsCacheKey &key);
     static const Translator *getTranslator(const QString &cleanFile);
     static void setTranslator(const QString &cleanFile, const Translator *results);
+    static void deleteReplacedTranslators();
     static bool isBlacklisted(const QString &cleanFile);
     static void setBlacklisted(const QString &cleanFile);
     static void addIncludeCycle(const QSet<QString> &fileNames, const CppParserState &parserState);
+    static const ParseResults *getCachedResults(const QByteArray &cacheKey);
+    static void setCachedResults(const QByteArray &cacheKey, const ParseResults *results);
 
 private:
     static IncludeCycleHash &includeCycles();
     static TranslatorHash &translatedFiles();
+    static QList<const Translator *> &replacedTranslators();
     static QSet<QString> &blacklistedFiles();
+    static CachedResultsHash &cachedResults();
+};
+
+// Persistent on-disk cache of the results of parsing headers stand-alone.
+// Entries are keyed by the header's file name, the parser state at the point
+// of inclusion and the configuration that influences parsing. The header's
+// content hash is stored in the entry and checked when loading it. Included
+// headers are stored as separate entries and referenced by their keys.
+class CppResultsCache {
+public:
+    static void setDirectory(const QString &directory, const ConversionData &cd);
+    static bool isEnabled();
+    static QByteArray key(const QString &cleanFile, const CppParserState &parserState);
+    static const ParseResults *load(const QByteArray &key);
+    static bool canStore(const ParseResults *results);
+    static void store(const QByteArray &key, const QString &cleanFile, const ParseResults *results,
+                      const Translator *tor);
 };
 
 QT_END_NAMESPACE
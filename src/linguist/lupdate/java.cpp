@@ -46,39 +46,62 @@ class Scope
         {}
 };
 
-/*
-  The tokenizer maintains the following global variables. The names
-  should be self-explanatory.
-*/
-
-static QString yyFileName;
-static QChar yyCh;
-static QString yyIdent;
-static QString yyComment;
-static QString yyString;
-static bool yyEOF = false;
-
-static qlonglong yyInteger;
-static int yyParenDepth;
-static int yyLineNo;
-static int yyCurLineNo;
-static int yyParenLineNo;
-static int yyTok;
-
-// the string to read from and current position in the string
-static QString yyInStr;
-static int yyInPos;
-
-// The parser maintains the following global variables.
-static QString yyPackage;
-static QStack<Scope*> yyScope;
-
-std::ostream &yyMsg(int line = 0)
+class JavaParser
+{
+public:
+    JavaParser(SourceMessages &messages, const QString &fileName, const QString &in);
+    void parse();
+
+private:
+    std::ostream &yyMsg(int line = 0);
+    QChar getChar();
+    int getToken();
+    bool match(int t);
+    bool matchString(QString &s);
+    bool matchStringOrNull(QString &s);
+    bool matchExpression();
+    QString context() const;
+    void recordMessage(const QString &context, const QString &text, const QString &comment,
+                       const QString &extracomment, bool plural);
+
+    SourceMessages &m_messages;
+
+    // The tokenizer state. The names should be self-explanatory.
+    QString yyFileName;
+    QChar yyCh;
+    QString yyIdent;
+    QString yyComment;
+    QString yyString;
+    bool yyEOF = false;
+
+    qlonglong yyInteger = 0;
+    int yyParenDepth = 0;
+    int yyLineNo = 0;
+    int yyCurLineNo = 1;
+    int yyParenLineNo = 1;
+    int yyTok = -1;
+
+    // the string to read from and current position in the string
+    QString yyInStr;
+    int yyInPos = 0;
+
+    // The parser state.
+    QString yyPackage;
+    QStack<Scope> yyScope;
+};
+
+JavaParser::JavaParser(SourceMessages &messages, const QString &fileName, const QString &in)
+    : m_messages(messages), yyFileName(fileName), yyInStr(in)
 {
-    return std::cerr << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
 }
 
-static QChar getChar()
+std::ostream &JavaParser::yyMsg(int line)
+{
+    return m_messages.diagnostics() << qPrintable(yyFileName) << ':'
+                                    << (line ? line : yyLineNo) << ": ";
+}
+
+QChar JavaParser::getChar()
 {
     if (yyInPos >= yyInStr.size()) {
         yyEOF = true;
@@ -90,7 +113,7 @@ static QChar getChar()
     return c;
 }
 
-static int getToken()
+int JavaParser::getToken()
 {
     const char tab[] = "bfnrt\"\'\\";
     const char backTab[] = "\b\f\n\r\t\"\'\\";
@@ -312,7 +335,7 @@ static int getToken()
     return Tok_Eof;
 }
 
-static bool match( int t )
+bool JavaParser::match( int t )
 {
     bool matches = ( yyTok == t );
     if ( matches )
@@ -320,7 +343,7 @@ static bool match( int t )
     return matches;
 }
 
-static bool matchString( QString &s )
+bool JavaParser::matchString( QString &s )
 {
     if ( yyTok != Tok_String )
         return false;
@@ -342,7 +365,7 @@ static bool matchString( QString &s )
     return true;
 }
 
-static bool matchStringOrNull(QString &s)
+bool JavaParser::matchStringOrNull(QString &s)
 {
     bool matches = matchString(s);
     if (!matches) {
@@ -367,7 +390,7 @@ static bool matchStringOrNull(QString &s)
  * list(a,b).size(2,4)
  * etc...
  */
-static bool matchExpression()
+bool JavaParser::matchExpression()
 {
     if (match(Tok_Integer)) {
         return true;
@@ -395,37 +418,37 @@ static bool matchExpression()
     return true;
 }
 
-static const QString context()
+QString JavaParser::context() const
 {
       QString context(yyPackage);
       bool innerClass = false;
       for (int i = 0; i < yyScope.size(); ++i) {
-         if (yyScope.at(i)->type == Scope::Clazz) {
+         if (yyScope.at(i).type == Scope::Clazz) {
              if (innerClass)
                  context.append("$"_L1);
              else
                  context.append("."_L1);
 
-             context.append(yyScope.at(i)->name);
+             context.append(yyScope.at(i).name);
              innerClass = true;
          }
      }
      return context;
 }
 
-static void recordMessage(
-    Translator *tor, const QString &context, const QString &text, const QString &comment,
-    const QString &extracomment, bool plural, ConversionData &cd)
+void JavaParser::recordMessage(
+    const QString &context, const QString &text, const QString &comment,
+    const QString &extracomment, bool plural)
 {
     TranslatorMessage msg(
         context, text, comment, QString(),
         yyFileName, yyLineNo, QStringList(),
         TranslatorMessage::Unfinished, plural);
     msg.setExtraComment(extracomment.simplified());
-    tor->extend(msg, cd);
+    m_messages.append(msg);
 }
 
-static void parse(Translator *tor, ConversionData &cd)
+void JavaParser::parse()
 {
     QString text;
     QString com;
@@ -440,7 +463,7 @@ static void parse(Translator *tor, ConversionData &cd)
         case Tok_class:
             yyTok = getToken();
             if(yyTok == Tok_Ident) {
-                yyScope.push(new Scope(yyIdent, Scope::Clazz, yyLineNo));
+                yyScope.push(Scope(yyIdent, Scope::Clazz, yyLineNo));
             }
             else {
                 yyMsg() << "'class' must be followed by a class name.\n";
@@ -466,7 +489,7 @@ static void parse(Translator *tor, ConversionData &cd)
                         plural = true;
                     }
                 }
-                recordMessage(tor, context(), text, com, extracomment, plural, cd);
+                recordMessage(context(), text, com, extracomment, plural);
             }
             break;
         case Tok_translate:
@@ -494,7 +517,7 @@ static void parse(Translator *tor, ConversionData &cd)
                             break;
                         }
                     }
-                    recordMessage(tor, contextOverride, text, com, extracomment, plural, cd);
+                    recordMessage(contextOverride, text, com, extracomment, plural);
                 }
             }
             break;
@@ -516,13 +539,13 @@ static void parse(Translator *tor, ConversionData &cd)
                 yyMsg() << "Excess closing brace.\n";
             }
             else
-                delete (yyScope.pop());
+                yyScope.pop();
             extracomment.clear();
             yyTok = getToken();
             break;
 
          case Tok_LeftBrace:
-            yyScope.push(new Scope(QString(), Scope::Other, yyLineNo));
+            yyScope.push(Scope(QString(), Scope::Other, yyLineNo));
             yyTok = getToken();
             break;
 
@@ -555,39 +578,26 @@ static void parse(Translator *tor, ConversionData &cd)
     }
 
     if ( !yyScope.isEmpty() )
-        yyMsg(yyScope.top()->line) << "Unbalanced opening brace.\n";
+        yyMsg(yyScope.top().line) << "Unbalanced opening brace.\n";
     else if ( yyParenDepth != 0 )
         yyMsg(yyParenLineNo) << "Unbalanced opening parenthesis.\n";
 }
 
 
-bool loadJava(Translator &translator, const QString &filename, ConversionData &cd)
+bool loadJava(SourceMessages &messages, const QString &filename, const ConversionData &cd)
 {
     QFile file(filename);
     if (!file.open(QIODevice::ReadOnly)) {
-        cd.appendError(QStringLiteral("Cannot open %1: %2").arg(filename, file.errorString()));
+        messages.setError(QStringLiteral("Cannot open %1: %2").arg(filename, file.errorString()));
         return false;
     }
 
-    yyInPos = -1;
-    yyFileName = filename;
-    yyPackage.clear();
-    yyScope.clear();
-    yyTok = -1;
-    yyParenDepth = 0;
-    yyCurLineNo = 0;
-    yyParenLineNo = 1;
-
     QTextStream ts(&file);
     ts.setEncoding(cd.m_sourceIsUtf16 ? QStringConverter::Utf16 : QStringConverter::Utf8);
     ts.setAutoDetectUnicode(true);
-    yyInStr = ts.readAll();
-    yyInPos = 0;
-    yyFileName = filename;
-    yyCurLineNo = 1;
-    yyParenLineNo = 1;
 
-    parse(&translator, cd);
+    JavaParser parser(messages, filename, ts.readAll());
+    parser.parse();
     return true;
 }
 
@@ -14,11 +14,15 @@
 #include <QtCore/QStringList>
 #include <QtCore/QTranslator>
 
+#include <translatormessage.h>
+
+#include <memory>
+#include <sstream>
+
 QT_BEGIN_NAMESPACE
 
 class ConversionData;
 class Translator;
-class TranslatorMessage;
 
 enum UpdateOption {
     Verbose = 1,
@@ -44,14 +48,58 @@ Translator merge(
     UpdateOptions options, QString &err);
 
 void loadCPP(Translator &translator, const QStringList &filenames, ConversionData &cd);
-bool loadJava(Translator &translator, const QString &filename, ConversionData &cd);
-bool loadPython(Translator &translator, const QString &fileName, ConversionData &cd);
+
+/*
+  What parsing one source file yields: its messages in the order they were
+  found, the parser's diagnostics and the error that stopped it, if any.
+  Parsers that fill their own SourceMessages can run concurrently; record()
+  then adds the messages to a Translator as if they were parsed into it.
+*/
+class SourceMessages
+{
+public:
+    void append(const TranslatorMessage &msg) { m_messages.append(msg); }
+    std::ostream &diagnostics() { return m_diagnostics; }
+    void setError(const QString &error) { m_error = error; }
+
+    void record(Translator &translator, ConversionData &cd) const;
+
+private:
+    QList<TranslatorMessage> m_messages;
+    std::ostringstream m_diagnostics;
+    QString m_error;
+};
+
+bool loadJava(SourceMessages &messages, const QString &filename, const ConversionData &cd);
+bool loadPython(SourceMessages &messages, const QString &fileName, const ConversionData &cd);
 bool loadUI(Translator &translator, const QString &filename, ConversionData &cd);
 
 #ifndef QT_NO_QML
-bool loadQScript(Translator &translator, const QString &filename, ConversionData &cd);
-bool loadJSModule(Translator &translator, const QString &filename, ConversionData &cd);
-bool loadQml(Translator &translator, const QString &filename, ConversionData &cd);
+/*
+  Parses QML and JavaScript files one after the other. The engine and its
+  memory pool are kept from one file to the next, so that a thread parsing
+  many files allocates them only once. An extractor must only be used by
+  one thread at a time.
+*/
+class QmlExtractor
+{
+public:
+    QmlExtractor();
+    ~QmlExtractor();
+
+    bool loadQScript(SourceMessages &messages, const QString &filename);
+    bool loadJSModule(SourceMessages &messages, const QString &filename);
+    bool loadQml(SourceMessages &messages, const QString &filename);
+
+private:
+    Q_DISABLE_COPY(QmlExtractor)
+
+    enum CodeType { QMLCode, JSCode, MJSCode };
+    bool load(SourceMessages &messages, const QString &filename, CodeType mode);
+
+    struct Private;
+    std::unique_ptr<Private> d;
+};
 #endif
 
 #define LUPDATE_FOR_EACH_TR_FUNCTION(UNARY_MACRO) \
@@ -23,7 +23,14 @@
 #include <QtCore/QStringList>
 #include <QtCore/QTranslator>
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 using namespace Qt::StringLiterals;
 
@@ -31,6 +38,8 @@ bool useClangToParseCpp = false;
 QString commandLineCompilationDatabaseDir; // for the path to the json file passed as a command line argument.
                                     // Has priority over what is in the .pro file and passed to the project.
 QStringList rootDirs;
+int jobCount = 1; // number of parser and updater threads, 0 means one per core
+QString cacheDir; // directory of the persistent C++ parse results cache
 
 // Can't have an array of QStaticStringData<N> for different N, so
 // use QString, which requires constructor calls. Doesn't matter
@@ -205,10 +214,8 @@ static void printErr(const QString & out)
     std::cerr << qPrintable(out);
 }
 
-static void printWarning(UpdateOptions options,
-                         const QString &msg,
-                         const QString &warningMsg = {},
-                         const QString &errorMsg = {})
+static QString warningText(UpdateOptions options, const QString &msg,
+                           const QString &warningMsg, const QString &errorMsg)
 {
     QString text = msg;
     if (options & Werror) {
@@ -220,8 +227,15 @@ static void printWarning(UpdateOptions options,
         if (!warningMsg.isEmpty())
             text.append(" "_L1).append(warningMsg);
     }
+    return text;
+}
 
-    printErr(text);
+static void printWarning(UpdateOptions options,
+                         const QString &msg,
+                         const QString &warningMsg = {},
+                         const QString &errorMsg = {})
+{
+    printErr(warningText(options, msg, warningMsg, errorMsg));
 }
 
 static void recursiveFileInfoList(const QDir &dir,
@@ -311,6 +325,13 @@ static void printUsage()
             "           Specify the output file(s). This will override the TRANSLATIONS.\n"
             "    -version\n"
             "           Display the version of lupdate and exit.\n"
+            "    -j <n>\n"
+            "           Parse source files and update the TS files in <n> parallel\n"
+            "           threads. With 0, one thread per available core is used. The result\n"
+            "           is the same as with a single thread. Default: 1.\n"
+            "    -cache-dir <directory>\n"
+            "           Store the results of parsing C++ header files in <directory> and\n"
+            "           reuse them in later runs for headers that did not change.\n"
             "    -clang-parser [compilation-database-dir]\n"
             "           Use clang to parse cpp files. Otherwise a custom parser is used.\n"
             "           This option needs a clang compilation database (compile_commands.json)\n"
@@ -364,6 +385,204 @@ static bool handleTrFunctionAliases(const QString &arg)
     return true;
 }
 
+/*
+  Collects what updating a TS file prints, so that files updated in parallel
+  can report in input order. An unbuffered log prints right away.
+*/
+class UpdateLog
+{
+public:
+    explicit UpdateLog(bool buffered = false) : m_buffered(buffered) {}
+
+    void printOut(const QString &out) { append(false, out); }
+    void printErr(const QString &out) { append(true, out); }
+    void printWarning(UpdateOptions options, const QString &msg,
+                      const QString &warningMsg = {}, const QString &errorMsg = {});
+    void flush();
+
+private:
+    struct Chunk
+    {
+        bool isError;
+        QString text;
+    };
+
+    void append(bool isError, const QString &text);
+
+    bool m_buffered;
+    QList<Chunk> m_chunks;
+};
+
+void UpdateLog::append(bool isError, const QString &text)
+{
+    if (m_buffered)
+        m_chunks.append({ isError, text });
+    else if (isError)
+        ::printErr(text);
+    else
+        ::printOut(text);
+}
+
+void UpdateLog::printWarning(UpdateOptions options, const QString &msg,
+                             const QString &warningMsg, const QString &errorMsg)
+{
+    printErr(warningText(options, msg, warningMsg, errorMsg));
+}
+
+void UpdateLog::flush()
+{
+    for (const Chunk &chunk : std::as_const(m_chunks)) {
+        if (chunk.isError)
+            ::printErr(chunk.text);
+        else
+            ::printOut(chunk.text);
+    }
+    m_chunks.clear();
+}
+
+enum class TsFileStatus { Ready, Skipped, Failed, Aborted };
+
+/*
+  Loads an existing TS file, or sets up an empty one, and checks that it can
+  be updated. Aborted means that -Werror stops updating any further files.
+*/
+static TsFileStatus loadTsFile(Translator &tor, const QString &fileName,
+    const QString &sourceLanguage, const QString &targetLanguage,
+    UpdateOptions options, UpdateLog &log)
+{
+    ConversionData cd;
+    cd.m_sortContexts = !(options & NoSort);
+    cd.m_sortMessages = options & SortMessages;
+    if (QFile(fileName).exists()) {
+        if (!tor.load(fileName, cd, "auto"_L1)) {
+            log.printErr(cd.error());
+            return TsFileStatus::Failed;
+        }
+        tor.resolveDuplicates();
+        cd.clearErrors();
+        if (!targetLanguage.isEmpty() && targetLanguage != tor.languageCode()) {
+            log.printWarning(options,
+                             "Specified target language '%1' disagrees with"
+                                            " existing file's language '%2'.\n"_L1
+                                     .arg(targetLanguage, tor.languageCode()),
+                             u"Ignoring.\n"_s);
+            if (options & Werror)
+                return TsFileStatus::Aborted;
+        }
+        if (!sourceLanguage.isEmpty() && sourceLanguage != tor.sourceLanguageCode()) {
+            log.printWarning(options,
+                             "Specified source language '%1' disagrees with"
+                                     " existing file's language '%2'.\n"_L1
+                                     .arg(sourceLanguage, tor.sourceLanguageCode()),
+                             u"Ignoring.\n"_s);
+            if (options & Werror)
+                return TsFileStatus::Aborted;
+        }
+        // If there is translation in the file, the language should be recognized
+        // (when the language is not recognized, plural translations are lost)
+        if (tor.translationsExist()) {
+
+            if (tor.languageCode().isEmpty()) {
+                log.printErr("File %1 won't be updated: it does not specify any "
+                             "target languages. To set a target language, open "
+                             "the file in Qt Linguist.\n"_L1.arg(fileName));
+                return TsFileStatus::Skipped;
+            }
+            QLocale::Language l;
+            QLocale::Territory c;
+            tor.languageAndTerritory(tor.languageCode(), &l, &c);
+            QStringList forms;
+            if (!getNumerusInfo(l, c, 0, &forms, 0)) {
+                log.printErr(QStringLiteral("File %1 won't be updated: it contains translation but the"
+                " target language is not recognized\n").arg(fileName));
+                return TsFileStatus::Skipped;
+            }
+        }
+    } else {
+        if (!targetLanguage.isEmpty())
+            tor.setLanguageCode(targetLanguage);
+        else
+            tor.setLanguageCode(Translator::guessLanguageCodeFromFileName(fileName));
+        if (!sourceLanguage.isEmpty())
+            tor.setSourceLanguageCode(sourceLanguage);
+    }
+    return TsFileStatus::Ready;
+}
+
+/*
+  Merges the extracted messages into a loaded TS file and saves it.
+  Returns false if the file could not be written.
+*/
+static bool mergeTsFile(Translator &tor, const QString &fileName,
+    const Translator &fetchedTor, const QList<Translator> &aliens,
+    UpdateOptions options, UpdateLog &log)
+{
+    const QString fn = QDir().relativeFilePath(fileName);
+    ConversionData cd;
+    cd.m_sortContexts = !(options & NoSort);
+    cd.m_sortMessages = options & SortMessages;
+
+    tor.makeFileNamesAbsolute(QFileInfo(fileName).absoluteDir());
+    if (options & NoLocations)
+        tor.setLocationsType(Translator::NoLocations);
+    else if (options & RelativeLocations)
+        tor.setLocationsType(Translator::RelativeLocations);
+    else if (options & AbsoluteLocations)
+        tor.setLocationsType(Translator::AbsoluteLocations);
+    if (options & Verbose)
+        log.printOut(QStringLiteral("Updating '%1'...\n").arg(fn));
+
+    UpdateOptions theseOptions = options;
+    if (tor.locationsType() == Translator::NoLocations) // Could be set from file
+        theseOptions |= NoLocations;
+    QString err;
+    Translator out = merge(tor, fetchedTor, aliens, theseOptions, err);
+    tor = Translator();
+
+    if ((options & Verbose) && !err.isEmpty())
+        log.printOut(err);
+    if (options & PluralOnly) {
+        if (options & Verbose)
+            log.printOut(QStringLiteral("Stripping non plural forms in '%1'...\n").arg(fn));
+        out.stripNonPluralForms();
+    }
+    if (options & NoObsolete)
+        out.stripObsoleteMessages();
+    out.stripEmptyContexts();
+
+    out.normalizeTranslations(cd);
+    if (!cd.errors().isEmpty()) {
+        log.printErr(cd.error());
+        cd.clearErrors();
+    }
+    if (!out.save(fileName, cd, "auto"_L1)) {
+        log.printErr(cd.error());
+        return false;
+    }
+    return true;
+}
+
+// Calls job(worker, index) for every index below count, on threadCount threads.
+template <typename Job>
+static void runJobs(qsizetype count, size_t threadCount, Job job)
+{
+    std::atomic<qsizetype> nextIndex = 0;
+    std::vector<std::thread> workers;
+    workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        workers.emplace_back([&, i]() {
+            for (;;) {
+                const qsizetype index = nextIndex.fetch_add(1);
+                if (index >= count)
+                    break;
+                job(i, index);
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+}
+
 static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFileNames,
     const QStringList &alienFiles,
     const QString &sourceLanguage, const QString &targetLanguage,
@@ -390,105 +609,72 @@ static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFil
         tor.resolveDuplicates();
         aliens << tor;
     }
-    QDir dir;
-    QString err;
-    for (const QString &fileName : tsFileNames) {
-        QString fn = dir.relativeFilePath(fileName);
-        ConversionData cd;
-        Translator tor;
-        cd.m_sortContexts = !(options & NoSort);
-        cd.m_sortMessages = options & SortMessages;
-        if (QFile(fileName).exists()) {
-            if (!tor.load(fileName, cd, "auto"_L1)) {
-                printErr(cd.error());
+
+    size_t threadCount = jobCount > 0 ? size_t(jobCount)
+                                      : size_t(std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, size_t(tsFileNames.size()));
+
+    if (threadCount <= 1) {
+        UpdateLog log;
+        for (const QString &fileName : tsFileNames) {
+            Translator tor;
+            switch (loadTsFile(tor, fileName, sourceLanguage, targetLanguage, options, log)) {
+            case TsFileStatus::Aborted:
+                return;
+            case TsFileStatus::Failed:
                 *fail = true;
                 continue;
+            case TsFileStatus::Skipped:
+                continue;
+            case TsFileStatus::Ready:
+                break;
             }
-            tor.resolveDuplicates();
-            cd.clearErrors();
-            if (!targetLanguage.isEmpty() && targetLanguage != tor.languageCode()) {
-                printWarning(options,
-                             "Specified target language '%1' disagrees with"
-                                            " existing file's language '%2'.\n"_L1
-                                     .arg(targetLanguage, tor.languageCode()),
-                             u"Ignoring.\n"_s);
-                if (options & Werror)
-                    return;
-            }
-            if (!sourceLanguage.isEmpty() && sourceLanguage != tor.sourceLanguageCode()) {
-                printWarning(options,
-                             "Specified source language '%1' disagrees with"
-                                     " existing file's language '%2'.\n"_L1
-                                     .arg(sourceLanguage, tor.sourceLanguageCode()),
-                             u"Ignoring.\n"_s);
-                if (options & Werror)
-                    return;
-            }
-            // If there is translation in the file, the language should be recognized
-            // (when the language is not recognized, plural translations are lost)
-            if (tor.translationsExist()) {
-
-                if (tor.languageCode().isEmpty()) {
-                    printErr("File %1 won't be updated: it does not specify any "
-                             "target languages. To set a target language, open "
-                             "the file in Qt Linguist.\n"_L1.arg(fileName));
-                    continue;
-                }
-                QLocale::Language l;
-                QLocale::Territory c;
-                tor.languageAndTerritory(tor.languageCode(), &l, &c);
-                QStringList forms;
-                if (!getNumerusInfo(l, c, 0, &forms, 0)) {
-                    printErr(QStringLiteral("File %1 won't be updated: it contains translation but the"
-                    " target language is not recognized\n").arg(fileName));
-                    continue;
-                }
-            }
-        } else {
-            if (!targetLanguage.isEmpty())
-                tor.setLanguageCode(targetLanguage);
-            else
-                tor.setLanguageCode(Translator::guessLanguageCodeFromFileName(fileName));
-            if (!sourceLanguage.isEmpty())
-                tor.setSourceLanguageCode(sourceLanguage);
+            if (!mergeTsFile(tor, fileName, fetchedTor, aliens, options, log))
+                *fail = true;
         }
-        tor.makeFileNamesAbsolute(QFileInfo(fileName).absoluteDir());
-        if (options & NoLocations)
-            tor.setLocationsType(Translator::NoLocations);
-        else if (options & RelativeLocations)
-            tor.setLocationsType(Translator::RelativeLocations);
-        else if (options & AbsoluteLocations)
-            tor.setLocationsType(Translator::AbsoluteLocations);
-        if (options & Verbose)
-            printOut(QStringLiteral("Updating '%1'...\n").arg(fn));
-
-        UpdateOptions theseOptions = options;
-        if (tor.locationsType() == Translator::NoLocations) // Could be set from file
-            theseOptions |= NoLocations;
-        Translator out = merge(tor, fetchedTor, aliens, theseOptions, err);
+        return;
+    }
 
-        if ((options & Verbose) && !err.isEmpty()) {
-            printOut(err);
-            err.clear();
+    // The extracted messages and the alien files are only read from here on,
+    // so every TS file can be loaded, merged and saved by its own thread. With
+    // -Werror, the files following the first one that aborts must stay
+    // untouched, as in the serial loop, so a file is only saved once all files
+    // before it are checked. What a file reports is replayed in input order.
+    const qsizetype count = tsFileNames.size();
+    std::vector<UpdateLog> logs(count, UpdateLog(true));
+    std::vector<TsFileStatus> status(count);
+    std::vector<char> saved(count, true);
+    std::mutex checkedMutex;
+    std::condition_variable checkedCondition;
+    std::vector<char> checked(count, false);
+    qsizetype checkedCount = 0; // files checked before the first unchecked one
+    qsizetype aborted = count; // the first file that aborts
+    runJobs(count, threadCount, [&](size_t, qsizetype index) {
+        Translator tor;
+        status[index] = loadTsFile(tor, tsFileNames.at(index), sourceLanguage,
+                                   targetLanguage, options, logs[index]);
+        if (options & Werror) {
+            std::unique_lock<std::mutex> lock(checkedMutex);
+            checked[index] = true;
+            if (status[index] == TsFileStatus::Aborted)
+                aborted = std::min(aborted, index);
+            while (checkedCount < count && checked[checkedCount])
+                ++checkedCount;
+            checkedCondition.notify_all();
+            checkedCondition.wait(lock, [&] { return checkedCount >= index || aborted < index; });
+            if (aborted < index)
+                return;
         }
-        if (options & PluralOnly) {
-            if (options & Verbose)
-                printOut(QStringLiteral("Stripping non plural forms in '%1'...\n").arg(fn));
-            out.stripNonPluralForms();
+        if (status[index] == TsFileStatus::Ready) {
+            saved[index] = mergeTsFile(tor, tsFileNames.at(index), fetchedTor,
+                                       aliens, options, logs[index]);
         }
-        if (options & NoObsolete)
-            out.stripObsoleteMessages();
-        out.stripEmptyContexts();
+    });
 
-        out.normalizeTranslations(cd);
-        if (!cd.errors().isEmpty()) {
-            printErr(cd.error());
-            cd.clearErrors();
-        }
-        if (!out.save(fileName, cd, "auto"_L1)) {
-            printErr(cd.error());
+    for (qsizetype i = 0; i < count && i <= aborted; ++i) {
+        logs[i].flush();
+        if (i < aborted && (status[i] == TsFileStatus::Failed || !saved[i]))
             *fail = true;
-        }
     }
 }
 
@@ -589,36 +775,131 @@ static bool processTs(Translator &fetchedTor, const QString &file, ConversionDat
     return false;
 }
 
+void SourceMessages::record(Translator &translator, ConversionData &cd) const
+{
+    const std::string diagnostics = m_diagnostics.str();
+    if (!diagnostics.empty())
+        std::cerr << diagnostics;
+    if (!m_error.isEmpty())
+        cd.appendError(m_error);
+    for (const TranslatorMessage &msg : m_messages)
+        translator.extend(msg, cd);
+}
+
+// These files are parsed on their own, without following includes, so
+// they can be parsed in any order.
+enum class StandaloneSource { None, Java, Python, Qml, QScript, JSModule };
+
+static StandaloneSource standaloneSource(const QString &fileName)
+{
+    if (fileName.endsWith(".java"_L1, Qt::CaseInsensitive))
+        return StandaloneSource::Java;
+    if (fileName.endsWith(u".py", Qt::CaseInsensitive))
+        return StandaloneSource::Python;
+#ifndef QT_NO_QML
+    if (fileName.endsWith(".js"_L1, Qt::CaseInsensitive)
+        || fileName.endsWith(".qs"_L1, Qt::CaseInsensitive)) {
+        return StandaloneSource::QScript;
+    }
+    if (fileName.endsWith(".mjs"_L1, Qt::CaseInsensitive))
+        return StandaloneSource::JSModule;
+    if (fileName.endsWith(".qml"_L1, Qt::CaseInsensitive))
+        return StandaloneSource::Qml;
+#endif
+    return StandaloneSource::None;
+}
+
+class StandaloneParser
+{
+public:
+    void load(SourceMessages &messages, const QString &fileName, const ConversionData &cd)
+    {
+        switch (standaloneSource(fileName)) {
+        case StandaloneSource::Java:
+            loadJava(messages, fileName, cd);
+            break;
+        case StandaloneSource::Python:
+            loadPython(messages, fileName, cd);
+            break;
+#ifndef QT_NO_QML
+        case StandaloneSource::Qml:
+            m_qml.loadQml(messages, fileName);
+            break;
+        case StandaloneSource::QScript:
+            m_qml.loadQScript(messages, fileName);
+            break;
+        case StandaloneSource::JSModule:
+            m_qml.loadJSModule(messages, fileName);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+
+private:
+#ifndef QT_NO_QML
+    QmlExtractor m_qml;
+#endif
+};
+
 static void processSources(Translator &fetchedTor, const QStringList &sourceFiles,
                            ConversionData &cd, UpdateOptions options, bool *fail)
 {
 #ifdef QT_NO_QML
     bool requireQmlSupport = false;
 #endif
+    // With several jobs, the standalone files are all parsed up front, each
+    // into its own SourceMessages, by one StandaloneParser per thread. Their
+    // messages and diagnostics are recorded in input order below.
+    QStringList standaloneFiles;
+    for (const QString &sourceFile : sourceFiles) {
+        if (standaloneSource(sourceFile) != StandaloneSource::None)
+            standaloneFiles << sourceFile;
+    }
+    size_t threadCount = jobCount > 0 ? size_t(jobCount)
+                                      : size_t(std::thread::hardware_concurrency());
+    threadCount = std::min(threadCount, size_t(standaloneFiles.size()));
+    std::vector<SourceMessages> standaloneMessages;
+    if (threadCount > 1) {
+        // The alias lookup hash is built lazily; build it before the threads share it.
+        trFunctionAliasManager.nameToTrFunctionMap();
+        standaloneMessages = std::vector<SourceMessages>(standaloneFiles.size());
+        std::vector<StandaloneParser> parsers(threadCount);
+        runJobs(standaloneFiles.size(), threadCount, [&](size_t worker, qsizetype index) {
+            parsers[worker].load(standaloneMessages[index], standaloneFiles.at(index), cd);
+        });
+    }
+    std::unique_ptr<StandaloneParser> serialParser;
+    qsizetype standaloneIndex = 0;
+    const auto recordStandalone = [&](const QString &sourceFile) {
+        if (standaloneMessages.empty()) {
+            if (!serialParser)
+                serialParser = std::make_unique<StandaloneParser>();
+            SourceMessages messages;
+            serialParser->load(messages, sourceFile, cd);
+            messages.record(fetchedTor, cd);
+        } else {
+            standaloneMessages[standaloneIndex].record(fetchedTor, cd);
+            standaloneMessages[standaloneIndex] = SourceMessages();
+        }
+        ++standaloneIndex;
+    };
+
     QStringList sourceFilesCpp;
     for (const auto &sourceFile : sourceFiles) {
-        if (sourceFile.endsWith(".java"_L1, Qt::CaseInsensitive))
-            loadJava(fetchedTor, sourceFile, cd);
+        if (standaloneSource(sourceFile) != StandaloneSource::None)
+            recordStandalone(sourceFile);
         else if (sourceFile.endsWith(".ui"_L1, Qt::CaseInsensitive)
                  || sourceFile.endsWith(".jui"_L1, Qt::CaseInsensitive))
             loadUI(fetchedTor, sourceFile, cd);
-#ifndef QT_NO_QML
-        else if (sourceFile.endsWith(".js"_L1, Qt::CaseInsensitive)
-                 || sourceFile.endsWith(".qs"_L1, Qt::CaseInsensitive)) {
-            loadQScript(fetchedTor, sourceFile, cd);
-        } else if (sourceFile.endsWith(".mjs"_L1, Qt::CaseInsensitive)) {
-            loadJSModule(fetchedTor, sourceFile, cd);
-        } else if (sourceFile.endsWith(".qml"_L1, Qt::CaseInsensitive))
-            loadQml(fetchedTor, sourceFile, cd);
-#else
+#ifdef QT_NO_QML
         else if (sourceFile.endsWith(".qml"_L1, Qt::CaseInsensitive)
                  || sourceFile.endsWith(".js"_L1, Qt::CaseInsensitive)
                  || sourceFile.endsWith(".mjs"_L1, Qt::CaseInsensitive)
                  || sourceFile.endsWith(".qs"_L1, Qt::CaseInsensitive))
             requireQmlSupport = true;
 #endif // QT_NO_QML
-        else if (sourceFile.endsWith(u".py", Qt::CaseInsensitive))
-            loadPython(fetchedTor, sourceFile, cd);
         else if (!processTs(fetchedTor, sourceFile, cd))
             sourceFilesCpp << sourceFile;
     }
@@ -718,6 +999,8 @@ private:
         cd.m_includePath = prj.includePaths;
         cd.m_excludes = prj.excluded;
         cd.m_sourceIsUtf16 = options & SourceIsUtf16;
+        cd.m_jobCount = jobCount;
+        cd.m_cacheDir = cacheDir;
         if (commandLineCompilationDatabaseDir.isEmpty())
             cd.m_compilationDatabaseDir = prj.compileCommands;
         else
@@ -931,6 +1214,27 @@ int main(int argc, char **argv)
         } else if (arg == "-version"_L1) {
             printOut(QStringLiteral("lupdate version %1\n").arg(QLatin1String(QT_VERSION_STR)));
             return 0;
+        } else if (arg == "-j"_L1) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The option -j requires a parameter.\n"_s);
+                return 1;
+            }
+            bool ok = false;
+            jobCount = args[i].toInt(&ok);
+            if (!ok || jobCount < 0) {
+                printErr(u"Invalid parameter passed to -j.\n"_s);
+                return 1;
+            }
+            continue;
+        } else if (arg == "-cache-dir"_L1) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The option -cache-dir requires a parameter.\n"_s);
+                return 1;
+            }
+            cacheDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+            continue;
         } else if (arg == "-ts"_L1) {
             metTsFlag = true;
             metXTsFlag = false;
@@ -1187,6 +1491,8 @@ int main(int argc, char **argv)
         cd.m_allCSources = allCSources;
         cd.m_compilationDatabaseDir = commandLineCompilationDatabaseDir;
         cd.m_rootDirs = rootDirs;
+        cd.m_jobCount = jobCount;
+        cd.m_cacheDir = cacheDir;
         for (const QString &resource : std::as_const(resourceFiles))
             sourceFiles << getResources(resource);
         processSources(fetchedTor, sourceFiles, cd, options, &fail);
@@ -15,6 +15,7 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -39,61 +40,127 @@ enum class StringType
     RawString
 };
 
-/*
-  The tokenizer maintains the following global variables. The names
-  should be self-explanatory.
-*/
-static QString yyFileName;
-static int yyCh;
-static QByteArray yyIdent;
-static char yyComment[65536];
-static size_t yyCommentLen;
-static char yyString[65536];
-static size_t yyStringLen;
-static int yyParenDepth;
-static int yyLineNo;
-static int yyCurLineNo;
-
 struct ExtraComment
 {
     QByteArray extraComment;
     int lineNo;
 };
 
-static QList<ExtraComment> extraComments;
-
-static QList<ExtraComment> ids;
-
-QHash<QByteArray, Token> tokens = {
-    {"None", Tok_None},
-    {"class", Tok_class},
-    {"def", Tok_def},
-    {"return", Tok_return},
-    {"__tr", Tok_tr}, // Legacy?
-    {"__trUtf8", Tok_trUtf8}
-};
-
-// the file to read from (if reading from a file)
-static FILE *yyInFile;
-
-// the string to read from and current position in the string (otherwise)
-static int yyInPos;
-static int buf;
+static QHash<QByteArray, Token> defaultTokens()
+{
+    QHash<QByteArray, Token> tokens = {
+        {"None", Tok_None},
+        {"class", Tok_class},
+        {"def", Tok_def},
+        {"return", Tok_return},
+        {"__tr", Tok_tr}, // Legacy?
+        {"__trUtf8", Tok_trUtf8}
+    };
 
-static int (*getChar)();
-static int (*peekChar)();
+    // Match the function aliases to our tokens
+    const auto &nameMap  = trFunctionAliasManager.nameToTrFunctionMap();
+    for (auto it = nameMap.cbegin(), end = nameMap.cend(); it != end; ++it) {
+        switch (it.value()) {
+        case TrFunctionAliasManager::Function_tr:
+        case TrFunctionAliasManager::Function_QT_TR_NOOP:
+            tokens.insert(it.key().toUtf8(), Tok_tr);
+            break;
+        case TrFunctionAliasManager::Function_trUtf8:
+            tokens.insert(it.key().toUtf8(), Tok_trUtf8);
+            break;
+        case TrFunctionAliasManager::Function_translate:
+        case TrFunctionAliasManager::Function_QT_TRANSLATE_NOOP:
+        // QTranslator::findMessage() has the same parameters as QApplication::translate().
+        case TrFunctionAliasManager::Function_findMessage:
+            tokens.insert(it.key().toUtf8(), Tok_translate);
+            break;
+        default:
+            break;
+        }
+    }
+    return tokens;
+}
 
-static int yyIndentationSize;
-static int yyContinuousSpaceCount;
-static bool yyCountingIndentation;
+// The aliases are known before the first file is parsed; from then on the
+// table is only read, by any number of parsers.
+static const QHash<QByteArray, Token> &pythonTokens()
+{
+    static const QHash<QByteArray, Token> tokens = defaultTokens();
+    return tokens;
+}
 
 // (Context, indentation level) pair.
 using ContextPair = QPair<QByteArray, int>;
 // Stack of (Context, indentation level) pairs.
 using ContextStack = QStack<ContextPair>;
-static ContextStack yyContextStack;
 
-static int getCharFromFile()
+class PythonParser
+{
+public:
+    PythonParser(SourceMessages &messages, const QString &fileName, FILE *inFile);
+    void parse(const QByteArray &initialContext = {}, const QByteArray &defaultContext = {});
+
+private:
+    int getChar();
+    int peekChar();
+    bool parseStringEscape(int quoteChar, StringType stringType);
+    Token parseString(StringType stringType = StringType::NoString);
+    QByteArray readLine();
+    Token getToken(StringType stringType = StringType::NoString);
+
+    bool match(Token t);
+    bool matchStringStart();
+    bool matchString(QByteArray *s);
+    bool matchEncoding(bool *utf8);
+    bool matchStringOrNone(QByteArray *s);
+    bool matchExpression();
+    bool parseTranslate(QByteArray *text, QByteArray *context, QByteArray *comment,
+                        bool *utf8, bool *plural);
+    void setMessageParameters(TranslatorMessage *message, int lineNo);
+
+    SourceMessages &m_messages;
+    const QHash<QByteArray, Token> &tokens;
+
+    // The tokenizer state. The names should be self-explanatory.
+    QString yyFileName;
+    int yyCh;
+    QByteArray yyIdent;
+    char yyComment[65536];
+    size_t yyCommentLen = 0;
+    char yyString[65536];
+    size_t yyStringLen = 0;
+    int yyParenDepth = 0;
+    int yyLineNo = 0;
+    int yyCurLineNo = 1;
+
+    QList<ExtraComment> extraComments;
+    QList<ExtraComment> ids;
+
+    // the file to read from
+    FILE *yyInFile;
+    int buf = -1;
+
+    int yyIndentationSize = -1;
+    int yyContinuousSpaceCount = 0;
+    bool yyCountingIndentation = false;
+
+    ContextStack yyContextStack;
+
+    // The parser state.
+    Token yyTok = Tok_Eof;
+};
+
+PythonParser::PythonParser(SourceMessages &messages, const QString &fileName, FILE *inFile)
+    : m_messages(messages), tokens(pythonTokens()), yyFileName(fileName), yyInFile(inFile)
+{
+    yyCh = getChar();
+    // The first line is line 1 even if it is empty, and not indented.
+    yyCurLineNo = 1;
+    yyContinuousSpaceCount = 0;
+    yyCountingIndentation = false;
+}
+
+int PythonParser::getChar()
 {
     int c;
 
@@ -115,33 +182,14 @@ static int getCharFromFile()
     return c;
 }
 
-static int peekCharFromFile()
+int PythonParser::peekChar()
 {
     int c = getc(yyInFile);
     buf = c;
     return c;
 }
 
-static void startTokenizer(const QString &fileName, int (*getCharFunc)(),
-                           int (*peekCharFunc)())
-{
-    yyInPos = 0;
-    buf = -1;
-    getChar = getCharFunc;
-    peekChar = peekCharFunc;
-
-    yyFileName = fileName;
-    yyCh = getChar();
-    yyParenDepth = 0;
-    yyCurLineNo = 1;
-
-    yyIndentationSize = -1;
-    yyContinuousSpaceCount = 0;
-    yyCountingIndentation = false;
-    yyContextStack.clear();
-}
-
-static bool parseStringEscape(int quoteChar, StringType stringType)
+bool PythonParser::parseStringEscape(int quoteChar, StringType stringType)
 {
     static const char tab[] = "abfnrtv";
     static const char backTab[] = "\a\b\f\n\r\t\v";
@@ -219,7 +267,7 @@ static bool parseStringEscape(int quoteChar, StringType stringType)
     return true;
 }
 
-static Token parseString(StringType stringType = StringType::NoString)
+Token PythonParser::parseString(StringType stringType)
 {
     int quoteChar = yyCh;
     bool tripleQuote = false;
@@ -276,10 +324,8 @@ static Token parseString(StringType stringType = StringType::NoString)
     yyString[yyStringLen] = '\0';
 
     if (yyCh != quoteChar) {
-        printf("%c\n", yyCh);
-
-        qWarning("%s:%d: Unterminated string",
-                 qPrintable(yyFileName), yyLineNo);
+        m_messages.diagnostics() << qPrintable(yyFileName) << ':' << yyLineNo
+                                 << ": Unterminated string\n";
     }
 
     if (yyCh == EOF)
@@ -288,7 +334,7 @@ static Token parseString(StringType stringType = StringType::NoString)
     return Tok_String;
 }
 
-static QByteArray readLine()
+QByteArray PythonParser::readLine()
 {
     QByteArray result;
     while (true) {
@@ -300,7 +346,7 @@ static QByteArray readLine()
     return result;
 }
 
-static Token getToken(StringType stringType = StringType::NoString)
+Token PythonParser::getToken(StringType stringType)
 {
     yyIdent.clear();
     yyCommentLen = 0;
@@ -400,9 +446,7 @@ static Token getToken(StringType stringType = StringType::NoString)
   (3) the call appears within a function defined outside the class definition.
 */
 
-static Token yyTok;
-
-static bool match(Token t)
+bool PythonParser::match(Token t)
 {
     const bool matches = (yyTok == t);
     if (matches)
@@ -410,7 +454,7 @@ static bool match(Token t)
     return matches;
 }
 
-static bool matchStringStart()
+bool PythonParser::matchStringStart()
 {
     if (yyTok == Tok_String)
         return true;
@@ -428,7 +472,7 @@ static bool matchStringStart()
     return false;
 }
 
-static bool matchString(QByteArray *s)
+bool PythonParser::matchString(QByteArray *s)
 {
     s->clear();
     bool ok = false;
@@ -440,7 +484,7 @@ static bool matchString(QByteArray *s)
     return ok;
 }
 
-static bool matchEncoding(bool *utf8)
+bool PythonParser::matchEncoding(bool *utf8)
 {
     // Remove any leading module paths.
     if (yyTok == Tok_Ident && std::strcmp(yyIdent, "PySide6") == 0) {
@@ -479,7 +523,7 @@ static bool matchEncoding(bool *utf8)
     return false;
 }
 
-static bool matchStringOrNone(QByteArray *s)
+bool PythonParser::matchStringOrNone(QByteArray *s)
 {
     bool matches = matchString(s);
 
@@ -502,7 +546,7 @@ static bool matchStringOrNone(QByteArray *s)
  * list(a,b).size(2,4)
  * etc...
  */
-static bool matchExpression()
+bool PythonParser::matchExpression()
 {
     if (match(Tok_Integer))
         return true;
@@ -530,8 +574,8 @@ static bool matchExpression()
     return true;
 }
 
-static bool parseTranslate(QByteArray *text, QByteArray *context, QByteArray *comment,
-                           bool *utf8, bool *plural)
+bool PythonParser::parseTranslate(QByteArray *text, QByteArray *context, QByteArray *comment,
+                                  bool *utf8, bool *plural)
 {
     text->clear();
     context->clear();
@@ -601,8 +645,7 @@ static bool parseTranslate(QByteArray *text, QByteArray *context, QByteArray *co
     return false;
 }
 
-static void setMessageParameters(TranslatorMessage *message,
-                                 int lineNo)
+void PythonParser::setMessageParameters(TranslatorMessage *message, int lineNo)
 {
     // PYSIDE-2863: parseTranslate() can read past the message
     // and capture extraComments intended for the next message.
@@ -621,9 +664,7 @@ static void setMessageParameters(TranslatorMessage *message,
         message->setId(QString::fromUtf8(ids.takeFirst().extraComment));
 }
 
-static void parse(Translator &tor, ConversionData &cd,
-                  const QByteArray &initialContext = {},
-                  const QByteArray &defaultContext = {})
+void PythonParser::parse(const QByteArray &initialContext, const QByteArray &defaultContext)
 {
     QByteArray context;
     QByteArray text;
@@ -697,7 +738,7 @@ static void parse(Translator &tor, ConversionData &cd,
                                               {}, yyFileName, yyLineNo,
                                               {}, TranslatorMessage::Unfinished, plural);
                     setMessageParameters(&message, lineNo);
-                    tor.extend(message, cd);
+                    m_messages.append(message);
                 }
             }
                 break;
@@ -711,7 +752,7 @@ static void parse(Translator &tor, ConversionData &cd,
                                                   {}, yyFileName, yyLineNo,
                                                   {}, TranslatorMessage::Unfinished, plural);
                         setMessageParameters(&message, lineNo);
-                        tor.extend(message, cd);
+                        m_messages.append(message);
                     }
                 }
                 break;
@@ -737,7 +778,7 @@ static void parse(Translator &tor, ConversionData &cd,
                         TranslatorMessage message(QString::fromUtf8(context),
                                                   {}, QString::fromUtf8(comment), {},
                                                   yyFileName, yyLineNo, {});
-                        tor.extend(message, cd);
+                        m_messages.append(message);
                     }
                 }
                 yyTok = getToken();
@@ -748,55 +789,32 @@ static void parse(Translator &tor, ConversionData &cd,
     }
 
     if (yyParenDepth != 0) {
-        qWarning("%s: Unbalanced parentheses in Python code",
-                 qPrintable(yyFileName));
+        m_messages.diagnostics() << qPrintable(yyFileName)
+                                 << ": Unbalanced parentheses in Python code\n";
     }
 }
 
-bool loadPython(Translator &translator, const QString &fileName, ConversionData &cd)
+bool loadPython(SourceMessages &messages, const QString &fileName, const ConversionData &cd)
 {
-    // Match the function aliases to our tokens
-    static bool firstTime = true;
-    if (firstTime) {
-        firstTime = false;
-        const auto &nameMap  = trFunctionAliasManager.nameToTrFunctionMap();
-        for (auto it = nameMap.cbegin(), end = nameMap.cend(); it != end; ++it) {
-            switch (it.value()) {
-            case TrFunctionAliasManager::Function_tr:
-            case TrFunctionAliasManager::Function_QT_TR_NOOP:
-                tokens.insert(it.key().toUtf8(), Tok_tr);
-                break;
-            case TrFunctionAliasManager::Function_trUtf8:
-                tokens.insert(it.key().toUtf8(), Tok_trUtf8);
-                break;
-            case TrFunctionAliasManager::Function_translate:
-            case TrFunctionAliasManager::Function_QT_TRANSLATE_NOOP:
-            // QTranslator::findMessage() has the same parameters as QApplication::translate().
-            case TrFunctionAliasManager::Function_findMessage:
-                tokens.insert(it.key().toUtf8(), Tok_translate);
-                break;
-            default:
-                break;
-            }
-        }
-    }
-
+    Q_UNUSED(cd);
+    FILE *inFile;
 #ifdef Q_CC_MSVC
     const auto *fileNameC = reinterpret_cast<const wchar_t *>(fileName.utf16());
-    const bool ok = _wfopen_s(&yyInFile, fileNameC, L"r") == 0;
+    const bool ok = _wfopen_s(&inFile, fileNameC, L"r") == 0;
 #else
     const QByteArray fileNameC = QFile::encodeName(fileName);
-    yyInFile = std::fopen( fileNameC.constData(), "r");
-    const bool ok = yyInFile != nullptr;
+    inFile = std::fopen( fileNameC.constData(), "r");
+    const bool ok = inFile != nullptr;
 #endif
     if (!ok) {
-        cd.appendError(QStringLiteral("Cannot open %1").arg(fileName));
+        messages.setError(QStringLiteral("Cannot open %1").arg(fileName));
         return false;
     }
 
-    startTokenizer(fileName, getCharFromFile, peekCharFromFile);
-    parse(translator, cd);
-    std::fclose(yyInFile);
+    // The buffers are too large for the stack of a worker thread.
+    auto parser = std::make_unique<PythonParser>(messages, fileName, inFile);
+    parser->parse();
+    std::fclose(inFile);
     return true;
 }
 
@@ -35,16 +35,17 @@ using namespace Qt::StringLiterals;
 class FindTrCalls: protected AST::Visitor
 {
 public:
-    FindTrCalls(Engine *engine, ConversionData &cd)
+    FindTrCalls(Engine *engine, SourceMessages &messages)
         : engine(engine)
-        , m_cd(cd)
+        , m_messages(messages)
     {
     }
 
-    void operator()(Translator *translator, const QString &fileName, AST::Node *node)
+    // The engine may have parsed other files before; only the comments
+    // from firstComment on belong to this one.
+    void operator()(const QString &fileName, AST::Node *node, qsizetype firstComment)
     {
-        m_todo = engine->comments();
-        m_translator = translator;
+        m_todo = engine->comments().mid(firstComment);
         m_fileName = fileName;
         m_component = QFileInfo(fileName).completeBaseName();
         accept(node);
@@ -138,7 +139,7 @@ protected:
                 msg.setExtraComment(ParserTool::transcode(extracomment.simplified()));
                 msg.setId(msgid);
                 msg.setExtras(extra);
-                m_translator->extend(msg, m_cd);
+                m_messages.append(msg);
                 consumeComment();
                 break; }
             case TrFunctionAliasManager::Function_qsTranslate:
@@ -179,7 +180,7 @@ protected:
                 msg.setExtraComment(ParserTool::transcode(extracomment.simplified()));
                 msg.setId(msgid);
                 msg.setExtras(extra);
-                m_translator->extend(msg, m_cd);
+                m_messages.append(msg);
                 consumeComment();
                 break; }
             case TrFunctionAliasManager::Function_qsTrId:
@@ -207,7 +208,7 @@ protected:
                 msg.setExtraComment(ParserTool::transcode(extracomment.simplified()));
                 msg.setId(id);
                 msg.setExtras(extra);
-                m_translator->extend(msg, m_cd);
+                m_messages.append(msg);
                 consumeComment();
                 break; }
             }
@@ -219,13 +220,13 @@ protected:
 private:
     std::ostream &yyMsg(int line)
     {
-        return std::cerr << qPrintable(m_fileName) << ':' << line << ": ";
+        return m_messages.diagnostics() << qPrintable(m_fileName) << ':' << line << ": ";
     }
 
     void throwRecursionDepthError() final
     {
-        std::cerr << qPrintable(m_fileName) << ": "
-                  << "Maximum statement or expression depth exceeded";
+        m_messages.diagnostics() << qPrintable(m_fileName) << ": "
+                                 << "Maximum statement or expression depth exceeded";
     }
 
 
@@ -252,8 +253,7 @@ private:
     }
 
     Engine *engine;
-    Translator *m_translator;
-    ConversionData &m_cd;
+    SourceMessages &m_messages;
     QString m_fileName;
     QString m_component;
 
@@ -430,18 +430,30 @@ private:
     int lastOffset;
 };
 
-enum CodeType {
-    QMLCode,
-    JSCode,
-    MJSCode,
+static const qsizetype MaxRetainedComments = 10000;
+static const int MaxFilesPerEngine = 200;
+
+struct QmlExtractor::Private
+{
+    Private() { engine.setLexer(&lexer); }
+
+    Engine engine;
+    Lexer lexer{&engine};
+    int files = 0;
 };
 
-static bool load(Translator &translator, const QString &filename, ConversionData &cd, CodeType mode)
+QmlExtractor::QmlExtractor()
+    : d(std::make_unique<Private>())
+{
+}
+
+QmlExtractor::~QmlExtractor() = default;
+
+bool QmlExtractor::load(SourceMessages &messages, const QString &filename, CodeType mode)
 {
-    cd.m_sourceFileName = filename;
     QFile file(filename);
     if (!file.open(QIODevice::ReadOnly)) {
-        cd.appendError(QStringLiteral("Cannot open %1: %2").arg(filename, file.errorString()));
+        messages.setError(QStringLiteral("Cannot open %1: %2").arg(filename, file.errorString()));
         return false;
     }
 
@@ -453,12 +465,19 @@ static bool load(Translator &translator, const QString &filename, ConversionData
         code = ts.readAll();
     }
 
-    Engine driver;
-    Parser parser(&driver);
+    // The syntax tree of the previous file is not needed anymore; its memory
+    // is reused for this one. The engine keeps the comments and some strings
+    // of all files, though, and the pool keeps the blocks of the largest file,
+    // so the engine is replaced once in a while.
+    if (d->files >= MaxFilesPerEngine || d->engine.comments().size() > MaxRetainedComments)
+        d = std::make_unique<Private>();
+    ++d->files;
+    Engine &driver = d->engine;
+    driver.pool()->reset();
+    const qsizetype firstComment = driver.comments().size();
 
-    Lexer lexer(&driver);
-    lexer.setCode(code, /*line = */ 1, mode == QMLCode);
-    driver.setLexer(&lexer);
+    Parser parser(&driver);
+    d->lexer.setCode(code, /*line = */ 1, mode == QMLCode);
 
     bool rc;
     if (mode == QMLCode)
@@ -469,31 +488,30 @@ static bool load(Translator &translator, const QString &filename, ConversionData
         rc = parser.parseModule();
 
     if (rc) {
-        FindTrCalls trCalls(&driver, cd);
+        FindTrCalls trCalls(&driver, messages);
 
         //find all tr calls in the code
-        trCalls(&translator, filename, parser.rootNode());
+        trCalls(filename, parser.rootNode(), firstComment);
     } else {
-        QString error = createErrorString(filename, code, parser);
-        cd.appendError(error);
+        messages.setError(createErrorString(filename, code, parser));
         return false;
     }
     return true;
 }
 
-bool loadQml(Translator &translator, const QString &filename, ConversionData &cd)
+bool QmlExtractor::loadQml(SourceMessages &messages, const QString &filename)
 {
-    return load(translator, filename, cd, /*qmlMode=*/ QMLCode);
+    return load(messages, filename, /*qmlMode=*/ QMLCode);
 }
 
-bool loadQScript(Translator &translator, const QString &filename, ConversionData &cd)
+bool QmlExtractor::loadQScript(SourceMessages &messages, const QString &filename)
 {
-    return load(translator, filename, cd, /*qmlMode=*/ JSCode);
+    return load(messages, filename, /*qmlMode=*/ JSCode);
 }
 
-bool loadJSModule(Translator &translator, const QString &filename, ConversionData &cd)
+bool QmlExtractor::loadJSModule(SourceMessages &messages, const QString &filename)
 {
-    return load(translator, filename, cd, /*qmlMode=*/ MJSCode);
+    return load(messages, filename, /*qmlMode=*/ MJSCode);
 }
 
 QT_END_NAMESPACE
@@ -701,20 +701,8 @@ static QString escapeComment(const QString &in, bool escape)
     return out;
 }
 
-bool savePO(const Translator &translator, QIODevice &dev, ConversionData &)
+static void writePoHeader(QTextStream &out, const Translator &translator, bool qtContexts)
 {
-    QString str_format = "-format"_L1;
-
-    bool ok = true;
-    QTextStream out(&dev);
-
-    bool qtContexts = false;
-    for (const TranslatorMessage &msg : translator.messages())
-        if (!msg.context().isEmpty()) {
-            qtContexts = true;
-            break;
-        }
-
     QString cmt = translator.extra("po-header_comment"_L1);
     if (!cmt.isEmpty())
         out << cmt << '\n';
@@ -746,102 +734,122 @@ bool savePO(const Translator &translator, QIODevice &dev, ConversionData &)
         hdrStr += u'\n';
     }
     out << poEscapedString(QString(), QString::fromLatin1("msgstr"), true, hdrStr);
+}
 
-    for (const TranslatorMessage &msg : translator.messages()) {
-        out << Qt::endl;
+static void writePoMessage(QTextStream &out, const TranslatorMessage &msg, bool qtContexts)
+{
+    static const QString str_format = u"-format"_s;
 
-        if (!msg.translatorComment().isEmpty())
-            out << poEscapedLines("#"_L1, true, msg.translatorComment());
+    out << Qt::endl;
 
-        if (!msg.extraComment().isEmpty())
-            out << poEscapedLines("#."_L1, true, msg.extraComment());
+    if (!msg.translatorComment().isEmpty())
+        out << poEscapedLines("#"_L1, true, msg.translatorComment());
 
-        if (!msg.id().isEmpty())
-            out << "#. ts-id "_L1 << msg.id() << '\n';
+    if (!msg.extraComment().isEmpty())
+        out << poEscapedLines("#."_L1, true, msg.extraComment());
 
-        QString xrefs = msg.extra("po-references"_L1);
-        if (!msg.fileName().isEmpty() || !xrefs.isEmpty()) {
-            QStringList refs;
-            for (const TranslatorMessage::Reference &ref : msg.allReferences())
-                refs.append(QString("%2:%1"_L1).arg(ref.lineNumber()).arg(ref.fileName()));
-            if (!xrefs.isEmpty())
-                refs << xrefs;
-            out << poWrappedEscapedLines("#:"_L1, true, refs.join(u' '));
-        }
+    if (!msg.id().isEmpty())
+        out << "#. ts-id "_L1 << msg.id() << '\n';
 
-        bool noWrap = false;
-        bool skipFormat = false;
-        QStringList flags;
-        if ((msg.type() == TranslatorMessage::Unfinished
-             || msg.type() == TranslatorMessage::Obsolete) && msg.isTranslated())
-            flags.append("fuzzy"_L1);
-        const auto itr = msg.extras().constFind("po-flags"_L1);
-        if (itr != msg.extras().cend()) {
-            const QStringList atoms = itr->split(", "_L1);
-            for (const QString &atom : atoms)
-                if (atom.endsWith(str_format)) {
-                    skipFormat = true;
-                    break;
-                }
-            if (atoms.contains("no-wrap"_L1))
-                noWrap = true;
-            flags.append(*itr);
-        }
-        if (!skipFormat) {
-            QString source = msg.sourceText();
-            // This is fuzzy logic, as we don't know whether the string is
-            // actually used with QString::arg().
-            for (int off = 0; (off = source.indexOf(u'%', off)) >= 0;) {
-                if (++off >= source.size())
-                    break;
-                if (source.at(off) == u'n' || source.at(off).isDigit()) {
-                    flags.append("qt-format"_L1);
-                    break;
-                }
+    QString xrefs = msg.extra("po-references"_L1);
+    if (!msg.fileName().isEmpty() || !xrefs.isEmpty()) {
+        QStringList refs;
+        for (const TranslatorMessage::Reference &ref : msg.allReferences())
+            refs.append(QString("%2:%1"_L1).arg(ref.lineNumber()).arg(ref.fileName()));
+        if (!xrefs.isEmpty())
+            refs << xrefs;
+        out << poWrappedEscapedLines("#:"_L1, true, refs.join(u' '));
+    }
+
+    bool noWrap = false;
+    bool skipFormat = false;
+    QStringList flags;
+    if ((msg.type() == TranslatorMessage::Unfinished
+         || msg.type() == TranslatorMessage::Obsolete) && msg.isTranslated())
+        flags.append("fuzzy"_L1);
+    const auto itr = msg.extras().constFind("po-flags"_L1);
+    if (itr != msg.extras().cend()) {
+        const QStringList atoms = itr->split(", "_L1);
+        for (const QString &atom : atoms)
+            if (atom.endsWith(str_format)) {
+                skipFormat = true;
+                break;
             }
-        }
-        if (!flags.isEmpty())
-            out << "#, " << flags.join(", "_L1) << '\n';
-
-        bool isObsolete = (msg.type() == TranslatorMessage::Obsolete
-                           || msg.type() == TranslatorMessage::Vanished);
-        QString prefix = QLatin1String(isObsolete ? "#~| " : "#| ");
-        if (!msg.oldComment().isEmpty())
-            out << poEscapedString(prefix, "msgctxt"_L1, noWrap,
-                                   escapeComment(msg.oldComment(), qtContexts));
-        if (!msg.oldSourceText().isEmpty())
-            out << poEscapedString(prefix, "msgid"_L1, noWrap, msg.oldSourceText());
-        QString plural = msg.extra("po-old_msgid_plural"_L1);
-        if (!plural.isEmpty())
-            out << poEscapedString(prefix, "msgid_plural"_L1, noWrap, plural);
-        prefix = QLatin1String(isObsolete ? "#~ " : "");
-        if (!msg.context().isEmpty())
-            out << poEscapedString(prefix, "msgctxt"_L1, noWrap,
-                                   escapeComment(msg.context(), true) + u'|'
-                                           + escapeComment(msg.comment(), true));
-        else if (!msg.comment().isEmpty())
-            out << poEscapedString(prefix, "msgctxt"_L1, noWrap,
-                                   escapeComment(msg.comment(), qtContexts));
-        out << poEscapedString(prefix, "msgid"_L1, noWrap, msg.sourceText());
-        if (!msg.isPlural()) {
-            QString transl = msg.translation();
-            transl.replace(Translator::BinaryVariantSeparator, Translator::TextVariantSeparator);
-            out << poEscapedString(prefix, "msgstr"_L1, noWrap, transl);
-        } else {
-            QString plural = msg.extra("po-msgid_plural"_L1);
-            if (plural.isEmpty())
-                plural = msg.sourceText();
-            out << poEscapedString(prefix, "msgid_plural"_L1, noWrap, plural);
-            const QStringList &translations = msg.translations();
-            for (int i = 0; i != translations.size(); ++i) {
-                QString str = translations.at(i);
-                str.replace(QChar(Translator::BinaryVariantSeparator),
-                            QChar(Translator::TextVariantSeparator));
-                out << poEscapedString(prefix, QString::fromLatin1("msgstr[%1]").arg(i), noWrap,
-                                       str);
+        if (atoms.contains("no-wrap"_L1))
+            noWrap = true;
+        flags.append(*itr);
+    }
+    if (!skipFormat) {
+        QString source = msg.sourceText();
+        // This is fuzzy logic, as we don't know whether the string is
+        // actually used with QString::arg().
+        for (int off = 0; (off = source.indexOf(u'%', off)) >= 0;) {
+            if (++off >= source.size())
+                break;
+            if (source.at(off) == u'n' || source.at(off).isDigit()) {
+                flags.append("qt-format"_L1);
+                break;
             }
         }
     }
+    if (!flags.isEmpty())
+        out << "#, " << flags.join(", "_L1) << '\n';
+
+    bool isObsolete = (msg.type() == TranslatorMessage::Obsolete
+                       || msg.type() == TranslatorMessage::Vanished);
+    QString prefix = QLatin1String(isObsolete ? "#~| " : "#| ");
+    if (!msg.oldComment().isEmpty())
+        out << poEscapedString(prefix, "msgctxt"_L1, noWrap,
+                               escapeComment(msg.oldComment(), qtContexts));
+    if (!msg.oldSourceText().isEmpty())
+        out << poEscapedString(prefix, "msgid"_L1, noWrap, msg.oldSourceText());
+    QString plural = msg.extra("po-old_msgid_plural"_L1);
+    if (!plural.isEmpty())
+        out << poEscapedString(prefix, "msgid_plural"_L1, noWrap, plural);
+    prefix = QLatin1String(isObsolete ? "#~ " : "");
+    if (!msg.context().isEmpty())
+        out << poEscapedString(prefix, "msgctxt"_L1, noWrap,
+                               escapeComment(msg.context(), true) + u'|'
+                                       + escapeComment(msg.comment(), true));
+    else if (!msg.comment().isEmpty())
+        out << poEscapedString(prefix, "msgctxt"_L1, noWrap,
+                               escapeComment(msg.comment(), qtContexts));
+    out << poEscapedString(prefix, "msgid"_L1, noWrap, msg.sourceText());
+    if (!msg.isPlural()) {
+        QString transl = msg.translation();
+        transl.replace(Translator::BinaryVariantSeparator, Translator::TextVariantSeparator);
+        out << poEscapedString(prefix, "msgstr"_L1, noWrap, transl);
+    } else {
+        QString plural = msg.extra("po-msgid_plural"_L1);
+        if (plural.isEmpty())
+            plural = msg.sourceText();
+        out << poEscapedString(prefix, "msgid_plural"_L1, noWrap, plural);
+        const QStringList &translations = msg.translations();
+        for (int i = 0; i != translations.size(); ++i) {
+            QString str = translations.at(i);
+            str.replace(QChar(Translator::BinaryVariantSeparator),
+                        QChar(Translator::TextVariantSeparator));
+            out << poEscapedString(prefix, QString::fromLatin1("msgstr[%1]").arg(i), noWrap,
+                                   str);
+        }
+    }
+}
+
+bool savePO(const Translator &translator, QIODevice &dev, ConversionData &)
+{
+    bool ok = true;
+    QTextStream out(&dev);
+
+    bool qtContexts = false;
+    for (const TranslatorMessage &msg : translator.messages())
+        if (!msg.context().isEmpty()) {
+            qtContexts = true;
+            break;
+        }
+
+    writePoHeader(out, translator, qtContexts);
+    for (const TranslatorMessage &msg : translator.messages())
+        writePoMessage(out, msg, qtContexts);
     return ok;
 }
 
@@ -852,6 +860,51 @@ static bool savePOT(const Translator &translator, QIODevice &dev, ConversionData
     return savePO(ttor, dev, cd);
 }
 
+static bool savePOStreamed(const Translator &header, TranslatorMessageStream &messages,
+                           QIODevice &dev, ConversionData &cd, bool dropTranslations)
+{
+    // The header needs to know whether any message has a context. Usually the
+    // first one does, so this rarely reads far.
+    bool qtContexts = false;
+    TranslatorMessage msg;
+    if (messages.rewind()) {
+        while (messages.next(&msg)) {
+            if (!msg.context().isEmpty()) {
+                qtContexts = true;
+                break;
+            }
+        }
+    }
+    if (!messages.rewind()) {
+        cd.appendError(u"Cannot re-read the messages"_s);
+        return false;
+    }
+
+    QTextStream out(&dev);
+    writePoHeader(out, header, qtContexts);
+    while (messages.next(&msg)) {
+        if (dropTranslations) {
+            if (msg.type() == TranslatorMessage::Finished)
+                msg.setType(TranslatorMessage::Unfinished);
+            msg.setTranslation(QString());
+        }
+        writePoMessage(out, msg, qtContexts);
+    }
+    return true;
+}
+
+static bool savePOStreamed(const Translator &header, TranslatorMessageStream &messages,
+                           QIODevice &dev, ConversionData &cd)
+{
+    return savePOStreamed(header, messages, dev, cd, false);
+}
+
+static bool savePOTStreamed(const Translator &header, TranslatorMessageStream &messages,
+                            QIODevice &dev, ConversionData &cd)
+{
+    return savePOStreamed(header, messages, dev, cd, true);
+}
+
 int initPO()
 {
     Translator::FileFormat format;
@@ -859,6 +912,7 @@ int initPO()
     format.untranslatedDescription = QT_TRANSLATE_NOOP("FMT", "GNU Gettext localization files");
     format.loader = &loadPO;
     format.saver = &savePO;
+    format.streamSaver = &savePOStreamed;
     format.fileType = Translator::FileFormat::TranslationSource;
     format.priority = 1;
     Translator::registerFileFormat(format);
@@ -866,6 +920,7 @@ int initPO()
     format.untranslatedDescription = QT_TRANSLATE_NOOP("FMT", "GNU Gettext localization template files");
     format.loader = &loadPO;
     format.saver = &savePOT;
+    format.streamSaver = &savePOTStreamed;
     format.fileType = Translator::FileFormat::TranslationSource;
     format.priority = -1;
     Translator::registerFileFormat(format);
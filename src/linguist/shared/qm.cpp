@@ -1,6 +1,7 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
+#include "qmreader.h"
 #include "translator.h"
 
 #ifndef QT_BOOTSTRAPPED
@@ -14,6 +15,7 @@
 #include <QtCore/QMap>
 #include <QtCore/QString>
 #include <QtCore/QStringDecoder>
+#include <QtCore/QtEndian>
 
 QT_BEGIN_NAMESPACE
 
@@ -434,176 +436,399 @@ static void fromBytes(const char *str, int len, QString *out, bool *utf8Fail)
     *utf8Fail = toUnicode.hasError();
 }
 
-bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
+static void fromBytes(QByteArrayView bytes, QString *out, bool *utf8Fail)
 {
-    QByteArray ba = dev.readAll();
-    const uchar *data = (uchar*)ba.data();
-    int len = ba.size();
-    if (len < MagicLength || memcmp(data, magic, MagicLength) != 0) {
-        cd.appendError("QM-Format error: magic marker missing"_L1);
-        return false;
+    fromBytes(bytes.data(), int(bytes.size()), out, utf8Fail);
+}
+
+QmReader::QmReader() = default;
+
+QmReader::~QmReader()
+{
+    close();
+}
+
+bool QmReader::open(const QString &fileName)
+{
+    close();
+    auto file = std::make_unique<QFile>(fileName);
+    if (!file->open(QIODevice::ReadOnly))
+        return fail(QString::fromLatin1("Cannot open %1: %2").arg(fileName, file->errorString()));
+    m_ownFile = std::move(file);
+    return readDevice(*m_ownFile);
+}
+
+bool QmReader::open(QIODevice &dev)
+{
+    close();
+    return readDevice(dev);
+}
+
+bool QmReader::readDevice(QIODevice &dev)
+{
+    auto *file = qobject_cast<QFile *>(&dev);
+    if (file && !file->isSequential()) {
+        const qint64 pos = file->pos();
+        const qint64 size = file->size() - pos;
+        if (size > 0) {
+            if (const uchar *data = file->map(pos, size)) {
+                m_mappedFile = file;
+                return parse(data, size);
+            }
+        }
     }
+    m_buffer = dev.readAll();
+    return parse(reinterpret_cast<const uchar *>(m_buffer.constData()), m_buffer.size());
+}
 
-    enum { Contexts = 0x2f, Hashes = 0x42, Messages = 0x69, NumerusRules = 0x88, Dependencies = 0x96, Language = 0xa7 };
+void QmReader::close()
+{
+    if (m_mappedFile)
+        m_mappedFile->unmap(const_cast<uchar *>(m_data));
+    m_mappedFile = nullptr;
+    m_ownFile.reset();
+    m_buffer.clear();
+    m_data = nullptr;
+    m_errorString.clear();
+    m_offsetArray = nullptr;
+    m_offsetLength = 0;
+    m_messageArray = nullptr;
+    m_messageLength = 0;
+    m_language = QByteArrayView();
+    m_dependencies = QByteArrayView();
+    m_numerusRules = QByteArrayView();
+}
 
-    // for squeezed but non-file data, this is what needs to be deleted
-    const uchar *messageArray = nullptr;
-    const uchar *offsetArray = nullptr;
-    uint offsetLength = 0;
+bool QmReader::fail(const QString &errorString)
+{
+    close();
+    m_errorString = errorString;
+    return false;
+}
 
-    bool ok = true;
-    bool utf8Fail = false;
-    const uchar *end = data + len;
+bool QmReader::parse(const uchar *data, qsizetype size)
+{
+    m_data = data;
+    if (size < MagicLength || memcmp(data, magic, MagicLength) != 0)
+        return fail("QM-Format error: magic marker missing"_L1);
 
+    enum { Contexts = 0x2f, Hashes = 0x42, Messages = 0x69, NumerusRules = 0x88, Dependencies = 0x96, Language = 0xa7 };
+
+    const uchar *end = data + size;
     data += MagicLength;
 
     while (data < end - 4) {
         quint8 tag = read8(data++);
         quint32 blockLen = read32(data);
-        //qDebug() << "TAG:" << tag <<  "BLOCKLEN:" << blockLen;
         data += 4;
         if (!tag || !blockLen)
             break;
-        if (data + blockLen > end) {
-            ok = false;
-            break;
-        }
+        if (blockLen > quint32(end - data))
+            return fail("QM-Format error"_L1);
 
+        const QByteArrayView block(reinterpret_cast<const char *>(data), blockLen);
         if (tag == Hashes) {
-            offsetArray = data;
-            offsetLength = blockLen;
-            //qDebug() << "HASHES: " << blockLen << QByteArray((const char *)data, blockLen).toHex();
+            m_offsetArray = data;
+            m_offsetLength = blockLen;
         } else if (tag == Messages) {
-            messageArray = data;
-            //qDebug() << "MESSAGES: " << blockLen << QByteArray((const char *)data, blockLen).toHex();
+            m_messageArray = data;
+            m_messageLength = blockLen;
         } else if (tag == Dependencies) {
-            QStringList dependencies;
-            QDataStream stream(QByteArray::fromRawData((const char*)data, blockLen));
-            QString dep;
-            while (!stream.atEnd()) {
-                stream >> dep;
-                dependencies.append(dep);
-            }
-            translator.setDependencies(dependencies);
+            m_dependencies = block;
         } else if (tag == Language) {
-            QString language;
-            fromBytes((const char *)data, blockLen, &language, &utf8Fail);
-            translator.setLanguageCode(language);
+            m_language = block;
+        } else if (tag == NumerusRules) {
+            m_numerusRules = block;
         }
 
         data += blockLen;
     }
+    return true;
+}
 
+QString QmReader::language() const
+{
+    return QString::fromUtf8(m_language);
+}
 
-    size_t numItems = offsetLength / (2 * sizeof(quint32));
-    //qDebug() << "NUMITEMS: " << numItems;
+QStringList QmReader::dependencies() const
+{
+    QStringList dependencies;
+    if (m_dependencies.isEmpty())
+        return dependencies;
+    QDataStream stream(QByteArray::fromRawData(m_dependencies.data(), m_dependencies.size()));
+    QString dep;
+    while (!stream.atEnd()) {
+        stream >> dep;
+        dependencies.append(dep);
+    }
+    return dependencies;
+}
 
-    QString strProN = "%n"_L1;
-    QLocale::Language l;
-    QLocale::Territory c;
-    Translator::languageAndTerritory(translator.languageCode(), &l, &c);
-    QStringList numerusForms;
-    bool guessPlurals = true;
-    if (getNumerusInfo(l, c, 0, &numerusForms, 0))
-        guessPlurals = (numerusForms.size() == 1);
+QByteArray QmReader::numerusRules() const
+{
+    return m_numerusRules.toByteArray();
+}
 
-    QString context, sourcetext, comment;
-    QStringList translations;
+/*
+  Reads the record of the index-th entry of the hash table into message.
+  Parts the record does not store are left as they are.
+*/
+bool QmReader::readMessage(qsizetype index, Message *message) const
+{
+    const uchar *entry = m_offsetArray + (index << 3);
+    const quint32 ro = read32(entry + 4);
+    message->m_hash = read32(entry);
+    message->m_translationCount = 0;
+    message->m_valid = false;
+    if (ro >= quint32(m_messageLength))
+        return false;
 
-    for (const uchar *start = offsetArray; start != offsetArray + (numItems << 3); start += 8) {
-        //quint32 hash = read32(start);
-        quint32 ro = read32(start + 4);
-        //qDebug() << "\nHASH:" << hash;
-        const uchar *m = messageArray + ro;
-
-        for (;;) {
-            uchar tag = read8(m++);
-            //qDebug() << "Tag:" << tag << " ADDR: " << m;
-            switch(tag) {
-            case Tag_End:
-                goto end;
-            case Tag_Translation: {
-                int len = read32(m);
-                m += 4;
-
-                // -1 indicates an empty string
-                // Otherwise streaming format is UTF-16 -> 2 bytes per character
-                if ((len != -1) && (len & 1)) {
-                    cd.appendError("QM-Format error"_L1);
-                    return false;
-                }
-                QString str;
-                if (len != -1)
-                    str = QString((const QChar *)m, len / 2);
-                if (QSysInfo::ByteOrder == QSysInfo::LittleEndian) {
-                    for (int i = 0; i < str.size(); ++i)
-                        str[i] = QChar((str.at(i).unicode() >> 8) +
-                            ((str.at(i).unicode() << 8) & 0xff00));
-                }
-                translations << str;
-                m += len;
-                break;
-            }
-            case Tag_Obsolete1:
-                m += 4;
-                //qDebug() << "OBSOLETE";
+    const uchar *m = m_messageArray + ro;
+    const uchar *end = m_messageArray + m_messageLength;
+    message->m_record = m;
+    while (m < end) {
+        const uchar tag = read8(m++);
+        switch (tag) {
+        case Tag_End:
+            message->m_recordEnd = m;
+            message->m_valid = true;
+            return true;
+        case Tag_Translation: {
+            if (end - m < 4)
+                return false;
+            const quint32 len = read32(m);
+            m += 4;
+            ++message->m_translationCount;
+            // 0xffffffff indicates an empty string
+            // Otherwise streaming format is UTF-16 -> 2 bytes per character
+            if (len == 0xffffffff)
                 break;
-            case Tag_SourceText: {
-                quint32 len = read32(m);
-                m += 4;
-                //qDebug() << "SOURCE LEN: " << len;
-                //qDebug() << "SOURCE: " << QByteArray((const char*)m, len);
-                fromBytes((const char*)m, len, &sourcetext, &utf8Fail);
-                m += len;
-                break;
-            }
-            case Tag_Context: {
-                quint32 len = read32(m);
-                m += 4;
-                //qDebug() << "CONTEXT LEN: " << len;
-                //qDebug() << "CONTEXT: " << QByteArray((const char*)m, len);
-                fromBytes((const char*)m, len, &context, &utf8Fail);
-                m += len;
-                break;
-            }
-            case Tag_Comment: {
-                quint32 len = read32(m);
-                m += 4;
-                //qDebug() << "COMMENT LEN: " << len;
-                //qDebug() << "COMMENT: " << QByteArray((const char*)m, len);
-                fromBytes((const char*)m, len, &comment, &utf8Fail);
+            if ((len & 1) || len > quint32(end - m))
+                return false;
+            m += len;
+            break;
+        }
+        case Tag_Obsolete1:
+            if (end - m < 4)
+                return false;
+            m += 4;
+            break;
+        case Tag_SourceText:
+        case Tag_Context:
+        case Tag_Comment: {
+            if (end - m < 4)
+                return false;
+            const quint32 len = read32(m);
+            m += 4;
+            if (len > quint32(end - m))
+                return false;
+            const QByteArrayView str(reinterpret_cast<const char *>(m), len);
+            if (tag == Tag_SourceText)
+                message->m_sourceText = str;
+            else if (tag == Tag_Context)
+                message->m_context = str;
+            else
+                message->m_comment = str;
+            m += len;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return false;
+}
+
+QStringList QmReader::Message::translations() const
+{
+    QStringList translations;
+    translations.reserve(m_translationCount);
+    for (const uchar *m = m_record; m < m_recordEnd;) {
+        const uchar tag = read8(m++);
+        if (tag == Tag_Translation) {
+            const quint32 len = read32(m);
+            m += 4;
+            QString str;
+            if (len != 0xffffffff) {
+                str.resize(len / 2);
+                qFromBigEndian<quint16>(m, len / 2, str.data());
                 m += len;
-                break;
-            }
-            default:
-                //qDebug() << "UNKNOWN TAG" << tag;
-                break;
             }
+            translations << str;
+        } else if (tag == Tag_Obsolete1) {
+            m += 4;
+        } else if (tag == Tag_SourceText || tag == Tag_Context || tag == Tag_Comment) {
+            m += 4 + read32(m);
         }
-    end:;
-        TranslatorMessage msg;
-        msg.setType(TranslatorMessage::Finished);
-        if (translations.size() > 1) {
-            // If guessPlurals is not false here, plural form discard messages
-            // will be spewn out later.
-            msg.setPlural(true);
-        } else if (guessPlurals) {
-            // This might cause false positives, so it is a fallback only.
-            if (sourcetext.contains(strProN))
-                msg.setPlural(true);
-        }
-        msg.setTranslations(translations);
-        translations.clear();
-        msg.setContext(context);
-        msg.setSourceText(sourcetext);
-        msg.setComment(comment);
-        translator.append(msg);
     }
-    if (utf8Fail) {
-        cd.appendError("Error: File contains invalid UTF-8 sequences."_L1);
+    return translations;
+}
+
+/*
+  Looks up a message the way QTranslator does: by the hash of its source text
+  and comment, then by comparing the parts that its record stores.
+*/
+bool QmReader::find(const QString &context, const QString &sourceText, const QString &comment,
+                    Message *message) const
+{
+    const QByteArray contextBytes = context.toUtf8();
+    const QByteArray sourceTextBytes = sourceText.toUtf8();
+    const QByteArray commentBytes = comment.toUtf8();
+    const quint32 hash = elfHash(sourceTextBytes + commentBytes);
+
+    // The hash table is sorted by hash, then by offset.
+    qsizetype lo = 0;
+    qsizetype hi = messageCount();
+    while (lo < hi) {
+        const qsizetype mid = lo + (hi - lo) / 2;
+        if (read32(m_offsetArray + (mid << 3)) < hash)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    for (; lo < messageCount() && read32(m_offsetArray + (lo << 3)) == hash; ++lo) {
+        Message msg;
+        if (!readMessage(lo, &msg))
+            continue;
+        if ((!msg.m_context.isNull() && msg.m_context != contextBytes)
+            || (!msg.m_sourceText.isNull() && msg.m_sourceText != sourceTextBytes)
+            || (!msg.m_comment.isNull() && msg.m_comment != commentBytes))
+            continue;
+        *message = msg;
+        return true;
+    }
+    return false;
+}
+
+QmReader::const_iterator::const_iterator(const QmReader *reader, qsizetype index)
+    : m_reader(reader), m_index(index)
+{
+    readCurrent();
+}
+
+void QmReader::const_iterator::readCurrent()
+{
+    if (m_index < m_reader->messageCount())
+        m_reader->readMessage(m_index, &m_message);
+}
+
+QmReader::const_iterator &QmReader::const_iterator::operator++()
+{
+    ++m_index;
+    readCurrent();
+    return *this;
+}
+
+QmReader::const_iterator QmReader::const_iterator::operator++(int)
+{
+    const_iterator it = *this;
+    ++*this;
+    return it;
+}
+
+QmStreamReader::QmStreamReader(QIODevice &dev, ConversionData &cd, const QString &languageCode)
+    : m_cd(cd), m_languageCode(languageCode)
+{
+    if (!m_reader.open(dev)) {
+        reportError(m_reader.errorString());
+        return;
+    }
+
+    if (!m_reader.languageData().isNull()) {
+        fromBytes(m_reader.languageData(), &m_languageCode, &m_utf8Fail);
+        m_languageInFile = true;
+    }
+
+    QLocale::Language l;
+    QLocale::Territory c;
+    Translator::languageAndTerritory(m_languageCode, &l, &c);
+    QStringList numerusForms;
+    if (getNumerusInfo(l, c, 0, &numerusForms, 0))
+        m_guessPlurals = (numerusForms.size() == 1);
+    m_it = m_reader.begin();
+}
+
+void QmStreamReader::reportError(const QString &error)
+{
+    if (m_error)
+        return;
+    m_error = true;
+    m_cd.appendError(error);
+}
+
+bool QmStreamReader::rewind()
+{
+    if (m_error)
+        return false;
+    m_it = m_reader.begin();
+    m_contextData = m_sourceTextData = m_commentData = QByteArrayView();
+    return true;
+}
+
+bool QmStreamReader::next(TranslatorMessage *msg)
+{
+    if (m_error)
+        return false;
+    if (*m_it == m_reader.end()) {
+        if (m_utf8Fail)
+            reportError("Error: File contains invalid UTF-8 sequences."_L1);
         return false;
     }
-    return ok;
+
+    const QmReader::Message &m = **m_it;
+    if (!m.isValid()) {
+        reportError("QM-Format error"_L1);
+        return false;
+    }
+    const auto decode = [this](QByteArrayView bytes, QByteArrayView *last, QString *out) {
+        if (bytes.data() == last->data() && bytes.size() == last->size())
+            return;
+        *last = bytes;
+        fromBytes(bytes, out, &m_utf8Fail);
+    };
+    decode(m.contextData(), &m_contextData, &m_context);
+    decode(m.sourceTextData(), &m_sourceTextData, &m_sourceText);
+    decode(m.commentData(), &m_commentData, &m_comment);
+    const QStringList translations = m.translations();
+    ++*m_it;
+
+    *msg = TranslatorMessage();
+    msg->setType(TranslatorMessage::Finished);
+    if (translations.size() > 1) {
+        // If guessPlurals is not false here, plural form discard messages
+        // will be spewn out later.
+        msg->setPlural(true);
+    } else if (m_guessPlurals) {
+        // This might cause false positives, so it is a fallback only.
+        if (m_sourceText.contains("%n"_L1))
+            msg->setPlural(true);
+    }
+    msg->setTranslations(translations);
+    msg->setContext(m_context);
+    msg->setSourceText(m_sourceText);
+    msg->setComment(m_comment);
+    return true;
+}
+
+void QmStreamReader::applyHeader(Translator *translator) const
+{
+    translator->setDependencies(m_reader.dependencies());
+    if (m_languageInFile)
+        translator->setLanguageCode(m_languageCode);
+}
+
+bool loadQM(Translator &translator, QIODevice &dev, ConversionData &cd)
+{
+    QmStreamReader reader(dev, cd, translator.languageCode());
+    if (reader.hasError())
+        return false;
+    reader.applyHeader(&translator);
+
+    TranslatorMessage msg;
+    while (reader.next(&msg))
+        translator.append(msg);
+    return !reader.hasError();
 }
 
 
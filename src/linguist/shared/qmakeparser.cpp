@@ -7,7 +7,11 @@
 #include "ioutils.h"
 using namespace QMakeInternal;
 
+#include <qcryptographichash.h>
+#include <qdatastream.h>
+#include <qdir.h>
 #include <qfile.h>
+#include <qsavefile.h>
 #ifdef PROPARSER_THREAD_SAFE
 # include <qthreadpool.h>
 #endif
@@ -99,6 +103,91 @@ void ProFileCache::discardFiles(const QString &prefix, QMakeVfs *vfs)
     }
 }
 
+///////////////////////////////////////////////////////////////////////
+//
+// ProFileDiskCache
+//
+///////////////////////////////////////////////////////////////////////
+
+static const quint32 diskCacheMagic = 0x514d4b43; // "QMKC"
+// Bump this whenever the token stream format changes. Entries are also only
+// used by the Qt version that wrote them, whose parser may differ.
+static const quint32 diskCacheVersion = 1;
+
+ProFileDiskCache::ProFileDiskCache(const QString &directory)
+{
+    if (!directory.isEmpty() && QDir().mkpath(directory))
+        m_directory = QDir(directory).absolutePath();
+}
+
+static QByteArrayView utf16Bytes(QStringView str)
+{
+    return QByteArrayView(reinterpret_cast<const char *>(str.utf16()),
+                          str.size() * qsizetype(sizeof(ushort)));
+}
+
+QByteArray ProFileDiskCache::contentHash(QStringView contents)
+{
+    return QCryptographicHash::hash(utf16Bytes(contents), QCryptographicHash::Sha1);
+}
+
+QString ProFileDiskCache::entryPath(const QString &fileName) const
+{
+    const QByteArray key = QCryptographicHash::hash(utf16Bytes(fileName),
+                                                    QCryptographicHash::Sha1);
+    return m_directory + QLatin1Char('/') + QString::fromLatin1(key.toHex());
+}
+
+// The streams use the byte order of nearly all hosts, so that the token
+// stream is read by a plain copy.
+static void setupStream(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+bool ProFileDiskCache::load(ProFile *pro, const QByteArray &contentHash) const
+{
+    QFile file(entryPath(pro->fileName()));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&file);
+    setupStream(in);
+    quint32 magic, version, qtVersion;
+    in >> magic >> version >> qtVersion;
+    if (in.status() != QDataStream::Ok || magic != diskCacheMagic || version != diskCacheVersion
+        || qtVersion != quint32(QT_VERSION)) {
+        return false;
+    }
+    QString fileName;
+    QByteArray hash;
+    in >> fileName >> hash;
+    if (in.status() != QDataStream::Ok || fileName != pro->fileName() || hash != contentHash)
+        return false;
+    bool ok, hostBuild;
+    QString items;
+    in >> ok >> hostBuild >> items;
+    if (in.status() != QDataStream::Ok)
+        return false;
+    *pro->itemsRef() = std::move(items);
+    pro->setOk(ok);
+    pro->setHostBuild(hostBuild);
+    return true;
+}
+
+void ProFileDiskCache::store(const ProFile *pro, const QByteArray &contentHash) const
+{
+    QSaveFile file(entryPath(pro->fileName()));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&file);
+    setupStream(out);
+    out << diskCacheMagic << diskCacheVersion << quint32(QT_VERSION) << pro->fileName()
+        << contentHash
+        << pro->isOk() << pro->isHostBuild() << pro->items();
+    file.commit();
+}
+
 ////////// Parser ///////////
 
 #define fL1S(s) QString::fromLatin1(s)
@@ -149,7 +238,9 @@ void QMakeParser::initialize()
 
 QMakeParser::QMakeParser(ProFileCache *cache, QMakeVfs *vfs, QMakeParserHandler *handler)
     : m_cache(cache)
+    , m_diskCache(nullptr)
     , m_handler(handler)
+    , m_recordedMessages(nullptr)
     , m_vfs(vfs)
 {
     // So that single-threaded apps don't have to call initialize() for now.
@@ -162,6 +253,7 @@ ProFile *QMakeParser::parsedProFile(const QString &fileName, ParseFlags flags)
     QMakeVfs::VfsFlags vfsFlags = ((flags & ParseCumulative) ? QMakeVfs::VfsCumulative
                                                              : QMakeVfs::VfsExact);
     int id = m_vfs->idForFileName(fileName, vfsFlags);
+    QList<QMakeParserMessage> replayed;
     if ((flags & ParseUseCache) && m_cache) {
         ProFileCache::Entry *ent;
 #ifdef PROPARSER_THREAD_SAFE
@@ -172,35 +264,43 @@ ProFile *QMakeParser::parsedProFile(const QString &fileName, ParseFlags flags)
             ent = &*it;
 #ifdef PROPARSER_THREAD_SAFE
             if (ent->locker && !ent->locker->done) {
-                ++ent->locker->waiters;
+                ProFileCache::Entry::Locker *lck = ent->locker;
+                ++lck->waiters;
                 QThreadPool::globalInstance()->releaseThread();
-                ent->locker->cond.wait(locker.mutex());
+                lck->cond.wait(locker.mutex());
                 QThreadPool::globalInstance()->reserveThread();
-                if (!--ent->locker->waiters) {
-                    delete ent->locker;
+                // Entries inserted meanwhile may have moved ours.
+                ent = &m_cache->parsed_files[id];
+                if (!--lck->waiters) {
+                    delete lck;
                     ent->locker = 0;
                 }
             }
 #endif
             if ((pro = ent->pro))
                 pro->ref();
+            replayed = ent->messages;
         } else {
             ent = &m_cache->parsed_files[id];
 #ifdef PROPARSER_THREAD_SAFE
             ent->locker = new ProFileCache::Entry::Locker;
             locker.unlock();
 #endif
-            QString contents;
-            if (readFile(id, flags, &contents)) {
-                pro = parsedProBlock(QStringView(contents), id, fileName, 1, FullGrammar);
+            QList<QMakeParserMessage> messages;
+            m_recordedMessages = &messages;
+            if ((pro = parseFile(id, fileName, flags))) {
                 pro->itemsRef()->squeeze();
                 pro->ref();
-            } else {
-                pro = nullptr;
             }
-            ent->pro = pro;
+            m_recordedMessages = nullptr;
 #ifdef PROPARSER_THREAD_SAFE
             locker.relock();
+            // Entries inserted while unlocked may have moved ours.
+            ent = &m_cache->parsed_files[id];
+#endif
+            ent->pro = pro;
+            ent->messages = std::move(messages);
+#ifdef PROPARSER_THREAD_SAFE
             if (ent->locker->waiters) {
                 ent->locker->done = true;
                 ent->locker->cond.wakeAll();
@@ -211,15 +311,36 @@ ProFile *QMakeParser::parsedProFile(const QString &fileName, ParseFlags flags)
 #endif
         }
     } else {
-        QString contents;
-        if (readFile(id, flags, &contents))
-            pro = parsedProBlock(QStringView(contents), id, fileName, 1, FullGrammar);
-        else
-            pro = nullptr;
+        pro = parseFile(id, fileName, flags);
+    }
+    // A file from the cache reports what parsing it reported, just like
+    // parsing it again would.
+    if (m_handler) {
+        for (const QMakeParserMessage &msg : std::as_const(replayed))
+            m_handler->message(msg.type, msg.msg, msg.fileName, msg.lineNo);
     }
     return pro;
 }
 
+ProFile *QMakeParser::parseFile(int id, const QString &fileName, ParseFlags flags)
+{
+    QString contents;
+    if (!readFile(id, flags, &contents))
+        return nullptr;
+    ProFile *pro = new ProFile(id, fileName);
+    QByteArray contentHash;
+    if (m_diskCache) {
+        contentHash = ProFileDiskCache::contentHash(contents);
+        if (m_diskCache->load(pro, contentHash))
+            return pro;
+    }
+    m_reported = false;
+    read(pro, QStringView(contents), 1, FullGrammar);
+    if (m_diskCache && !m_reported)
+        m_diskCache->store(pro, contentHash);
+    return pro;
+}
+
 ProFile *QMakeParser::parsedProBlock(
         QStringView contents, int id, const QString &name, int line, SubGrammar grammar)
 {
@@ -1285,7 +1406,12 @@ bool QMakeParser::resolveVariable(ushort *xprPtr, int tlen, int needSep, ushort
 
 void QMakeParser::message(int type, const QString &msg) const
 {
-    if (!m_inError && m_handler)
+    m_reported = true;
+    if (m_inError)
+        return;
+    if (m_recordedMessages)
+        m_recordedMessages->append({ type, msg, m_proFile->fileName(), m_lineNo });
+    if (m_handler)
         m_handler->message(type, msg, m_proFile->fileName(), m_lineNo);
 }
 
@@ -43,8 +43,19 @@ public:
 };
 
 class ProFileCache;
+class ProFileDiskCache;
 class QMakeVfs;
 
+// A message issued while parsing a file. It is kept with the cached file, so
+// that every user of the file gets to see it.
+struct QMakeParserMessage
+{
+    int type;
+    QString msg;
+    QString fileName;
+    int lineNo;
+};
+
 class QMAKE_EXPORT QMakeParser
 {
 public:
@@ -73,6 +84,9 @@ public:
 
     void discardFileFromCache(int id);
 
+    // Files read from disk are looked up in and added to cache, if set.
+    void setDiskCache(const ProFileDiskCache *cache) { m_diskCache = cache; }
+
 #ifdef PROPARSER_DEBUG
     static QString formatProBlock(const QString &block);
 #endif
@@ -110,6 +124,7 @@ private:
     };
 
     bool readFile(int id, QMakeParser::ParseFlags flags, QString *contents);
+    ProFile *parseFile(int id, const QString &fileName, ParseFlags flags);
     void read(ProFile *pro, QStringView content, int line, SubGrammar grammar);
 
     ALWAYS_INLINE void putTok(ushort *&tokPtr, ushort tok);
@@ -154,6 +169,7 @@ private:
     ScopeState m_state;
     int m_markLine; // Put marker for this line
     bool m_inError; // Current line had a parsing error; suppress followup error messages
+    mutable bool m_reported; // A message was issued while parsing the current file
     bool m_canElse; // Conditionals met on previous line, but no scope was opened
     int m_invert; // Pending conditional is negated
     enum { NoOperator, AndOperator, OrOperator } m_operator; // Pending conditional is ORed/ANDed
@@ -161,7 +177,9 @@ private:
     QString m_tmp; // Temporary for efficient toQString
 
     ProFileCache *m_cache;
+    const ProFileDiskCache *m_diskCache;
     QMakeParserHandler *m_handler;
+    QList<QMakeParserMessage> *m_recordedMessages; // of the file being added to m_cache
     QMakeVfs *m_vfs;
 
     // This doesn't help gcc 3.3 ...
@@ -185,6 +203,7 @@ public:
 private:
     struct Entry {
         ProFile *pro;
+        QList<QMakeParserMessage> messages;
 #ifdef PROPARSER_THREAD_SAFE
         struct Locker {
             Locker() : waiters(0), done(false) {}
@@ -204,6 +223,27 @@ private:
     friend class QMakeParser;
 };
 
+// Stores the token streams of parsed files in a directory, so that unchanged
+// files need not be parsed again in later runs. An entry is found by the file
+// name and used only if it was made from the same contents. Files whose parsing
+// issued messages are not stored, as these would be lost.
+class QMAKE_EXPORT ProFileDiskCache
+{
+public:
+    explicit ProFileDiskCache(const QString &directory);
+
+    bool isValid() const { return !m_directory.isEmpty(); }
+
+    static QByteArray contentHash(QStringView contents);
+    bool load(ProFile *pro, const QByteArray &contentHash) const;
+    void store(const ProFile *pro, const QByteArray &contentHash) const;
+
+private:
+    QString entryPath(const QString &fileName) const;
+
+    QString m_directory;
+};
+
 #if !defined(__GNUC__) || __GNUC__ > 3 || (__GNUC__ == 3 && __GNUC_MINOR__ > 3)
 Q_DECLARE_TYPEINFO(QMakeParser::BlockScope, Q_RELOCATABLE_TYPE);
 Q_DECLARE_TYPEINFO(QMakeParser::Context, Q_PRIMITIVE_TYPE);
@@ -0,0 +1,188 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef QMREADER_H
+#define QMREADER_H
+
+#include "translator.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QByteArrayView>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <iterator>
+#include <memory>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+class QFile;
+class QIODevice;
+
+/*
+  Reads a .qm file in place.
+
+  Files are memory-mapped where possible, otherwise read into one buffer.
+  Messages are visited in the order of the file's hash table. A Message only
+  refers to the bytes of its record; strings are decoded when asked for.
+
+  In files saved in stripped mode, a record stores only as much of its
+  context, source text and comment as is needed to tell it apart from its
+  neighbors. Iterating keeps the missing parts of the previous message,
+  just like a full load does; find() compares only the parts that are stored.
+*/
+class QmReader
+{
+public:
+    class Message
+    {
+    public:
+        // Raw UTF-8 bytes; null if no record so far stored the part.
+        QByteArrayView contextData() const { return m_context; }
+        QByteArrayView sourceTextData() const { return m_sourceText; }
+        QByteArrayView commentData() const { return m_comment; }
+
+        QString context() const { return QString::fromUtf8(m_context); }
+        QString sourceText() const { return QString::fromUtf8(m_sourceText); }
+        QString comment() const { return QString::fromUtf8(m_comment); }
+        QStringList translations() const;
+        int translationCount() const { return m_translationCount; }
+
+        quint32 hash() const { return m_hash; }
+        bool isValid() const { return m_valid; }
+
+    private:
+        friend class QmReader;
+
+        QByteArrayView m_context;
+        QByteArrayView m_sourceText;
+        QByteArrayView m_comment;
+        const uchar *m_record = nullptr;
+        const uchar *m_recordEnd = nullptr;
+        int m_translationCount = 0;
+        quint32 m_hash = 0;
+        bool m_valid = false;
+    };
+
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Message;
+        using difference_type = qsizetype;
+        using pointer = const Message *;
+        using reference = const Message &;
+
+        const Message &operator*() const { return m_message; }
+        const Message *operator->() const { return &m_message; }
+        const_iterator &operator++();
+        const_iterator operator++(int);
+        bool operator==(const const_iterator &other) const { return m_index == other.m_index; }
+        bool operator!=(const const_iterator &other) const { return m_index != other.m_index; }
+
+    private:
+        friend class QmReader;
+        const_iterator(const QmReader *reader, qsizetype index);
+        void readCurrent();
+
+        const QmReader *m_reader;
+        qsizetype m_index;
+        Message m_message;
+    };
+
+    QmReader();
+    ~QmReader();
+
+    bool open(const QString &fileName);
+    // A mapped device must stay open as long as the reader is used.
+    bool open(QIODevice &dev);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    bool isMapped() const { return m_mappedFile != nullptr; }
+    QString errorString() const { return m_errorString; }
+
+    QByteArrayView languageData() const { return m_language; }
+    QString language() const;
+    QStringList dependencies() const;
+    QByteArray numerusRules() const;
+
+    qsizetype messageCount() const { return m_offsetLength / 8; }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, messageCount()); }
+
+    bool find(const QString &context, const QString &sourceText, const QString &comment,
+              Message *message) const;
+
+private:
+    Q_DISABLE_COPY(QmReader)
+
+    bool readDevice(QIODevice &dev);
+    bool parse(const uchar *data, qsizetype size);
+    bool fail(const QString &errorString);
+    bool readMessage(qsizetype index, Message *message) const;
+
+    std::unique_ptr<QFile> m_ownFile;
+    QFile *m_mappedFile = nullptr;
+    QByteArray m_buffer;
+    const uchar *m_data = nullptr;
+    QString m_errorString;
+
+    const uchar *m_offsetArray = nullptr;
+    qsizetype m_offsetLength = 0;
+    const uchar *m_messageArray = nullptr;
+    qsizetype m_messageLength = 0;
+    QByteArrayView m_language;
+    QByteArrayView m_dependencies;
+    QByteArrayView m_numerusRules;
+};
+
+/*
+  Turns the records of a .qm file into TranslatorMessages one at a time,
+  the way loading the file does.
+
+  The language the file names is known right away; languageCode is used for
+  guessing plural forms if it names none. applyHeader() transfers the
+  language and the dependencies to a Translator. Errors are appended to the
+  ConversionData once.
+*/
+class QmStreamReader : public TranslatorMessageStream
+{
+public:
+    QmStreamReader(QIODevice &dev, ConversionData &cd, const QString &languageCode = QString());
+
+    bool rewind() override;
+    bool next(TranslatorMessage *msg) override;
+
+    bool hasError() const { return m_error; }
+    QString languageCode() const { return m_languageCode; }
+    void applyHeader(Translator *translator) const;
+
+private:
+    Q_DISABLE_COPY(QmStreamReader)
+
+    void reportError(const QString &error);
+
+    QmReader m_reader;
+    ConversionData &m_cd;
+    std::optional<QmReader::const_iterator> m_it;
+    QString m_languageCode;
+    bool m_languageInFile = false;
+    bool m_guessPlurals = true;
+    bool m_error = false;
+
+    // Parts a record does not store are inherited from the previous one, so
+    // only what changed is decoded.
+    QString m_context;
+    QString m_sourceText;
+    QString m_comment;
+    QByteArrayView m_contextData;
+    QByteArrayView m_sourceTextData;
+    QByteArrayView m_commentData;
+    bool m_utf8Fail = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QMREADER_H
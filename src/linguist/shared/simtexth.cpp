@@ -7,6 +7,11 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QString>
 #include <QtCore/QList>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/private/qsimd_p.h>
+
+#include <algorithm>
+#include <numeric>
 
 
 QT_BEGIN_NAMESPACE
@@ -71,29 +76,6 @@ static const int indexOf[256] = {
     15, 12, 16, 17, 18, 19, 2,  10, 15, 7,  19, 2,  6,  7,  10, 0
 };
 
-/*
-  The entry bitCount[i] (for i between 0 and 255) is the number of bits used to
-  represent i in binary.
-*/
-static const int bitCount[256] = {
-    0,  1,  1,  2,  1,  2,  2,  3,  1,  2,  2,  3,  2,  3,  3,  4,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    4,  5,  5,  6,  5,  6,  6,  7,  5,  6,  6,  7,  6,  7,  7,  8
-};
-
 static inline void setCoOccurence(CoMatrix &m, char c, char d)
 {
     int k = indexOf[(uchar) c] + 20 * indexOf[(uchar) d];
@@ -122,27 +104,149 @@ CoMatrix::CoMatrix(const QString &str)
 static inline int worth(const CoMatrix &m)
 {
     int w = 0;
-    for (int i = 0; i < 50; i++)
-        w += bitCount[m.b[i]];
+    for (int i = 0; i < 13; ++i)
+        w += qPopulationCount(m.w[i]);
     return w;
 }
 
-static inline CoMatrix reunion(const CoMatrix &m, const CoMatrix &n)
+/*
+  Counts the co-occurrences found in both matrices and in either of them,
+  one word at a time, without materializing their intersection and union.
+*/
+static inline void countCoOccurrences(const CoMatrix &m, const CoMatrix &n,
+                                      int *common, int *all)
 {
-    CoMatrix p;
-    for (int i = 0; i < 13; ++i)
-        p.w[i] = m.w[i] | n.w[i];
-    return p;
+    int c = 0;
+    int a = 0;
+    for (int i = 0; i < 13; ++i) {
+        c += qPopulationCount(m.w[i] & n.w[i]);
+        a += qPopulationCount(m.w[i] | n.w[i]);
+    }
+    *common = c;
+    *all = a;
 }
 
-static inline CoMatrix intersection(const CoMatrix &m, const CoMatrix &n)
+static inline int similarityScore(int common, int all, int delta)
 {
-    CoMatrix p;
-    for (int i = 0; i < 13; ++i)
-        p.w[i] = m.w[i] & n.w[i];
-    return p;
+    return ((common + 1) << 10) / (all + (delta << 1) + 1);
+}
+
+static void similarityScoresScalar(const CoMatrix &m, int length, const CoMatrix *cms,
+                                   const int *lengths, qsizetype count, int *scores)
+{
+    for (qsizetype i = 0; i < count; ++i) {
+        int common;
+        int all;
+        countCoOccurrences(m, cms[i], &common, &all);
+        scores[i] = similarityScore(common, all, qAbs(length - lengths[i]));
+    }
+}
+
+/*
+  The vector kernels count the bits of each byte by looking its two nibbles
+  up in a table with a byte shuffle. The 50 bytes of a matrix (plus padding)
+  are covered by overlapping loads that stay within its 52 bytes; the bytes a
+  load shares with the previous one are masked out of it. The byte counts of
+  the intersection and of the union are summed up with a single SAD each.
+*/
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+QT_FUNCTION_TARGET(AVX2)
+static inline __m256i popcountBytes256(__m256i v)
+{
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    const __m256i lo = _mm256_and_si256(v, nibble);
+    const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(table, lo), _mm256_shuffle_epi8(table, hi));
 }
 
+QT_FUNCTION_TARGET(AVX2)
+static void similarityScoresAvx2(const CoMatrix &m, int length, const CoMatrix *cms,
+                                 const int *lengths, qsizetype count, int *scores)
+{
+    // Bytes 0..31, then 20..51 without the twelve bytes seen already
+    const __m256i tail = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                          -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                          -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i m0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m.b));
+    const __m256i m1 = _mm256_and_si256(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(m.b + 20)), tail);
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const __m256i n0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cms[i].b));
+        const __m256i n1 = _mm256_and_si256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cms[i].b + 20)), tail);
+        const __m256i both = _mm256_add_epi8(popcountBytes256(_mm256_and_si256(m0, n0)),
+                                             popcountBytes256(_mm256_and_si256(m1, n1)));
+        const __m256i either = _mm256_add_epi8(popcountBytes256(_mm256_or_si256(m0, n0)),
+                                               popcountBytes256(_mm256_or_si256(m1, n1)));
+        // Common counts in the low, all counts in the high halves of the lanes
+        const __m256i sums = _mm256_or_si256(_mm256_sad_epu8(both, zero),
+                                             _mm256_slli_epi64(_mm256_sad_epu8(either, zero), 32));
+        __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(sums),
+                                    _mm256_extracti128_si256(sums, 1));
+        sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+        const int common = _mm_cvtsi128_si32(sum);
+        const int all = _mm_cvtsi128_si32(_mm_srli_epi64(sum, 32));
+        scores[i] = similarityScore(common, all, qAbs(length - lengths[i]));
+    }
+}
+#endif
+
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+QT_FUNCTION_TARGET(SSSE3)
+static inline __m128i popcountBytes128(__m128i v)
+{
+    const __m128i table = _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    const __m128i lo = _mm_and_si128(v, nibble);
+    const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+    return _mm_add_epi8(_mm_shuffle_epi8(table, lo), _mm_shuffle_epi8(table, hi));
+}
+
+QT_FUNCTION_TARGET(SSSE3)
+static void similarityScoresSsse3(const CoMatrix &m, int length, const CoMatrix *cms,
+                                  const int *lengths, qsizetype count, int *scores)
+{
+    // Bytes 0..47, then 36..51 without the twelve bytes seen already
+    const __m128i tail = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -1, -1, -1, -1);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i m0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m.b));
+    const __m128i m1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m.b + 16));
+    const __m128i m2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m.b + 32));
+    const __m128i m3 = _mm_and_si128(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(m.b + 36)), tail);
+
+    for (qsizetype i = 0; i < count; ++i) {
+        const uchar *b = cms[i].b;
+        const __m128i n0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b));
+        const __m128i n1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + 16));
+        const __m128i n2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + 32));
+        const __m128i n3 = _mm_and_si128(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + 36)), tail);
+        const __m128i both = _mm_add_epi8(
+                _mm_add_epi8(popcountBytes128(_mm_and_si128(m0, n0)),
+                             popcountBytes128(_mm_and_si128(m1, n1))),
+                _mm_add_epi8(popcountBytes128(_mm_and_si128(m2, n2)),
+                             popcountBytes128(_mm_and_si128(m3, n3))));
+        const __m128i either = _mm_add_epi8(
+                _mm_add_epi8(popcountBytes128(_mm_or_si128(m0, n0)),
+                             popcountBytes128(_mm_or_si128(m1, n1))),
+                _mm_add_epi8(popcountBytes128(_mm_or_si128(m2, n2)),
+                             popcountBytes128(_mm_or_si128(m3, n3))));
+        // Common counts in the low, all counts in the high halves of the lanes
+        __m128i sum = _mm_or_si128(_mm_sad_epu8(both, zero),
+                                   _mm_slli_epi64(_mm_sad_epu8(either, zero), 32));
+        sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+        const int common = _mm_cvtsi128_si32(sum);
+        const int all = _mm_cvtsi128_si32(_mm_srli_epi64(sum, 32));
+        scores[i] = similarityScore(common, all, qAbs(length - lengths[i]));
+    }
+}
+#endif
+
 StringSimilarityMatcher::StringSimilarityMatcher(const QString &stringToMatch)
     : m_cm(stringToMatch)
 {
@@ -151,52 +255,206 @@ StringSimilarityMatcher::StringSimilarityMatcher(const QString &stringToMatch)
 
 int StringSimilarityMatcher::getSimilarityScore(const QString &strCandidate)
 {
-    CoMatrix cmTarget(strCandidate);
-    int delta = qAbs(m_length - strCandidate.size());
-    int score = ( (worth(intersection(m_cm, cmTarget)) + 1) << 10 ) /
-        ( worth(reunion(m_cm, cmTarget)) + (delta << 1) + 1 );
-    return score;
+    return getSimilarityScore(CoMatrix(strCandidate), strCandidate.size());
 }
 
-CandidateList similarTextHeuristicCandidates(const Translator *tor,
-    const QString &text, int maxCandidates)
+int StringSimilarityMatcher::getSimilarityScore(const CoMatrix &cmCandidate,
+                                                int candidateLength) const
 {
-    QList<int> scores;
-    CandidateList candidates;
-    StringSimilarityMatcher matcher(text);
+    int common;
+    int all;
+    countCoOccurrences(m_cm, cmCandidate, &common, &all);
+    return similarityScore(common, all, qAbs(m_length - candidateLength));
+}
+
+void StringSimilarityMatcher::getSimilarityScores(const CoMatrix *cmCandidates,
+                                                  const int *candidateLengths,
+                                                  qsizetype count, int *scores) const
+{
+#if QT_COMPILER_SUPPORTS_HERE(AVX2)
+    if (qCpuHasFeature(AVX2))
+        return similarityScoresAvx2(m_cm, m_length, cmCandidates, candidateLengths, count, scores);
+#endif
+#if QT_COMPILER_SUPPORTS_HERE(SSSE3)
+    if (qCpuHasFeature(SSSE3))
+        return similarityScoresSsse3(m_cm, m_length, cmCandidates, candidateLengths, count, scores);
+#endif
+    similarityScoresScalar(m_cm, m_length, cmCandidates, candidateLengths, count, scores);
+}
 
-    for (const TranslatorMessage &mtm : tor->messages()) {
+SimilarTextIndex::Entry::Entry(const Candidate &cand, bool enabled)
+    : cm(cand.source),
+      length(cand.source.size()),
+      enabled(enabled),
+      candidate(cand)
+{
+}
+
+SimilarTextIndex::SimilarTextIndex(const Translator *tor)
+{
+    const auto &messages = tor->messages();
+    m_entries.reserve(messages.size());
+    for (const TranslatorMessage &mtm : messages) {
         if (mtm.type() == TranslatorMessage::Unfinished
             || mtm.translation().isEmpty())
             continue;
+        append(Candidate(mtm.context(), mtm.sourceText(), mtm.comment(), mtm.translation()));
+    }
+}
+
+void SimilarTextIndex::clear()
+{
+    m_entries.clear();
+    m_byLength.clear();
+    m_matrices.clear();
+    m_lengths.clear();
+    m_sorted = true;
+}
+
+qsizetype SimilarTextIndex::append(const Candidate &cand, bool enabled)
+{
+    m_entries.append(Entry(cand, enabled));
+    m_sorted = false;
+    return m_entries.size() - 1;
+}
+
+void SimilarTextIndex::setCandidate(qsizetype id, const Candidate &cand, bool enabled)
+{
+    Entry &e = m_entries[id];
+    if (e.candidate.source != cand.source) {
+        e = Entry(cand, enabled);
+        m_sorted = false;
+    } else {
+        e.candidate = cand;
+        e.enabled = enabled;
+    }
+}
+
+void SimilarTextIndex::sortByLength() const
+{
+    if (m_sorted)
+        return;
+    m_byLength.resize(m_entries.size());
+    std::iota(m_byLength.begin(), m_byLength.end(), 0);
+    std::sort(m_byLength.begin(), m_byLength.end(), [this](qsizetype a, qsizetype b) {
+        const int la = m_entries.at(a).length;
+        const int lb = m_entries.at(b).length;
+        return la < lb || (la == lb && a < b);
+    });
+    m_matrices.clear();
+    m_matrices.reserve(m_byLength.size());
+    m_lengths.clear();
+    m_lengths.reserve(m_byLength.size());
+    for (qsizetype id : std::as_const(m_byLength)) {
+        m_matrices.append(m_entries.at(id).cm);
+        m_lengths.append(m_entries.at(id).length);
+    }
+    m_sorted = true;
+}
+
+/*
+  The entries are visited in buckets of equal length, nearest to the length
+  of the searched text first. The matrices of a bucket are adjacent, so they
+  are scored with one call of the batch kernel.
+
+  The intersection of two matrices has at most as many bits set as the sparser
+  one, and their union at least as many as the denser one. Over all entries
+  at a given length distance, this bounds the score highest for an entry
+  exactly as dense as the searched text; as the bound only shrinks with the
+  distance, it tells when to stop.
+
+  Ties are resolved in favor of the entry that was added first, so the result
+  is the same as the one of a linear scan.
+*/
+CandidateList SimilarTextIndex::candidates(const QString &text, int maxCandidates) const
+{
+    CandidateList candidates;
+    if (maxCandidates <= 0 || m_entries.isEmpty())
+        return candidates;
+    sortByLength();
+
+    struct Hit
+    {
+        int score;
+        qsizetype id;
+    };
+    QList<Hit> hits; // by descending score, then ascending id
+
+    const StringSimilarityMatcher matcher(text);
+    const int w = worth(CoMatrix(text));
+    const int length = text.size();
+    QList<int> scores;
+
+    // The buckets in [lo, hi) are done
+    qsizetype hi = std::lower_bound(m_lengths.cbegin(), m_lengths.cend(), length)
+            - m_lengths.cbegin();
+    qsizetype lo = hi;
+    while (lo > 0 || hi < m_lengths.size()) {
+        qsizetype begin;
+        qsizetype end;
+        if (hi == m_lengths.size()
+            || (lo > 0 && length - m_lengths.at(lo - 1) <= m_lengths.at(hi) - length)) {
+            end = lo;
+            begin = std::lower_bound(m_lengths.cbegin(), m_lengths.cbegin() + lo,
+                                     m_lengths.at(lo - 1))
+                    - m_lengths.cbegin();
+            lo = begin;
+        } else {
+            begin = hi;
+            end = std::upper_bound(m_lengths.cbegin() + hi, m_lengths.cend(), m_lengths.at(hi))
+                    - m_lengths.cbegin();
+            hi = end;
+        }
+        const int delta = qAbs(length - m_lengths.at(begin));
+        const int bucketMinScore = hits.size() == maxCandidates ? hits.last().score
+                                                                : textSimilarityThreshold;
+        if (((w + 1) << 10) / (w + (delta << 1) + 1) < bucketMinScore)
+            break;
 
-        QString s = mtm.sourceText();
-        int score = matcher.getSimilarityScore(s);
-
-        if (candidates.size() == maxCandidates && score > scores[maxCandidates - 1] )
-            candidates.removeLast();
-
-        if (candidates.size() < maxCandidates && score >= textSimilarityThreshold) {
-            Candidate cand(mtm.context(), s, mtm.comment(), mtm.translation());
-
-            int i;
-            for (i = 0; i < candidates.size(); i++) {
-                if (score >= scores.at(i)) {
-                    if (score == scores.at(i)) {
-                        if (candidates.at(i) == cand)
-                            goto continue_outer_loop;
-                    } else {
-                        break;
-                    }
-                }
+        scores.resize(end - begin);
+        matcher.getSimilarityScores(m_matrices.constData() + begin,
+                                    m_lengths.constData() + begin, end - begin, scores.data());
+        for (qsizetype pos = begin; pos < end; ++pos) {
+            const qsizetype id = m_byLength.at(pos);
+            const Entry &e = m_entries.at(id);
+            if (!e.enabled)
+                continue;
+            const int score = scores.at(pos - begin);
+            const int minScore = hits.size() == maxCandidates ? hits.last().score
+                                                              : textSimilarityThreshold;
+            if (score < minScore)
+                continue;
+
+            // Equal candidates have equal scores; keep the one that was added first.
+            auto dup = std::find_if(hits.begin(), hits.end(), [&](const Hit &h) {
+                return h.score == score && m_entries.at(h.id).candidate == e.candidate;
+            });
+            if (dup != hits.end()) {
+                if (dup->id < id)
+                    continue;
+                hits.erase(dup);
             }
-            scores.insert(i, score);
-            candidates.insert(i, cand);
+            auto it = std::find_if(hits.begin(), hits.end(), [&](const Hit &h) {
+                return score > h.score || (score == h.score && id < h.id);
+            });
+            if (it - hits.begin() >= maxCandidates)
+                continue;
+            hits.insert(it, Hit{ score, id });
+            if (hits.size() > maxCandidates)
+                hits.removeLast();
         }
-        continue_outer_loop:
-        ;
     }
+
+    candidates.reserve(hits.size());
+    for (const Hit &h : std::as_const(hits))
+        candidates.append(m_entries.at(h.id).candidate);
     return candidates;
 }
 
+CandidateList similarTextHeuristicCandidates(const Translator *tor,
+    const QString &text, int maxCandidates)
+{
+    return SimilarTextIndex(tor).candidates(text, maxCandidates);
+}
+
 QT_END_NAMESPACE
@@ -55,12 +55,18 @@ struct CoMatrix
  * This class is more efficient for searching through a large array of candidate strings, since we only
  * have to construct the CoMatrix for the \a stringToMatch once,
  * after that we just call getSimilarityScore(strCandidate).
+ * Candidates whose CoMatrix is already known can be scored directly, one at a
+ * time or as a contiguous batch with getSimilarityScores(), which uses SIMD
+ * instructions where the CPU has them.
  * \sa getSimilarityScore
  */
 class StringSimilarityMatcher {
 public:
     StringSimilarityMatcher(const QString &stringToMatch);
     int getSimilarityScore(const QString &strCandidate);
+    int getSimilarityScore(const CoMatrix &cmCandidate, int candidateLength) const;
+    void getSimilarityScores(const CoMatrix *cmCandidates, const int *candidateLengths,
+                             qsizetype count, int *scores) const;
 
 private:
     CoMatrix m_cm;
@@ -79,6 +85,50 @@ static inline int getSimilarityScore(const QString &str1, const QString &str2)
     return StringSimilarityMatcher(str1).getSimilarityScore(str2);
 }
 
+/**
+ * Holds the co-occurrence matrices of a set of candidates, so that repeated
+ * searches for similar texts do not have to rebuild a CoMatrix for every
+ * candidate string.
+ * Entries are visited in buckets of equal length, in order of their length
+ * distance to the searched text. Each bucket is scored as one batch, and the
+ * search stops as soon as the best score still reachable
+ * drops below the threshold or below the worst of the candidates found so
+ * far.
+ * \sa similarTextHeuristicCandidates
+ */
+class SimilarTextIndex
+{
+public:
+    SimilarTextIndex() = default;
+    explicit SimilarTextIndex(const Translator *tor);
+
+    qsizetype size() const { return m_entries.size(); }
+    void clear();
+    qsizetype append(const Candidate &cand, bool enabled = true);
+    void setCandidate(qsizetype id, const Candidate &cand, bool enabled = true);
+
+    CandidateList candidates(const QString &text, int maxCandidates) const;
+
+private:
+    struct Entry
+    {
+        Entry(const Candidate &cand, bool enabled);
+
+        CoMatrix cm;
+        int length;
+        bool enabled;
+        Candidate candidate;
+    };
+
+    void sortByLength() const;
+
+    QList<Entry> m_entries;
+    mutable QList<qsizetype> m_byLength; // entry ids, ordered by length
+    mutable QList<CoMatrix> m_matrices; // their matrices and lengths, in the same order
+    mutable QList<int> m_lengths;
+    mutable bool m_sorted = true;
+};
+
 CandidateList similarTextHeuristicCandidates( const Translator *tor,
                                               const QString &text,
                                               int maxCandidates );
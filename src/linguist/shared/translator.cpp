@@ -28,8 +28,7 @@ QT_BEGIN_NAMESPACE
 using namespace Qt::Literals::StringLiterals;
 
 Translator::Translator() :
-    m_locationsType(AbsoluteLocations),
-    m_indexOk(true)
+    m_locationsType(AbsoluteLocations)
 {
 }
 
@@ -51,34 +50,164 @@ QList<Translator::FileFormat> &Translator::registeredFileFormats()
     return theFormats;
 }
 
-void Translator::addIndex(int idx, const TranslatorMessage &msg) const
+/*
+  The index maps the keys of the messages to slots instead of message
+  indexes, so inserting or removing a message only has to update the small
+  tables between slots and indexes, but not the hashes. Slots of removed
+  messages stay behind as tombstones until there are more of them than
+  messages, then the slots are renumbered.
+
+  Of several messages with the same key, the last one is found, just like
+  when the index is built from scratch. The number of messages is tracked
+  for such keys. When the last one is removed, the key becomes an orphan,
+  and the next resolveOrphans() looks for the message that takes over.
+*/
+template <typename Key, typename IndexOfSlot>
+static void addKey(QHash<Key, int> *index, QHash<Key, int> *duplicates, const Key &key,
+                   int slot, IndexOfSlot indexOfSlot)
+{
+    const auto it = index->find(key);
+    if (it == index->end()) {
+        index->insert(key, slot);
+        return;
+    }
+    int &count = (*duplicates)[key];
+    count = count ? count + 1 : 2;
+    if (indexOfSlot(*it) < indexOfSlot(slot))
+        *it = slot;
+}
+
+template <typename Key>
+static void delKey(QHash<Key, int> *index, QHash<Key, int> *duplicates, QSet<Key> *orphans,
+                   const Key &key, int slot)
 {
+    const auto it = index->find(key);
+    if (it == index->end())
+        return;
+    const auto dup = duplicates->find(key);
+    if (dup == duplicates->end()) {
+        index->erase(it);
+        orphans->remove(key);
+        return;
+    }
+    if (--*dup == 1)
+        duplicates->erase(dup);
+    if (*it == slot)
+        orphans->insert(key);
+}
 
-    m_msgIdx[TMMKey(msg)] = idx;
+void Translator::addIndex(int slot, const TranslatorMessage &msg)
+{
+    const auto indexOf = [this](int slot) { return indexOfSlot(slot); };
+    addKey(&m_msgIdx, &m_duplicateKeys, TMMKey(msg), slot, indexOf);
     if (!msg.id().isEmpty())
-        m_idMsgIdx[msg.id()] = idx;
+        addKey(&m_idMsgIdx, &m_duplicateIds, msg.id(), slot, indexOf);
+}
 
+void Translator::delIndex(int slot, const TranslatorMessage &msg)
+{
+    delKey(&m_msgIdx, &m_duplicateKeys, &m_orphanKeys, TMMKey(msg), slot);
+    if (!msg.id().isEmpty())
+        delKey(&m_idMsgIdx, &m_duplicateIds, &m_orphanIds, msg.id(), slot);
 }
 
-void Translator::delIndex(int idx) const
+void Translator::resolveOrphans()
 {
-    const TranslatorMessage &msg = m_messages.at(idx);
+    if (m_orphanKeys.isEmpty() && m_orphanIds.isEmpty())
+        return;
+    for (int i = 0; i < m_messages.size(); ++i) {
+        const TranslatorMessage &msg = m_messages.at(i);
+        if (!m_orphanKeys.isEmpty()) {
+            const TMMKey key(msg);
+            if (m_orphanKeys.contains(key))
+                m_msgIdx[key] = m_messageSlots.at(i);
+        }
+        if (!msg.id().isEmpty() && m_orphanIds.contains(msg.id()))
+            m_idMsgIdx[msg.id()] = m_messageSlots.at(i);
+    }
+    m_orphanKeys.clear();
+    m_orphanIds.clear();
+}
 
-    m_msgIdx.remove(TMMKey(msg));
-    if (!msg.id().isEmpty())
-        m_idMsgIdx.remove(msg.id());
+int Translator::indexOfSlot(int slot) const
+{
+    return slot < 0 ? -1 : m_slotMessages.at(slot);
+}
+
+void Translator::updateSlots(int from)
+{
+    for (int i = from; i < m_messageSlots.size(); ++i)
+        m_slotMessages[m_messageSlots.at(i)] = i;
+}
+
+void Translator::compactIndex()
+{
+    if (m_deadSlots <= m_messages.size())
+        return;
 
+    resolveOrphans();
+    for (auto it = m_msgIdx.begin(); it != m_msgIdx.end(); ) {
+        const int idx = indexOfSlot(*it);
+        if (idx < 0) {
+            it = m_msgIdx.erase(it);
+        } else {
+            *it = idx;
+            ++it;
+        }
+    }
+    for (auto it = m_idMsgIdx.begin(); it != m_idMsgIdx.end(); ) {
+        const int idx = indexOfSlot(*it);
+        if (idx < 0) {
+            it = m_idMsgIdx.erase(it);
+        } else {
+            *it = idx;
+            ++it;
+        }
+    }
+    m_slotMessages.resize(m_messages.size());
+    for (int i = 0; i < m_messages.size(); ++i) {
+        m_slotMessages[i] = i;
+        m_messageSlots[i] = i;
+    }
+    m_deadSlots = 0;
 }
 
-void Translator::ensureIndexed() const
+void Translator::removeMessage(int idx)
 {
-    if (!m_indexOk) {
-        m_indexOk = true;
-        m_idMsgIdx.clear();
-        m_msgIdx.clear();
-        for (int i = 0; i < m_messages.size(); i++)
-            addIndex(i, m_messages.at(i));
+    const int slot = m_messageSlots.at(idx);
+    delIndex(slot, m_messages.at(idx));
+    m_slotMessages[slot] = -1;
+    ++m_deadSlots;
+    m_messages.removeAt(idx);
+    m_messageSlots.removeAt(idx);
+    updateSlots(idx);
+    compactIndex();
+}
+
+template <typename Predicate>
+void Translator::removeMessagesIf(Predicate pred)
+{
+    int kept = 0;
+    for (int i = 0; i < m_messages.size(); ++i) {
+        const int slot = m_messageSlots.at(i);
+        if (pred(std::as_const(m_messages).at(i))) {
+            delIndex(slot, m_messages.at(i));
+            m_slotMessages[slot] = -1;
+            ++m_deadSlots;
+            continue;
+        }
+        if (kept != i) {
+            m_messages[kept] = std::move(m_messages[i]);
+            m_messageSlots[kept] = slot;
+        }
+        m_slotMessages[slot] = kept;
+        ++kept;
     }
+    m_messages.resize(kept);
+    m_messageSlots.resize(kept);
+    resolveOrphans();
+    compactIndex();
+    m_strings.prune();
 }
 
 void Translator::replaceSorted(const TranslatorMessage &msg)
@@ -87,9 +216,12 @@ void Translator::replaceSorted(const TranslatorMessage &msg)
     if (index == -1) {
         appendSorted(msg);
     } else {
-        delIndex(index);
+        const int slot = m_messageSlots.at(index);
+        delIndex(slot, m_messages.at(index));
         m_messages[index] = msg;
-        addIndex(index, msg);
+        m_messages[index].internStrings(m_strings);
+        addIndex(slot, m_messages.at(index));
+        resolveOrphans();
     }
 }
 
@@ -114,9 +246,11 @@ void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
     } else {
         TranslatorMessage &emsg = m_messages[index];
         if (emsg.sourceText().isEmpty()) {
-            delIndex(index);
+            const int slot = m_messageSlots.at(index);
+            delIndex(slot, emsg);
             emsg.setSourceText(msg.sourceText());
-            addIndex(index, msg);
+            addIndex(slot, emsg);
+            resolveOrphans();
         } else if (!msg.sourceText().isEmpty() && emsg.sourceText() != msg.sourceText()) {
             cd.appendError(QString::fromLatin1("Contradicting source strings for message with id '%1'.")
                            .arg(emsg.id()));
@@ -131,7 +265,7 @@ void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
                                 : QString::fromLatin1("message '%1'").arg(makeMsgId(msg))));
             return;
         }
-        emsg.addReferenceUniq(msg.fileName(), msg.lineNumber());
+        emsg.addReferenceUniq(m_strings.intern(msg.fileName()), msg.lineNumber());
         if (!msg.extraComment().isEmpty()) {
             QString cmt = emsg.extraComment();
             if (!cmt.isEmpty()) {
@@ -150,13 +284,13 @@ void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
 
 void Translator::insert(int idx, const TranslatorMessage &msg)
 {
-    if (m_indexOk) {
-        if (idx == m_messages.size())
-            addIndex(idx, msg);
-        else
-            m_indexOk = false;
-    }
+    const int slot = m_slotMessages.size();
     m_messages.insert(idx, msg);
+    m_messages[idx].internStrings(m_strings);
+    m_messageSlots.insert(idx, slot);
+    m_slotMessages.append(idx);
+    updateSlots(idx + 1);
+    addIndex(slot, m_messages.at(idx));
 }
 
 void Translator::append(const TranslatorMessage &msg)
@@ -223,7 +357,7 @@ void Translator::appendSorted(const TranslatorMessage &msg)
         append(msg);
 }
 
-static QString guessFormat(const QString &filename, const QString &format)
+QString Translator::guessFormat(const QString &filename, const QString &format)
 {
     if (format != "auto"_L1)
         return format;
@@ -241,7 +375,7 @@ static QString guessFormat(const QString &filename, const QString &format)
 static QString getDependencyName(const QString &filename, const QString &format)
 {
     const QString file = QFileInfo(filename).fileName();
-    const QString fmt = guessFormat(file, format);
+    const QString fmt = Translator::guessFormat(file, format);
 
     if (file.endsWith(u'.' + fmt))
         return file.chopped(fmt.size() + 1);
@@ -291,9 +425,8 @@ bool Translator::load(const QString &filename, ConversionData &cd, const QString
 }
 
 
-bool Translator::save(const QString &filename, ConversionData &cd, const QString &format) const
+static bool openOutput(QFile &file, const QString &filename, ConversionData &cd)
 {
-    QFile file;
     if (filename.isEmpty() || filename == "-"_L1) {
 #ifdef Q_OS_WIN
         // QFile is broken for text files
@@ -312,6 +445,24 @@ bool Translator::save(const QString &filename, ConversionData &cd, const QString
             return false;
         }
     }
+    return true;
+}
+
+static void warnAboutRelativeLocations(const QString &filename)
+{
+    std::cerr << "Warning: relative locations are not supported for non TS files. "
+                 "File "
+              << qPrintable(filename)
+              << " will be generated with the "
+                 "default location type."
+              << std::endl;
+}
+
+bool Translator::save(const QString &filename, ConversionData &cd, const QString &format) const
+{
+    QFile file;
+    if (!openOutput(file, filename, cd))
+        return false;
 
     QString fmt = guessFormat(filename, format);
     cd.m_targetDir = QFileInfo(filename).absoluteDir();
@@ -320,12 +471,7 @@ bool Translator::save(const QString &filename, ConversionData &cd, const QString
         if (fmt == format.extension) {
             if (format.saver) {
                 if (fmt != u"ts" && m_locationsType == RelativeLocations)
-                    std::cerr << "Warning: relative locations are not supported for non TS files. "
-                                 "File "
-                              << qPrintable(filename)
-                              << " will be generated with the "
-                                 "default location type."
-                              << std::endl;
+                    warnAboutRelativeLocations(filename);
                 return (*format.saver)(*this, file, cd);
             }
             cd.appendError(QString("Cannot save %1 files"_L1).arg(fmt));
@@ -337,6 +483,40 @@ bool Translator::save(const QString &filename, ConversionData &cd, const QString
     return false;
 }
 
+bool Translator::canSaveStreamed(const QString &filename, TranslatorMessageStream &messages,
+                                 ConversionData &cd, const QString &format) const
+{
+    const QString fmt = guessFormat(filename, format);
+    for (const FileFormat &format : std::as_const(registeredFileFormats())) {
+        if (fmt == format.extension) {
+            if (!format.streamSaver)
+                return false;
+            return !format.streamCheck || (*format.streamCheck)(messages, cd);
+        }
+    }
+    return false;
+}
+
+bool Translator::saveStreamed(const QString &filename, TranslatorMessageStream &messages,
+                              ConversionData &cd, const QString &format) const
+{
+    const QString fmt = guessFormat(filename, format);
+    for (const FileFormat &format : std::as_const(registeredFileFormats())) {
+        if (fmt == format.extension && format.streamSaver) {
+            QFile file;
+            if (!openOutput(file, filename, cd))
+                return false;
+            cd.m_targetDir = QFileInfo(filename).absoluteDir();
+            if (fmt != u"ts" && m_locationsType == RelativeLocations)
+                warnAboutRelativeLocations(filename);
+            return (*format.streamSaver)(*this, messages, file, cd);
+        }
+    }
+
+    cd.appendError(QString("Cannot stream %1 files"_L1).arg(fmt));
+    return false;
+}
+
 QString Translator::makeLanguageCode(QLocale::Language language, QLocale::Territory territory)
 {
     QString result = QLocale::languageToCode(language);
@@ -373,13 +553,12 @@ void Translator::languageAndTerritory(QStringView languageCode, QLocale::Languag
 
 int Translator::find(const TranslatorMessage &msg) const
 {
-    ensureIndexed();
     if (msg.id().isEmpty())
-        return m_msgIdx.value(TMMKey(msg), -1);
-    int i = m_idMsgIdx.value(msg.id(), -1);
+        return indexOfSlot(m_msgIdx.value(TMMKey(msg), -1));
+    int i = indexOfSlot(m_idMsgIdx.value(msg.id(), -1));
     if (i >= 0)
         return i;
-    i = m_msgIdx.value(TMMKey(msg), -1);
+    i = indexOfSlot(m_msgIdx.value(TMMKey(msg), -1));
     // If both have an id, then find only by id.
     return i >= 0 && m_messages.at(i).id().isEmpty() ? i : -1;
 }
@@ -402,34 +581,30 @@ int Translator::find(const QString &context,
     return -1;
 }
 
+bool Translator::isObsolete(const TranslatorMessage &msg)
+{
+    return msg.type() == TranslatorMessage::Obsolete || msg.type() == TranslatorMessage::Vanished;
+}
+
 void Translator::stripObsoleteMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->type() == TranslatorMessage::Obsolete || it->type() == TranslatorMessage::Vanished)
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &m) {
+        return isObsolete(m);
+    });
 }
 
 void Translator::stripFinishedMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->type() == TranslatorMessage::Finished)
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &m) {
+        return m.type() == TranslatorMessage::Finished;
+    });
 }
 
 void Translator::stripUntranslatedMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (!it->isTranslated())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &m) {
+        return !m.isTranslated();
+    });
 }
 
 bool Translator::translationsExist() const
@@ -446,63 +621,61 @@ bool Translator::unfinishedTranslationsExist() const
 
 void Translator::stripEmptyContexts()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->sourceText() == QLatin1String(ContextComment))
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &m) {
+        return m.sourceText() == QLatin1String(ContextComment);
+    });
 }
 
 void Translator::stripNonPluralForms()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (!it->isPlural())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    removeMessagesIf([](const TranslatorMessage &m) {
+        return !m.isPlural();
+    });
 }
 
 void Translator::stripIdenticalSourceTranslations()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); ) {
+    removeMessagesIf([](const TranslatorMessage &m) {
         // we need to have just one translation, and it be equal to the source
-        if (it->translations().size() == 1 && it->translation() == it->sourceText())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    }
-    m_indexOk = false;
+        return m.translations().size() == 1 && m.translation() == m.sourceText();
+    });
+}
+
+void Translator::dropTranslation(TranslatorMessage &msg)
+{
+    if (msg.type() == TranslatorMessage::Finished)
+        msg.setType(TranslatorMessage::Unfinished);
+    msg.setTranslation(QString());
 }
 
 void Translator::dropTranslations()
 {
-    for (auto &message : m_messages) {
-        if (message.type() == TranslatorMessage::Finished)
-            message.setType(TranslatorMessage::Unfinished);
-        message.setTranslation(QString());
-    }
+    for (auto &message : m_messages)
+        dropTranslation(message);
 }
 
-void Translator::dropUiLines()
+void Translator::dropUiLines(TranslatorMessage &msg)
 {
     const QString uiXt = ".ui"_L1;
     const QString juiXt = ".jui"_L1;
-    for (auto &message : m_messages) {
-        QHash<QString, int> have;
-        QList<TranslatorMessage::Reference> refs;
-        for (const auto &itref : message.allReferences()) {
-            const QString &fn = itref.fileName();
-            if (fn.endsWith(uiXt) || fn.endsWith(juiXt)) {
-                if (++have[fn] == 1)
-                    refs.append(TranslatorMessage::Reference(fn, -1));
-            } else {
-                refs.append(itref);
-            }
+    QHash<QString, int> have;
+    QList<TranslatorMessage::Reference> refs;
+    for (const auto &itref : msg.allReferences()) {
+        const QString &fn = itref.fileName();
+        if (fn.endsWith(uiXt) || fn.endsWith(juiXt)) {
+            if (++have[fn] == 1)
+                refs.append(TranslatorMessage::Reference(fn, -1));
+        } else {
+            refs.append(itref);
         }
-        message.setReferences(refs);
     }
+    msg.setReferences(refs);
+}
+
+void Translator::dropUiLines()
+{
+    for (auto &message : m_messages)
+        dropUiLines(message);
 }
 
 class TranslatorMessagePtrBase
@@ -593,7 +766,10 @@ Translator::Duplicates Translator::resolveDuplicates()
                 omsg = &m_messages[oi];
                 if (msg.id().isEmpty() || omsg->id().isEmpty()) {
                     if (!msg.id().isEmpty() && omsg->id().isEmpty()) {
+                        const int slot = m_messageSlots.at(oi);
+                        delIndex(slot, *omsg);
                         omsg->setId(msg.id());
+                        addIndex(slot, *omsg);
                         idRefs.insert(TranslatorMessageIdPtr(this, oi));
                     }
                     pDup = &dups.byContents;
@@ -611,47 +787,54 @@ Translator::Duplicates Translator::resolveDuplicates()
         (*pDup)[oi].append(msg.tsLineNumber());
         if (!omsg->isTranslated() && msg.isTranslated())
             omsg->setTranslations(msg.translations());
-        m_indexOk = false;
-        m_messages.removeAt(i);
+        removeMessage(i);
     }
+    resolveOrphans();
     return dups;
 }
 
 void Translator::reportDuplicates(const Duplicates &dupes,
                                   const QString &fileName, bool verbose)
+{
+    reportDuplicates(dupes, fileName, verbose, std::cerr);
+}
+
+void Translator::reportDuplicates(const Duplicates &dupes,
+                                  const QString &fileName, bool verbose, std::ostream &out)
 {
     if (!dupes.byId.isEmpty() || !dupes.byContents.isEmpty()) {
-        std::cerr << "Warning: dropping duplicate messages in '" << qPrintable(fileName);
+        out << "Warning: dropping duplicate messages in '" << qPrintable(fileName);
         if (!verbose) {
-            std::cerr << "'\n(try -verbose for more info).\n";
+            out << "'\n(try -verbose for more info).\n";
         } else {
-            std::cerr << "':\n";
+            out << "':\n";
             for (auto it = dupes.byId.begin(); it != dupes.byId.end(); ++it) {
                 const TranslatorMessage &msg = message(it.key());
-                std::cerr << "\n* ID: " << qPrintable(msg.id()) << std::endl;
-                reportDuplicatesLines(msg, it.value());
+                out << "\n* ID: " << qPrintable(msg.id()) << std::endl;
+                reportDuplicatesLines(msg, it.value(), out);
             }
             for (auto it = dupes.byContents.begin(); it != dupes.byContents.end(); ++it) {
                 const TranslatorMessage &msg = message(it.key());
-                std::cerr << "\n* Context: " << qPrintable(msg.context())
-                          << "\n* Source: " << qPrintable(msg.sourceText()) << std::endl;
+                out << "\n* Context: " << qPrintable(msg.context())
+                    << "\n* Source: " << qPrintable(msg.sourceText()) << std::endl;
                 if (!msg.comment().isEmpty())
-                    std::cerr << "* Comment: " << qPrintable(msg.comment()) << std::endl;
-                reportDuplicatesLines(msg, it.value());
+                    out << "* Comment: " << qPrintable(msg.comment()) << std::endl;
+                reportDuplicatesLines(msg, it.value(), out);
             }
-            std::cerr << std::endl;
+            out << std::endl;
         }
     }
 }
 
 void Translator::reportDuplicatesLines(const TranslatorMessage &msg,
-                                       const DuplicateEntries::value_type &dups) const
+                                       const DuplicateEntries::value_type &dups,
+                                       std::ostream &out) const
 {
     if (msg.tsLineNumber() >= 0) {
-        std::cerr << "* Line in .ts file: " << msg.tsLineNumber() << std::endl;
+        out << "* Line in .ts file: " << msg.tsLineNumber() << std::endl;
         for (int tsLineNumber : dups) {
             if (tsLineNumber >= 0)
-                std::cerr << "* Duplicate at line: " << tsLineNumber << std::endl;
+                out << "* Duplicate at line: " << tsLineNumber << std::endl;
         }
     }
 }
@@ -667,9 +850,10 @@ void Translator::makeFileNamesAbsolute(const QDir &originalPath)
             QFileInfo fi (fileName);
             if (fi.isRelative())
                 fileName = originalPath.absoluteFilePath(fileName);
-            msg.addReference(fileName, ref.lineNumber());
+            msg.addReference(m_strings.intern(fileName), ref.lineNumber());
         }
     }
+    m_strings.prune();
 }
 
 const QList<TranslatorMessage> &Translator::messages() const
@@ -694,18 +878,32 @@ QStringList Translator::normalizedTranslations(const TranslatorMessage &msg, int
     return translations;
 }
 
-void Translator::normalizeTranslations(ConversionData &cd)
+int Translator::numerusFormCount(const QString &languageCode)
 {
-    bool truncated = false;
     QLocale::Language l;
     QLocale::Territory c;
-    languageAndTerritory(languageCode(), &l, &c);
+    languageAndTerritory(languageCode, &l, &c);
     int numPlurals = 1;
     if (l != QLocale::C) {
         QStringList forms;
         if (getNumerusInfo(l, c, 0, &forms, 0))
             numPlurals = forms.size(); // includes singular
     }
+    return numPlurals;
+}
+
+void Translator::reportTruncatedTranslations(ConversionData &cd)
+{
+    cd.appendError(QLatin1String(
+        "Removed plural forms as the target language has less "
+        "forms.\nIf this sounds wrong, possibly the target language is "
+        "not set or recognized."));
+}
+
+void Translator::normalizeTranslations(ConversionData &cd)
+{
+    bool truncated = false;
+    const int numPlurals = numerusFormCount(languageCode());
     for (int i = 0; i < m_messages.size(); ++i) {
         const TranslatorMessage &msg = m_messages.at(i);
         QStringList tlns = msg.translations();
@@ -721,10 +919,7 @@ void Translator::normalizeTranslations(ConversionData &cd)
         }
     }
     if (truncated)
-        cd.appendError(QLatin1String(
-            "Removed plural forms as the target language has less "
-            "forms.\nIf this sounds wrong, possibly the target language is "
-            "not set or recognized."));
+        reportTruncatedTranslations(cd);
 }
 
 QString Translator::guessLanguageCodeFromFileName(const QString &filename)
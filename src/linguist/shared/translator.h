@@ -17,6 +17,8 @@
 #include <QSet>
 #include <QVector>
 
+#include <iosfwd>
+
 QT_BEGIN_NAMESPACE
 
 class QIODevice;
@@ -62,6 +64,8 @@ public:
     bool m_idBased = false;
     TranslatorSaveMode m_saveMode = SaveEverything;
     QStringList m_rootDirs;
+    int m_jobCount = 1; // lupdate specific, 0 means one thread per core
+    QString m_cacheDir; // lupdate specific
 };
 
 class TMMKey {
@@ -78,6 +82,18 @@ inline size_t qHash(const TMMKey &key)
     return qHash(key.context) ^ qHash(key.source) ^ qHash(key.comment);
 }
 
+// A sequence of messages that is visited one message at a time, possibly
+// several times, instead of being held in a Translator.
+class TranslatorMessageStream
+{
+public:
+    virtual ~TranslatorMessageStream() = default;
+    // Starts over at the first message; false if the input cannot be re-read.
+    virtual bool rewind() = 0;
+    // Fetches the next message; false after the last one or on errors.
+    virtual bool next(TranslatorMessage *msg) = 0;
+};
+
 class Translator
 {
 public:
@@ -86,6 +102,16 @@ public:
     bool load(const QString &filename, ConversionData &err, const QString &format /* = "auto" */);
     bool save(const QString &filename, ConversionData &err, const QString &format /* = "auto" */) const;
 
+    // Saves the messages of a stream without collecting them. This translator
+    // only provides the header data: languages, dependencies, extras and the
+    // locations type. canSaveStreamed() reads the stream once if the format
+    // needs to verify that the output will be the same as with save().
+    bool canSaveStreamed(const QString &filename, TranslatorMessageStream &messages,
+                         ConversionData &err, const QString &format /* = "auto" */) const;
+    bool saveStreamed(const QString &filename, TranslatorMessageStream &messages,
+                      ConversionData &err, const QString &format /* = "auto" */) const;
+    static QString guessFormat(const QString &filename, const QString &format);
+
     int find(const TranslatorMessage &msg) const;
     int find(const QString &context,
         const QString &comment, const TranslatorMessage::References &refs) const;
@@ -105,6 +131,10 @@ public:
     void stripIdenticalSourceTranslations();
     void dropTranslations();
     void dropUiLines();
+    // The rules of the functions above for a single message, for streams.
+    static bool isObsolete(const TranslatorMessage &msg);
+    static void dropTranslation(TranslatorMessage &msg);
+    static void dropUiLines(TranslatorMessage &msg);
     void makeFileNamesAbsolute(const QDir &originalPath);
     bool translationsExist() const;
     bool unfinishedTranslationsExist() const;
@@ -116,8 +146,11 @@ public:
     };
     Duplicates resolveDuplicates();
     void reportDuplicates(const Duplicates &dupes, const QString &fileName, bool verbose);
+    void reportDuplicates(const Duplicates &dupes, const QString &fileName, bool verbose,
+                          std::ostream &out);
     void reportDuplicatesLines(const TranslatorMessage &msg,
-                               const DuplicateEntries::value_type &dups) const;
+                               const DuplicateEntries::value_type &dups,
+                               std::ostream &out) const;
 
     QString languageCode() const { return m_language; }
     QString sourceLanguageCode() const { return m_sourceLanguage; }
@@ -135,6 +168,8 @@ public:
     const QList<TranslatorMessage> &messages() const;
     static QStringList normalizedTranslations(const TranslatorMessage &m, int numPlurals);
     void normalizeTranslations(ConversionData &cd);
+    static int numerusFormCount(const QString &languageCode);
+    static void reportTruncatedTranslations(ConversionData &cd);
     QStringList normalizedTranslations(const TranslatorMessage &m, ConversionData &cd, bool *ok) const;
 
     int messageCount() const { return m_messages.size(); }
@@ -161,14 +196,23 @@ public:
     // registration of file formats
     typedef bool (*SaveFunction)(const Translator &, QIODevice &out, ConversionData &data);
     typedef bool (*LoadFunction)(Translator &, QIODevice &in, ConversionData &data);
+    typedef bool (*StreamCheckFunction)(TranslatorMessageStream &messages, ConversionData &data);
+    typedef bool (*StreamSaveFunction)(const Translator &header, TranslatorMessageStream &messages,
+                                       QIODevice &out, ConversionData &data);
     struct FileFormat {
-        FileFormat() : untranslatedDescription(nullptr), loader(0), saver(0), priority(-1) {}
+        FileFormat()
+            : untranslatedDescription(nullptr), loader(0), saver(0), streamCheck(nullptr),
+              streamSaver(nullptr), priority(-1)
+        {}
         QString extension; // such as "ts", "xlf", ...
         const char *untranslatedDescription;
         // human-readable description
         QString description() const { return FMT::tr(untranslatedDescription); }
         LoadFunction loader;
         SaveFunction saver;
+        // optional; a format without streamCheck can always be streamed
+        StreamCheckFunction streamCheck;
+        StreamSaveFunction streamSaver;
         enum FileType { TranslationSource, TranslationBinary } fileType;
         int priority; // 0 = highest, -1 = invisible
     };
@@ -180,9 +224,15 @@ public:
 
 private:
     void insert(int idx, const TranslatorMessage &msg);
-    void addIndex(int idx, const TranslatorMessage &msg) const;
-    void delIndex(int idx) const;
-    void ensureIndexed() const;
+    void removeMessage(int idx);
+    template <typename Predicate>
+    void removeMessagesIf(Predicate pred);
+    void addIndex(int slot, const TranslatorMessage &msg);
+    void delIndex(int slot, const TranslatorMessage &msg);
+    void resolveOrphans();
+    int indexOfSlot(int slot) const;
+    void updateSlots(int from);
+    void compactIndex();
 
     typedef QList<TranslatorMessage> TMM;       // int stores the sequence position.
 
@@ -202,10 +252,18 @@ private:
     QString m_sourceLanguage;
     QStringList m_dependencies;
     ExtraData m_extra;
-
-    mutable bool m_indexOk;
-    mutable QHash<QString, int> m_idMsgIdx;
-    mutable QHash<TMMKey, int> m_msgIdx;
+    StringPool m_strings; // context and file names shared by the messages
+
+    // keys -> slots; see addIndex()
+    QHash<QString, int> m_idMsgIdx;
+    QHash<TMMKey, int> m_msgIdx;
+    QHash<QString, int> m_duplicateIds; // keys of several messages -> their number
+    QHash<TMMKey, int> m_duplicateKeys;
+    QSet<QString> m_orphanIds; // keys whose last message was removed
+    QSet<TMMKey> m_orphanKeys;
+    QList<int> m_messageSlots; // message index -> slot
+    QList<int> m_slotMessages; // slot -> message index, -1 if removed
+    int m_deadSlots = 0;
 };
 
 bool getNumerusInfo(QLocale::Language language, QLocale::Territory territory, QByteArray *rules,
@@ -13,6 +13,30 @@
 
 QT_BEGIN_NAMESPACE
 
+QString StringPool::intern(const QString &str)
+{
+#ifdef LINGUIST_NO_STRING_POOL
+    // Only for measuring what the pool saves
+    return str;
+#else
+    if (str.isEmpty())
+        return str;
+    const auto it = m_strings.constFind(str);
+    if (it != m_strings.cend())
+        return *it;
+    QString copy = str;
+    if (copy.capacity() > copy.size())
+        copy.squeeze();
+    m_strings.insert(copy);
+    return copy;
+#endif
+}
+
+void StringPool::prune()
+{
+    m_strings.removeIf([](const QString &str) { return str.isDetached(); });
+}
+
 TranslatorMessage::TranslatorMessage()
   : m_lineNumber(-1), m_type(Unfinished), m_plural(false)
 {
@@ -88,6 +112,14 @@ TranslatorMessage::References TranslatorMessage::allReferences() const
     return refs;
 }
 
+void TranslatorMessage::internStrings(StringPool &pool)
+{
+    m_context = pool.intern(m_context);
+    m_fileName = pool.intern(m_fileName);
+    for (Reference &ref : m_extraRefs)
+        ref.m_fileName = pool.intern(ref.m_fileName);
+}
+
 
 bool TranslatorMessage::hasExtra(const QString &key) const
 {
@@ -7,12 +7,30 @@
 #include <QString>
 #include <QStringList>
 #include <QHash>
+#include <QSet>
 
 
 QT_BEGIN_NAMESPACE
 
 enum TranslatorSaveMode { SaveEverything, SaveStripped };
 
+/*
+  Hands out one shared copy of equal strings. Context and file names are
+  repeated by thousands of messages; interned, they all refer to the same
+  data instead of holding an allocation each. prune() drops the strings
+  that only the pool refers to any more.
+*/
+class StringPool
+{
+public:
+    QString intern(const QString &str);
+    void prune();
+    void clear() { m_strings.clear(); }
+
+private:
+    QSet<QString> m_strings;
+};
+
 class TranslatorMessage
 {
 public:
@@ -20,6 +38,7 @@ public:
     typedef QHash<QString, QString> ExtraData;
     class Reference
     {
+        friend class TranslatorMessage;
         QString m_fileName;
         int m_lineNumber;
     public:
@@ -82,6 +101,8 @@ public:
     void addReferenceUniq(const QString &fileName, int lineNumber);
     References extraReferences() const { return m_extraRefs; }
     References allReferences() const;
+    // Shares the context and file names with other messages using the same pool.
+    void internStrings(StringPool &pool);
     QString userData() const { return m_userData; }
     void setUserData(const QString &userData) { m_userData = userData; }
     QString extraComment() const { return m_extraComment; }
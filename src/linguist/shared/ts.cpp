@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "translator.h"
+#include "tsreader.h"
 
 #include <QtCore/QByteArray>
 #include <QtCore/QDebug>
@@ -11,6 +12,7 @@
 #include <QtCore/QXmlStreamReader>
 
 #include <algorithm>
+#include <memory>
 
 using namespace Qt::StringLiterals;
 
@@ -32,6 +34,13 @@ public:
     // the "real thing"
     bool read(Translator &translator);
 
+    // Pulls the next message; false at the end of the file or on errors.
+    bool readMessage(TranslatorMessage *msg);
+
+    QString languageCode() const { return m_language; }
+    QString sourceLanguageCode() const { return m_sourceLanguage; }
+    void applyHeader(Translator *translator) const;
+
 private:
     bool elementStarts(const QString &str) const
     {
@@ -48,9 +57,34 @@ private:
     // needed to join <lengthvariant>s
     QString readTransContents();
 
+    void startTS();
+    void readDependencies();
+    bool readMessageBody(TranslatorMessage *msg);
+    void finishTSItem();
+
     void handleError();
 
     ConversionData &m_cd;
+
+    enum State { OutsideTS, InTS, InContext };
+    State m_state = OutsideTS;
+    QString m_context;
+
+    // per <TS> state of the location references
+    QHash<QString, int> m_currentLine;
+    QString m_currentFile;
+    bool m_maybeRelative = false;
+    bool m_maybeAbsolute = false;
+    int m_messageCount = 0;
+
+    // header data
+    bool m_sawTS = false;
+    bool m_sawDependencies = false;
+    bool m_sawTSItem = false;
+    QString m_language;
+    QString m_sourceLanguage;
+    QStringList m_dependencies;
+    Translator::ExtraData m_extras;
 };
 
 void TSReader::handleError()
@@ -158,245 +192,313 @@ QString TSReader::readTransContents()
     }
 }
 
-bool TSReader::read(Translator &translator)
+void TSReader::startTS()
+{
+    static const QString strlanguage = u"language"_s;
+    static const QString strsourcelanguage = u"sourcelanguage"_s;
+    //static const QString strversion = u"version"_s;
+
+    // <TS>
+    //qDebug() << "TS " << attributes();
+    m_currentLine.clear();
+    m_currentFile.clear();
+    m_maybeRelative = false;
+    m_maybeAbsolute = false;
+
+    QXmlStreamAttributes atts = attributes();
+    //QString version = atts.value(strversion).toString();
+    m_sawTS = true;
+    m_language = atts.value(strlanguage).toString();
+    m_sourceLanguage = atts.value(strsourcelanguage).toString();
+}
+
+void TSReader::readDependencies()
 {
     static const QString strcatalog = u"catalog"_s;
-    static const QString strcomment = u"comment"_s;
-    static const QString strcontext = u"context"_s;
-    static const QString strdependencies = u"dependencies"_s;
     static const QString strdependency = u"dependency"_s;
+
+    /*
+     * <dependencies>
+     *   <dependency catalog="qtsystems_no"/>
+     *   <dependency catalog="qtbase_no"/>
+     * </dependencies>
+     **/
+    QStringList dependencies;
+    while (!atEnd()) {
+        readNext();
+        if (isEndElement()) {
+            // </dependencies> found, finish local loop
+            break;
+        } else if (elementStarts(strdependency)) {
+            // <dependency>
+            QXmlStreamAttributes atts = attributes();
+            dependencies.append(atts.value(strcatalog).toString());
+            while (!atEnd()) {
+                readNext();
+                if (isEndElement()) {
+                    // </dependency> found, finish local loop
+                    break;
+                }
+            }
+        }
+    }
+    m_sawDependencies = true;
+    m_dependencies = dependencies;
+}
+
+// Reads up to and including </message>; false if the file ended before.
+bool TSReader::readMessageBody(TranslatorMessage *msg)
+{
+    static const QString strcomment = u"comment"_s;
     static const QString strextracomment = u"extracomment"_s;
     static const QString strfilename = u"filename"_s;
     static const QString strid = u"id"_s;
-    static const QString strlanguage = u"language"_s;
     static const QString strline = u"line"_s;
     static const QString strlocation = u"location"_s;
-    static const QString strmessage = u"message"_s;
-    static const QString strname = u"name"_s;
     static const QString strnumerus = u"numerus"_s;
     static const QString strnumerusform = u"numerusform"_s;
     static const QString strobsolete = u"obsolete"_s;
     static const QString stroldcomment = u"oldcomment"_s;
     static const QString stroldsource = u"oldsource"_s;
     static const QString strsource = u"source"_s;
-    static const QString strsourcelanguage = u"sourcelanguage"_s;
     static const QString strtranslation = u"translation"_s;
     static const QString strtranslatorcomment = u"translatorcomment"_s;
-    static const QString strTS = u"TS"_s;
     static const QString strtype = u"type"_s;
     static const QString strunfinished = u"unfinished"_s;
     static const QString struserdata = u"userdata"_s;
     static const QString strvanished = u"vanished"_s;
-    //static const QString strversion = u"version"_s;
     static const QString stryes = u"yes"_s;
 
     static const QString strextrans("extra-"_L1);
 
+    // <message>
+    TranslatorMessage::References refs;
+    QString currentMsgFile = m_currentFile;
+
+    *msg = TranslatorMessage();
+    msg->setId(attributes().value(strid).toString());
+    msg->setContext(m_context);
+    msg->setType(TranslatorMessage::Finished);
+    msg->setPlural(attributes().value(strnumerus) == stryes);
+    msg->setTsLineNumber(lineNumber());
     while (!atEnd()) {
         readNext();
-        if (isStartDocument()) {
-            // <!DOCTYPE TS>
-            //qDebug() << attributes();
-        } else if (isEndDocument()) {
-            // <!DOCTYPE TS>
-            //qDebug() << attributes();
-        } else if (isDTD()) {
-            // <!DOCTYPE TS>
-            //qDebug() << tokenString();
-        } else if (elementStarts(strTS)) {
-            // <TS>
-            //qDebug() << "TS " << attributes();
-            QHash<QString, int> currentLine;
-            QString currentFile;
-            bool maybeRelative = false, maybeAbsolute = false;
-
+        if (isEndElement()) {
+            // </message> found, finish local loop
+            msg->setReferences(refs);
+            return true;
+        } else if (isWhiteSpace()) {
+            // ignore these, just whitespace
+        } else if (elementStarts(strsource)) {
+            // <source>...</source>
+            msg->setSourceText(readContents());
+        } else if (elementStarts(stroldsource)) {
+            // <oldsource>...</oldsource>
+            msg->setOldSourceText(readContents());
+        } else if (elementStarts(stroldcomment)) {
+            // <oldcomment>...</oldcomment>
+            msg->setOldComment(readContents());
+        } else if (elementStarts(strextracomment)) {
+            // <extracomment>...</extracomment>
+            msg->setExtraComment(readContents());
+        } else if (elementStarts(strtranslatorcomment)) {
+            // <translatorcomment>...</translatorcomment>
+            msg->setTranslatorComment(readContents());
+        } else if (elementStarts(strlocation)) {
+            // <location/>
+            m_maybeAbsolute = true;
             QXmlStreamAttributes atts = attributes();
-            //QString version = atts.value(strversion).toString();
-            translator.setLanguageCode(atts.value(strlanguage).toString());
-            translator.setSourceLanguageCode(atts.value(strsourcelanguage).toString());
-            while (!atEnd()) {
-                readNext();
-                if (isEndElement()) {
-                    // </TS> found, finish local loop
-                    break;
-                } else if (isWhiteSpace()) {
-                    // ignore these, just whitespace
-                } else if (isStartElement()
-                        && name().toString().startsWith(strextrans)) {
-                    // <extra-...>
-                    QString tag = name().toString();
-                    translator.setExtra(tag.mid(6), readContents());
-                    // </extra-...>
-                } else if (elementStarts(strdependencies)) {
-                    /*
-                     * <dependencies>
-                     *   <dependency catalog="qtsystems_no"/>
-                     *   <dependency catalog="qtbase_no"/>
-                     * </dependencies>
-                     **/
-                    QStringList dependencies;
-                    while (!atEnd()) {
-                        readNext();
-                        if (isEndElement()) {
-                            // </dependencies> found, finish local loop
-                            break;
-                        } else if (elementStarts(strdependency)) {
-                            // <dependency>
-                            QXmlStreamAttributes atts = attributes();
-                            dependencies.append(atts.value(strcatalog).toString());
-                            while (!atEnd()) {
-                                readNext();
-                                if (isEndElement()) {
-                                    // </dependency> found, finish local loop
-                                    break;
-                                }
-                            }
-                        }
+            QString fileName = atts.value(strfilename).toString();
+            if (fileName.isEmpty()) {
+                fileName = currentMsgFile;
+                m_maybeRelative = true;
+            } else {
+                if (refs.isEmpty())
+                    m_currentFile = fileName;
+                currentMsgFile = fileName;
+            }
+            const QString lin = atts.value(strline).toString();
+            if (lin.isEmpty()) {
+                refs.append(TranslatorMessage::Reference(fileName, -1));
+            } else {
+                bool bOK;
+                int lineNo = lin.toInt(&bOK);
+                if (bOK) {
+                    if (lin.startsWith(u'+') || lin.startsWith(u'-')) {
+                        lineNo = (m_currentLine[fileName] += lineNo);
+                        m_maybeRelative = true;
                     }
-                    translator.setDependencies(dependencies);
-                } else if (elementStarts(strcontext)) {
-                    // <context>
-                    QString context;
-                    while (!atEnd()) {
-                        readNext();
-                        if (isEndElement()) {
-                            // </context> found, finish local loop
-                            break;
-                        } else if (isWhiteSpace()) {
-                            // ignore these, just whitespace
-                        } else if (elementStarts(strname)) {
-                            // <name>
-                            context = readElementText();
-                            // </name>
-                        } else if (elementStarts(strmessage)) {
-                            // <message>
-                            TranslatorMessage::References refs;
-                            QString currentMsgFile = currentFile;
-
-                            TranslatorMessage msg;
-                            msg.setId(attributes().value(strid).toString());
-                            msg.setContext(context);
-                            msg.setType(TranslatorMessage::Finished);
-                            msg.setPlural(attributes().value(strnumerus) == stryes);
-                            msg.setTsLineNumber(lineNumber());
-                            while (!atEnd()) {
-                                readNext();
-                                if (isEndElement()) {
-                                    // </message> found, finish local loop
-                                    msg.setReferences(refs);
-                                    translator.append(msg);
-                                    break;
-                                } else if (isWhiteSpace()) {
-                                    // ignore these, just whitespace
-                                } else if (elementStarts(strsource)) {
-                                    // <source>...</source>
-                                    msg.setSourceText(readContents());
-                                } else if (elementStarts(stroldsource)) {
-                                    // <oldsource>...</oldsource>
-                                    msg.setOldSourceText(readContents());
-                                } else if (elementStarts(stroldcomment)) {
-                                    // <oldcomment>...</oldcomment>
-                                    msg.setOldComment(readContents());
-                                } else if (elementStarts(strextracomment)) {
-                                    // <extracomment>...</extracomment>
-                                    msg.setExtraComment(readContents());
-                                } else if (elementStarts(strtranslatorcomment)) {
-                                    // <translatorcomment>...</translatorcomment>
-                                    msg.setTranslatorComment(readContents());
-                                } else if (elementStarts(strlocation)) {
-                                    // <location/>
-                                    maybeAbsolute = true;
-                                    QXmlStreamAttributes atts = attributes();
-                                    QString fileName = atts.value(strfilename).toString();
-                                    if (fileName.isEmpty()) {
-                                        fileName = currentMsgFile;
-                                        maybeRelative = true;
-                                    } else {
-                                        if (refs.isEmpty())
-                                            currentFile = fileName;
-                                        currentMsgFile = fileName;
-                                    }
-                                    const QString lin = atts.value(strline).toString();
-                                    if (lin.isEmpty()) {
-                                        refs.append(TranslatorMessage::Reference(fileName, -1));
-                                    } else {
-                                        bool bOK;
-                                        int lineNo = lin.toInt(&bOK);
-                                        if (bOK) {
-                                            if (lin.startsWith(u'+') || lin.startsWith(u'-')) {
-                                                lineNo = (currentLine[fileName] += lineNo);
-                                                maybeRelative = true;
-                                            }
-                                            refs.append(TranslatorMessage::Reference(fileName, lineNo));
-                                        }
-                                    }
-                                    readContents();
-                                } else if (elementStarts(strcomment)) {
-                                    // <comment>...</comment>
-                                    msg.setComment(readContents());
-                                } else if (elementStarts(struserdata)) {
-                                    // <userdata>...</userdata>
-                                    msg.setUserData(readContents());
-                                } else if (elementStarts(strtranslation)) {
-                                    // <translation>
-                                    QXmlStreamAttributes atts = attributes();
-                                    QStringView type = atts.value(strtype);
-                                    if (type == strunfinished)
-                                        msg.setType(TranslatorMessage::Unfinished);
-                                    else if (type == strvanished)
-                                        msg.setType(TranslatorMessage::Vanished);
-                                    else if (type == strobsolete)
-                                        msg.setType(TranslatorMessage::Obsolete);
-                                    if (msg.isPlural()) {
-                                        QStringList translations;
-                                        while (!atEnd()) {
-                                            readNext();
-                                            if (isEndElement()) {
-                                                break;
-                                            } else if (isWhiteSpace()) {
-                                                // ignore these, just whitespace
-                                            } else if (elementStarts(strnumerusform)) {
-                                                translations.append(readTransContents());
-                                            } else {
-                                                handleError();
-                                                break;
-                                            }
-                                        }
-                                        msg.setTranslations(translations);
-                                    } else {
-                                        msg.setTranslation(readTransContents());
-                                    }
-                                    // </translation>
-                                } else if (isStartElement()
-                                        && name().toString().startsWith(strextrans)) {
-                                    // <extra-...>
-                                    QString tag = name().toString();
-                                    msg.setExtra(tag.mid(6), readContents());
-                                    // </extra-...>
-                                } else {
-                                    handleError();
-                                }
-                            }
-                            // </message>
-                        } else {
-                            handleError();
-                        }
+                    refs.append(TranslatorMessage::Reference(fileName, lineNo));
+                }
+            }
+            readContents();
+        } else if (elementStarts(strcomment)) {
+            // <comment>...</comment>
+            msg->setComment(readContents());
+        } else if (elementStarts(struserdata)) {
+            // <userdata>...</userdata>
+            msg->setUserData(readContents());
+        } else if (elementStarts(strtranslation)) {
+            // <translation>
+            QXmlStreamAttributes atts = attributes();
+            QStringView type = atts.value(strtype);
+            if (type == strunfinished)
+                msg->setType(TranslatorMessage::Unfinished);
+            else if (type == strvanished)
+                msg->setType(TranslatorMessage::Vanished);
+            else if (type == strobsolete)
+                msg->setType(TranslatorMessage::Obsolete);
+            if (msg->isPlural()) {
+                QStringList translations;
+                while (!atEnd()) {
+                    readNext();
+                    if (isEndElement()) {
+                        break;
+                    } else if (isWhiteSpace()) {
+                        // ignore these, just whitespace
+                    } else if (elementStarts(strnumerusform)) {
+                        translations.append(readTransContents());
+                    } else {
+                        handleError();
+                        break;
                     }
-                    // </context>
-                } else {
-                    handleError();
                 }
-                // if the file is empty adopt AbsoluteLocation (default location type for Translator)
-                if (translator.messageCount() == 0)
-                    maybeAbsolute = true;
-                translator.setLocationsType(maybeRelative ? Translator::RelativeLocations :
-                                            maybeAbsolute ? Translator::AbsoluteLocations :
-                                                            Translator::NoLocations);
-            } // </TS>
+                msg->setTranslations(translations);
+            } else {
+                msg->setTranslation(readTransContents());
+            }
+            // </translation>
+        } else if (isStartElement()
+                && name().toString().startsWith(strextrans)) {
+            // <extra-...>
+            QString tag = name().toString();
+            msg->setExtra(tag.mid(6), readContents());
+            // </extra-...>
         } else {
             handleError();
         }
     }
+    return false;
+}
+
+// Runs after each item on the <TS> level has been read.
+void TSReader::finishTSItem()
+{
+    // if the file is empty adopt AbsoluteLocation (default location type for Translator)
+    if (m_messageCount == 0)
+        m_maybeAbsolute = true;
+    m_sawTSItem = true;
+}
+
+bool TSReader::readMessage(TranslatorMessage *msg)
+{
+    static const QString strcontext = u"context"_s;
+    static const QString strdependencies = u"dependencies"_s;
+    static const QString strmessage = u"message"_s;
+    static const QString strname = u"name"_s;
+    static const QString strTS = u"TS"_s;
+
+    static const QString strextrans("extra-"_L1);
+
+    while (!atEnd()) {
+        readNext();
+        switch (m_state) {
+        case OutsideTS:
+            if (isStartDocument()) {
+                // <!DOCTYPE TS>
+                //qDebug() << attributes();
+            } else if (isEndDocument()) {
+                // <!DOCTYPE TS>
+                //qDebug() << attributes();
+            } else if (isDTD()) {
+                // <!DOCTYPE TS>
+                //qDebug() << tokenString();
+            } else if (elementStarts(strTS)) {
+                startTS();
+                m_state = InTS;
+            } else {
+                handleError();
+            }
+            break;
+        case InTS:
+            if (isEndElement()) {
+                // </TS> found
+                m_state = OutsideTS;
+                break;
+            } else if (isWhiteSpace()) {
+                // ignore these, just whitespace
+            } else if (isStartElement()
+                    && name().toString().startsWith(strextrans)) {
+                // <extra-...>
+                QString tag = name().toString();
+                m_extras[tag.mid(6)] = readContents();
+                // </extra-...>
+            } else if (elementStarts(strdependencies)) {
+                readDependencies();
+            } else if (elementStarts(strcontext)) {
+                // <context>
+                m_context.clear();
+                m_state = InContext;
+                break;
+            } else {
+                handleError();
+            }
+            finishTSItem();
+            break;
+        case InContext:
+            if (isEndElement()) {
+                // </context> found
+                m_state = InTS;
+                finishTSItem();
+            } else if (isWhiteSpace()) {
+                // ignore these, just whitespace
+            } else if (elementStarts(strname)) {
+                // <name>
+                m_context = readElementText();
+                // </name>
+            } else if (elementStarts(strmessage)) {
+                if (readMessageBody(msg)) {
+                    ++m_messageCount;
+                    return true;
+                }
+            } else {
+                handleError();
+            }
+            break;
+        }
+    }
+    // a <context> cut short by an error still counts as an item
+    if (m_state == InContext) {
+        m_state = InTS;
+        finishTSItem();
+    }
+    return false;
+}
+
+void TSReader::applyHeader(Translator *translator) const
+{
+    if (m_sawTS) {
+        translator->setLanguageCode(m_language);
+        translator->setSourceLanguageCode(m_sourceLanguage);
+    }
+    for (auto it = m_extras.cbegin(), end = m_extras.cend(); it != end; ++it)
+        translator->setExtra(it.key(), it.value());
+    if (m_sawDependencies)
+        translator->setDependencies(m_dependencies);
+    if (m_sawTSItem) {
+        translator->setLocationsType(m_maybeRelative ? Translator::RelativeLocations :
+                                     m_maybeAbsolute ? Translator::AbsoluteLocations :
+                                                       Translator::NoLocations);
+    }
+}
+
+bool TSReader::read(Translator &translator)
+{
+    m_messageCount = translator.messageCount();
+    TranslatorMessage msg;
+    while (readMessage(&msg))
+        translator.append(msg);
+    applyHeader(&translator);
     if (hasError()) {
         m_cd.appendError(errorString());
         return false;
@@ -404,6 +506,53 @@ bool TSReader::read(Translator &translator)
     return true;
 }
 
+TSStreamReader::TSStreamReader(QIODevice &dev, ConversionData &cd)
+    : m_dev(dev), m_cd(cd), m_reader(std::make_unique<TSReader>(dev, cd))
+{
+}
+
+TSStreamReader::~TSStreamReader() = default;
+
+bool TSStreamReader::rewind()
+{
+    if (m_dev.isSequential() || !m_dev.seek(0))
+        return false;
+    m_reader = std::make_unique<TSReader>(m_dev, m_cd);
+    m_errorReported = false;
+    return true;
+}
+
+bool TSStreamReader::next(TranslatorMessage *msg)
+{
+    if (m_reader->readMessage(msg))
+        return true;
+    if (m_reader->hasError() && !m_errorReported) {
+        m_cd.appendError(m_reader->errorString());
+        m_errorReported = true;
+    }
+    return false;
+}
+
+bool TSStreamReader::hasError() const
+{
+    return m_reader->hasError();
+}
+
+QString TSStreamReader::languageCode() const
+{
+    return m_reader->languageCode();
+}
+
+QString TSStreamReader::sourceLanguageCode() const
+{
+    return m_reader->sourceLanguageCode();
+}
+
+void TSStreamReader::applyHeader(Translator *translator) const
+{
+    m_reader->applyHeader(translator);
+}
+
 static QString tsNumericEntity(int ch)
 {
     return QString(ch <= 0x20 ? QLatin1String("<byte value=\"x%1\"/>") : "&#x%1;"_L1)
@@ -481,11 +630,9 @@ static void writeVariants(QTextStream &t, const char *indent, const QString &inp
     }
 }
 
-bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
+static void writeTsHeader(QTextStream &t, const Translator &translator,
+                          const QRegularExpression &drops)
 {
-    bool result = true;
-    QTextStream t(&dev);
-
     // The xml prolog allows processors to easily detect the correct encoding
     t << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<!DOCTYPE TS>\n";
 
@@ -507,18 +654,150 @@ bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
         t << "</dependencies>\n";
     }
 
+    writeExtras(t, "    ", translator.extras(), drops);
+}
+
+static bool isTsNoise(const TranslatorMessage &msg)
+{
+    return (msg.type() == TranslatorMessage::Obsolete
+            || msg.type() == TranslatorMessage::Vanished)
+        && msg.translation().isEmpty();
+}
+
+// Tracks the previous references for writing relative locations.
+struct TsLocationState
+{
+    QHash<QString, int> currentLine;
+    QString currentFile;
+};
+
+static void writeTsMessage(QTextStream &t, const TranslatorMessage &msg,
+                           Translator::LocationsType locationsType, const ConversionData &cd,
+                           const QRegularExpression &drops, TsLocationState *state)
+{
+    //msg.dump();
+
+    t << "    <message";
+    if (!msg.id().isEmpty())
+        t << " id=\"" << tsProtect(msg.id()) << "\"";
+    if (msg.isPlural())
+        t << " numerus=\"yes\"";
+    t << ">\n";
+    if (locationsType != Translator::NoLocations) {
+        QString cfile = state->currentFile;
+        bool first = true;
+        for (const TranslatorMessage::Reference &ref : msg.allReferences()) {
+            QString fn = cd.m_targetDir.relativeFilePath(ref.fileName())
+                                 .replace(u'\\', u'/');
+            int ln = ref.lineNumber();
+            QString ld;
+            if (locationsType == Translator::RelativeLocations) {
+                if (ln != -1) {
+                    int dlt = ln - state->currentLine[fn];
+                    if (dlt >= 0)
+                        ld.append(u'+');
+                    ld.append(QString::number(dlt));
+                    state->currentLine[fn] = ln;
+                }
+
+                if (fn != cfile) {
+                    if (first)
+                        state->currentFile = fn;
+                    cfile = fn;
+                } else {
+                    fn.clear();
+                }
+                first = false;
+            } else {
+                if (ln != -1)
+                    ld = QString::number(ln);
+            }
+
+            if (!ld.isEmpty()) {
+                t << "        <location";
+                if (!fn.isEmpty())
+                    t << " filename=\"" << fn << "\"";
+                t << " line=\"" << ld << "\"";
+                t << "/>\n";
+            }
+        }
+    }
+
+    t << "        <source>"
+      << tsProtect(msg.sourceText())
+      << "</source>\n";
+
+    if (!msg.oldSourceText().isEmpty())
+        t << "        <oldsource>" << tsProtect(msg.oldSourceText()) << "</oldsource>\n";
+
+    if (!msg.comment().isEmpty()) {
+        t << "        <comment>"
+          << tsProtect(msg.comment())
+          << "</comment>\n";
+    }
+
+    if (!msg.oldComment().isEmpty())
+        t << "        <oldcomment>" << tsProtect(msg.oldComment()) << "</oldcomment>\n";
+
+    if (!msg.extraComment().isEmpty())
+        t << "        <extracomment>" << tsProtect(msg.extraComment())
+          << "</extracomment>\n";
+
+    if (!msg.translatorComment().isEmpty())
+        t << "        <translatorcomment>" << tsProtect(msg.translatorComment())
+          << "</translatorcomment>\n";
+
+    t << "        <translation";
+    if (msg.type() == TranslatorMessage::Unfinished)
+        t << " type=\"unfinished\"";
+    else if (msg.type() == TranslatorMessage::Vanished)
+        t << " type=\"vanished\"";
+    else if (msg.type() == TranslatorMessage::Obsolete)
+        t << " type=\"obsolete\"";
+    if (msg.isPlural()) {
+        t << ">";
+        const QStringList &translns = msg.translations();
+        for (int j = 0; j < translns.size(); ++j) {
+            t << "\n            <numerusform";
+            writeVariants(t, "            ", translns[j]);
+            t << "</numerusform>";
+        }
+        t << "\n        ";
+    } else {
+        writeVariants(t, "        ", msg.translation());
+    }
+    t << "</translation>\n";
+
+    writeExtras(t, "        ", msg.extras(), drops);
+
+    if (!msg.userData().isEmpty())
+        t << "        <userdata>" << msg.userData() << "</userdata>\n";
+    t << "    </message>\n";
+}
+
+static void writeTsContextStart(QTextStream &t, const QString &context)
+{
+    t << "<context>\n"
+         "    <name>"
+      << tsProtect(context)
+      << "</name>\n";
+}
+
+bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
+{
+    bool result = true;
+    QTextStream t(&dev);
+
     QRegularExpression drops(QRegularExpression::anchoredPattern(cd.dropTags().join(u'|')));
 
-    writeExtras(t, "    ", translator.extras(), drops);
+    writeTsHeader(t, translator, drops);
 
     QHash<QString, QList<TranslatorMessage> > messageOrder;
     QList<QString> contextOrder;
     for (const TranslatorMessage &msg : translator.messages()) {
         // no need for such noise
-        if ((msg.type() == TranslatorMessage::Obsolete || msg.type() == TranslatorMessage::Vanished)
-            && msg.translation().isEmpty()) {
+        if (isTsNoise(msg))
             continue;
-        }
 
         QList<TranslatorMessage> &context = messageOrder[msg.context()];
         if (context.isEmpty())
@@ -535,118 +814,76 @@ bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
             std::sort(contextMessages.begin(), contextMessages.end(), messageComparator);
     }
 
-    QHash<QString, int> currentLine;
-    QString currentFile;
+    TsLocationState locationState;
     for (const QString &context : std::as_const(contextOrder)) {
-        t << "<context>\n"
-             "    <name>"
-          << tsProtect(context)
-          << "</name>\n";
-        for (const TranslatorMessage &msg : std::as_const(messageOrder[context])) {
-            //msg.dump();
-
-                t << "    <message";
-                if (!msg.id().isEmpty())
-                    t << " id=\"" << tsProtect(msg.id()) << "\"";
-                if (msg.isPlural())
-                    t << " numerus=\"yes\"";
-                t << ">\n";
-                if (translator.locationsType() != Translator::NoLocations) {
-                    QString cfile = currentFile;
-                    bool first = true;
-                    for (const TranslatorMessage::Reference &ref : msg.allReferences()) {
-                        QString fn = cd.m_targetDir.relativeFilePath(ref.fileName())
-                                             .replace(u'\\', u'/');
-                        int ln = ref.lineNumber();
-                        QString ld;
-                        if (translator.locationsType() == Translator::RelativeLocations) {
-                            if (ln != -1) {
-                                int dlt = ln - currentLine[fn];
-                                if (dlt >= 0)
-                                    ld.append(u'+');
-                                ld.append(QString::number(dlt));
-                                currentLine[fn] = ln;
-                            }
-
-                            if (fn != cfile) {
-                                if (first)
-                                    currentFile = fn;
-                                cfile = fn;
-                            } else {
-                                fn.clear();
-                            }
-                            first = false;
-                        } else {
-                            if (ln != -1)
-                                ld = QString::number(ln);
-                        }
-
-                        if (!ld.isEmpty()) {
-                            t << "        <location";
-                            if (!fn.isEmpty())
-                                t << " filename=\"" << fn << "\"";
-                            t << " line=\"" << ld << "\"";
-                            t << "/>\n";
-                        }
-                    }
-                }
+        writeTsContextStart(t, context);
+        for (const TranslatorMessage &msg : std::as_const(messageOrder[context]))
+            writeTsMessage(t, msg, translator.locationsType(), cd, drops, &locationState);
+        t << "</context>\n";
+    }
 
-                t << "        <source>"
-                  << tsProtect(msg.sourceText())
-                  << "</source>\n";
+    t << "</TS>\n";
+    return result;
+}
 
-                if (!msg.oldSourceText().isEmpty())
-                    t << "        <oldsource>" << tsProtect(msg.oldSourceText()) << "</oldsource>\n";
+// Streaming gives the same output as saveTS() if no sorting was asked for
+// and each context comes in one piece.
+static bool canStreamTS(TranslatorMessageStream &messages, ConversionData &cd)
+{
+    if (cd.sortContexts() || cd.sortMessages() || !messages.rewind())
+        return false;
 
-                if (!msg.comment().isEmpty()) {
-                    t << "        <comment>"
-                      << tsProtect(msg.comment())
-                      << "</comment>\n";
-                }
+    QSet<QString> seenContexts;
+    QString context;
+    TranslatorMessage msg;
+    while (messages.next(&msg)) {
+        if (isTsNoise(msg))
+            continue;
+        if (!seenContexts.isEmpty() && msg.context() == context)
+            continue;
+        context = msg.context();
+        if (seenContexts.contains(context))
+            return false;
+        seenContexts.insert(context);
+    }
+    return true;
+}
 
-                    if (!msg.oldComment().isEmpty())
-                        t << "        <oldcomment>" << tsProtect(msg.oldComment()) << "</oldcomment>\n";
-
-                    if (!msg.extraComment().isEmpty())
-                        t << "        <extracomment>" << tsProtect(msg.extraComment())
-                          << "</extracomment>\n";
-
-                    if (!msg.translatorComment().isEmpty())
-                        t << "        <translatorcomment>" << tsProtect(msg.translatorComment())
-                          << "</translatorcomment>\n";
-
-                t << "        <translation";
-                if (msg.type() == TranslatorMessage::Unfinished)
-                    t << " type=\"unfinished\"";
-                else if (msg.type() == TranslatorMessage::Vanished)
-                    t << " type=\"vanished\"";
-                else if (msg.type() == TranslatorMessage::Obsolete)
-                    t << " type=\"obsolete\"";
-                if (msg.isPlural()) {
-                    t << ">";
-                    const QStringList &translns = msg.translations();
-                    for (int j = 0; j < translns.size(); ++j) {
-                        t << "\n            <numerusform";
-                        writeVariants(t, "            ", translns[j]);
-                        t << "</numerusform>";
-                    }
-                    t << "\n        ";
-                } else {
-                    writeVariants(t, "        ", msg.translation());
-                }
-                t << "</translation>\n";
+static bool saveTSStreamed(const Translator &header, TranslatorMessageStream &messages,
+                           QIODevice &dev, ConversionData &cd)
+{
+    if (!messages.rewind()) {
+        cd.appendError(u"Cannot re-read the messages"_s);
+        return false;
+    }
 
-                writeExtras(t, "        ", msg.extras(), drops);
+    QTextStream t(&dev);
+
+    QRegularExpression drops(QRegularExpression::anchoredPattern(cd.dropTags().join(u'|')));
 
-                if (!msg.userData().isEmpty())
-                    t << "        <userdata>" << msg.userData() << "</userdata>\n";
-                t << "    </message>\n";
+    writeTsHeader(t, header, drops);
+
+    TsLocationState locationState;
+    bool inContext = false;
+    QString context;
+    TranslatorMessage msg;
+    while (messages.next(&msg)) {
+        if (isTsNoise(msg))
+            continue;
+        if (!inContext || msg.context() != context) {
+            if (inContext)
+                t << "</context>\n";
+            context = msg.context();
+            writeTsContextStart(t, context);
+            inContext = true;
         }
-        t << "</context>\n";
+        writeTsMessage(t, msg, header.locationsType(), cd, drops, &locationState);
     }
+    if (inContext)
+        t << "</context>\n";
 
     t << "</TS>\n";
-    return result;
+    return true;
 }
 
 bool loadTS(Translator &translator, QIODevice &dev, ConversionData &cd)
@@ -665,6 +902,8 @@ int initTS()
     format.untranslatedDescription = QT_TRANSLATE_NOOP("FMT", "Qt translation sources");
     format.loader = &loadTS;
     format.saver = &saveTS;
+    format.streamCheck = &canStreamTS;
+    format.streamSaver = &saveTSStreamed;
     Translator::registerFileFormat(format);
 
     return 1;
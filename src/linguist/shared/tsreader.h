@@ -0,0 +1,54 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef TSREADER_H
+#define TSREADER_H
+
+#include "translator.h"
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+class TSReader;
+
+/*
+  Reads a .ts file one message at a time.
+
+  Only the state needed to resolve relative locations is kept between
+  messages, so memory use does not grow with the size of the file.
+  The language codes are known as soon as the first message was read;
+  dependencies, extras and the locations type only once next() returned
+  false. applyHeader() transfers them to a Translator the way loading the
+  file would.
+
+  Errors are appended to the ConversionData, once per pass. rewind() needs
+  a random-access device.
+*/
+class TSStreamReader : public TranslatorMessageStream
+{
+public:
+    TSStreamReader(QIODevice &dev, ConversionData &cd);
+    ~TSStreamReader() override;
+
+    bool rewind() override;
+    bool next(TranslatorMessage *msg) override;
+
+    bool hasError() const;
+    QString languageCode() const;
+    QString sourceLanguageCode() const;
+    void applyHeader(Translator *translator) const;
+
+private:
+    Q_DISABLE_COPY(TSStreamReader)
+
+    QIODevice &m_dev;
+    ConversionData &m_cd;
+    std::unique_ptr<TSReader> m_reader;
+    bool m_errorReported = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // TSREADER_H
@@ -735,6 +735,63 @@ bool loadXLIFF(Translator &translator, QIODevice &dev, ConversionData &cd)
     return hand.parse();
 }
 
+static QRegularExpression xliffDropTags(const ConversionData &cd)
+{
+    QStringList dtgs = cd.dropTags();
+    dtgs << "po-(old_)?msgid_plural"_L1;
+    return QRegularExpression(QRegularExpression::anchoredPattern(dtgs.join(u'|')));
+}
+
+static QString xliffFileName(const TranslatorMessage &msg)
+{
+    QString fn = msg.fileName();
+    if (fn.isEmpty() && msg.type() == TranslatorMessage::Obsolete)
+        fn = QLatin1String(MAGIC_OBSOLETE_REFERENCE);
+    return fn;
+}
+
+static void writeXliffStart(QTextStream &ts, const Translator &translator,
+                            const QRegularExpression &drops, int indent)
+{
+    ts.setFieldAlignment(QTextStream::AlignRight);
+    ts << "<?xml version=\"1.0\"";
+    ts << " encoding=\"utf-8\"?>\n";
+    ts << "<xliff version=\"1.2\" xmlns=\"" << XLIFF12namespaceURI
+       << "\" xmlns:trolltech=\"" << TrollTsNamespaceURI << "\">\n";
+    writeExtras(ts, indent + 1, translator.extras(), drops);
+}
+
+static void writeFileStart(QTextStream &ts, const Translator &translator, const QString &fn,
+                           const TranslatorMessage &firstMessage, int indent)
+{
+    QString sourceLanguageCode = translator.sourceLanguageCode();
+    if (sourceLanguageCode.isEmpty() || sourceLanguageCode == "C"_L1)
+        sourceLanguageCode = "en"_L1;
+    else
+        sourceLanguageCode.replace(u'_', u'-');
+    QString languageCode = translator.languageCode();
+    languageCode.replace(u'_', u'-');
+    writeIndent(ts, indent);
+    ts << "<file original=\"" << fn << "\""
+        << " datatype=\"" << dataType(firstMessage) << "\""
+        << " source-language=\"" << sourceLanguageCode.toLatin1() << "\""
+        << " target-language=\"" << languageCode.toLatin1() << "\""
+        << "><body>\n";
+}
+
+static void writeGroupStart(QTextStream &ts, const QString &ctx, int indent)
+{
+    writeIndent(ts, indent);
+    ts << "<group restype=\"" << restypeContext << "\""
+        << " resname=\"" << xlProtect(ctx) << "\">\n";
+}
+
+static void writeEnd(QTextStream &ts, const char *tag, int indent)
+{
+    writeIndent(ts, indent);
+    ts << tag << "\n";
+}
+
 bool saveXLIFF(const Translator &translator, QIODevice &dev, ConversionData &cd)
 {
     bool ok = true;
@@ -742,17 +799,13 @@ bool saveXLIFF(const Translator &translator, QIODevice &dev, ConversionData &cd)
 
     QTextStream ts(&dev);
 
-    QStringList dtgs = cd.dropTags();
-    dtgs << "po-(old_)?msgid_plural"_L1;
-    QRegularExpression drops(QRegularExpression::anchoredPattern(dtgs.join(u'|')));
+    QRegularExpression drops = xliffDropTags(cd);
 
     QHash<QString, QHash<QString, QList<TranslatorMessage> > > messageOrder;
     QHash<QString, QList<QString> > contextOrder;
     QList<QString> fileOrder;
     for (const TranslatorMessage &msg : translator.messages()) {
-        QString fn = msg.fileName();
-        if (fn.isEmpty() && msg.type() == TranslatorMessage::Obsolete)
-            fn = QLatin1String(MAGIC_OBSOLETE_REFERENCE);
+        QString fn = xliffFileName(msg);
         QHash<QString, QList<TranslatorMessage> > &file = messageOrder[fn];
         if (file.isEmpty())
             fileOrder.append(fn);
@@ -762,34 +815,15 @@ bool saveXLIFF(const Translator &translator, QIODevice &dev, ConversionData &cd)
         context.append(msg);
     }
 
-    ts.setFieldAlignment(QTextStream::AlignRight);
-    ts << "<?xml version=\"1.0\"";
-    ts << " encoding=\"utf-8\"?>\n";
-    ts << "<xliff version=\"1.2\" xmlns=\"" << XLIFF12namespaceURI
-       << "\" xmlns:trolltech=\"" << TrollTsNamespaceURI << "\">\n";
+    writeXliffStart(ts, translator, drops, indent);
     ++indent;
-    writeExtras(ts, indent, translator.extras(), drops);
-    QString sourceLanguageCode = translator.sourceLanguageCode();
-    if (sourceLanguageCode.isEmpty() || sourceLanguageCode == "C"_L1)
-        sourceLanguageCode = "en"_L1;
-    else
-        sourceLanguageCode.replace(u'_', u'-');
-    QString languageCode = translator.languageCode();
-    languageCode.replace(u'_', u'-');
     for (const QString &fn : std::as_const(fileOrder)) {
-        writeIndent(ts, indent);
-        ts << "<file original=\"" << fn << "\""
-            << " datatype=\"" << dataType(messageOrder[fn].cbegin()->first()) << "\""
-            << " source-language=\"" << sourceLanguageCode.toLatin1() << "\""
-            << " target-language=\"" << languageCode.toLatin1() << "\""
-            << "><body>\n";
+        writeFileStart(ts, translator, fn, messageOrder[fn].cbegin()->first(), indent);
         ++indent;
 
         for (const QString &ctx : std::as_const(contextOrder[fn])) {
             if (!ctx.isEmpty()) {
-                writeIndent(ts, indent);
-                ts << "<group restype=\"" << restypeContext << "\""
-                    << " resname=\"" << xlProtect(ctx) << "\">\n";
+                writeGroupStart(ts, ctx, indent);
                 ++indent;
             }
 
@@ -798,22 +832,111 @@ bool saveXLIFF(const Translator &translator, QIODevice &dev, ConversionData &cd)
 
             if (!ctx.isEmpty()) {
                 --indent;
-                writeIndent(ts, indent);
-                ts << "</group>\n";
+                writeEnd(ts, "</group>", indent);
             }
         }
 
         --indent;
-        writeIndent(ts, indent);
-        ts << "</body></file>\n";
+        writeEnd(ts, "</body></file>", indent);
     }
     --indent;
-    writeIndent(ts, indent);
-    ts << "</xliff>\n";
+    writeEnd(ts, "</xliff>", indent);
 
     return ok;
 }
 
+// Streaming gives the same output as saveXLIFF() if the messages of each
+// file, and the messages of each context within a file, come in one piece.
+static bool canStreamXLIFF(TranslatorMessageStream &messages, ConversionData &)
+{
+    if (!messages.rewind())
+        return false;
+
+    QSet<QString> seenFiles;
+    QSet<QString> seenContexts;
+    QString fn;
+    QString ctx;
+    TranslatorMessage msg;
+    while (messages.next(&msg)) {
+        const QString msgFn = xliffFileName(msg);
+        if (seenFiles.isEmpty() || msgFn != fn) {
+            if (seenFiles.contains(msgFn))
+                return false;
+            seenFiles.insert(msgFn);
+            seenContexts.clear();
+            fn = msgFn;
+        } else if (msg.context() == ctx) {
+            continue;
+        }
+        ctx = msg.context();
+        if (seenContexts.contains(ctx))
+            return false;
+        seenContexts.insert(ctx);
+    }
+    return true;
+}
+
+static bool saveXLIFFStreamed(const Translator &header, TranslatorMessageStream &messages,
+                              QIODevice &dev, ConversionData &cd)
+{
+    if (!messages.rewind()) {
+        cd.appendError(u"Cannot re-read the messages"_s);
+        return false;
+    }
+
+    int indent = 0;
+
+    QTextStream ts(&dev);
+
+    QRegularExpression drops = xliffDropTags(cd);
+
+    writeXliffStart(ts, header, drops, indent);
+    ++indent;
+
+    bool inFile = false;
+    QString fn;
+    QString ctx;
+    TranslatorMessage msg;
+    while (messages.next(&msg)) {
+        const QString msgFn = xliffFileName(msg);
+        const bool newFile = !inFile || msgFn != fn;
+        if (newFile || msg.context() != ctx) {
+            if (inFile && !ctx.isEmpty()) {
+                --indent;
+                writeEnd(ts, "</group>", indent);
+            }
+            if (newFile) {
+                if (inFile) {
+                    --indent;
+                    writeEnd(ts, "</body></file>", indent);
+                }
+                fn = msgFn;
+                writeFileStart(ts, header, fn, msg, indent);
+                ++indent;
+                inFile = true;
+            }
+            ctx = msg.context();
+            if (!ctx.isEmpty()) {
+                writeGroupStart(ts, ctx, indent);
+                ++indent;
+            }
+        }
+        writeMessage(ts, msg, drops, indent);
+    }
+    if (inFile) {
+        if (!ctx.isEmpty()) {
+            --indent;
+            writeEnd(ts, "</group>", indent);
+        }
+        --indent;
+        writeEnd(ts, "</body></file>", indent);
+    }
+    --indent;
+    writeEnd(ts, "</xliff>", indent);
+
+    return true;
+}
+
 int initXLIFF()
 {
     Translator::FileFormat format;
@@ -823,6 +946,8 @@ int initXLIFF()
     format.priority = 1;
     format.loader = &loadXLIFF;
     format.saver = &saveXLIFF;
+    format.streamCheck = &canStreamXLIFF;
+    format.streamSaver = &saveXLIFFStreamed;
     Translator::registerFileFormat(format);
     return 1;
 }
@@ -6,6 +6,7 @@
 #include "location.h"
 #include "qdocdatabase.h"
 
+#include <QtCore/qmutex.h>
 #include <QtCore/qregularexpression.h>
 
 #include <cstdio>
@@ -320,7 +321,7 @@ const Atom *Atom::next(AtomType t, const QString &s) const
 */
 QString Atom::typeString() const
 {
-    static bool deja = false;
+    static thread_local bool deja = false;
 
     if (!deja) {
         int i = 0;
@@ -390,10 +391,17 @@ LinkAtom::LinkAtom(const QString &p1, const QString &p2, Location location)
   This function resolves the parameters that were enclosed in
   square brackets. If the parameters have already been resolved,
   it does nothing and returns immediately.
+
+  Links are resolved as they are generated, possibly by several
+  threads at once, as in briefs listed on several pages.
  */
 void LinkAtom::resolveSquareBracketParams()
 {
-    if (m_resolved)
+    if (m_resolved.load(std::memory_order_acquire))
+        return;
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
+    if (m_resolved.load(std::memory_order_relaxed))
         return;
     const QStringList params = m_squareBracketParams.toLower().split(QLatin1Char(' '));
     for (const auto &param : params) {
@@ -422,7 +430,7 @@ void LinkAtom::resolveSquareBracketParams()
         }
         break;
     }
-    m_resolved = true;
+    m_resolved.store(true, std::memory_order_release);
 }
 
 /*!
@@ -431,7 +439,7 @@ void LinkAtom::resolveSquareBracketParams()
 LinkAtom::LinkAtom(const LinkAtom &t)
     : Atom(Link, t.string()),
       location(t.location),
-      m_resolved(t.m_resolved),
+      m_resolved(t.m_resolved.load()),
       m_genus(t.m_genus),
       m_domain(t.m_domain),
       m_squareBracketParams(t.m_squareBracketParams)
@@ -447,7 +455,7 @@ LinkAtom::LinkAtom(const LinkAtom &t)
 LinkAtom::LinkAtom(Atom *previous, const LinkAtom &t)
     : Atom(previous, Link, t.string()),
       location(t.location),
-      m_resolved(t.m_resolved),
+      m_resolved(t.m_resolved.load()),
       m_genus(t.m_genus),
       m_domain(t.m_domain),
       m_squareBracketParams(t.m_squareBracketParams)
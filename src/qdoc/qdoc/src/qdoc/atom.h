@@ -9,6 +9,8 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qstringlist.h>
 
+#include <atomic>
+
 QT_BEGIN_NAMESPACE
 
 class Tree;
@@ -190,7 +192,7 @@ public:
     Location location;
 
 protected:
-    bool m_resolved {};
+    std::atomic<bool> m_resolved {};
     Node::Genus m_genus {};
     Tree *m_domain {};
     QString m_squareBracketParams {};
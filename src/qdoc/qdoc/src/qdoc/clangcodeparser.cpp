@@ -17,13 +17,18 @@
 #include "sourcefileparser.h"
 #include "utilities.h"
 
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qscopedvaluerollback.h>
 #include <QtCore/qtemporarydir.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qthread.h>
 #include <QtCore/qvarlengtharray.h>
+#include <QtCore/qwaitcondition.h>
 
 #include <clang-c/Index.h>
 
@@ -42,6 +47,8 @@
 #include "template_declaration.h"
 
 #include <cstdio>
+#include <deque>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -79,6 +86,11 @@ static const auto kClangDontDisplayDiagnostics = 0;
 
 static CXTranslationUnit_Flags flags_ = static_cast<CXTranslationUnit_Flags>(0);
 
+static const auto kSourceFileFlags =
+        static_cast<CXTranslationUnit_Flags>(CXTranslationUnit_Incomplete
+                                             | CXTranslationUnit_SkipFunctionBodies
+                                             | CXTranslationUnit_KeepGoing);
+
 constexpr const char fnDummyFileName[] = "/fn_dummyfile.cpp";
 
 #ifndef QT_NO_DEBUG_STREAM
@@ -770,6 +782,7 @@ public:
                 isInterestingCache_[file] = isInteresting;
             }
             if (isInteresting) {
+                visitedHeaders_ = true;
                 return visitHeader(cur, loc);
             }
 
@@ -795,6 +808,12 @@ public:
 
     Node *nodeForCommentAtLocation(CXSourceLocation loc, CXSourceLocation nextCommentLoc);
 
+    /*!
+      Returns true if declarations in headers were visited, which
+      may have added nodes to the database.
+     */
+    bool visitedHeaders() const { return visitedHeaders_; }
+
 private:
     /*!
       SimpleLoc represents a simple location in the main source file,
@@ -819,6 +838,7 @@ private:
     Aggregate *parent_;
     std::set<QString> allHeaders_;
     QHash<CXFile, bool> isInterestingCache_; // doing a canonicalFilePath is slow, so keep a cache.
+    bool visitedHeaders_ = false;
 
     /*!
         Returns true if the symbol should be ignored for the documentation.
@@ -1484,9 +1504,37 @@ ClangCodeParser::ClangCodeParser(
 ) : m_qdb{qdb},
     m_includePaths{include_paths},
     m_defines{defines},
-    m_pch{pch}
+    m_pch{pch},
+    m_cache{config.parseCacheDir()}
 {
     m_allHeaders = config.getHeaderFiles();
+
+    if (m_cache.isEnabled()) {
+        // Whatever else the parsing of a source file depends on
+        QCryptographicHash key(QCryptographicHash::Sha1);
+        key.addData(fromCXString(clang_getClangVersion()).toUtf8());
+        if (m_pch)
+            key.addData((*m_pch).get().hash);
+        for (const auto &define : std::as_const(m_defines))
+            key.addData(define + '\0');
+        for (const auto &path : m_includePaths)
+            key.addData(path + '\0');
+        // The declarations visited in a source file depend on them
+        for (const auto &header : m_allHeaders)
+            key.addData(QString(header.path + u'/' + header.filename + QChar::Null).toUtf8());
+        QStringList macros;
+        for (const QString &macro : config.subVars(CONFIG_MACRO)) {
+            const QString macroDotName = CONFIG_MACRO + Config::dot + macro;
+            macros << macroDotName + QLatin1Char('=') + config.get(macroDotName).asString();
+            for (const QString &format : config.subVars(macroDotName)) {
+                const QString formatDotName = macroDotName + Config::dot + format;
+                macros << formatDotName + QLatin1Char('=') + config.get(formatDotName).asString();
+            }
+        }
+        macros.sort();
+        key.addData(macros.join(QChar::Null).toUtf8());
+        m_cache.setKey(key.result());
+    }
 }
 
 static const char *defaultArgs_[] = {
@@ -1574,6 +1622,40 @@ void getMoreArgs(
     }
 }
 
+/*
+  Returns the paths of the files that the translation unit \a tu
+  consists of, starting with its main file.
+ */
+static QStringList inclusionsOf(CXTranslationUnit tu)
+{
+    QStringList files;
+    clang_getInclusions(
+            tu,
+            [](CXFile file, CXSourceLocation *, unsigned int, CXClientData data) {
+                static_cast<QStringList *>(data)->append(fromCXString(clang_getFileName(file)));
+            },
+            &files);
+    return files;
+}
+
+/*
+  Returns a hash of the paths and contents of the headers that the
+  precompiled header \a tu was built from. The path of its main file
+  is left out, as it is a temporary one.
+ */
+static QByteArray hashOfHeaders(CXTranslationUnit tu)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const QStringList files = inclusionsOf(tu);
+    for (qsizetype i = 0; i < files.size(); ++i) {
+        if (i > 0)
+            hash.addData(files.at(i).toUtf8());
+        if (QFile file(files.at(i)); file.open(QIODevice::ReadOnly))
+            hash.addData(&file);
+    }
+    return hash.result();
+}
+
 /*!
   Building the PCH must be possible when there are no .cpp
   files, so it is moved here to its own member function, and
@@ -1704,7 +1786,11 @@ std::optional<PCHFile> buildPCH(
     visitor.visitChildren(cur);
     qCDebug(lcQdoc) << "PCH built and visited for" << module_header;
 
-    return std::make_optional(PCHFile{std::move(pch_directory), pch_name});
+    QByteArray hash;
+    if (!Config::instance().parseCacheDir().isEmpty())
+        hash = hashOfHeaders(tu);
+
+    return std::make_optional(PCHFile{std::move(pch_directory), pch_name, hash});
 }
 
 static float getUnpatchedVersion(QString t)
@@ -1714,36 +1800,430 @@ static float getUnpatchedVersion(QString t)
     return t.toFloat();
 }
 
+/*
+  Adds the documentation in the QDoc \a comment that spans from
+  \a loc to \a endLoc to \a result. \a findNode is called
+  to find the node that a comment without topic commands documents,
+  and \a findContext for the namespaces around a comment with topic
+  commands.
+ */
+template<typename FindNode, typename FindContext>
+static void addDocumentation(ParsedCppFileIR &result, Location loc, const Location &endLoc,
+                             QString comment, const QSet<QString> &commands,
+                             FindNode findNode, FindContext findContext)
+{
+    Doc::trimCStyleComment(loc, comment);
+
+    // Doc constructor parses the comment.
+    Doc doc(loc, endLoc, comment, commands, CppCodeParser::topic_commands);
+    if (hasTooManyTopics(doc))
+        return;
+
+    if (!doc.topicsUsed().isEmpty()) {
+        result.untied.emplace_back(UntiedDocumentation{doc, findContext()});
+        return;
+    }
+
+    if (Node *n = findNode()) {
+        result.tied.emplace_back(TiedDocumentation{doc, n});
+    } else if (CodeParser::isWorthWarningAbout(doc)) {
+        bool future = false;
+        if (doc.metaCommandsUsed().contains(COMMAND_SINCE)) {
+            QString sinceVersion = doc.metaCommandArgs(COMMAND_SINCE).at(0).first;
+            if (getUnpatchedVersion(sinceVersion) >
+                getUnpatchedVersion(Config::instance().get(CONFIG_VERSION).asString()))
+                future = true;
+        }
+        if (!future) {
+            doc.location().warning(
+                    QStringLiteral("Cannot tie this documentation to anything"),
+                    QStringLiteral("qdoc found a /*! ... */ comment, but there was no "
+                                   "topic command (e.g., '\\%1', '\\%2') in the "
+                                   "comment and no function definition following "
+                                   "the comment.")
+                            .arg(COMMAND_FN, COMMAND_PAGE));
+        }
+    }
+}
+
+static ParseCache::Position toCachePosition(const Location &location)
+{
+    return { location.filePath(), location.lineNo(), location.columnNo() };
+}
+
+static Location fromCachePosition(const ParseCache::Position &position)
+{
+    Location location(position.filePath);
+    location.setColumnNo(position.columnNo);
+    location.setLineNo(position.lineNo);
+    return location;
+}
+
+/*
+  Returns what a node must match to be taken for a node in the parse
+  cache: its type and, for a function, the types of its parameters.
+ */
+static QString cacheSignature(const Node *node)
+{
+    QString signature = QString::number(node->nodeType());
+    if (node->isFunction()) {
+        const auto *fn = static_cast<const FunctionNode *>(node);
+        for (const Parameter &parameter : fn->parameters().parameters())
+            signature += QLatin1Char(';') + parameter.type();
+        if (fn->isConst())
+            signature += QLatin1String(" const");
+    }
+    return signature;
+}
+
+/*
+  Returns how \a node is found again in the parse cache: by its path
+  from the root of the primary tree, and the state that a source file
+  leaves a function in.
+
+  \sa ClangVisitor::readParameterNamesAndAttributes()
+ */
+static ParseCache::TiedNode toCacheNode(const Node *node)
+{
+    ParseCache::TiedNode cached;
+    for (const Node *n = node; n->parent(); n = n->parent()) {
+        const qint64 index = n->parent()->childNodes().indexOf(const_cast<Node *>(n));
+        cached.path.prepend({ n->name(), index });
+    }
+    cached.signature = cacheSignature(node);
+    if (node->isFunction(Node::CPP)) {
+        const auto *fn = static_cast<const FunctionNode *>(node);
+        cached.metaness = fn->metaness();
+        cached.invokable = fn->isInvokable();
+        cached.isOverride = fn->isOverride();
+        for (const Parameter &parameter : fn->parameters().parameters()) {
+            cached.parameterNames << parameter.name();
+            cached.defaultValues << parameter.defaultValue();
+        }
+    }
+    return cached;
+}
+
+/*
+  Returns the node in \a qdb that \a cached was made from, or nullptr
+  if it is no longer there.
+ */
+static Node *fromCacheNode(QDocDatabase *qdb, const ParseCache::TiedNode &cached)
+{
+    Node *node = qdb->primaryTreeRoot();
+    for (const auto &[name, index] : cached.path) {
+        if (!node->isAggregate())
+            return nullptr;
+        const NodeList &children = static_cast<Aggregate *>(node)->childNodes();
+        if (index < 0 || index >= children.size() || children.at(index)->name() != name)
+            return nullptr;
+        node = children.at(index);
+    }
+    return cacheSignature(node) == cached.signature ? node : nullptr;
+}
+
+static void restoreCachedState(Node *node, const ParseCache::TiedNode &cached)
+{
+    if (!node->isFunction(Node::CPP))
+        return;
+
+    auto *fn = static_cast<FunctionNode *>(node);
+    fn->setMetaness(static_cast<FunctionNode::Metaness>(cached.metaness));
+    fn->setInvokable(cached.invokable);
+    fn->setOverride(cached.isOverride);
+    Parameters &parameters = fn->parameters();
+    for (int i = 0; i < parameters.count() && i < cached.parameterNames.size(); ++i) {
+        parameters[i].setName(cached.parameterNames.at(i));
+        parameters[i].setDefaultValue(cached.defaultValues.at(i));
+    }
+}
+
+/*
+  The translation units of the source files, parsed by worker threads
+  ahead of parse_cpp_file(). Each worker has its own index, and takes
+  the files in order. The workers stay at most a few files ahead of
+  the file parse_cpp_file() is processing, as every parsed translation
+  unit holds on to a lot of memory.
+ */
+struct ClangCodeParser::ParseAhead
+{
+    struct Unit
+    {
+        QString filePath;
+        std::vector<const char *> args;
+        CXTranslationUnit tu = nullptr;
+        CXErrorCode error = CXError_Success;
+        bool parsed = false;
+        bool skipped = false;
+    };
+
+    ~ParseAhead();
+    void work(CXIndex index);
+    void skipTo(size_t unit);
+
+    std::vector<Unit> units;
+    QHash<QString, size_t> unitForFile;
+    std::deque<CompilationIndex> indexes;
+    std::vector<std::unique_ptr<QThread>> threads;
+    QMutex mutex;
+    QWaitCondition unitParsed;
+    QWaitCondition unitTaken;
+    size_t nextUnit = 0;
+    size_t firstPendingUnit = 0;
+    size_t window = 0;
+    bool canceled = false;
+};
+
+ClangCodeParser::ParseAhead::~ParseAhead()
+{
+    {
+        QMutexLocker locker(&mutex);
+        canceled = true;
+        unitTaken.wakeAll();
+    }
+    for (const auto &thread : threads)
+        thread->wait();
+    // The translation units must go before the indexes they belong to.
+    for (const Unit &unit : units)
+        clang_disposeTranslationUnit(unit.tu);
+}
+
+void ClangCodeParser::ParseAhead::work(CXIndex index)
+{
+    QMutexLocker locker(&mutex);
+    while (true) {
+        while (!canceled && nextUnit < units.size() && nextUnit >= firstPendingUnit + window)
+            unitTaken.wait(&mutex);
+        if (canceled || nextUnit == units.size())
+            return;
+        Unit &unit = units[nextUnit++];
+        locker.unlock();
+
+        CXTranslationUnit tu = nullptr;
+        const CXErrorCode error =
+                clang_parseTranslationUnit2(index, unit.filePath.toLocal8Bit(), unit.args.data(),
+                                            static_cast<int>(unit.args.size()), nullptr, 0,
+                                            kSourceFileFlags, &tu);
+
+        locker.relock();
+        if (unit.skipped) {
+            clang_disposeTranslationUnit(tu);
+            tu = nullptr;
+        }
+        unit.tu = tu;
+        unit.error = error;
+        unit.parsed = true;
+        unitParsed.wakeAll();
+    }
+}
+
+/*
+  Moves the window of the workers to \a unit. The units before it are
+  not going to be taken any more, so their translation units are
+  disposed of, or not parsed at all if no worker has started on them.
+  Must be called with the mutex locked.
+ */
+void ClangCodeParser::ParseAhead::skipTo(size_t unit)
+{
+    for (size_t i = firstPendingUnit; i < unit; ++i) {
+        Unit &skipped = units[i];
+        skipped.skipped = true;
+        clang_disposeTranslationUnit(std::exchange(skipped.tu, nullptr));
+    }
+    nextUnit = qMax(nextUnit, unit);
+    firstPendingUnit = unit;
+    unitTaken.wakeAll();
+}
+
+ClangCodeParser::~ClangCodeParser() = default;
+
 /*!
-  Get ready to parse the C++ cpp file identified by \a filePath
-  and add its parsed contents to the database. \a location is
-  used for reporting errors.
+  Starts parsing the C++ files in \a filePaths with \a threadCount
+  worker threads, each with its own clang index.
+
+  parse_cpp_file() then waits for the translation unit of its file
+  instead of parsing it, and visits it in the calling thread, so the
+  documentation is added to the database in the order in which the
+  files are passed to parse_cpp_file(). That should be the order of
+  \a filePaths, for the workers to stay ahead of it. Files that the
+  parse cache has a valid entry for are not parsed.
+
+  Does nothing if \a threadCount is less than two.
+ */
+void ClangCodeParser::parseAhead(const std::vector<QString> &filePaths, int threadCount)
+{
+    m_parseAhead.reset();
+    if (threadCount < 2 || filePaths.empty())
+        return;
+
+    m_parseAhead = std::make_unique<ParseAhead>();
+    ParseAhead &ahead = *m_parseAhead;
+    ahead.units.reserve(filePaths.size());
+    for (const QString &filePath : filePaths) {
+        if (ahead.unitForFile.contains(filePath) || m_cacheEntries.contains(filePath))
+            continue;
+        if (auto entry = m_cache.load(filePath)) {
+            m_cacheEntries.insert(filePath, std::move(*entry));
+            continue;
+        }
+        ahead.unitForFile.insert(filePath, ahead.units.size());
+        ahead.units.push_back({ filePath, compilerArguments(filePath) });
+    }
+
+    threadCount = int(qMin(size_t(threadCount), ahead.units.size()));
+    ahead.window = 2 * size_t(threadCount);
+    qCDebug(lcQdoc) << "Parsing" << ahead.units.size() << "translation units with"
+                    << threadCount << "threads";
+    for (int i = 0; i < threadCount; ++i) {
+        ahead.indexes.emplace_back();
+        CXIndex index = ahead.indexes.back().index =
+                clang_createIndex(1, kClangDontDisplayDiagnostics);
+        ahead.threads.emplace_back(QThread::create([&ahead, index] { ahead.work(index); }));
+        ahead.threads.back()->start();
+    }
+}
+
+/*!
+  Takes the translation unit of \a filePath that parseAhead() handed
+  to the worker threads, waiting for it to be parsed if necessary.
+  Stores the translation unit in \a tu and the error code of parsing
+  it in \a error, and the compiler arguments it was parsed with in
+  m_args.
+
+  Returns \c false if \a filePath is not parsed ahead, or was taken
+  already.
+ */
+bool ClangCodeParser::takeParsedTranslationUnit(const QString &filePath, CXTranslationUnit *tu,
+                                                int *error)
+{
+    if (!m_parseAhead)
+        return false;
+    ParseAhead &ahead = *m_parseAhead;
+    const auto it = ahead.unitForFile.constFind(filePath);
+    if (it == ahead.unitForFile.cend())
+        return false;
+
+    const size_t i = *it;
+    QMutexLocker locker(&ahead.mutex);
+    if (i < ahead.firstPendingUnit)
+        return false;
+
+    // Taking a file out of order moves the workers' window to it.
+    ahead.skipTo(i);
+    ParseAhead::Unit &unit = ahead.units[i];
+    while (!unit.parsed)
+        ahead.unitParsed.wait(&ahead.mutex);
+
+    *tu = std::exchange(unit.tu, nullptr);
+    *error = unit.error;
+    m_args = unit.args;
+    ahead.firstPendingUnit = i + 1;
+    ahead.unitTaken.wakeAll();
+    return true;
+}
+
+/*!
+  Returns the parse cache entry of \a filePath, if there is a valid
+  one. parseAhead() may have loaded it already.
+ */
+std::optional<ParseCache::Entry> ClangCodeParser::takeCacheEntry(const QString &filePath)
+{
+    if (auto it = m_cacheEntries.find(filePath); it != m_cacheEntries.end()) {
+        ParseCache::Entry entry = std::move(*it);
+        m_cacheEntries.erase(it);
+        return entry;
+    }
+    return m_cache.load(filePath);
+}
+
+/*!
+  Returns the documentation that the parse cache \a entry holds for a
+  source file, the same as parsing the file would. Returns nothing,
+  before changing anything, if a node that the entry refers to cannot
+  be found.
+ */
+std::optional<ParsedCppFileIR> ClangCodeParser::parseCacheEntry(const ParseCache::Entry &entry)
+{
+    QList<Node *> nodes;
+    nodes.reserve(entry.comments.size());
+    for (const ParseCache::Comment &comment : entry.comments) {
+        Node *node = nullptr;
+        if (comment.node && !(node = fromCacheNode(m_qdb, *comment.node)))
+            return std::nullopt;
+        nodes << node;
+    }
+
+    ParsedCppFileIR result{};
+    const QSet<QString> &commands = CppCodeParser::topic_commands + CppCodeParser::meta_commands;
+    for (qsizetype i = 0; i < entry.comments.size(); ++i) {
+        const ParseCache::Comment &comment = entry.comments.at(i);
+        const auto findNode = [&]() {
+            if (nodes.at(i))
+                restoreCachedState(nodes.at(i), *comment.node);
+            return nodes.at(i);
+        };
+        const auto findContext = [&]() { return comment.context; };
+        addDocumentation(result, fromCachePosition(comment.start),
+                         fromCachePosition(comment.end), comment.text, commands, findNode,
+                         findContext);
+    }
+    return result;
+}
+
+/*!
+  Returns the arguments for clang to parse the C++ file identified
+  by \a filePath with.
 
   If parsing C++ header file as source, do not use the precompiled
   header as the source file itself is likely already included in the
   PCH and therefore interferes visiting the TU's children.
  */
-ParsedCppFileIR ClangCodeParser::parse_cpp_file(const QString &filePath)
+std::vector<const char *> ClangCodeParser::compilerArguments(const QString &filePath) const
 {
-    flags_ = static_cast<CXTranslationUnit_Flags>(CXTranslationUnit_Incomplete
-                                                  | CXTranslationUnit_SkipFunctionBodies
-                                                  | CXTranslationUnit_KeepGoing);
-
-    CompilationIndex index{ clang_createIndex(1, kClangDontDisplayDiagnostics) };
-
-    getDefaultArgs(m_defines, m_args);
+    std::vector<const char *> args;
+    getDefaultArgs(m_defines, args);
     if (m_pch && !filePath.endsWith(".mm")
             && !std::holds_alternative<CppHeaderSourceFile>(tag_source_file(filePath).second)) {
-        m_args.push_back("-w");
-        m_args.push_back("-include-pch");
-        m_args.push_back((*m_pch).get().name.constData());
+        args.push_back("-w");
+        args.push_back("-include-pch");
+        args.push_back((*m_pch).get().name.constData());
+    }
+    getMoreArgs(m_includePaths, m_allHeaders, args);
+    return args;
+}
+
+/*!
+  Get ready to parse the C++ cpp file identified by \a filePath
+  and add its parsed contents to the database. \a location is
+  used for reporting errors.
+
+  If the parse cache has a valid entry for the file, the file is not
+  parsed, and its documentation is taken from the entry instead.
+  Otherwise the file's translation unit is taken from the worker
+  threads if parseAhead() was called for it, and the parse cache is
+  updated.
+ */
+ParsedCppFileIR ClangCodeParser::parse_cpp_file(const QString &filePath)
+{
+    if (auto entry = takeCacheEntry(filePath)) {
+        if (auto result = parseCacheEntry(*entry))
+            return std::move(*result);
+        m_cache.discard(filePath);
     }
-    getMoreArgs(m_includePaths, m_allHeaders, m_args);
 
+    // Declared first, as the translation unit must be disposed of before its index.
+    CompilationIndex index;
     TranslationUnit tu;
-    CXErrorCode err =
-            clang_parseTranslationUnit2(index, filePath.toLocal8Bit(), m_args.data(),
-                                        static_cast<int>(m_args.size()), nullptr, 0, flags_, &tu.tu);
+    CXErrorCode err;
+    if (int error; takeParsedTranslationUnit(filePath, &tu.tu, &error)) {
+        err = static_cast<CXErrorCode>(error);
+    } else {
+        index.index = clang_createIndex(1, kClangDontDisplayDiagnostics);
+        m_args = compilerArguments(filePath);
+        err = clang_parseTranslationUnit2(index, filePath.toLocal8Bit(), m_args.data(),
+                                          static_cast<int>(m_args.size()), nullptr, 0,
+                                          kSourceFileFlags, &tu.tu);
+    }
     qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << filePath << m_args
                     << ") returns" << err;
     printDiagnostics(tu);
@@ -1759,6 +2239,7 @@ ParsedCppFileIR ClangCodeParser::parse_cpp_file(const QString &filePath)
     ClangVisitor visitor(m_qdb, m_allHeaders);
     visitor.visitChildren(tuCur);
 
+    ParseCache::Entry cacheEntry;
     CXToken *tokens;
     unsigned int numTokens = 0;
     const QSet<QString> &commands = CppCodeParser::topic_commands + CppCodeParser::meta_commands;
@@ -1774,14 +2255,10 @@ ParsedCppFileIR ClangCodeParser::parse_cpp_file(const QString &filePath)
         auto commentLoc = clang_getTokenLocation(tu, tokens[i]);
         auto loc = fromCXSourceLocation(commentLoc);
         auto end_loc = fromCXSourceLocation(clang_getRangeEnd(clang_getTokenExtent(tu, tokens[i])));
-        Doc::trimCStyleComment(loc, comment);
-
-        // Doc constructor parses the comment.
-        Doc doc(loc, end_loc, comment, commands, CppCodeParser::topic_commands);
-        if (hasTooManyTopics(doc))
-            continue;
+        ParseCache::Comment &cached = cacheEntry.comments.emplace_back(
+                ParseCache::Comment{ comment, toCachePosition(loc), toCachePosition(end_loc) });
 
-        if (doc.topicsUsed().isEmpty()) {
+        const auto findNode = [&]() -> Node * {
             Node *n = nullptr;
             if (i + 1 < numTokens) {
                 // Try to find the next declaration.
@@ -1791,41 +2268,30 @@ ParsedCppFileIR ClangCodeParser::parse_cpp_file(const QString &filePath)
                 nextCommentLoc = clang_getTokenLocation(tu, tokens[i + 1]);
                 n = visitor.nodeForCommentAtLocation(commentLoc, nextCommentLoc);
             }
-
-            if (n) {
-                parse_result.tied.emplace_back(TiedDocumentation{doc, n});
-            } else if (CodeParser::isWorthWarningAbout(doc)) {
-                bool future = false;
-                if (doc.metaCommandsUsed().contains(COMMAND_SINCE)) {
-                    QString sinceVersion = doc.metaCommandArgs(COMMAND_SINCE).at(0).first;
-                    if (getUnpatchedVersion(sinceVersion) >
-                        getUnpatchedVersion(Config::instance().get(CONFIG_VERSION).asString()))
-                        future = true;
-                }
-                if (!future) {
-                    doc.location().warning(
-                            QStringLiteral("Cannot tie this documentation to anything"),
-                            QStringLiteral("qdoc found a /*! ... */ comment, but there was no "
-                                           "topic command (e.g., '\\%1', '\\%2') in the "
-                                           "comment and no function definition following "
-                                           "the comment.")
-                                    .arg(COMMAND_FN, COMMAND_PAGE));
-                }
-            }
-        } else {
-            parse_result.untied.emplace_back(UntiedDocumentation{doc, QStringList()});
-
+            if (n)
+                cached.node = toCacheNode(n);
+            return n;
+        };
+        const auto findContext = [&]() {
             CXCursor cur = clang_getCursor(tu, commentLoc);
             while (true) {
                 CXCursorKind kind = clang_getCursorKind(cur);
                 if (clang_isTranslationUnit(kind) || clang_isInvalid(kind))
                     break;
-                if (kind == CXCursor_Namespace) {
-                    parse_result.untied.back().context << fromCXString(clang_getCursorSpelling(cur));
-                }
+                if (kind == CXCursor_Namespace)
+                    cached.context << fromCXString(clang_getCursorSpelling(cur));
                 cur = clang_getCursorLexicalParent(cur);
             }
-        }
+            return cached.context;
+        };
+        addDocumentation(parse_result, loc, end_loc, comment, commands, findNode, findContext);
+    }
+
+    // Parsing a file that declared anything itself cannot be skipped.
+    if (m_cache.isEnabled() && !visitor.visitedHeaders()) {
+        for (const QString &file : inclusionsOf(tu))
+            cacheEntry.dependencies.append({ file, m_cache.fileHash(file) });
+        m_cache.store(filePath, cacheEntry);
     }
 
     clang_disposeTokens(tu, tokens, numTokens);
@@ -5,13 +5,16 @@
 #define CLANGCODEPARSER_H
 
 #include "codeparser.h"
+#include "parsecache.h"
 #include "parsererror.h"
 #include "config.h"
 
 #include <QtCore/qtemporarydir.h>
 #include <QtCore/QStringList>
 
+#include <memory>
 #include <optional>
+#include <vector>
 
 typedef struct CXTranslationUnitImpl *CXTranslationUnit;
 
@@ -27,6 +30,7 @@ struct ParsedCppFileIR {
 struct PCHFile {
     QTemporaryDir dir;
     QByteArray name;
+    QByteArray hash; // of the headers, if a parse cache is used
 };
 
 std::optional<PCHFile> buildPCH(
@@ -76,9 +80,20 @@ public:
         std::optional<std::reference_wrapper<const PCHFile>> pch
     );
 
+    ~ClangCodeParser();
+
+    void parseAhead(const std::vector<QString> &filePaths, int threadCount);
     ParsedCppFileIR parse_cpp_file(const QString &filePath);
+    void logParseCacheStatistics() const { m_cache.logStatistics(); }
 
 private:
+    struct ParseAhead;
+
+    std::vector<const char *> compilerArguments(const QString &filePath) const;
+    bool takeParsedTranslationUnit(const QString &filePath, CXTranslationUnit *tu, int *error);
+    std::optional<ParseCache::Entry> takeCacheEntry(const QString &filePath);
+    std::optional<ParsedCppFileIR> parseCacheEntry(const ParseCache::Entry &entry);
+
     QDocDatabase* m_qdb{};
     std::set<Config::HeaderFilePath> m_allHeaders {}; // file name->path
     const std::vector<QByteArray>& m_includePaths;
@@ -87,6 +102,9 @@ private:
     QStringList m_namespaceScope {};
     QByteArray s_fn;
     std::optional<std::reference_wrapper<const PCHFile>> m_pch;
+    std::unique_ptr<ParseAhead> m_parseAhead;
+    ParseCache m_cache;
+    QHash<QString, ParseCache::Entry> m_cacheEntries; // loaded by parseAhead()
 };
 
 QT_END_NAMESPACE
@@ -6,8 +6,10 @@
 
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qtemporaryfile.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qthread.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qregularexpression.h>
 
@@ -63,6 +65,7 @@ QString ConfigStrings::OUTPUTDIR = QStringLiteral("outputdir");
 QString ConfigStrings::OUTPUTFORMATS = QStringLiteral("outputformats");
 QString ConfigStrings::OUTPUTPREFIXES = QStringLiteral("outputprefixes");
 QString ConfigStrings::OUTPUTSUFFIXES = QStringLiteral("outputsuffixes");
+QString ConfigStrings::PARSECACHE = QStringLiteral("parsecache");
 QString ConfigStrings::PRODUCTNAME QStringLiteral("productname");
 QString ConfigStrings::PROJECT = QStringLiteral("project");
 QString ConfigStrings::REDIRECTDOCUMENTATIONTODEVNULL =
@@ -80,6 +83,7 @@ QString ConfigStrings::STYLESHEETS = QStringLiteral("stylesheets");
 QString ConfigStrings::SYNTAXHIGHLIGHTING = QStringLiteral("syntaxhighlighting");
 QString ConfigStrings::TABSIZE = QStringLiteral("tabsize");
 QString ConfigStrings::TAGFILE = QStringLiteral("tagfile");
+QString ConfigStrings::THREADS = QStringLiteral("threads");
 QString ConfigStrings::TIMESTAMPS = QStringLiteral("timestamps");
 QString ConfigStrings::TOCTITLES = QStringLiteral("toctitles");
 QString ConfigStrings::TRADEMARKSPAGE = QStringLiteral("trademarkspage");
@@ -373,6 +377,7 @@ void Config::reset()
     setStringList(CONFIG_LANGUAGE, QStringList("Cpp")); // i.e. C++
     setStringList(CONFIG_OUTPUTFORMATS, QStringList("HTML"));
     setStringList(CONFIG_TABSIZE, QStringList("8"));
+    setStringList(CONFIG_THREADS, QStringList("1"));
     setStringList(CONFIG_LOCATIONINFO, QStringList("true"));
     setStringList(CONFIG_WARNABOUTMISSINGIMAGES, QStringList("true"));
     setStringList(CONFIG_WARNABOUTMISSINGPROJECTFILES, QStringList("true"));
@@ -510,6 +515,10 @@ void Config::processCommandLineOptions(const QStringList &args)
         setStringList(CONFIG_LOGPROGRESS, QStringList("true"));
     if (m_parser.isSet(m_parser.timestampsOption))
         setStringList(CONFIG_TIMESTAMPS, QStringList("true"));
+    if (m_parser.isSet(m_parser.threadsOption))
+        setStringList(CONFIG_THREADS, QStringList(m_parser.value(m_parser.threadsOption)));
+    if (m_parser.isSet(m_parser.parseCacheOption))
+        setStringList(CONFIG_PARSECACHE, QStringList(m_parser.value(m_parser.parseCacheOption)));
     if (m_parser.isSet(m_parser.useDocBookExtensions))
         setStringList(CONFIG_DOCBOOKEXTENSIONS, QStringList("true"));
 }
@@ -583,6 +592,39 @@ QSet<QString> Config::getOutputFormats() const
         return overrideOutputFormats;
 }
 
+/*!
+  Returns the number of threads to parse source files and generate
+  pages with, as set by the \c threads variable or the command-line
+  option -threads. A value of 0 or less stands for the number of
+  processor cores. By default, everything runs in the main thread
+  only, and 1 is returned.
+ */
+int Config::threadCount() const
+{
+    const int count = m_configVars.value(CONFIG_THREADS).asInt();
+    return count > 0 ? count : QThread::idealThreadCount();
+}
+
+/*!
+  Returns the absolute path of the directory to keep the parse cache
+  in, as set by the \c parsecache variable or the command-line option
+  -parsecache. A relative path is relative to the directory of the
+  configuration file that sets it. Returns an empty string if no
+  parse cache is used, which is the default.
+ */
+QString Config::parseCacheDir() const
+{
+    const auto &configVar = m_configVars.value(CONFIG_PARSECACHE);
+    if (configVar.m_values.isEmpty())
+        return QString();
+
+    const auto &value = configVar.m_values.last();
+    const QString path = value.m_value.trimmed();
+    if (path.isEmpty())
+        return QString();
+    return QDir::cleanPath(QDir(value.m_path).absoluteFilePath(path));
+}
+
 // TODO: [late-canonicalization][pod-configuration]
 // The canonicalization for paths is done at the time where they are
 // required, and done each time they are requested.
@@ -942,10 +984,16 @@ QString Config::findFile(const Location &location, const QStringList &files,
   \a userFriendlySourceFilePath. \a location is for identifying
   the file and line number where a qdoc error occurred. The
   constructed output file name is returned.
+
+  Copies are serialized, as pages generated in parallel may refer to
+  the same file.
  */
 QString Config::copyFile(const Location &location, const QString &sourceFilePath,
                          const QString &userFriendlySourceFilePath, const QString &targetDirPath)
 {
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
+
     // TODO: A copying operation should only be performed on files
     // that we assume to be available. Ensure that this is true at the
     // API boundary and bubble up the error checking and reporting to
@@ -128,6 +128,8 @@ public:
     }
     [[nodiscard]] QString getOutputDir(const QString &format = QString("HTML")) const;
     [[nodiscard]] QSet<QString> getOutputFormats() const;
+    [[nodiscard]] int threadCount() const;
+    [[nodiscard]] QString parseCacheDir() const;
     [[nodiscard]] QStringList getCanonicalPathList(const QString &var,
                                                    PathFlags flags = None) const;
     [[nodiscard]] QRegularExpression getRegExp(const QString &var) const;
@@ -290,6 +292,7 @@ struct ConfigStrings
     static QString OUTPUTFORMATS;
     static QString OUTPUTPREFIXES;
     static QString OUTPUTSUFFIXES;
+    static QString PARSECACHE;
     static QString PRODUCTNAME;
     static QString PROJECT;
     static QString REDIRECTDOCUMENTATIONTODEVNULL;
@@ -306,6 +309,7 @@ struct ConfigStrings
     static QString SYNTAXHIGHLIGHTING;
     static QString TABSIZE;
     static QString TAGFILE;
+    static QString THREADS;
     static QString TIMESTAMPS;
     static QString TOCTITLES;
     static QString TRADEMARKSPAGE;
@@ -372,6 +376,7 @@ struct ConfigStrings
 #define CONFIG_OUTPUTFORMATS ConfigStrings::OUTPUTFORMATS
 #define CONFIG_OUTPUTPREFIXES ConfigStrings::OUTPUTPREFIXES
 #define CONFIG_OUTPUTSUFFIXES ConfigStrings::OUTPUTSUFFIXES
+#define CONFIG_PARSECACHE ConfigStrings::PARSECACHE
 #define CONFIG_PRODUCTNAME ConfigStrings::PRODUCTNAME
 #define CONFIG_PROJECT ConfigStrings::PROJECT
 #define CONFIG_REDIRECTDOCUMENTATIONTODEVNULL ConfigStrings::REDIRECTDOCUMENTATIONTODEVNULL
@@ -388,6 +393,7 @@ struct ConfigStrings
 #define CONFIG_SYNTAXHIGHLIGHTING ConfigStrings::SYNTAXHIGHLIGHTING
 #define CONFIG_TABSIZE ConfigStrings::TABSIZE
 #define CONFIG_TAGFILE ConfigStrings::TAGFILE
+#define CONFIG_THREADS ConfigStrings::THREADS
 #define CONFIG_TIMESTAMPS ConfigStrings::TIMESTAMPS
 #define CONFIG_TOCTITLES ConfigStrings::TOCTITLES
 #define CONFIG_TRADEMARKSPAGE ConfigStrings::TRADEMARKSPAGE
@@ -14,6 +14,9 @@
 #include "text.h"
 #include "utilities.h"
 
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
 #include <qcryptographichash.h>
 
 QT_BEGIN_NAMESPACE
@@ -22,6 +25,13 @@ using namespace Qt::StringLiterals;
 
 DocUtilities &Doc::m_utilities = DocUtilities::instance();
 
+// The files quoted from, as split for quoting, by path. With the
+// environment variable QDOC_NO_FILE_CACHE set, each quote reads its
+// file again, which tests compare the output of the cache with.
+static QMutex s_quotedFilesMutex;
+static QHash<QString, std::shared_ptr<const Quoter::Code>> s_quotedFiles;
+static const bool s_cacheQuotedFiles = !qEnvironmentVariableIsSet("QDOC_NO_FILE_CACHE");
+
 /*!
     \typedef ArgList
     \relates Doc
@@ -362,6 +372,9 @@ void Doc::terminate()
 {
     m_utilities.cmdHash.clear();
     m_utilities.macroHash.clear();
+
+    QMutexLocker locker(&s_quotedFilesMutex);
+    s_quotedFiles.clear();
 }
 
 /*!
@@ -411,16 +424,41 @@ void Doc::quoteFromFile(const Location &location, Quoter &quoter, ResolvedFile r
     // spread resposability should be removed, together with quoteFromFile.
     quoter.reset();
 
-    QString code;
-    {
-        QFile input_file{resolved_file.get_path()};
-        if (!input_file.open(QFile::ReadOnly))
-            return;
-        code = DocParser::untabifyEtc(QTextStream{&input_file}.readAll());
+    const QString &path = resolved_file.get_path();
+    std::shared_ptr<const Quoter::Code> code;
+    if (s_cacheQuotedFiles) {
+        QMutexLocker locker(&s_quotedFilesMutex);
+        code = s_quotedFiles.value(path);
+    }
+
+    if (!code) {
+        QString plainCode;
+        {
+            QFile input_file{path};
+            if (!input_file.open(QFile::ReadOnly))
+                return;
+            plainCode = DocParser::untabifyEtc(QTextStream{&input_file}.readAll());
+        }
+
+        // Marking up the code may warn about it at the location of this
+        // quote. Such code is marked up again for every quote, to warn
+        // at the location of each.
+        Location::MessageLog messages;
+        Location::MessageLog *log = Location::messageLog();
+        Location::setMessageLog(&messages);
+        CodeMarker *marker = CodeMarker::markerForFileName(path);
+        const QString markedCode = marker->markedUpCode(plainCode, nullptr, location);
+        Location::setMessageLog(log);
+        Location::emitMessages(messages);
+
+        code = Quoter::splitCode(path, plainCode, markedCode);
+        if (s_cacheQuotedFiles && messages.isEmpty()) {
+            QMutexLocker locker(&s_quotedFilesMutex);
+            s_quotedFiles.insert(path, code);
+        }
     }
 
-    CodeMarker *marker = CodeMarker::markerForFileName(resolved_file.get_path());
-    quoter.quoteFromFile(resolved_file.get_path(), code, marker->markedUpCode(code, nullptr, location));
+    quoter.quoteFromFile(path, std::move(code));
 }
 
 QT_END_NAMESPACE
@@ -11,12 +11,16 @@
 #include "tokenizer.h"
 
 #include <QtCore/qfile.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qregularexpression.h>
 #include <QtCore/qtextstream.h>
 
+#include <algorithm>
 #include <cctype>
 #include <climits>
 #include <functional>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -24,6 +28,24 @@ using namespace Qt::StringLiterals;
 
 DocUtilities &DocParser::s_utilities = DocUtilities::instance();
 
+namespace {
+
+// A file included with \include, split into lines, with the lines
+// that look like the markers of its snippets
+struct IncludedFile
+{
+    QString content;
+    QStringList lines;
+    QList<qsizetype> markerLines;
+};
+
+} // namespace
+
+// Not used with QDOC_NO_FILE_CACHE set, like the cache of quoted files
+static QMutex s_includedFilesMutex;
+static QHash<QString, std::shared_ptr<const IncludedFile>> s_includedFiles;
+static const bool s_cacheIncludedFiles = !qEnvironmentVariableIsSet("QDOC_NO_FILE_CACHE");
+
 enum {
     CMD_A,
     CMD_ANNOTATEDLIST,
@@ -269,6 +291,9 @@ void DocParser::initialize(const Config &config, FileResolver &file_resolver)
     // KLUDGE: file_resolver is temporarily a pointer. See the
     // comment for file_resolver in the header file for more context.
     DocParser::file_resolver = &file_resolver;
+
+    QMutexLocker locker(&s_includedFilesMutex);
+    s_includedFiles.clear();
 }
 
 /*!
@@ -1400,6 +1425,38 @@ void DocParser::insertKeyword(const QString &keyword)
     m_private->extra->m_keywords.append(m_private->m_text.lastAtom());
 }
 
+/*
+  Returns the file \a filePath, read the first time it is included,
+  or \nullptr if it cannot be read.
+*/
+static std::shared_ptr<const IncludedFile> includedFile(const QString &filePath)
+{
+    if (s_cacheIncludedFiles) {
+        QMutexLocker locker(&s_includedFilesMutex);
+        if (auto file = s_includedFiles.value(filePath))
+            return file;
+    }
+
+    QFile inFile(filePath);
+    if (!inFile.open(QFile::ReadOnly))
+        return nullptr;
+
+    auto file = std::make_shared<IncludedFile>();
+    QTextStream inStream(&inFile);
+    file->content = inStream.readAll();
+    file->lines = file->content.split(QLatin1Char('\n'));
+    for (qsizetype i = 0; i < file->lines.size(); ++i) {
+        if (QStringView{file->lines[i]}.trimmed().startsWith(QLatin1String("//!")))
+            file->markerLines << i;
+    }
+
+    if (s_cacheIncludedFiles) {
+        QMutexLocker locker(&s_includedFilesMutex);
+        s_includedFiles.insert(filePath, file);
+    }
+    return file;
+}
+
 void DocParser::include(const QString &fileName, const QString &identifier, const QStringList &parameters)
 {
     if (location().depth() > 16)
@@ -1408,49 +1465,38 @@ void DocParser::include(const QString &fileName, const QString &identifier, cons
     if (filePath.isEmpty()) {
         location().warning(QStringLiteral("Cannot find qdoc include file '%1'").arg(fileName));
     } else {
-        QFile inFile(filePath);
-        if (!inFile.open(QFile::ReadOnly)) {
+        const std::shared_ptr<const IncludedFile> file = includedFile(filePath);
+        if (!file) {
             location().warning(
                     QStringLiteral("Cannot open qdoc include file '%1'").arg(filePath));
         } else {
             location().push(fileName);
-            QTextStream inStream(&inFile);
-            QString includedContent = inStream.readAll();
-            inFile.close();
 
             if (identifier.isEmpty()) {
+                QString includedContent = file->content;
                 expandArgumentsInString(includedContent, parameters);
                 m_input.insert(m_position, includedContent);
                 m_inputLength = m_input.size();
                 m_openedInputs.push(m_position + includedContent.size());
             } else {
-                QStringList lineBuffer = includedContent.split(QLatin1Char('\n'));
-                qsizetype bufLen{lineBuffer.size()};
-                qsizetype i;
-                QStringView trimmedLine;
-                for (i = 0; i < bufLen; ++i) {
-                    trimmedLine = QStringView{lineBuffer[i]}.trimmed();
-                    if (trimmedLine.startsWith(QLatin1String("//!")) &&
-                        trimmedLine.contains(identifier))
-                        break;
-                }
-                if (i < bufLen - 1) {
-                    ++i;
-                } else {
+                const QStringList &lineBuffer = file->lines;
+                const qsizetype bufLen{lineBuffer.size()};
+                const auto isMarkerFor = [&](qsizetype i) {
+                    return QStringView{lineBuffer[i]}.trimmed().contains(identifier);
+                };
+                const auto first = std::find_if(file->markerLines.cbegin(),
+                                                file->markerLines.cend(), isMarkerFor);
+                if (first == file->markerLines.cend() || *first == bufLen - 1) {
                     location().warning(
                             QStringLiteral("Cannot find '%1' in '%2'").arg(identifier, filePath));
                     return;
                 }
+                const auto last = std::find_if(first + 1, file->markerLines.cend(), isMarkerFor);
+                const qsizetype end = (last == file->markerLines.cend()) ? bufLen : *last;
+
                 QString result;
-                do {
-                    trimmedLine = QStringView{lineBuffer[i]}.trimmed();
-                    if (trimmedLine.startsWith(QLatin1String("//!")) &&
-                        trimmedLine.contains(identifier))
-                        break;
-                    else
-                        result += lineBuffer[i] + QLatin1Char('\n');
-                    ++i;
-                } while (i < bufLen);
+                for (qsizetype i = *first + 1; i < end; ++i)
+                    result += lineBuffer[i] + QLatin1Char('\n');
 
                 expandArgumentsInString(result, parameters);
                 if (result.isEmpty()) {
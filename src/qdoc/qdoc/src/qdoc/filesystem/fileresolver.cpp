@@ -4,8 +4,10 @@
 #include "fileresolver.h"
 
 #include "qdoc/boundaries/filesystem/filepath.h"
+#include "qdoc/utilities.h"
 
 #include <QDir>
+#include <QMutexLocker>
 
 #include <iostream>
 #include <algorithm>
@@ -27,6 +29,12 @@
  * A file is considered to be resolved if, from any root directory,
  * the query represents an existing file.
  *
+ * Rather than asking the filesystem about the query in each root
+ * directory, the search looks the components of the query up in the
+ * listings of the directories on the way to the file. Each directory
+ * is listed once, the first time a query reaches it, so files that
+ * are created in a directory after that are not found.
+ *
  * For example, consider the following directory structure on some
  * filesystem:
  *
@@ -116,6 +124,22 @@ FileResolver::FileResolver(std::vector<DirectoryPath>&& search_directories)
     );
 }
 
+/*!
+ * Destroys the instance, logging how many of the queries it was
+ * asked to resolve could be resolved.
+ */
+FileResolver::~FileResolver()
+{
+    const qsizetype resolved{resolved_queries}, unresolved{unresolved_queries};
+    if (resolved + unresolved == 0)
+        return;
+
+    qCDebug(lcQdoc, "File resolver: %lld queries resolved, %lld unresolved "
+                    "(%.1f%% hit ratio), %lld directories listed",
+            qlonglong(resolved), qlonglong(unresolved),
+            100.0 * resolved / (resolved + unresolved), qlonglong(listings.size()));
+}
+
 // REMARK: Note that we do not treat absolute path specially.
 // This will in general mean that they cannot get resolved (albeit
 // there is a peculiar instance in which they can considering that
@@ -144,14 +168,66 @@ FileResolver::FileResolver(std::vector<DirectoryPath>&& search_directories)
 * query and the path that the \a query was resolved to.
 */
 [[nodiscard]] std::optional<ResolvedFile> FileResolver::resolve(QString query) const {
+    // Queries with components that are not names of entries, such as
+    // "." or "..", are left to the filesystem to make sense of.
+    const QStringList components{QDir::fromNativeSeparators(query).split(u'/')};
+    const bool is_plain{std::none_of(components.cbegin(), components.cend(), [](const QString& component) {
+        return component.isEmpty() || component == u"." || component == u"..";
+    })};
+
     for (auto& directory_path : search_directories) {
+        if (is_plain && !is_listed(directory_path.value(), components)) continue;
+
         auto maybe_filepath = FilePath::refine(QDir(directory_path.value() + "/" + query).path());
-        if (maybe_filepath) return ResolvedFile{std::move(query), std::move(*maybe_filepath)};
+        if (maybe_filepath) {
+            ++resolved_queries;
+            return ResolvedFile{std::move(query), std::move(*maybe_filepath)};
+        }
     }
 
+    ++unresolved_queries;
+    qCDebug(lcQdoc, "File resolver: no file matches %ls", qUtf16Printable(query));
     return std::nullopt;
 }
 
+// Returns the key that the name of an entry is listed under, which
+// ignores the case of the name where the filesystem usually does.
+static QString listing_key(const QString& name) {
+#if defined(Q_OS_WIN) || defined(Q_OS_DARWIN)
+    return name.toCaseFolded();
+#else
+    return name;
+#endif
+}
+
+/*!
+ * Returns true if the path that \a components make up, relative to
+ * \a directory, is listed in the directories along the way.
+ *
+ * Directories that were not needed yet are listed now.
+ */
+bool FileResolver::is_listed(const QString& directory, const QStringList& components) const {
+    QMutexLocker locker(&listings_mutex);
+
+    QString path{directory};
+    for (const QString& component : components) {
+        auto listing = listings.constFind(path);
+        if (listing == listings.cend()) {
+            QSet<QString> names;
+            const QStringList entries{QDir(path).entryList(QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot)};
+            for (const QString& entry : entries)
+                names.insert(listing_key(entry));
+            listing = listings.insert(path, std::move(names));
+        }
+
+        if (!listing->contains(listing_key(component))) return false;
+        path += QLatin1Char('/');
+        path += component;
+    }
+
+    return true;
+}
+
 /*!
  * \fn FileResolver::get_search_directories() const
  *
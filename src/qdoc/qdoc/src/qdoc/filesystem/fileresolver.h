@@ -6,19 +6,34 @@
 #include "qdoc/boundaries/filesystem/directorypath.h"
 #include "qdoc/boundaries/filesystem/resolvedfile.h"
 
+#include <atomic>
 #include <optional>
 #include <vector>
 
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
 
 class FileResolver {
 public:
     FileResolver(std::vector<DirectoryPath>&& search_directories);
+    ~FileResolver();
 
     [[nodiscard]] std::optional<ResolvedFile> resolve(QString filename) const;
 
     [[nodiscard]] const std::vector<DirectoryPath>& get_search_directories() const { return search_directories; }
 
 private:
+    [[nodiscard]] bool is_listed(const QString& directory, const QStringList& components) const;
+
     std::vector<DirectoryPath> search_directories;
+
+    // The names of the entries of the directories that were looked
+    // into, each listed the first time it is needed.
+    mutable QMutex listings_mutex;
+    mutable QHash<QString, QSet<QString>> listings;
+    mutable std::atomic<qsizetype> resolved_queries{0};
+    mutable std::atomic<qsizetype> unresolved_queries{0};
 };
@@ -29,13 +29,18 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qregularexpression.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qwaitcondition.h>
 
 #ifndef QT_BOOTSTRAPPED
 #    include "QtCore/qurl.h"
 #endif
 
+#include <atomic>
 #include <string>
+#include <vector>
 
 using namespace std::literals::string_literals;
 
@@ -43,14 +48,14 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
-Generator *Generator::s_currentGenerator;
+thread_local Generator *Generator::s_currentGenerator;
 QMap<QString, QMap<QString, QString>> Generator::s_fmtLeftMaps;
 QMap<QString, QMap<QString, QString>> Generator::s_fmtRightMaps;
 QList<Generator *> Generator::s_generators;
 QString Generator::s_outDir;
 QString Generator::s_outSubdir;
 QStringList Generator::s_outFileNames;
-QSet<QString> Generator::s_trademarks;
+thread_local QSet<QString> Generator::s_trademarks;
 QSet<QString> Generator::s_outputFormats;
 QHash<QString, QString> Generator::s_outputPrefixes;
 QHash<QString, QString> Generator::s_outputSuffixes;
@@ -59,7 +64,7 @@ bool Generator::s_noLinkErrors = false;
 bool Generator::s_autolinkErrors = false;
 bool Generator::s_redirectDocumentationToDevNull = false;
 bool Generator::s_useOutputSubdirs = true;
-QmlTypeNode *Generator::s_qmlTypeContext = nullptr;
+thread_local QmlTypeNode *Generator::s_qmlTypeContext = nullptr;
 
 static QRegularExpression tag("</?@[^>]*>");
 static QLatin1String amp("&amp;");
@@ -206,8 +211,7 @@ QFile *Generator::openSubPageFile(const PageNode *node, const QString &fileName)
 
     QString path = outputDir() + QLatin1Char('/') + fileName;
 
-    auto outPath = s_redirectDocumentationToDevNull ? QStringLiteral("/dev/null") : path;
-    auto outFile = new QFile(outPath);
+    auto outFile = new QFile(outputFilePath(fileName));
 
     if (!s_redirectDocumentationToDevNull && outFile->exists()) {
         const QString warningText {"Output file already exists, overwriting %1"_L1.arg(outFile->fileName())};
@@ -228,14 +232,37 @@ QFile *Generator::openSubPageFile(const PageNode *node, const QString &fileName)
     return outFile;
 }
 
+/*!
+  Returns the path of the output file named \a fileName.
+ */
+QString Generator::outputFilePath(const QString &fileName)
+{
+    if (s_redirectDocumentationToDevNull)
+        return QStringLiteral("/dev/null");
+    return outputDir() + QLatin1Char('/') + fileName;
+}
+
 /*!
   Creates the file named \a fileName in the output directory.
   Attaches a QTextStream to the created file, which is written
   to all over the place using out().
+
+  When rendering a page in another thread, the output goes to
+  a string instead, and the file is created when the page is
+  written out.
  */
 void Generator::beginSubPage(const Node *node, const QString &fileName)
 {
     Q_ASSERT(node->isPageNode());
+    if (m_renderedPage) {
+        s_trademarks.clear();
+        auto &file = m_renderedPage->files.emplace_back(
+                RenderedPage::File{ static_cast<const PageNode *>(node), fileName, QString(),
+                                    m_renderedPage->messages.size() });
+        m_renderedPage->openFiles.push(&file);
+        outStreamStack.push(new QTextStream(&file.contents));
+        return;
+    }
     QFile *outFile = openSubPageFile(static_cast<const PageNode*>(node), fileName);
     auto *out = new QTextStream(outFile);
     outStreamStack.push(out);
@@ -248,6 +275,8 @@ void Generator::beginSubPage(const Node *node, const QString &fileName)
  */
 void Generator::endSubPage()
 {
+    if (m_renderedPage)
+        m_renderedPage->openFiles.pop();
     outStreamStack.top()->flush();
     delete outStreamStack.top()->device();
     delete outStreamStack.pop();
@@ -315,8 +344,10 @@ QString Generator::fileBase(const Node *node) const
 
     base.prepend(outputPrefix(node));
     QString canonicalName{ Utilities::asAsciiPrintable(base) };
-    Node *n = const_cast<Node *>(node);
-    n->setFileNameBase(canonicalName);
+    if (!canonicalName.isEmpty()) {
+        Node *n = const_cast<Node *>(node);
+        n->setFileNameBase(canonicalName);
+    }
     return canonicalName;
 }
 
@@ -881,7 +912,11 @@ void Generator::addImageToCopy(const ExampleNode *en, const ResolvedFile& resolv
     // Understand if we really need this information and where it should
     // belong, considering that it should be part of whichever system
     // would actually store the file itself.
-    s_outFileNames << prefix.mid(1) + "/" + resolved_file.get_query();
+    const QString imageFileName = prefix.mid(1) + "/" + resolved_file.get_query();
+    if (m_renderedPage)
+        m_renderedPage->extraFileNames << imageFileName;
+    else
+        s_outFileNames << imageFileName;
 
 
     // TODO: [uncentralized-output-directory-structure]
@@ -963,6 +998,78 @@ void Generator::generateFileList(const ExampleNode *en, CodeMarker *marker, bool
         generateText(text, en, marker);
 }
 
+/*!
+  Writes the page or pages of \a node, if it has any, without
+  recursing into its children.
+ */
+void Generator::generatePage(Node *node)
+{
+    /*
+      Obtain a code marker for the source file.
+     */
+    CodeMarker *marker = CodeMarker::markerForFileName(node->location().filePath());
+
+    if (node->isCollectionNode()) {
+        /*
+          A collection node collects: groups, C++ modules, or QML
+          modules. Testing for a CollectionNode must be done
+          before testing for a TextPageNode because a
+          CollectionNode is a PageNode at this point.
+
+          Don't output an HTML page for the collection node unless
+          the \group, \module, or \qmlmodule command was actually
+          seen by qdoc in the qdoc comment for the node.
+
+          A key prerequisite in this case is the call to
+          mergeCollections(cn). We must determine whether this
+          group, module or QML module has members in other
+          modules. We know at this point that cn's members list
+          contains only members in the current module. Therefore,
+          before outputting the page for cn, we must search for
+          members of cn in the other modules and add them to the
+          members list.
+        */
+        auto *cn = static_cast<CollectionNode *>(node);
+        if (cn->wasSeen()) {
+            m_qdb->mergeCollections(cn);
+            beginSubPage(node, fileName(node));
+            generateCollectionNode(cn, marker);
+            endSubPage();
+        } else if (cn->isGenericCollection()) {
+            // Currently used only for the module's related orphans page
+            // but can be generalized for other kinds of collections if
+            // other use cases pop up.
+            QString name = cn->name().toLower();
+            name.replace(QChar(' '), QString("-"));
+            QString filename =
+                    cn->tree()->physicalModuleName() + "-" + name + "." + fileExtension();
+            beginSubPage(node, filename);
+            generateGenericCollectionPage(cn, marker);
+            endSubPage();
+        }
+    } else if (node->isTextPageNode()) {
+        beginSubPage(node, fileName(node));
+        generatePageNode(static_cast<PageNode *>(node), marker);
+        endSubPage();
+    } else if (node->isAggregate()) {
+        if ((node->isClassNode() || node->isHeader() || node->isNamespace())
+            && node->docMustBeGenerated()) {
+            beginSubPage(node, fileName(node));
+            generateCppReferencePage(static_cast<Aggregate *>(node), marker);
+            endSubPage();
+        } else if (node->isQmlType()) {
+            beginSubPage(node, fileName(node));
+            auto *qcn = static_cast<QmlTypeNode *>(node);
+            generateQmlTypePage(qcn, marker);
+            endSubPage();
+        } else if (node->isProxyNode()) {
+            beginSubPage(node, fileName(node));
+            generateProxyPage(static_cast<Aggregate *>(node), marker);
+            endSubPage();
+        }
+    }
+}
+
 /*!
   Recursive writing of HTML files from the root \a node.
  */
@@ -977,71 +1084,11 @@ void Generator::generateDocumentation(Node *node)
     if (node->isExternalPage())
         return;
 
-    /*
-      Obtain a code marker for the source file.
-     */
-    CodeMarker *marker = CodeMarker::markerForFileName(node->location().filePath());
-
     if (node->parent() != nullptr) {
-        if (node->isCollectionNode()) {
-            /*
-              A collection node collects: groups, C++ modules, or QML
-              modules. Testing for a CollectionNode must be done
-              before testing for a TextPageNode because a
-              CollectionNode is a PageNode at this point.
-
-              Don't output an HTML page for the collection node unless
-              the \group, \module, or \qmlmodule command was actually
-              seen by qdoc in the qdoc comment for the node.
-
-              A key prerequisite in this case is the call to
-              mergeCollections(cn). We must determine whether this
-              group, module or QML module has members in other
-              modules. We know at this point that cn's members list
-              contains only members in the current module. Therefore,
-              before outputting the page for cn, we must search for
-              members of cn in the other modules and add them to the
-              members list.
-            */
-            auto *cn = static_cast<CollectionNode *>(node);
-            if (cn->wasSeen()) {
-                m_qdb->mergeCollections(cn);
-                beginSubPage(node, fileName(node));
-                generateCollectionNode(cn, marker);
-                endSubPage();
-            } else if (cn->isGenericCollection()) {
-                // Currently used only for the module's related orphans page
-                // but can be generalized for other kinds of collections if
-                // other use cases pop up.
-                QString name = cn->name().toLower();
-                name.replace(QChar(' '), QString("-"));
-                QString filename =
-                        cn->tree()->physicalModuleName() + "-" + name + "." + fileExtension();
-                beginSubPage(node, filename);
-                generateGenericCollectionPage(cn, marker);
-                endSubPage();
-            }
-        } else if (node->isTextPageNode()) {
-            beginSubPage(node, fileName(node));
-            generatePageNode(static_cast<PageNode *>(node), marker);
-            endSubPage();
-        } else if (node->isAggregate()) {
-            if ((node->isClassNode() || node->isHeader() || node->isNamespace())
-                && node->docMustBeGenerated()) {
-                beginSubPage(node, fileName(node));
-                generateCppReferencePage(static_cast<Aggregate *>(node), marker);
-                endSubPage();
-            } else if (node->isQmlType()) {
-                beginSubPage(node, fileName(node));
-                auto *qcn = static_cast<QmlTypeNode *>(node);
-                generateQmlTypePage(qcn, marker);
-                endSubPage();
-            } else if (node->isProxyNode()) {
-                beginSubPage(node, fileName(node));
-                generateProxyPage(static_cast<Aggregate *>(node), marker);
-                endSubPage();
-            }
-        }
+        if (m_pageSchedule)
+            m_pageSchedule->append(node);
+        else
+            generatePage(node);
     }
 
     if (node->isAggregate()) {
@@ -1649,13 +1696,153 @@ void Generator::generateOverloadedSignal(const Node *node, CodeMarker *marker)
 
 /*!
   Traverses the database recursively to generate all the documentation.
+
+  If the \c threads configuration variable asks for more than one
+  thread and the generator supports it, the pages are rendered in
+  parallel; see generateDocsConcurrently().
+
+  The database is frozen first whatever the number of threads, so
+  that lists of collections have the same members in both cases.
  */
 void Generator::generateDocs()
 {
     s_currentGenerator = this;
+    m_qdb->freeze();
+    const int threadCount = Config::instance().threadCount();
+    if (threadCount > 1 && generateDocsConcurrently(threadCount))
+        return;
     generateDocumentation(m_qdb->primaryTreeRoot());
 }
 
+/*!
+  Renders the pages with \a threadCount threads, each using its own
+  rendering context created by createRenderingContext(). Returns
+  \c false, without generating anything, if the generator does not
+  provide rendering contexts.
+
+  The traversal of generateDocumentation() first only schedules the
+  pages. As generateDocs() has frozen the database, the threads only
+  read from it; the file names of all nodes are computed up front.
+  The threads render the pages into memory, holding back their
+  messages. The calling thread writes the pages out and emits the
+  messages in the order of the serial traversal, as the pages are
+  done, so the output does not depend on the number of threads.
+ */
+bool Generator::generateDocsConcurrently(int threadCount)
+{
+    std::vector<std::unique_ptr<Generator>> contexts;
+    for (int i = 0; i < threadCount; ++i) {
+        std::unique_ptr<Generator> context = createRenderingContext();
+        if (!context)
+            return false;
+        contexts.push_back(std::move(context));
+    }
+
+    PageSchedule schedule;
+    Location::setMessageLog(&schedule.messages);
+    m_pageSchedule = &schedule;
+    generateDocumentation(m_qdb->primaryTreeRoot());
+    m_pageSchedule = nullptr;
+    Location::setMessageLog(nullptr);
+
+    warmUpFileBases();
+    formattingLeftMap();
+    formattingRightMap();
+
+    qCDebug(lcQdoc, "Generating %lld pages in %d threads",
+            static_cast<long long>(schedule.nodes.size()), threadCount);
+
+    std::vector<RenderedPage> pages(schedule.nodes.size());
+    std::atomic<qsizetype> nextPage = 0;
+    QMutex mutex;
+    QWaitCondition pageDone;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (const auto &context : contexts) {
+        Generator *generator = context.get();
+        threads.emplace_back(QThread::create([&, generator] {
+            s_currentGenerator = generator;
+            qsizetype i;
+            while ((i = nextPage++) < schedule.nodes.size()) {
+                RenderedPage &page = pages[i];
+                generator->m_renderedPage = &page;
+                Location::setMessageLog(&page.messages);
+                generator->generatePage(schedule.nodes.at(i));
+                Location::setMessageLog(nullptr);
+                generator->m_renderedPage = nullptr;
+
+                QMutexLocker locker(&mutex);
+                page.done = true;
+                pageDone.wakeAll();
+            }
+        }));
+        threads.back()->start();
+    }
+
+    for (qsizetype i = 0; i < schedule.nodes.size(); ++i) {
+        {
+            QMutexLocker locker(&mutex);
+            while (!pages[i].done)
+                pageDone.wait(&mutex);
+        }
+        Location::emitMessages(schedule.precedingMessages.at(i));
+        writeRenderedPage(pages[i]);
+        pages[i] = RenderedPage();
+    }
+    Location::emitMessages(schedule.messages);
+
+    for (const auto &thread : threads)
+        thread->wait();
+    return true;
+}
+
+/*!
+  Computes the file name bases of all nodes in all trees, which
+  fileBase() otherwise caches in the nodes as they are needed.
+ */
+void Generator::warmUpFileBases()
+{
+    const auto warmUp = [this](const Node *node, const auto &recurse) -> void {
+        if (node->isPageNode() || node->isCollectionNode())
+            fileBase(node);
+        if (node->isAggregate()) {
+            for (const Node *child : static_cast<const Aggregate *>(node)->childNodes())
+                recurse(child, recurse);
+        }
+    };
+    for (Tree *tree : m_qdb->searchOrder()) {
+        warmUp(tree->root(), warmUp);
+        for (auto type : { Node::Group, Node::Module, Node::QmlModule }) {
+            if (const CNMap *collections = tree->getCollectionMap(type)) {
+                for (const CollectionNode *cn : *collections)
+                    fileBase(cn);
+            }
+        }
+    }
+}
+
+/*!
+  Writes the files of the rendered \a page, emitting the messages
+  held back while rendering it in between, in the order in which
+  they would have been emitted when rendering the page directly.
+ */
+void Generator::writeRenderedPage(const RenderedPage &page)
+{
+    qsizetype emitted = 0;
+    for (const auto &file : page.files) {
+        Location::emitMessages(page.messages.mid(emitted, file.messageCount - emitted));
+        emitted = file.messageCount;
+
+        QFile *outFile = openSubPageFile(file.node, file.fileName);
+        QTextStream out(outFile);
+        out << file.contents;
+        out.flush();
+        delete outFile;
+    }
+    Location::emitMessages(page.messages.mid(emitted));
+    s_outFileNames << page.extraFileNames;
+}
+
 Generator *Generator::generatorForFormat(const QString &format)
 {
     for (const auto &generator : std::as_const(s_generators)) {
@@ -1884,6 +2071,8 @@ QTextStream &Generator::out()
 
 QString Generator::outFileName()
 {
+    if (m_renderedPage)
+        return QFileInfo(outputFilePath(m_renderedPage->openFiles.top()->fileName)).fileName();
     return QFileInfo(static_cast<QFile *>(out().device())->fileName()).fileName();
 }
 
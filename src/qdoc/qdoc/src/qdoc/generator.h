@@ -4,16 +4,22 @@
 #ifndef GENERATOR_H
 #define GENERATOR_H
 
+#include "location.h"
 #include "text.h"
 #include "utilities.h"
 #include "filesystem/fileresolver.h"
 
 #include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qstack.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qtextstream.h>
+
+#include <deque>
+#include <memory>
 #include <optional>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -23,7 +29,6 @@ class Aggregate;
 class CodeMarker;
 class ExampleNode;
 class FunctionNode;
-class Location;
 class Node;
 class QDocDatabase;
 
@@ -74,6 +79,7 @@ public:
 
 protected:
     static QFile *openSubPageFile(const PageNode *node, const QString &fileName);
+    virtual std::unique_ptr<Generator> createRenderingContext() const { return nullptr; }
     void beginSubPage(const Node *node, const QString &fileName);
     void endSubPage();
     [[nodiscard]] virtual QString fileExtension() const = 0;
@@ -170,7 +176,47 @@ protected:
     }
 
 private:
-    static Generator *s_currentGenerator;
+    // The pages in the order of the serial traversal, with the messages
+    // the traversal emitted before reaching each of them
+    struct PageSchedule
+    {
+        void append(Node *node)
+        {
+            nodes << node;
+            precedingMessages << std::exchange(messages, {});
+        }
+
+        QList<Node *> nodes;
+        QList<Location::MessageLog> precedingMessages;
+        Location::MessageLog messages;
+    };
+
+    // The output of a page rendered by another thread, to be written out
+    // in the order of the serial traversal
+    struct RenderedPage
+    {
+        struct File
+        {
+            const PageNode *node;
+            QString fileName;
+            QString contents;
+            qsizetype messageCount; // emitted before the file was opened
+        };
+
+        std::deque<File> files;
+        QStack<File *> openFiles;
+        QStringList extraFileNames;
+        Location::MessageLog messages;
+        bool done { false };
+    };
+
+    static QString outputFilePath(const QString &fileName);
+    void generatePage(Node *node);
+    bool generateDocsConcurrently(int threadCount);
+    void warmUpFileBases();
+    static void writeRenderedPage(const RenderedPage &page);
+
+    static thread_local Generator *s_currentGenerator;
     static QMap<QString, QMap<QString, QString>> s_fmtLeftMaps;
     static QMap<QString, QMap<QString, QString>> s_fmtRightMaps;
     static QList<Generator *> s_generators;
@@ -179,14 +225,14 @@ private:
     static QString s_outSubdir;
     static QStringList s_outFileNames;
     static QSet<QString> s_outputFormats;
-    static QSet<QString> s_trademarks;
+    static thread_local QSet<QString> s_trademarks;
     static QHash<QString, QString> s_outputPrefixes;
     static QHash<QString, QString> s_outputSuffixes;
     static bool s_noLinkErrors;
     static bool s_autolinkErrors;
     static bool s_redirectDocumentationToDevNull;
     static bool s_useOutputSubdirs;
-    static QmlTypeNode *s_qmlTypeContext;
+    static thread_local QmlTypeNode *s_qmlTypeContext;
 
     void generateReimplementsClause(const FunctionNode *fn, CodeMarker *marker);
     static void copyTemplateFiles(const QString &configVar, const QString &subDir);
@@ -205,6 +251,10 @@ protected:
     int m_numTableRows { 0 };
     QString m_link {};
     QString m_sectionNumber {};
+
+private:
+    PageSchedule *m_pageSchedule { nullptr };
+    RenderedPage *m_renderedPage { nullptr };
 };
 
 std::optional<QString> formatStatus(const Node *node, QDocDatabase *qdb);
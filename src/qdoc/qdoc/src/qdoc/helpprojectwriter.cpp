@@ -17,6 +17,7 @@
 #include "typedefnode.h"
 
 #include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -157,6 +158,9 @@ void HelpProjectWriter::readSelectors(SubProject &subproject, const QStringList
 
 void HelpProjectWriter::addExtraFile(const QString &file)
 {
+    // Pages generated in parallel add the images they use
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
     for (HelpProject &project : m_projects)
         project.m_extraFiles.insert(file);
 }
@@ -38,7 +38,7 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
-bool HtmlGenerator::s_inUnorderedList { false };
+thread_local bool HtmlGenerator::s_inUnorderedList { false };
 
 static const Atom openCodeTag {Atom::FormattingLeft, ATOM_FORMATTING_TELETYPE};
 static const Atom closeCodeTag {Atom::FormattingRight, ATOM_FORMATTING_TELETYPE};
@@ -88,6 +88,9 @@ inline void HtmlGenerator::closeUnorderedList()
  */
 HtmlGenerator::~HtmlGenerator()
 {
+    if (m_isRenderingContext)
+        return;
+
     if (m_helpProjectWriter) {
         delete m_helpProjectWriter;
         m_helpProjectWriter = nullptr;
@@ -261,6 +264,20 @@ void HtmlGenerator::generateDocs()
     }
 }
 
+/*!
+  Returns a copy of this generator to render pages with in another
+  thread. The copy shares the help project writer, which only has
+  extra files added to it while rendering, and has no manifest
+  writer.
+ */
+std::unique_ptr<Generator> HtmlGenerator::createRenderingContext() const
+{
+    auto context = std::make_unique<HtmlGenerator>(*this);
+    context->m_manifestWriter = nullptr;
+    context->m_isRenderingContext = true;
+    return context;
+}
+
 /*!
   Generate an html file with the contents of a C++ or QML source file.
  */
@@ -291,7 +308,7 @@ void HtmlGenerator::generateExampleFilePage(const Node *en, ResolvedFile resolve
 qsizetype HtmlGenerator::generateAtom(const Atom *atom, const Node *relative, CodeMarker *marker)
 {
     qsizetype idx, skipAhead = 0;
-    static bool in_para = false;
+    static thread_local bool in_para = false;
     Node::Genus genus = Node::DontCare;
 
     switch (atom->type()) {
@@ -346,9 +363,9 @@ qsizetype HtmlGenerator::generateAtom(const Atom *atom, const Node *relative, Co
         // This may at one time have been used to mark up C++ code but it is
         // now widely used to write teletype text. As a result, text marked
         // with the \c command is not passed to a code marker.
-        out() << formattingLeftMap()[ATOM_FORMATTING_TELETYPE];
+        out() << formattingLeftMap().value(ATOM_FORMATTING_TELETYPE);
         out() << protectEnc(plainCode(atom->string()));
-        out() << formattingRightMap()[ATOM_FORMATTING_TELETYPE];
+        out() << formattingRightMap().value(ATOM_FORMATTING_TELETYPE);
         break;
     case Atom::CaptionLeft:
         out() << "<p class=\"figCaption\">";
@@ -419,7 +436,7 @@ qsizetype HtmlGenerator::generateAtom(const Atom *atom, const Node *relative, Co
         if (atom->string().startsWith("span "))
             out() << '<' + atom->string() << '>';
         else
-            out() << formattingLeftMap()[atom->string()];
+            out() << formattingLeftMap().value(atom->string());
         break;
     case Atom::FormattingRight:
         if (atom->string() == ATOM_FORMATTING_LINK) {
@@ -431,15 +448,15 @@ qsizetype HtmlGenerator::generateAtom(const Atom *atom, const Node *relative, Co
                 const Atom tm_link(Atom::NavLink, m_trademarkspage);
                 if (const auto &link = getLink(&tm_link, relative, &node);
                         !link.isEmpty() && node != relative)
-                    out() << "<a href=\"%1\">%2</a>"_L1.arg(link, formattingRightMap()[atom->string()]);
+                    out() << "<a href=\"%1\">%2</a>"_L1.arg(link, formattingRightMap().value(atom->string()));
                 else
-                    out() << formattingRightMap()[atom->string()];
+                    out() << formattingRightMap().value(atom->string());
             }
             out() << "</span>";
         } else if (atom->string().startsWith("span ")) {
             out() << "</span>";
         } else {
-            out() << formattingRightMap()[atom->string()];
+            out() << formattingRightMap().value(atom->string());
         }
         break;
     case Atom::AnnotatedList: {
@@ -680,9 +697,9 @@ qsizetype HtmlGenerator::generateAtom(const Atom *atom, const Node *relative, Co
         admonType.chop(4);
         out() << "<div class=\"admonition " << admonType.toLower() << "\">\n"
               << "<p>";
-        out() << formattingLeftMap()[ATOM_FORMATTING_BOLD];
+        out() << formattingLeftMap().value(ATOM_FORMATTING_BOLD);
         out() << admonType << ": ";
-        out() << formattingRightMap()[ATOM_FORMATTING_BOLD];
+        out() << formattingRightMap().value(ATOM_FORMATTING_BOLD);
     } break;
     case Atom::ImportantRight:
     case Atom::NoteRight:
@@ -43,6 +43,7 @@ protected:
     void generateCollectionNode(CollectionNode *cn, CodeMarker *marker) override;
     void generateGenericCollectionPage(CollectionNode *cn, CodeMarker *marker) override;
     [[nodiscard]] QString fileExtension() const override;
+    std::unique_ptr<Generator> createRenderingContext() const override;
 
 private:
     enum SubTitleSize { SmallSubTitle, LargeSubTitle };
@@ -128,13 +129,14 @@ private:
 
     QString groupReferenceText(PageNode* node);
 
-    static bool s_inUnorderedList;
+    static thread_local bool s_inUnorderedList;
 
     int m_codeIndent { 0 };
     QString m_codePrefix {};
     QString m_codeSuffix {};
     HelpProjectWriter *m_helpProjectWriter { nullptr };
     ManifestWriter *m_manifestWriter { nullptr };
+    bool m_isRenderingContext { false }; // shares the writers of another generator
     QString m_headerScripts {};
     QString m_headerStyles {};
     QString m_endHeader {};
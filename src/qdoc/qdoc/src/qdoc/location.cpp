@@ -12,6 +12,7 @@
 #include <climits>
 #include <cstdio>
 #include <cstdlib>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -22,6 +23,7 @@ QString Location::s_programName;
 QString Location::s_project;
 QSet<QString> Location::s_reports;
 QRegularExpression *Location::s_spuriousRegExp = nullptr;
+thread_local Location::MessageLog *Location::s_messageLog = nullptr;
 
 /*!
   \class Location
@@ -262,6 +264,10 @@ int Location::exitCode()
  */
 void Location::fatal(const QString &message, const QString &details) const
 {
+    if (s_messageLog) {
+        MessageLog *log = std::exchange(s_messageLog, nullptr);
+        emitMessages(*log);
+    }
     emitMessage(Error, message, details);
     information(message);
     information(details);
@@ -282,9 +288,49 @@ void Location::fatal(const QString &message, const QString &details) const
 void Location::report(const QString &message, const QString &details) const
 {
     const auto &config = Config::instance();
-    if ((!config.preparing() || config.singleExec()) && !s_reports.contains(message)) {
-        emitMessage(Report, message, details);
-        s_reports << message;
+    if (!config.preparing() || config.singleExec()) {
+        if (s_messageLog) {
+            s_messageLog->append(Message{ *this, Report, message, details });
+        } else if (!s_reports.contains(message)) {
+            emitMessage(Report, message, details);
+            s_reports << message;
+        }
+    }
+}
+
+/*!
+  \fn void Location::setMessageLog(MessageLog *log)
+
+  Makes the messages of the calling thread go to \a log instead of
+  \c stderr, or to \c stderr again if \a log is \nullptr. This lets
+  threads that generate output in parallel keep their messages until
+  they can be emitted in the order of the serial output.
+
+  \sa emitMessages()
+ */
+
+/*!
+  \fn Location::MessageLog *Location::messageLog()
+
+  Returns the log that the messages of the calling thread go to, or
+  \nullptr if they go to \c stderr.
+
+  \sa setMessageLog()
+ */
+
+/*!
+  Emits the messages held in \a log, in order, as if they were
+  emitted by the calling thread just now. Recurring reports are
+  ignored, and warnings are counted against the warning limit, as
+  usual.
+ */
+void Location::emitMessages(const MessageLog &log)
+{
+    for (const Message &msg : log) {
+        if (msg.type == Report)
+            msg.location.report(msg.message, msg.details);
+        else
+            msg.location.emitMessage(msg.type, msg.message, msg.details);
     }
 }
 
@@ -354,6 +400,11 @@ void Location::internalError(const QString &hint)
  */
 void Location::emitMessage(MessageType type, const QString &message, const QString &details) const
 {
+    if (s_messageLog) {
+        s_messageLog->append(Message{ *this, type, message, details });
+        return;
+    }
+
     if (type == Warning && s_spuriousRegExp != nullptr) {
         auto match = s_spuriousRegExp->match(message, 0, QRegularExpression::NormalMatch,
                                              QRegularExpression::AnchorAtOffsetMatchOption);
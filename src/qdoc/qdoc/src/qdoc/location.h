@@ -5,6 +5,7 @@
 #define LOCATION_H
 
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qstack.h>
 
 QT_BEGIN_NAMESPACE
@@ -14,6 +15,9 @@ class QRegularExpression;
 class Location
 {
 public:
+    struct Message;
+    using MessageLog = QList<Message>;
+
     Location();
     explicit Location(const QString &filePath);
     Location(const Location &other);
@@ -55,6 +59,9 @@ public:
     static void information(const QString &message);
     static void internalError(const QString &hint);
     static int exitCode();
+    static MessageLog *messageLog() { return s_messageLog; }
+    static void setMessageLog(MessageLog *log) { s_messageLog = log; }
+    static void emitMessages(const MessageLog &log);
 
 private:
     enum MessageType { Warning, Error, Report };
@@ -84,6 +91,16 @@ private:
     static QString s_project;
     static QRegularExpression *s_spuriousRegExp;
     static QSet<QString> s_reports;
+    static thread_local MessageLog *s_messageLog;
+};
+
+// A message held back by a thread, to be emitted later by emitMessages()
+struct Location::Message
+{
+    Location location;
+    MessageType type;
+    QString message;
+    QString details;
 };
 Q_DECLARE_TYPEINFO(Location::StackEntry, Q_RELOCATABLE_TYPE);
 Q_DECLARE_TYPEINFO(Location, Q_COMPLEX_TYPE); // stkTop = &stkBottom
@@ -86,6 +86,11 @@ static void parseSourceFiles(
         });
 
 
+    // The translation units are parsed by worker threads, but their
+    // documentation is still processed here in the order of the sources.
+    source_file_parser.parseAhead(std::vector<QString>(qml_sources, sources.end()),
+                                  Config::instance().threadCount());
+
     std::for_each(qml_sources, sources.end(),
             [&source_file_parser, &cpp_code_parser, &error_handler](const QString& source){
         qCDebug(lcQdoc, "Parsing %s", qPrintable(source));
@@ -581,6 +586,7 @@ static void processQdocconfFile(const QString &fileName)
 
         SourceFileParser source_file_parser{clangParser, docParser};
         parseSourceFiles(std::move(sources), source_file_parser, cpp_code_parser);
+        clangParser.logParseCacheStatistics();
 
         if (config.get(CONFIG_LOGPROGRESS).asBool())
             qCInfo(lcQdoc) << "Source files parsed for" << project;
@@ -0,0 +1,231 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "parsecache.h"
+
+#include "utilities.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+static const quint32 cacheMagic = 0x51445043; // "QDPC"
+static const quint32 cacheVersion = 1;
+
+static QDataStream &operator<<(QDataStream &out, const ParseCache::Position &position)
+{
+    return out << position.filePath << qint32(position.lineNo) << qint32(position.columnNo);
+}
+
+static QDataStream &operator>>(QDataStream &in, ParseCache::Position &position)
+{
+    qint32 lineNo, columnNo;
+    in >> position.filePath >> lineNo >> columnNo;
+    position.lineNo = lineNo;
+    position.columnNo = columnNo;
+    return in;
+}
+
+static QDataStream &operator<<(QDataStream &out, const ParseCache::TiedNode &node)
+{
+    return out << node.path << node.signature << qint32(node.metaness) << node.invokable
+               << node.isOverride << node.parameterNames << node.defaultValues;
+}
+
+static QDataStream &operator>>(QDataStream &in, ParseCache::TiedNode &node)
+{
+    qint32 metaness;
+    in >> node.path >> node.signature >> metaness >> node.invokable >> node.isOverride
+            >> node.parameterNames >> node.defaultValues;
+    node.metaness = metaness;
+    return in;
+}
+
+static QDataStream &operator<<(QDataStream &out, const ParseCache::Comment &comment)
+{
+    out << comment.text << comment.start << comment.end << comment.context
+        << comment.node.has_value();
+    if (comment.node)
+        out << *comment.node;
+    return out;
+}
+
+static QDataStream &operator>>(QDataStream &in, ParseCache::Comment &comment)
+{
+    bool hasNode;
+    in >> comment.text >> comment.start >> comment.end >> comment.context >> hasNode;
+    if (hasNode)
+        in >> comment.node.emplace();
+    return in;
+}
+
+/*!
+  \class ParseCache
+  \internal
+  \brief Keeps what ClangCodeParser extracted from each source file on
+  disk, for the next run of QDoc to load instead of parsing the file.
+
+  Each source file gets an entry in the cache \e directory. An entry
+  holds the documentation comments of the file, together with what
+  clang told about them, and the hashes of the contents of all files
+  the translation unit consisted of. An entry is only loaded if it was
+  stored with the same key, and none of those files changed since.
+
+  A disabled cache, with an empty directory, neither loads nor stores
+  anything.
+
+  \sa setKey()
+ */
+
+/*!
+  Constructs a parse cache that keeps its entries in \a directory,
+  which is created if needed.
+ */
+ParseCache::ParseCache(const QString &directory) : m_directory(directory)
+{
+    if (isEnabled() && !QDir().mkpath(m_directory)) {
+        qCWarning(lcQdoc) << "Cannot create the parse cache directory" << m_directory;
+        m_directory.clear();
+    }
+}
+
+/*!
+  Logs how many of the entries were hit, if any were looked up.
+
+  QDoc calls this once the source files are parsed, while the debug
+  output of the project is still enabled.
+ */
+void ParseCache::logStatistics() const
+{
+    if (isEnabled() && (m_hits || m_misses)) {
+        qCDebug(lcQdoc, "Parse cache %s: %d hits, %d misses (%.1f%% hit ratio)",
+                qPrintable(m_directory), m_hits, m_misses,
+                100.0 * m_hits / (m_hits + m_misses));
+    }
+}
+
+/*!
+  \fn void ParseCache::setKey(const QByteArray &key)
+
+  Sets the \a key that the entries must have been stored with to be
+  loaded. It stands for everything other than the files themselves
+  that parsing them depends on, such as the precompiled header and the
+  defines and macros of the configuration.
+ */
+
+/*!
+  Returns a hash of the contents of the file \a filePath, or an empty
+  byte array if it cannot be read. The hash is only computed the first
+  time it is asked for.
+ */
+QByteArray ParseCache::fileHash(const QString &filePath)
+{
+    auto it = m_fileHashes.constFind(filePath);
+    if (it != m_fileHashes.cend())
+        return *it;
+
+    QByteArray hash;
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadOnly)) {
+        QCryptographicHash hasher(QCryptographicHash::Sha1);
+        if (hasher.addData(&file))
+            hash = hasher.result();
+    }
+    m_fileHashes.insert(filePath, hash);
+    return hash;
+}
+
+/*!
+  Returns the entry of \a sourceFile, if it was stored with the
+  current key and none of its dependencies changed.
+ */
+std::optional<ParseCache::Entry> ParseCache::load(const QString &sourceFile)
+{
+    if (!isEnabled())
+        return std::nullopt;
+
+    const auto miss = [this, &sourceFile](const char *reason) {
+        ++m_misses;
+        qCDebug(lcQdoc, "Parse cache miss for %s: %s", qPrintable(sourceFile), reason);
+        return std::nullopt;
+    };
+
+    QFile file(entryPath(sourceFile));
+    if (!file.open(QIODevice::ReadOnly))
+        return miss("not cached");
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic, version;
+    QString storedSourceFile;
+    QByteArray key;
+    in >> magic >> version;
+    if (magic != cacheMagic || version != cacheVersion)
+        return miss("stored by another version of QDoc");
+    in >> storedSourceFile >> key;
+    if (storedSourceFile != sourceFile || key != m_key)
+        return miss("parsed with other headers or configuration");
+
+    Entry entry;
+    in >> entry.dependencies;
+    for (const auto &[path, hash] : std::as_const(entry.dependencies)) {
+        if (hash.isEmpty() || fileHash(path) != hash)
+            return miss("changed");
+    }
+    in >> entry.comments;
+    if (in.status() != QDataStream::Ok)
+        return miss("corrupt");
+
+    ++m_hits;
+    return entry;
+}
+
+/*!
+  Stores \a entry as the entry of \a sourceFile, along with the
+  current key.
+ */
+void ParseCache::store(const QString &sourceFile, const Entry &entry)
+{
+    if (!isEnabled())
+        return;
+
+    QSaveFile file(entryPath(sourceFile));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(lcQdoc) << "Cannot write the parse cache entry" << file.fileName();
+        return;
+    }
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << cacheMagic << cacheVersion << sourceFile << m_key << entry.dependencies
+        << entry.comments;
+    if (out.status() != QDataStream::Ok || !file.commit())
+        qCWarning(lcQdoc) << "Cannot write the parse cache entry" << file.fileName();
+}
+
+/*!
+  Removes the entry of \a sourceFile, after it was loaded but could
+  not be used, and counts it as a miss.
+ */
+void ParseCache::discard(const QString &sourceFile)
+{
+    if (!isEnabled())
+        return;
+
+    --m_hits;
+    ++m_misses;
+    qCDebug(lcQdoc, "Parse cache miss for %s: declarations changed", qPrintable(sourceFile));
+    QFile::remove(entryPath(sourceFile));
+}
+
+QString ParseCache::entryPath(const QString &sourceFile) const
+{
+    const QByteArray name =
+            QCryptographicHash::hash(sourceFile.toUtf8(), QCryptographicHash::Sha1).toHex();
+    return m_directory + QLatin1Char('/') + QLatin1String(name) + QLatin1String(".cache");
+}
+
+QT_END_NAMESPACE
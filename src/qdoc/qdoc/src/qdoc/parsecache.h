@@ -0,0 +1,78 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef PARSECACHE_H
+#define PARSECACHE_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+#include <optional>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+class ParseCache
+{
+public:
+    struct Position
+    {
+        QString filePath;
+        int lineNo { 0 };
+        int columnNo { 0 };
+    };
+
+    // The declaration a comment without topic commands documents,
+    // and the state the source file left it in.
+    struct TiedNode
+    {
+        QList<std::pair<QString, qint64>> path; // name and index among siblings
+        QString signature;
+        int metaness { 0 };
+        bool invokable { false };
+        bool isOverride { false };
+        QStringList parameterNames;
+        QStringList defaultValues;
+    };
+
+    struct Comment
+    {
+        QString text; // as it appears in the source, /*! included
+        Position start;
+        Position end;
+        QStringList context; // enclosing namespaces, for comments with topic commands
+        std::optional<TiedNode> node;
+    };
+
+    struct Entry
+    {
+        QList<std::pair<QString, QByteArray>> dependencies; // file path and hash
+        QList<Comment> comments;
+    };
+
+    explicit ParseCache(const QString &directory = QString());
+
+    [[nodiscard]] bool isEnabled() const { return !m_directory.isEmpty(); }
+    void setKey(const QByteArray &key) { m_key = key; }
+    QByteArray fileHash(const QString &filePath);
+    std::optional<Entry> load(const QString &sourceFile);
+    void store(const QString &sourceFile, const Entry &entry);
+    void discard(const QString &sourceFile);
+    void logStatistics() const;
+
+private:
+    [[nodiscard]] QString entryPath(const QString &sourceFile) const;
+
+    QString m_directory {};
+    QByteArray m_key {};
+    QHash<QString, QByteArray> m_fileHashes {};
+    int m_hits { 0 };
+    int m_misses { 0 };
+};
+
+QT_END_NAMESPACE
+
+#endif
@@ -35,7 +35,9 @@ QDocCommandLineParser::QDocCommandLineParser()
       frameworkOption("F", "Add macOS framework to the include path for header files.",
                       "framework"),
       timestampsOption(QStringList() << QStringLiteral("timestamps")),
-      useDocBookExtensions(QStringList() << QStringLiteral("docbook-extensions"))
+      useDocBookExtensions(QStringList() << QStringLiteral("docbook-extensions")),
+      threadsOption(QStringList() << QStringLiteral("threads")),
+      parseCacheOption(QStringList() << QStringLiteral("parsecache"))
 {
     setApplicationDescription(QStringLiteral("Qt documentation generator"));
     addHelpOption();
@@ -132,6 +134,18 @@ QDocCommandLineParser::QDocCommandLineParser()
     useDocBookExtensions.setDescription(
             QStringLiteral("Use the DocBook Library extensions for metadata."));
     addOption(useDocBookExtensions);
+
+    threadsOption.setDescription(
+            QStringLiteral("Parse C++ sources and generate HTML pages in parallel, using "
+                           "count threads; 0 uses the number of processor cores."));
+    threadsOption.setValueName(QStringLiteral("count"));
+    addOption(threadsOption);
+
+    parseCacheOption.setDescription(
+            QStringLiteral("Keep what was parsed from each C++ source file in the directory "
+                           "dir, and load it from there while the file is unchanged."));
+    parseCacheOption.setValueName(QStringLiteral("dir"));
+    addOption(parseCacheOption);
 }
 
 /*!
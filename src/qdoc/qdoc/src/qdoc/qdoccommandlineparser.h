@@ -20,7 +20,8 @@ struct QDocCommandLineParser : public QCommandLineParser
     QCommandLineOption noLinkErrorsOption, autoLinkErrorsOption, debugOption, atomsDumpOption;
     QCommandLineOption prepareOption, generateOption, logProgressOption, singleExecOption;
     QCommandLineOption includePathOption, includePathSystemOption, frameworkOption;
-    QCommandLineOption timestampsOption, useDocBookExtensions;
+    QCommandLineOption timestampsOption, useDocBookExtensions, threadsOption;
+    QCommandLineOption parseCacheOption;
 };
 
 QT_END_NAMESPACE
@@ -710,13 +710,53 @@ void QDocDatabase::processForest()
  */
 void QDocDatabase::processForest(FindFunctionPtr func)
 {
-    Tree *t = m_forest.firstTree();
-    while (t) {
+    for (Tree *t : searchOrder()) {
         if (!m_completedFindFunctions.values(t).contains(func)) {
             (this->*(func))(t->root());
             m_completedFindFunctions.insert(t, func);
         }
-        t = m_forest.nextTree();
+    }
+}
+
+/*!
+  Completes everything the database otherwise computes lazily while
+  the documentation is generated, that is, the maps built by
+  processForest() and the merged collections. Afterwards, generating
+  the documentation only reads from the database, so pages can be
+  generated by several threads at once.
+
+  Collections are merged in advance, as mergeCollections() is meant
+  to give the same result at any point of the generation. Merging
+  them lazily instead would make the members of a list depend on the
+  pages generated before it, so the database is frozen for any number
+  of threads.
+ */
+void QDocDatabase::freeze()
+{
+    processForest();
+
+    const Node::NodeType types[] = { Node::Group, Node::Module, Node::QmlModule };
+    QList<CollectionNode *> collections;
+    for (Tree *tree : searchOrder()) {
+        for (auto type : types) {
+            if (const CNMap *m = tree->getCollectionMap(type))
+                collections << m->values();
+        }
+    }
+    for (CollectionNode *cn : std::as_const(collections))
+        mergeCollections(cn);
+
+    // The lists of collections merge into the first collection that
+    // is not the page the list is generated on.
+    CNMap cnm;
+    for (auto type : types) {
+        mergeCollections(type, cnm, nullptr);
+        for (auto pageType : types) {
+            if (const CNMap *m = primaryTree()->getCollectionMap(pageType)) {
+                for (const CollectionNode *cn : *m)
+                    mergeCollections(type, cnm, cn);
+            }
+        }
     }
 }
 
@@ -967,11 +1007,8 @@ void QDocDatabase::resolveNamespaces()
 
     bool linkErrors = !Config::instance().get(CONFIG_NOLINKERRORS).asBool();
     NodeMultiMap namespaceMultimap;
-    Tree *t = m_forest.firstTree();
-    while (t) {
+    for (Tree *t : searchOrder())
         t->root()->findAllNamespaces(namespaceMultimap);
-        t = m_forest.nextTree();
-    }
     const QList<QString> keys = namespaceMultimap.uniqueKeys();
     for (const QString &key : keys) {
         NamespaceNode *ns = nullptr;
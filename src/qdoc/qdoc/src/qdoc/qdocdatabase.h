@@ -331,6 +331,7 @@ public:
                        Generator *g);
 
     void processForest();
+    void freeze();
 
     NamespaceNode *primaryTreeRoot() { return m_forest.primaryTreeRoot(); }
     void newPrimaryTree(const QString &module) { m_forest.newPrimaryTree(module); }
@@ -7,9 +7,9 @@
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qregularexpression.h>
 
-QT_BEGIN_NAMESPACE
+#include <algorithm>
 
-QHash<QString, QString> Quoter::s_commentHash;
+QT_BEGIN_NAMESPACE
 
 static void replaceMultipleNewlines(QString &s)
 {
@@ -81,40 +81,48 @@ static void trimWhiteSpace(QString &str)
     str.resize(++j);
 }
 
-Quoter::Quoter() : m_silent(false)
-{
-    /* We're going to hard code these delimiters:
-        * C++, Qt, Qt Script, Java:
-          //! [<id>]
-        * .pro, .py, CMake files:
-          #! [<id>]
-        * .html, .qrc, .ui, .xq, .xml files:
-          <!-- [<id>] -->
-    */
-    if (s_commentHash.empty()) {
-        s_commentHash["pro"] = "#!";
-        s_commentHash["py"] = "#!";
-        s_commentHash["cmake"] = "#!";
-        s_commentHash["html"] = "<!--";
-        s_commentHash["qrc"] = "<!--";
-        s_commentHash["ui"] = "<!--";
-        s_commentHash["xml"] = "<!--";
-        s_commentHash["xq"] = "<!--";
-    }
-}
-
 void Quoter::reset()
 {
     m_silent = false;
-    m_plainLines.clear();
-    m_markedLines.clear();
+    m_code.reset();
+    m_line = 0;
     m_codeLocation = Location();
 }
 
 void Quoter::quoteFromFile(const QString &userFriendlyFilePath, const QString &plainCode,
                            const QString &markedCode)
+{
+    quoteFromFile(userFriendlyFilePath, splitCode(userFriendlyFilePath, plainCode, markedCode));
+}
+
+/*
+  Starts quoting \a code, the lines of the file \a userFriendlyFilePath
+  as split by splitCode().
+*/
+void Quoter::quoteFromFile(const QString &userFriendlyFilePath, std::shared_ptr<const Code> code)
 {
     m_silent = false;
+    m_code = std::move(code);
+    m_line = 0;
+    m_codeLocation = Location(userFriendlyFilePath);
+    if (m_code->markedCodeMismatch) {
+        m_codeLocation.warning(
+                QStringLiteral("Something is wrong with qdoc's handling of marked code"));
+    }
+    m_codeLocation.start();
+}
+
+/*
+  Splits the \a plainCode and \a markedCode of the file
+  \a userFriendlyFilePath into the lines that quoting works on, and
+  notes the lines that its snippet markers are on, so that
+  quoteSnippet() can go straight to them.
+*/
+std::shared_ptr<const Quoter::Code> Quoter::splitCode(const QString &userFriendlyFilePath,
+                                                      const QString &plainCode,
+                                                      const QString &markedCode)
+{
+    auto code = std::make_shared<Code>();
 
     /*
       Split the source code into logical lines. Empty lines are
@@ -137,28 +145,62 @@ void Quoter::quoteFromFile(const QString &userFriendlyFilePath, const QString &p
 
       Newlines are preserved because they affect codeLocation.
     */
-    m_codeLocation = Location(userFriendlyFilePath);
-
-    m_plainLines = splitLines(plainCode);
-    m_markedLines = splitLines(markedCode);
-    if (m_markedLines.size() != m_plainLines.size()) {
-        m_codeLocation.warning(
-                QStringLiteral("Something is wrong with qdoc's handling of marked code"));
-        m_markedLines = m_plainLines;
+    code->plainLines = splitLines(plainCode);
+    code->markedLines = splitLines(markedCode);
+    if (code->markedLines.size() != code->plainLines.size()) {
+        code->markedCodeMismatch = true;
+        code->markedLines = code->plainLines;
     }
 
     /*
       Squeeze blanks (cat -s).
     */
-    for (auto &line : m_markedLines)
+    for (auto &line : code->markedLines)
         replaceMultipleNewlines(line);
-    m_codeLocation.start();
+
+    code->lineOffsets.reserve(code->markedLines.size() + 1);
+    int offset = 0;
+    for (const auto &line : std::as_const(code->markedLines)) {
+        code->lineOffsets << offset;
+        offset += line.count(QLatin1Char('\n')) + 1;
+    }
+    code->lineOffsets << offset;
+
+    /*
+      Index the markers by the delimiter they match, with white space
+      trimmed the way match() does. With QDOC_NO_FILE_CACHE set, snippets
+      are searched for line by line instead.
+    */
+    static const bool indexMarkers = !qEnvironmentVariableIsSet("QDOC_NO_FILE_CACHE");
+    if (!indexMarkers)
+        return code;
+    code->snippetLinesIndexed = true;
+    QString prefix = commentForFile(QFileInfo(userFriendlyFilePath).fileName()) + " [";
+    trimWhiteSpace(prefix);
+    for (qsizetype i = 0; i < code->plainLines.size(); ++i) {
+        QString str = code->plainLines.at(i);
+        if (!str.contains(prefix.front()))
+            continue;
+        while (str.endsWith(QLatin1Char('\n')))
+            str.chop(1);
+        trimWhiteSpace(str);
+        for (qsizetype from = str.indexOf(prefix); from != -1;
+             from = str.indexOf(prefix, from + 1)) {
+            const qsizetype to = str.indexOf(QLatin1Char(']'), from + prefix.size());
+            if (to == -1)
+                break;
+            QList<qsizetype> &lines = code->snippetLines[str.sliced(from, to - from + 1)];
+            if (lines.isEmpty() || lines.last() != i)
+                lines << i;
+        }
+    }
+    return code;
 }
 
 QString Quoter::quoteLine(const Location &docLocation, const QString &command,
                           const QString &pattern)
 {
-    if (m_plainLines.isEmpty()) {
+    if (atEnd()) {
         failedAtEnd(docLocation, command);
         return QString();
     }
@@ -168,7 +210,7 @@ QString Quoter::quoteLine(const Location &docLocation, const QString &command,
         return QString();
     }
 
-    if (match(docLocation, pattern, m_plainLines.first()))
+    if (match(docLocation, pattern, currentLine()))
         return getLine();
 
     if (!m_silent) {
@@ -186,8 +228,19 @@ QString Quoter::quoteSnippet(const Location &docLocation, const QString &identif
     QString t;
     int indent = 0;
 
-    while (!m_plainLines.isEmpty()) {
-        if (match(docLocation, delimiter, m_plainLines.first())) {
+    // Go straight to the first marker, unless the identifier has
+    // brackets that the index of the markers does not account for
+    QString key = delimiter;
+    trimWhiteSpace(key);
+    if (!atEnd() && m_code->snippetLinesIndexed
+        && key.indexOf(QLatin1Char(']')) == key.size() - 1) {
+        const QList<qsizetype> lines = m_code->snippetLines.value(key);
+        const auto it = std::lower_bound(lines.cbegin(), lines.cend(), m_line);
+        skipTo(it != lines.cend() ? *it : m_code->plainLines.size());
+    }
+
+    while (!atEnd()) {
+        if (match(docLocation, delimiter, currentLine())) {
             QString startLine = getLine();
             while (indent < startLine.size() && startLine[indent] == QLatin1Char(' '))
                 indent++;
@@ -195,8 +248,8 @@ QString Quoter::quoteSnippet(const Location &docLocation, const QString &identif
         }
         getLine();
     }
-    while (!m_plainLines.isEmpty()) {
-        QString line = m_plainLines.first();
+    while (!atEnd()) {
+        QString line = currentLine();
         if (match(docLocation, delimiter, line)) {
             QString lastLine = getLine(indent);
             qsizetype dIndex = lastLine.indexOf(delimiter);
@@ -227,13 +280,13 @@ QString Quoter::quoteTo(const Location &docLocation, const QString &command, con
     QString comment = commentForCode();
 
     if (pattern.isEmpty()) {
-        while (!m_plainLines.isEmpty()) {
-            QString line = m_plainLines.first();
+        while (!atEnd()) {
+            QString line = currentLine();
             t += removeSpecialLines(line, comment);
         }
     } else {
-        while (!m_plainLines.isEmpty()) {
-            if (match(docLocation, pattern, m_plainLines.first())) {
+        while (!atEnd()) {
+            if (match(docLocation, pattern, currentLine())) {
                 return t;
             }
             t += getLine();
@@ -251,14 +304,22 @@ QString Quoter::quoteUntil(const Location &docLocation, const QString &command,
     return t;
 }
 
+/*
+  Skips the lines up to \a line, which must not come before the
+  current one.
+*/
+void Quoter::skipTo(qsizetype line)
+{
+    m_codeLocation.advanceLines(m_code->lineOffsets.at(line) - m_code->lineOffsets.at(m_line));
+    m_line = line;
+}
+
 QString Quoter::getLine(int unindent)
 {
-    if (m_plainLines.isEmpty())
+    if (atEnd())
         return QString();
 
-    m_plainLines.removeFirst();
-
-    QString t = m_markedLines.takeFirst();
+    QString t = m_code->markedLines.at(m_line++);
     int i = 0;
     while (i < unindent && i < t.size() && t[i] == QLatin1Char(' '))
         i++;
@@ -306,10 +367,29 @@ void Quoter::failedAtEnd(const Location &docLocation, const QString &command)
 
 QString Quoter::commentForCode() const
 {
-    QFileInfo fi = QFileInfo(m_codeLocation.fileName());
+    return commentForFile(m_codeLocation.fileName());
+}
+
+QString Quoter::commentForFile(const QString &fileName)
+{
+    /* We're going to hard code these delimiters:
+        * C++, Qt, Qt Script, Java:
+          //! [<id>]
+        * .pro, .py, CMake files:
+          #! [<id>]
+        * .html, .qrc, .ui, .xq, .xml files:
+          <!-- [<id>] -->
+    */
+    static const QHash<QString, QString> commentHash {
+        { "pro", "#!" },     { "py", "#!" },     { "cmake", "#!" },
+        { "html", "<!--" },  { "qrc", "<!--" },  { "ui", "<!--" },
+        { "xml", "<!--" },   { "xq", "<!--" },
+    };
+
+    QFileInfo fi = QFileInfo(fileName);
     if (fi.fileName() == "CMakeLists.txt")
         return "#!";
-    return s_commentHash.value(fi.suffix(), "//!");
+    return commentHash.value(fi.suffix(), "//!");
 }
 
 QString Quoter::removeSpecialLines(const QString &line, const QString &comment, int unindent)
@@ -7,37 +7,59 @@
 #include "location.h"
 
 #include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qstringlist.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class Quoter
 {
 public:
-    Quoter();
+    // The logical lines of a quoted file, with the lines that each
+    // snippet marker is found on. It can be shared between quoters.
+    struct Code
+    {
+        QStringList plainLines;
+        QStringList markedLines;
+        QList<int> lineOffsets; // in the file, of each line and of its end
+        QHash<QString, QList<qsizetype>> snippetLines;
+        bool snippetLinesIndexed { false };
+        bool markedCodeMismatch { false };
+    };
+
+    Quoter() = default;
 
     void reset();
     void quoteFromFile(const QString &userFriendlyFileName, const QString &plainCode,
                        const QString &markedCode);
+    void quoteFromFile(const QString &userFriendlyFileName, std::shared_ptr<const Code> code);
     QString quoteLine(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteTo(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteUntil(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteSnippet(const Location &docLocation, const QString &identifier);
 
     static QStringList splitLines(const QString &line);
+    static std::shared_ptr<const Code> splitCode(const QString &userFriendlyFileName,
+                                                 const QString &plainCode,
+                                                 const QString &markedCode);
 
 private:
+    [[nodiscard]] bool atEnd() const { return !m_code || m_line == m_code->plainLines.size(); }
+    [[nodiscard]] const QString &currentLine() const { return m_code->plainLines.at(m_line); }
+    void skipTo(qsizetype line);
     QString getLine(int unindent = 0);
     void failedAtEnd(const Location &docLocation, const QString &command);
     bool match(const Location &docLocation, const QString &pattern, const QString &line);
     [[nodiscard]] QString commentForCode() const;
+    static QString commentForFile(const QString &fileName);
     QString removeSpecialLines(const QString &line, const QString &comment, int unindent = 0);
 
     bool m_silent {};
-    QStringList m_plainLines {};
-    QStringList m_markedLines {};
+    std::shared_ptr<const Code> m_code {};
+    qsizetype m_line {};
     Location m_codeLocation {};
-    static QHash<QString, QString> s_commentHash;
 };
 
 QT_END_NAMESPACE
@@ -21,7 +21,7 @@
 
 QT_BEGIN_NAMESPACE
 
-QList<Section> Sections::s_stdSummarySections {
+thread_local QList<Section> Sections::s_stdSummarySections {
     { "Namespaces",       "namespace",       "namespaces",       "", Section::Summary },
     { "Classes",          "class",           "classes",          "", Section::Summary },
     { "Types",            "type",            "types",            "", Section::Summary },
@@ -31,7 +31,7 @@ QList<Section> Sections::s_stdSummarySections {
     { "Macros",           "macro",           "macros",           "", Section::Summary },
 };
 
-QList<Section> Sections::s_stdDetailsSections {
+thread_local QList<Section> Sections::s_stdDetailsSections {
     { "Namespaces",             "namespace",       "namespaces",       "nmspace", Section::Details },
     { "Classes",                "class",           "classes",          "classes", Section::Details },
     { "Type Documentation",     "type",            "types",            "types",   Section::Details },
@@ -41,7 +41,7 @@ QList<Section> Sections::s_stdDetailsSections {
     { "Macro Documentation",    "macro",           "macros",           "macros",  Section::Details },
 };
 
-QList<Section> Sections::s_stdCppClassSummarySections {
+thread_local QList<Section> Sections::s_stdCppClassSummarySections {
     { "Public Types",             "public type",             "public types",             "", Section::Summary },
     { "Properties",               "property",                "properties",               "", Section::Summary },
     { "Public Functions",         "public function",         "public functions",         "", Section::Summary },
@@ -62,7 +62,7 @@ QList<Section> Sections::s_stdCppClassSummarySections {
     { "Macros",                   "macro",                   "macros",                   "", Section::Summary },
 };
 
-QList<Section> Sections::s_stdCppClassDetailsSections {
+thread_local QList<Section> Sections::s_stdCppClassDetailsSections {
     { "Member Type Documentation",     "member", "members", "types",     Section::Details },
     { "Property Documentation",        "member", "members", "prop",      Section::Details },
     { "Member Function Documentation", "member", "members", "func",      Section::Details },
@@ -71,7 +71,7 @@ QList<Section> Sections::s_stdCppClassDetailsSections {
     { "Macro Documentation",           "member", "members", "macros",    Section::Details },
 };
 
-QList<Section> Sections::s_stdQmlTypeSummarySections {
+thread_local QList<Section> Sections::s_stdQmlTypeSummarySections {
     { "Properties",          "property",          "properties",          "", Section::Summary },
     { "Attached Properties", "attached property", "attached properties", "", Section::Summary },
     { "Signals",             "signal",            "signals",             "", Section::Summary },
@@ -81,7 +81,7 @@ QList<Section> Sections::s_stdQmlTypeSummarySections {
     { "Attached Methods",    "attached method",   "attached methods",    "", Section::Summary },
 };
 
-QList<Section> Sections::s_stdQmlTypeDetailsSections {
+thread_local QList<Section> Sections::s_stdQmlTypeDetailsSections {
     { "Property Documentation",          "member",         "members",         "qmlprop",    Section::Details },
     { "Attached Property Documentation", "member",         "members",         "qmlattprop", Section::Details },
     { "Signal Documentation",            "signal",         "signals",         "qmlsig",     Section::Details },
@@ -91,7 +91,7 @@ QList<Section> Sections::s_stdQmlTypeDetailsSections {
     { "Attached Method Documentation",   "member",         "members",         "qmlattmeth", Section::Details },
 };
 
-QList<Section> Sections::s_sinceSections {
+thread_local QList<Section> Sections::s_sinceSections {
     { "New Namespaces",              "", "", "", Section::Details },
     { "New Classes",                 "", "", "", Section::Details },
     { "New Member Functions",        "", "", "", Section::Details },
@@ -110,7 +110,7 @@ QList<Section> Sections::s_sinceSections {
     { "New QML Methods",             "", "", "", Section::Details },
 };
 
-QList<Section> Sections::s_allMembers{ { "", "member", "members", "", Section::AllMembers } };
+thread_local QList<Section> Sections::s_allMembers{ { "", "member", "members", "", Section::AllMembers } };
 
 /*!
   \class Section
@@ -191,14 +191,14 @@ private:
 private:
     Aggregate *m_aggregate { nullptr };
 
-    static SectionVector s_stdSummarySections;
-    static SectionVector s_stdDetailsSections;
-    static SectionVector s_stdCppClassSummarySections;
-    static SectionVector s_stdCppClassDetailsSections;
-    static SectionVector s_stdQmlTypeSummarySections;
-    static SectionVector s_stdQmlTypeDetailsSections;
-    static SectionVector s_sinceSections;
-    static SectionVector s_allMembers;
+    static thread_local SectionVector s_stdSummarySections;
+    static thread_local SectionVector s_stdDetailsSections;
+    static thread_local SectionVector s_stdCppClassSummarySections;
+    static thread_local SectionVector s_stdCppClassDetailsSections;
+    static thread_local SectionVector s_stdQmlTypeSummarySections;
+    static thread_local SectionVector s_stdQmlTypeDetailsSections;
+    static thread_local SectionVector s_sinceSections;
+    static thread_local SectionVector s_allMembers;
 };
 
 QT_END_NAMESPACE
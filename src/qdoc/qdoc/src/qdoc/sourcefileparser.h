@@ -71,6 +71,19 @@ public:
         Q_UNREACHABLE();
     }
 
+    // Lets the C++ parser start parsing the C++ files among sources in
+    // the background, with the given number of threads.
+    void parseAhead(const std::vector<QString>& sources, int thread_count) {
+        std::vector<QString> cpp_sources{};
+        for (const auto& source : sources) {
+            const SourceFileTag tag{tag_source_file(source).second};
+            if (std::holds_alternative<CppSourceFile>(tag) || std::holds_alternative<CppHeaderSourceFile>(tag))
+                cpp_sources.push_back(source);
+        }
+
+        cpp_file_parser.parseAhead(cpp_sources, thread_count);
+    }
+
 private:
     ParseResult operator()(const QString& path, CppSourceFile) {
          auto [untied, tied] = cpp_file_parser.parse_cpp_file(path);
@@ -33,6 +33,8 @@ protected:
     void generateDocumentation(Node *node) override;
     void generateExampleFilePage(const Node *en, ResolvedFile file, CodeMarker *marker = nullptr) override;
     [[nodiscard]] QString fileExtension() const override;
+    // WebXML pages are generated by the serial traversal only
+    std::unique_ptr<Generator> createRenderingContext() const override { return nullptr; }
 
     virtual const Atom *addAtomElements(QXmlStreamWriter &writer, const Atom *atom,
                                         const Node *relative, CodeMarker *marker);
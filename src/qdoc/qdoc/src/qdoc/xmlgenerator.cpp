@@ -10,6 +10,8 @@
 #include "qdocdatabase.h"
 #include "typedefnode.h"
 
+#include <QtCore/qmutex.h>
+
 using namespace Qt::Literals::StringLiterals;
 
 QT_BEGIN_NAMESPACE
@@ -97,6 +99,9 @@ void XmlGenerator::rewritePropertyBrief(const Atom *atom, const Node *relative)
 {
     if (relative->nodeType() != Node::Property && relative->nodeType() != Node::Variable)
         return;
+    // The brief may be rendered by several threads at once
+    static QMutex mutex;
+    QMutexLocker locker(&mutex);
     atom = atom->next();
     if (!atom || atom->type() != Atom::String)
         return;
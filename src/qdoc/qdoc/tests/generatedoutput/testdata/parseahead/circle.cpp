@@ -0,0 +1,41 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include "shapes.h"
+
+namespace Shapes {
+
+/*!
+    \class Shapes::Circle
+    \inmodule ParseAhead
+    \ingroup allshapes
+    \brief A circle.
+*/
+
+/*!
+    Constructs a circle with the given \a radius.
+*/
+Circle::Circle(double radius) : m_radius(radius) { }
+
+/*!
+    \reimp
+*/
+double Circle::area() const
+{
+    return 3.14159 * m_radius * m_radius;
+}
+
+/*!
+    \reimp
+*/
+const char *Circle::name() const
+{
+    return "circle";
+}
+
+/*!
+    \fn double Shapes::Circle::radius() const
+
+    Returns the radius of the circle.
+*/
+
+} // namespace Shapes
@@ -0,0 +1,35 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include "shapes.h"
+
+namespace Shapes {
+
+/*!
+    \class Shapes::Shape
+    \inmodule ParseAhead
+    \ingroup allshapes
+    \brief The base class of all shapes.
+
+    \sa Shapes::Circle, Shapes::Square
+*/
+
+/*!
+    Destroys the shape.
+*/
+Shape::~Shape() = default;
+
+/*!
+    \fn double Shapes::Shape::area() const
+
+    Returns the area of the shape.
+*/
+
+/*!
+    Returns the name of the shape.
+*/
+const char *Shape::name() const
+{
+    return "shape";
+}
+
+} // namespace Shapes
@@ -0,0 +1,42 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#pragma once
+
+namespace Shapes {
+
+class Shape
+{
+public:
+    virtual ~Shape();
+    virtual double area() const = 0;
+    virtual const char *name() const;
+};
+
+class Circle : public Shape
+{
+public:
+    explicit Circle(double radius);
+    double area() const override;
+    const char *name() const override;
+    double radius() const { return m_radius; }
+
+private:
+    double m_radius;
+};
+
+class Square : public Shape
+{
+public:
+    explicit Square(double side);
+    double area() const override;
+    const char *name() const override;
+    void scale(double factor);
+    void scale(double factorX, double factorY);
+
+private:
+    double m_side;
+};
+
+double totalArea(const Shape *const *shapes, int count);
+
+} // namespace Shapes
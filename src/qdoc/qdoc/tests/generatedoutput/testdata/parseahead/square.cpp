@@ -0,0 +1,53 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include "shapes.h"
+
+namespace Shapes {
+
+/*!
+    \class Shapes::Square
+    \inmodule ParseAhead
+    \ingroup allshapes
+    \brief A square.
+*/
+
+/*!
+    Constructs a square with the given \a side.
+*/
+Square::Square(double side) : m_side(side) { }
+
+/*!
+    \reimp
+*/
+double Square::area() const
+{
+    return m_side * m_side;
+}
+
+/*!
+    \reimp
+*/
+const char *Square::name() const
+{
+    return "square";
+}
+
+/*!
+    Scales the square by \a factor.
+*/
+void Square::scale(double factor)
+{
+    m_side *= factor;
+}
+
+/*!
+    \overload
+
+    Scales the square by the larger of \a factorX and \a factorY.
+*/
+void Square::scale(double factorX, double factorY)
+{
+    scale(factorX > factorY ? factorX : factorY);
+}
+
+} // namespace Shapes
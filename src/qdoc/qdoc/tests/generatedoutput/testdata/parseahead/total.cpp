@@ -0,0 +1,18 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+#include "shapes.h"
+
+namespace Shapes {
+
+/*!
+    Returns the sum of the areas of the \a count shapes in \a shapes.
+*/
+double totalArea(const Shape *const *shapes, int count)
+{
+    double total = 0;
+    for (int i = 0; i < count; ++i)
+        total += shapes[i]->area();
+    return total;
+}
+
+} // namespace Shapes
@@ -0,0 +1,38 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+// [first]
+int first()
+{
+    return 1;
+}
+// [first]
+
+// [repeated]
+int repeated()
+{
+    return 2;
+}
+// [repeated]
+
+// [outer]
+int outer()
+{
+    // [inner]
+    int inner = 3;
+    // [inner]
+    return inner;
+}
+// [outer]
+
+// [repeated]
+int repeatedAgain()
+{
+    return 4;
+}
+// [repeated]
+
+int last()
+{
+    return 5;
+}
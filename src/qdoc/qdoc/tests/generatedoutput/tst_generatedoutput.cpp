@@ -18,6 +18,10 @@ private slots:
 
     // HTML generator
     void htmlFromCpp();
+    void htmlFromCppInParallel();
+    void htmlFromCppParsedAhead();
+    void htmlFromCppWithParseCache();
+    void htmlWithQuotedFileCache();
 
     // Output format independent tests
     void inheritedQmlPropertyGroups();
@@ -36,10 +40,13 @@ private:
     QString m_extraParams;
     bool m_regen = false;
 
-    void runQDocProcess(const QStringList &arguments);
+    void runQDocProcess(const QStringList &arguments, QByteArray *debugOutput = nullptr,
+                        const QStringList &environment = {});
     void compareLineByLine(const QStringList &expectedFiles);
     void testAndCompare(const char *input, const char *outNames, const char *extraParams = nullptr);
     void copyIndexFiles();
+    void compareSerialAndParallel(const char *input, const QStringList &extraParams,
+                                  const QStringList &expectedFiles = {});
 };
 
 void tst_generatedOutput::initTestCase()
@@ -71,11 +78,23 @@ void tst_generatedOutput::init()
     }
 }
 
-void tst_generatedOutput::runQDocProcess(const QStringList &arguments)
+// Stores the standard error output of QDoc, with its debug messages
+// enabled, in \a debugOutput if that is given. The variables named in
+// \a environment are set for QDoc.
+void tst_generatedOutput::runQDocProcess(const QStringList &arguments, QByteArray *debugOutput,
+                                         const QStringList &environment)
 {
     QProcess qdocProcess;
     qdocProcess.setProgram(m_qdoc);
     qdocProcess.setArguments(arguments);
+    if (debugOutput || !environment.isEmpty()) {
+        QProcessEnvironment processEnvironment = QProcessEnvironment::systemEnvironment();
+        if (debugOutput)
+            processEnvironment.insert("QT_LOGGING_RULES", "qt.qdoc.debug=true");
+        for (const QString &variable : environment)
+            processEnvironment.insert(variable, "1");
+        qdocProcess.setProcessEnvironment(processEnvironment);
+    }
 
     auto failQDoc = [&](QProcess::ProcessError) {
         QFAIL(qPrintable(QStringLiteral("Running qdoc failed with exit code %1: %2")
@@ -85,10 +104,13 @@ void tst_generatedOutput::runQDocProcess(const QStringList &arguments)
 
     qdocProcess.start();
     qdocProcess.waitForFinished();
+    const QByteArray errorOutput = qdocProcess.readAllStandardError();
+    if (debugOutput)
+        *debugOutput = errorOutput;
     if (qdocProcess.exitCode() == 0)
         return;
 
-    QString errors = qdocProcess.readAllStandardError();
+    QString errors = errorOutput;
     if (!errors.isEmpty())
         qInfo().nospace() << "Received errors:\n" << qUtf8Printable(errors);
     if (!QTest::currentTestFailed())
@@ -165,6 +187,58 @@ void tst_generatedOutput::copyIndexFiles()
     }
 }
 
+// Returns the contents of the files in \a dir, by their relative paths
+static QMap<QString, QByteArray> readOutputFiles(const QString &dir)
+{
+    QMap<QString, QByteArray> files;
+    QDirIterator it(dir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QFile file(it.next());
+        if (file.open(QIODevice::ReadOnly))
+            files.insert(QDir(dir).relativeFilePath(file.fileName()), file.readAll());
+    }
+    return files;
+}
+
+// Copies the files in \a source to \a target, with their subdirectories
+static bool copyDirectory(const QString &source, const QString &target)
+{
+    QDirIterator it(source, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        const QString filePath = it.next();
+        const QString copy = QDir(target).filePath(QDir(source).relativeFilePath(filePath));
+        if (!QDir().mkpath(QFileInfo(copy).path()) || !QFile::copy(filePath, copy))
+            return false;
+    }
+    return true;
+}
+
+// Runs QDoc on \a input with one and with four threads and requires
+// the same files, with the same contents, in both output directories
+void tst_generatedOutput::compareSerialAndParallel(const char *input,
+                                                   const QStringList &extraParams,
+                                                   const QStringList &expectedFiles)
+{
+    QMap<QString, QByteArray> outputs[2];
+    for (int i = 0; i < 2; ++i) {
+        QTemporaryDir outputDir;
+        QVERIFY(outputDir.isValid());
+        QStringList args{ "-outputdir", outputDir.path() + "/", QFINDTESTDATA(input),
+                          "-threads", i ? "4" : "1" };
+        runQDocProcess(args + extraParams);
+        if (QTest::currentTestFailed())
+            return;
+        outputs[i] = readOutputFiles(outputDir.path());
+    }
+
+    QCOMPARE(outputs[1].keys(), outputs[0].keys());
+    QVERIFY(!outputs[0].isEmpty());
+    for (const QString &file : expectedFiles)
+        QVERIFY2(outputs[0].contains(file), qPrintable(file));
+    for (auto it = outputs[0].cbegin(); it != outputs[0].cend(); ++it)
+        QVERIFY2(outputs[1].value(it.key()) == it.value(), qPrintable(it.key()));
+}
+
 void tst_generatedOutput::htmlFromCpp()
 {
     testAndCompare("testdata/configs/testcpp.qdocconf",
@@ -181,6 +255,171 @@ void tst_generatedOutput::htmlFromCpp()
                    "testqdoc.html");
 }
 
+void tst_generatedOutput::htmlFromCppInParallel()
+{
+    // Sources parsed and pages rendered by worker threads must give
+    // the output of the serial mode
+    QScopedValueRollback<bool> skipRegen(m_regen, false);
+    testAndCompare("testdata/configs/testcpp.qdocconf",
+                   "testcpp-module.html "
+                   "testqdoc-test.html "
+                   "testqdoc-test-members.html "
+                   "testqdoc-test-obsolete.html "
+                   "testqdoc-testderived.html "
+                   "testqdoc-testderived-members.html "
+                   "testqdoc-testderived-obsolete.html "
+                   "obsolete-classes.html "
+                   "autolinking.html "
+                   "cpptypes.html "
+                   "testqdoc.html",
+                   "-threads 4");
+    if (QTest::currentTestFailed())
+        return;
+
+    // Groups and modules with members in more than one project are
+    // merged once for all pages, whatever the number of threads
+    copyIndexFiles();
+    compareSerialAndParallel("testdata/crossmodule/crossmodule.qdocconf",
+                             { "-indexdir", m_outputDir->path() });
+    if (QTest::currentTestFailed())
+        return;
+    compareSerialAndParallel("testdata/singleexec/singleexec.qdocconf", { "-single-exec" });
+}
+
+void tst_generatedOutput::htmlFromCppParsedAhead()
+{
+    // The classes are documented in several source files, which worker
+    // threads parse ahead of the documentation being read from them
+    compareSerialAndParallel("testdata/parseahead/parseahead.qdocconf", {},
+                             { "parseahead/parseahead-module.html",
+                               "parseahead/shapes.html",
+                               "parseahead/shapes-shape.html",
+                               "parseahead/shapes-circle.html",
+                               "parseahead/shapes-square.html",
+                               "parseahead/shapes-square-members.html" });
+}
+
+void tst_generatedOutput::htmlFromCppWithParseCache()
+{
+    // The second run loads the parsed source from the cache
+    QScopedValueRollback<bool> skipRegen(m_regen, false);
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    const QByteArray extraParams = "-parsecache " + cacheDir.path().toLocal8Bit();
+    for (int run = 0; run < 2; ++run) {
+        testAndCompare("testdata/configs/testcpp.qdocconf",
+                       "testcpp-module.html "
+                       "testqdoc-test.html "
+                       "testqdoc-test-members.html "
+                       "testqdoc-test-obsolete.html "
+                       "testqdoc-testderived.html "
+                       "testqdoc-testderived-members.html "
+                       "testqdoc-testderived-obsolete.html "
+                       "obsolete-classes.html "
+                       "autolinking.html "
+                       "cpptypes.html "
+                       "testqdoc.html",
+                       extraParams.constData());
+        if (QTest::currentTestFailed())
+            return;
+    }
+    QVERIFY(!QDir(cacheDir.path()).isEmpty());
+
+    // In a copy of the sources, count the hits and change a header
+    QTemporaryDir sourceDir;
+    QVERIFY(sourceDir.isValid());
+    for (const char *dir : { "configs", "images", "testcpp" }) {
+        QVERIFY(copyDirectory(QFINDTESTDATA("testdata/" + QString::fromLatin1(dir)),
+                              sourceDir.filePath(QString::fromLatin1(dir))));
+    }
+    QTemporaryDir copyCacheDir;
+    QVERIFY(copyCacheDir.isValid());
+
+    static const QRegularExpression statistics("Parse cache .*: (\\d+) hits, (\\d+) misses");
+    QMap<QString, QByteArray> firstOutput;
+    const auto run = [&](int expectedHits, int expectedMisses) {
+        QTemporaryDir outputDir;
+        QVERIFY(outputDir.isValid());
+        QByteArray log;
+        runQDocProcess({ "-outputdir", outputDir.path() + "/",
+                         sourceDir.filePath("configs/testcpp.qdocconf"),
+                         "-parsecache", copyCacheDir.path() },
+                       &log);
+        if (QTest::currentTestFailed())
+            return;
+
+        const QRegularExpressionMatch match = statistics.match(QString::fromLocal8Bit(log));
+        QVERIFY2(match.hasMatch(), log.constData());
+        QCOMPARE(match.captured(1).toInt(), expectedHits);
+        QCOMPARE(match.captured(2).toInt(), expectedMisses);
+
+        // Documentation taken from the cache gives the same pages
+        const QMap<QString, QByteArray> output = readOutputFiles(outputDir.path());
+        if (firstOutput.isEmpty())
+            firstOutput = output;
+        QCOMPARE(output.keys(), firstOutput.keys());
+        for (auto it = output.cbegin(); it != output.cend(); ++it)
+            QVERIFY2(firstOutput.value(it.key()) == it.value(), qPrintable(it.key()));
+    };
+
+    run(0, 1);
+    if (QTest::currentTestFailed())
+        return;
+    run(1, 0);
+    if (QTest::currentTestFailed())
+        return;
+
+    // An included header that changed makes the source file parsed again
+    QFile header(sourceDir.filePath("testcpp/testcpp.h"));
+    QVERIFY(header.open(QIODevice::Append));
+    QVERIFY(header.write("\n// Changed after the source was cached\n") > 0);
+    header.close();
+    run(0, 1);
+    if (QTest::currentTestFailed())
+        return;
+    run(1, 0);
+}
+
+void tst_generatedOutput::htmlWithQuotedFileCache()
+{
+    // The pages quote from and include the same files, which QDoc reads
+    // once. With QDOC_NO_FILE_CACHE set, it reads them for every quote
+    // and searches them for snippets line by line, which must give the
+    // same pages and warnings.
+    QMap<QString, QByteArray> outputs[2];
+    QStringList warnings[2];
+    for (int i = 0; i < 2; ++i) {
+        QTemporaryDir outputDir;
+        QVERIFY(outputDir.isValid());
+        QByteArray log;
+        runQDocProcess({ "-outputdir", outputDir.path() + "/",
+                         QFINDTESTDATA("testdata/quotecache/quotecache.qdocconf") },
+                       &log, i ? QStringList{ "QDOC_NO_FILE_CACHE" } : QStringList());
+        if (QTest::currentTestFailed())
+            return;
+        for (const QByteArray &line : log.split('\n')) {
+            if (line.contains("warning: "))
+                warnings[i] << QString::fromLocal8Bit(line);
+        }
+        warnings[i].sort();
+        outputs[i] = readOutputFiles(outputDir.path());
+    }
+
+    for (const char *page : { "quotecache/quotecache-first.html",
+                              "quotecache/quotecache-second.html",
+                              "quotecache/quotecache-third.html" }) {
+        QVERIFY2(outputs[0].contains(page), page);
+    }
+    QCOMPARE(outputs[1].keys(), outputs[0].keys());
+    for (auto it = outputs[0].cbegin(); it != outputs[0].cend(); ++it)
+        QVERIFY2(outputs[1].value(it.key()) == it.value(), qPrintable(it.key()));
+
+    // A missing snippet is reported on each page that quotes it
+    QCOMPARE(warnings[0].filter("failed at end of file").size(), 2);
+    QCOMPARE(warnings[0].filter("Cannot find 'missing'").size(), 2);
+    QCOMPARE(warnings[1], warnings[0]);
+}
+
 void tst_generatedOutput::inheritedQmlPropertyGroups()
 {
     testAndCompare("testdata/qmlpropertygroups/qmlpropertygroups.qdocconf",
@@ -305,3 +305,141 @@ TEST_CASE(
         QFileInfo{greatest_lower_bound.value() + "/" + relative_path}.canonicalFilePath()
     );
 }
+
+TEST_CASE(
+    "When a query has components that refer to the current or parent directory, it is resolved as the filesystem resolves it",
+    "[ResolvingFiles][File][Path][Validation][SpecialCase]"
+) {
+    QTemporaryDir working_directory{};
+    REQUIRE(working_directory.isValid());
+
+    REQUIRE(QDir{working_directory.path()}.mkpath("foo/bar"));
+    REQUIRE(QFile{working_directory.path() + "/foo/file.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+
+    FileResolver file_resolver{std::vector{*DirectoryPath::refine(working_directory.path())}};
+
+    QString query = GENERATE(as<QString>{}, "foo/./file.txt", "./foo/file.txt", "foo/bar/../file.txt", "foo//file.txt");
+    CAPTURE(query);
+
+    auto maybe_resolved_file{file_resolver.resolve(query)};
+
+    REQUIRE(maybe_resolved_file);
+    REQUIRE(maybe_resolved_file->get_path() == QFileInfo{working_directory.path() + "/foo/file.txt"}.canonicalFilePath());
+}
+
+TEST_CASE(
+    "When a query reaches directories that were already listed, it is resolved from their listings",
+    "[ResolvingFiles][File][Path][Validation][Listing]"
+) {
+    QTemporaryDir working_directory{};
+    REQUIRE(working_directory.isValid());
+
+    REQUIRE(QDir{working_directory.path()}.mkpath("foo"));
+    REQUIRE(QFile{working_directory.path() + "/foo/first.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+    REQUIRE(QFile{working_directory.path() + "/foo/second.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+
+    FileResolver file_resolver{std::vector{*DirectoryPath::refine(working_directory.path())}};
+
+    // Lists the search directory and foo.
+    REQUIRE(file_resolver.resolve("foo/first.txt"));
+
+    QString query = GENERATE(as<QString>{}, "foo/first.txt", "foo/second.txt");
+    CAPTURE(query);
+
+    auto maybe_resolved_file{file_resolver.resolve(query)};
+
+    REQUIRE(maybe_resolved_file);
+    REQUIRE(maybe_resolved_file->get_path() == QFileInfo{working_directory.path() + "/" + query}.canonicalFilePath());
+    REQUIRE(!file_resolver.resolve("foo/third.txt"));
+}
+
+TEST_CASE(
+    "When a query is a nested relative path, each of its components is looked up in the directory before it",
+    "[ResolvingFiles][File][Path][Validation][Listing]"
+) {
+    QTemporaryDir working_directory{};
+    REQUIRE(working_directory.isValid());
+
+    REQUIRE(QDir{working_directory.path()}.mkpath("foo/bar/baz"));
+    REQUIRE(QFile{working_directory.path() + "/foo/bar/baz/file.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+    REQUIRE(QFile{working_directory.path() + "/foo/bar/other.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+
+    FileResolver file_resolver{std::vector{*DirectoryPath::refine(working_directory.path())}};
+
+    SECTION("Paths to files in nested directories are resolved") {
+        QString query = GENERATE(as<QString>{}, "foo/bar/baz/file.txt", "foo/bar/other.txt");
+        CAPTURE(query);
+
+        auto maybe_resolved_file{file_resolver.resolve(query)};
+
+        REQUIRE(maybe_resolved_file);
+        REQUIRE(maybe_resolved_file->get_path() == QFileInfo{working_directory.path() + "/" + query}.canonicalFilePath());
+    }
+
+    SECTION("Paths that miss a component, or end in a directory, are not resolved") {
+        QString query = GENERATE(as<QString>{}, "foo/baz/file.txt", "foo/bar/file.txt", "bar/baz/file.txt", "foo/bar/baz", "foo/bar/other.txt/file.txt");
+        CAPTURE(query);
+
+        REQUIRE(!file_resolver.resolve(query));
+    }
+}
+
+TEST_CASE(
+    "When a query names a file in a different case, it is resolved only where the filesystem ignores case",
+    "[ResolvingFiles][File][Path][Validation][Listing]"
+) {
+    QTemporaryDir working_directory{};
+    REQUIRE(working_directory.isValid());
+
+    REQUIRE(QDir{working_directory.path()}.mkpath("Foo"));
+    REQUIRE(QFile{working_directory.path() + "/Foo/File.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+
+    FileResolver file_resolver{std::vector{*DirectoryPath::refine(working_directory.path())}};
+
+    REQUIRE(file_resolver.resolve("Foo/File.txt"));
+
+    QString query = GENERATE(as<QString>{}, "Foo/file.txt", "foo/File.txt", "FOO/FILE.TXT");
+    CAPTURE(query);
+
+    const bool is_case_sensitive{!QFileInfo::exists(working_directory.path() + "/" + query)};
+    auto maybe_resolved_file{file_resolver.resolve(query)};
+
+    if (is_case_sensitive) {
+        REQUIRE(!maybe_resolved_file);
+    } else {
+#if defined(Q_OS_WIN) || defined(Q_OS_DARWIN)
+        REQUIRE(maybe_resolved_file);
+        REQUIRE(maybe_resolved_file->get_path() == QFileInfo{working_directory.path() + "/Foo/File.txt"}.canonicalFilePath());
+#endif
+    }
+}
+
+TEST_CASE(
+    "When a file is created in a directory that was already listed, it is not found",
+    "[ResolvingFiles][File][Path][Validation][Listing][Limitation]"
+) {
+    QTemporaryDir working_directory{};
+    REQUIRE(working_directory.isValid());
+
+    REQUIRE(QDir{working_directory.path()}.mkpath("foo"));
+    REQUIRE(QDir{working_directory.path()}.mkpath("bar"));
+    REQUIRE(QFile{working_directory.path() + "/foo/first.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+
+    FileResolver file_resolver{std::vector{*DirectoryPath::refine(working_directory.path())}};
+
+    // Lists the search directory and foo, but not bar.
+    REQUIRE(file_resolver.resolve("foo/first.txt"));
+
+    REQUIRE(QFile{working_directory.path() + "/foo/later.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+    REQUIRE(QFile{working_directory.path() + "/bar/later.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+    REQUIRE(QDir{working_directory.path()}.mkpath("baz"));
+    REQUIRE(QFile{working_directory.path() + "/baz/later.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+
+    REQUIRE(!file_resolver.resolve("foo/later.txt"));
+    REQUIRE(!file_resolver.resolve("baz/later.txt"));
+    REQUIRE(file_resolver.resolve("bar/later.txt"));
+
+    FileResolver fresh_file_resolver{std::vector{*DirectoryPath::refine(working_directory.path())}};
+    REQUIRE(fresh_file_resolver.resolve("foo/later.txt"));
+    REQUIRE(fresh_file_resolver.resolve("baz/later.txt"));
+}
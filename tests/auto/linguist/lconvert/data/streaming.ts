@@ -0,0 +1,61 @@
+<?xml version="1.0" encoding="utf-8"?>
+<!DOCTYPE TS>
+<TS version="2.1" language="de" sourcelanguage="en">
+<dependencies>
+    <dependency catalog="qtbase_de"/>
+</dependencies>
+<extra-po-header-po_revision_date>2026-01-01 12:00+0100</extra-po-header-po_revision_date>
+<extra-po-header-x_generator>hand</extra-po-header-x_generator>
+<context>
+    <name>Editor</name>
+    <message>
+        <location filename="editor.cpp" line="+12"/>
+        <source>&amp;Open...</source>
+        <translation>Ö&amp;ffnen...</translation>
+    </message>
+    <message numerus="yes">
+        <location line="+7"/>
+        <source>%n file(s) changed</source>
+        <translation>
+            <numerusform>%n Datei geändert</numerusform>
+            <numerusform>%n Dateien geändert</numerusform>
+            <numerusform>too many</numerusform>
+        </translation>
+    </message>
+    <message>
+        <location line="+3"/>
+        <source>Save &quot;%1&quot;?</source>
+        <oldsource>Save %1?</oldsource>
+        <comment>dialog title</comment>
+        <translatorcomment>Keep it short.</translatorcomment>
+        <translation type="unfinished">%1 speichern?</translation>
+        <extra-po-flags>no-wrap</extra-po-flags>
+    </message>
+</context>
+<context>
+    <name>EditorView</name>
+    <message id="editor-view-zoom">
+        <location filename="editor.cpp" line="+40"/>
+        <source>Zoom</source>
+        <extracomment>Menu entry</extracomment>
+        <translation>Zoom</translation>
+    </message>
+</context>
+<context>
+    <name>Settings</name>
+    <message>
+        <location filename="settings.cpp" line="+5"/>
+        <location filename="settings.ui" line="+20"/>
+        <source>General</source>
+        <translation>Allgemein</translation>
+    </message>
+    <message>
+        <source>Removed entry</source>
+        <translation type="vanished">Entfernter Eintrag</translation>
+    </message>
+    <message>
+        <source>Obsolete entry</source>
+        <translation type="obsolete"></translation>
+    </message>
+</context>
+</TS>
@@ -3,6 +3,7 @@
 
 #include <QtTest/QtTest>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QTextStream>
 
 using namespace Qt::Literals::StringLiterals;
@@ -27,6 +28,8 @@ private slots:
     void chains_data();
     void chains();
     void merge();
+    void streams_data();
+    void streams();
 
 private:
     void doWait(QProcess *cvt, int stage);
@@ -369,6 +372,56 @@ void tst_lconvert::merge()
         doCompare(&cvt, dataDir + "idxmerge.ts.out");
 }
 
+void tst_lconvert::streams_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QStringList>("args");
+
+    QTest::newRow("ts-po") << "streaming.ts" << QStringList{ "-of", "po" };
+    QTest::newRow("ts-pot") << "streaming.ts" << QStringList{ "-of", "pot" };
+    QTest::newRow("ts-xlf") << "streaming.ts" << QStringList{ "-of", "xlf" };
+    QTest::newRow("ts-ts (drop-tags)")
+            << "streaming.ts" << QStringList{ "-of", "ts", "-drop-tags", "po-.*" };
+    QTest::newRow("ts-xlf (drop-tags)")
+            << "streaming.ts" << QStringList{ "-of", "xlf", "-drop-tags", "po-flags" };
+    QTest::newRow("ts-ts (filters)")
+            << "streaming.ts"
+            << QStringList{ "-of", "ts", "-no-obsolete", "-no-ui-lines", "-locations", "relative" };
+    QTest::newRow("ts-po (target language)")
+            << "streaming.ts" << QStringList{ "-of", "po", "-target-language", "pl" };
+    QTest::newRow("ts-ts (relative)") << "relative.ts" << QStringList{ "-of", "ts" };
+    QTest::newRow("ts-po (plurals)") << "plurals-de.ts" << QStringList{ "-of", "po" };
+    QTest::newRow("qm-ts") << "untranslated.qm" << QStringList{ "-of", "ts" };
+    QTest::newRow("qm-po") << "untranslated.qm" << QStringList{ "-of", "po" };
+    QTest::newRow("qm-xlf (target language)")
+            << "untranslated.qm" << QStringList{ "-of", "xlf", "-target-language", "de" };
+}
+
+void tst_lconvert::streams()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QStringList, args);
+
+    // Reading from standard input always loads the whole file, so that
+    // output is what the streamed conversion of the same file has to match.
+    QProcess loaded;
+    loaded.setStandardInputFile(dataDir + fileName);
+    loaded.start(lconvert,
+                 QStringList(args) << "-if" << QFileInfo(fileName).suffix() << "-i" << "-");
+    QVERIFY2(loaded.waitForStarted(), qPrintable(loaded.errorString()));
+    doWait(&loaded, 1);
+
+    QProcess streamed;
+    streamed.start(lconvert, QStringList(args) << (dataDir + fileName));
+    QVERIFY2(streamed.waitForStarted(), qPrintable(streamed.errorString()));
+    doWait(&streamed, 2);
+
+    const QByteArray expected = loaded.readAllStandardOutput();
+    QVERIFY(!expected.isEmpty());
+    QCOMPARE(streamed.readAllStandardOutput(), expected);
+    QCOMPARE(streamed.readAllStandardError(), loaded.readAllStandardError());
+}
+
 QTEST_APPLESS_MAIN(tst_lconvert)
 
 #include "tst_lconvert.moc"
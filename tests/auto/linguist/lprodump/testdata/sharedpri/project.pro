@@ -0,0 +1,2 @@
+TEMPLATE = subdirs
+SUBDIRS = sub1 sub2 sub3
@@ -0,0 +1,4 @@
+include(../common.pri)
+include(local.pri)
+
+SOURCES += main.cpp
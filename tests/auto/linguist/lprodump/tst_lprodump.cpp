@@ -0,0 +1,163 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QProcess>
+#include <QtCore/QTemporaryDir>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_lprodump : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_lprodump()
+      : dataDir(QFINDTESTDATA("testdata/"))
+      , lprodump(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath) + "/lprodump") {}
+
+private slots:
+    void sharedPriWarnings_data();
+    void sharedPriWarnings();
+    void diskCache();
+
+private:
+    void runLprodump(const QString &workDir, const QStringList &arguments, QByteArray *errors);
+
+    QString dataDir;
+    QString lprodump;
+};
+
+void tst_lprodump::runLprodump(const QString &workDir, const QStringList &arguments,
+                               QByteArray *errors)
+{
+    QProcess proc;
+    proc.setWorkingDirectory(workDir);
+    proc.start(lprodump, arguments);
+    QVERIFY2(proc.waitForStarted(), qPrintable(lprodump + ": "_L1 + proc.errorString()));
+    QVERIFY(proc.waitForFinished(30000));
+    *errors = proc.readAllStandardError();
+    QVERIFY2(proc.exitStatus() == QProcess::NormalExit && proc.exitCode() == 0,
+             errors->constData());
+}
+
+void tst_lprodump::sharedPriWarnings_data()
+{
+    QTest::addColumn<QString>("jobs");
+
+    QTest::newRow("serial") << u"1"_s;
+    QTest::newRow("parallel") << u"3"_s;
+}
+
+// Every project that includes a .pri file reports its parse errors, in the
+// order of the projects, however many threads evaluate them.
+void tst_lprodump::sharedPriWarnings()
+{
+    QFETCH(QString, jobs);
+
+    const QString workDir = QFileInfo(dataDir + "sharedpri"_L1).canonicalFilePath();
+    QTemporaryDir outDir;
+    QVERIFY(outDir.isValid());
+    QByteArray errors;
+    runLprodump(workDir, { u"project.pro"_s, u"-out"_s, outDir.filePath(u"project.json"_s),
+                           u"-j"_s, jobs }, &errors);
+    if (QTest::currentTestFailed())
+        return;
+
+    QStringList warnings;
+    for (const QByteArray &line : errors.split('\n')) {
+        if (line.contains(".pri:"))
+            warnings << QString::fromLocal8Bit(line);
+    }
+    QStringList expected;
+    for (const QString &sub : { u"sub1"_s, u"sub2"_s, u"sub3"_s }) {
+        expected << "WARNING: %1/common.pri:2: Excess closing brace."_L1.arg(workDir)
+                 << "WARNING: %1/%2/local.pri:2: Excess closing brace."_L1.arg(workDir, sub);
+    }
+    QCOMPARE(warnings, expected);
+}
+
+// The name of the entry that ProFileDiskCache stores a file under.
+static QString diskCacheEntry(const QString &cacheDir, const QString &fileName)
+{
+    const QByteArrayView bytes(reinterpret_cast<const char *>(fileName.utf16()),
+                               fileName.size() * qsizetype(sizeof(char16_t)));
+    return cacheDir + u'/'
+            + QString::fromLatin1(QCryptographicHash::hash(bytes, QCryptographicHash::Sha1).toHex());
+}
+
+static QStringList projectSources(const QString &jsonFile)
+{
+    QFile file(jsonFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    const QJsonArray projects = QJsonDocument::fromJson(file.readAll()).array();
+    QStringList sources;
+    for (const QJsonValue &source : projects.at(0).toObject().value("sources"_L1).toArray())
+        sources << QFileInfo(source.toString()).fileName();
+    return sources;
+}
+
+// A second run uses the stored project, until the project changes.
+void tst_lprodump::diskCache()
+{
+    QTemporaryDir workDir;
+    QTemporaryDir cacheDir;
+    QVERIFY(workDir.isValid());
+    QVERIFY(cacheDir.isValid());
+    const QString work = QFileInfo(workDir.path()).canonicalFilePath();
+    const QString cache = QFileInfo(cacheDir.path()).canonicalFilePath();
+    const QString proFile = work + "/project.pro"_L1;
+    QVERIFY(QFile::copy(dataDir + "diskcache/project.pro"_L1, proFile));
+    QVERIFY(QFile::setPermissions(proFile, QFile::ReadOwner | QFile::WriteOwner));
+    for (const char *source : { "/main.cpp", "/other.cpp" }) {
+        QFile file(work + QLatin1StringView(source));
+        QVERIFY(file.open(QIODevice::WriteOnly));
+    }
+    const QString jsonFile = work + "/project.json"_L1;
+    const QStringList arguments = { u"project.pro"_s, u"-out"_s, jsonFile,
+                                    u"-cache-dir"_s, cache };
+
+    QByteArray errors;
+    runLprodump(work, arguments, &errors);
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(projectSources(jsonFile), QStringList(u"main.cpp"_s));
+    const QString entry = diskCacheEntry(cache, proFile);
+    QVERIFY2(QFile::exists(entry), qPrintable(entry));
+
+    // Entries that are used are not written again.
+    const QDateTime past(QDate(2020, 1, 1), QTime(0, 0));
+    {
+        QFile file(entry);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(past, QFileDevice::FileModificationTime));
+    }
+    runLprodump(work, arguments, &errors);
+    if (QTest::currentTestFailed())
+        return;
+    QCOMPARE(QFileInfo(entry).lastModified(), past);
+    QCOMPARE(projectSources(jsonFile), QStringList(u"main.cpp"_s));
+
+    // A changed project is parsed again.
+    {
+        QFile file(proFile);
+        QVERIFY(file.open(QIODevice::Append | QIODevice::Text));
+        file.write("SOURCES += other.cpp\n");
+    }
+    runLprodump(work, arguments, &errors);
+    if (QTest::currentTestFailed())
+        return;
+    QVERIFY(QFileInfo(entry).lastModified() != past);
+    QCOMPARE(projectSources(jsonFile), QStringList({ u"main.cpp"_s, u"other.cpp"_s }));
+}
+
+QTEST_MAIN(tst_lprodump)
+#include "tst_lprodump.moc"
@@ -27,6 +27,8 @@ private slots:
     void markuntranslated();
     void dupes();
     void noTranslations();
+    void parallel();
+    void parallelFailure();
 
 private:
     void doCompare(const QStringList &actual, const QString &expectedFn);
@@ -194,5 +196,76 @@ void tst_lrelease::noTranslations()
     QVERIFY(stderrOutput.contains("lrelease warning: Met no 'TRANSLATIONS' entry in project file"));
 }
 
+void tst_lrelease::parallel()
+{
+    const QStringList tsFiles = { "translate.ts", "dupes.ts", "compressed.ts" };
+
+    // Release the same files serially and in parallel, each in a directory
+    // of its own, and expect the same files and the same report.
+    QByteArray output[2];
+    QTemporaryDir dirs[2];
+    for (int run = 0; run < 2; ++run) {
+        QVERIFY(dirs[run].isValid());
+        for (const QString &tsFile : tsFiles)
+            QVERIFY(QFile::copy(dataDir + tsFile, dirs[run].filePath(tsFile)));
+
+        QStringList args = tsFiles;
+        if (run == 1)
+            args = QStringList { "-j", "3" } + args;
+        QProcess proc;
+        proc.setWorkingDirectory(dirs[run].path());
+        proc.setProcessChannelMode(QProcess::MergedChannels);
+        proc.start(lrelease, args);
+        QVERIFY(proc.waitForFinished());
+        QCOMPARE(proc.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(proc.exitCode(), 0);
+        output[run] = proc.readAll();
+    }
+    QCOMPARE(output[1], output[0]);
+
+    for (const QString &tsFile : tsFiles) {
+        const QString qmFile = QFileInfo(tsFile).completeBaseName() + ".qm";
+        QFile serial(dirs[0].filePath(qmFile));
+        QFile parallel(dirs[1].filePath(qmFile));
+        QVERIFY(serial.open(QIODevice::ReadOnly));
+        QVERIFY(parallel.open(QIODevice::ReadOnly));
+        QCOMPARE(parallel.readAll(), serial.readAll());
+    }
+}
+
+void tst_lrelease::parallelFailure()
+{
+    const QStringList tsFiles = { "translate.ts", "missing.ts", "compressed.ts" };
+
+    // A file that cannot be loaded fails the run, but the files after it
+    // are released all the same, serially and in parallel.
+    QByteArray output[2];
+    QTemporaryDir dirs[2];
+    for (int run = 0; run < 2; ++run) {
+        QVERIFY(dirs[run].isValid());
+        for (const QString &tsFile : tsFiles) {
+            if (QFile::exists(dataDir + tsFile))
+                QVERIFY(QFile::copy(dataDir + tsFile, dirs[run].filePath(tsFile)));
+        }
+
+        QStringList args = tsFiles;
+        if (run == 1)
+            args = QStringList { "-j", "3" } + args;
+        QProcess proc;
+        proc.setWorkingDirectory(dirs[run].path());
+        proc.setProcessChannelMode(QProcess::MergedChannels);
+        proc.start(lrelease, args);
+        QVERIFY(proc.waitForFinished());
+        QCOMPARE(proc.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(proc.exitCode(), 1);
+        output[run] = proc.readAll();
+        QVERIFY2(output[run].contains("missing.ts"), output[run].constData());
+        QVERIFY(QFile::exists(dirs[run].filePath("translate.qm")));
+        QVERIFY(!QFile::exists(dirs[run].filePath("missing.qm")));
+        QVERIFY(QFile::exists(dirs[run].filePath("compressed.qm")));
+    }
+    QCOMPARE(output[1], output[0]);
+}
+
 QTEST_MAIN(tst_lrelease)
 #include "tst_lrelease.moc"
@@ -0,0 +1,14 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "namespaces.h"
+
+// App inherits the usings that follow it in the header when it is reopened.
+namespace App {
+
+QString title()
+{
+    return Dialog::tr("Title");
+}
+
+}
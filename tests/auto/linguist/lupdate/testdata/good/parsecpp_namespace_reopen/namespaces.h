@@ -0,0 +1,21 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore>
+
+namespace Gui {
+class Dialog : public QObject
+{
+    Q_OBJECT
+};
+}
+
+class Dialog : public QObject
+{
+    Q_OBJECT
+};
+
+namespace App {
+}
+
+using namespace Gui;
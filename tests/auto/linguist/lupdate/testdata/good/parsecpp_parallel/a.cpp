@@ -0,0 +1,14 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "widget.h"
+
+namespace Shapes {
+
+void Widget::first()
+{
+    tr("First message");
+    QCoreApplication::translate("Global", "Shared message");
+}
+
+}
@@ -0,0 +1,12 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "widget.h"
+
+using namespace Shapes;
+
+void Widget::second()
+{
+    tr("Second message");
+    tr("First message");
+}
@@ -0,0 +1,10 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "widget.h"
+
+void Shapes::Widget::third()
+{
+    tr("Third message");
+    QCoreApplication::translate("Global", "Shared message");
+}
@@ -0,0 +1,4 @@
+SOURCES += a.cpp b.cpp c.cpp
+HEADERS += widget.h
+
+TRANSLATIONS = project.ts
@@ -0,0 +1,17 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore>
+
+namespace Shapes {
+
+class Widget : public QObject
+{
+    Q_OBJECT
+public:
+    void first();
+    void second();
+    void third();
+};
+
+}
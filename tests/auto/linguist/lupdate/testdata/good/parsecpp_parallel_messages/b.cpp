@@ -0,0 +1,11 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "dialog.h"
+
+void Dialog::reject()
+{
+    tr("Reject");
+    //% "Discard"
+    QCoreApplication::translate("Dialog", "Discard");
+}
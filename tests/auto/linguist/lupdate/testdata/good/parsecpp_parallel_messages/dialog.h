@@ -0,0 +1,14 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore>
+
+class Dialog : public QObject
+{
+public:
+    void accept();
+    void reject();
+};
+
+//% "Orphan"
+inline bool dialogsEnabled = true;
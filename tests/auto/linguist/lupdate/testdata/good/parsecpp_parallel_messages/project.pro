@@ -0,0 +1,3 @@
+SOURCES += a.cpp b.cpp c.cpp
+
+TRANSLATIONS = project.ts
@@ -0,0 +1,11 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+package com.example;
+
+public class Widget {
+    public void first() {
+        tr("First message");
+        QCoreApplication.translate("Global", "Shared message");
+    }
+}
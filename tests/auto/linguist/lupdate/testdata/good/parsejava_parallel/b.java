@@ -0,0 +1,12 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+package com.example;
+
+public class Widget {
+    public void second() {
+        tr("Second message");
+        tr("First message");
+    }
+}
+}
@@ -0,0 +1,3 @@
+SOURCES += a.java b.java c.java
+
+TRANSLATIONS = project.ts
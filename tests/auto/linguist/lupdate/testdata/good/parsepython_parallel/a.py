@@ -0,0 +1,10 @@
+# Copyright (C) 2026 The Qt Company Ltd.
+# SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+from PySide6.QtCore import QCoreApplication, QObject
+
+
+class Widget(QObject):
+    def first(self):
+        print(self.tr("First message"))
+        print(QCoreApplication.translate("Global", "Shared message"))
@@ -0,0 +1,13 @@
+# Copyright (C) 2026 The Qt Company Ltd.
+# SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+from PySide6.QtCore import QObject
+
+
+class Widget(QObject):
+    def second(self):
+        print(self.tr("Second message"))
+        print(self.tr("First message"))
+
+
+print((
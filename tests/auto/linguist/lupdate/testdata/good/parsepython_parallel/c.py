@@ -0,0 +1,13 @@
+# Copyright (C) 2026 The Qt Company Ltd.
+# SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+from PySide6.QtCore import QCoreApplication, QObject
+
+
+class Helper(QObject):
+    def third(self):
+        print(self.tr("Third message"))
+        print(QCoreApplication.translate("Global", "Shared message"))
+
+
+print((
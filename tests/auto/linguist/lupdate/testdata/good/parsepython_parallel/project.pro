@@ -0,0 +1,3 @@
+SOURCES += a.py b.py c.py
+
+TRANSLATIONS = project.ts
@@ -0,0 +1,6 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+//: Only in b.
+var first = qsTr("Second message");
+var shared = qsTranslate("Global", "Shared message");
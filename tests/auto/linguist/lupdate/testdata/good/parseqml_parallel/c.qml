@@ -0,0 +1,10 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtQuick
+
+Item {
+    property string shared: qsTranslate("Global", "Shared message")
+    //: Only in c.
+    property string first: qsTr("Third message")
+}
@@ -0,0 +1,4 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+var shared = qsTranslate("Global", "Shared message");
@@ -0,0 +1,3 @@
+SOURCES += a.qml b.js c.qml d.js
+
+TRANSLATIONS = project.ts
@@ -0,0 +1,13 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+namespace Shapes {
+
+class Base : public QObject
+{
+    Q_OBJECT
+public:
+    void draw();
+};
+
+}
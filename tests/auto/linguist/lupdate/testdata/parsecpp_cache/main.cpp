@@ -0,0 +1,18 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "widget.h"
+
+namespace Shapes {
+
+void Base::draw()
+{
+    tr("Draw");
+}
+
+void Widget::resize()
+{
+    tr("Resize");
+}
+
+}
@@ -0,0 +1,4 @@
+SOURCES += main.cpp
+HEADERS += base.h widget.h
+
+TRANSLATIONS = project.ts
@@ -0,0 +1,15 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "base.h"
+
+namespace Shapes {
+
+class Widget : public Base
+{
+    Q_OBJECT
+public:
+    void resize();
+};
+
+}
@@ -6,13 +6,16 @@
 #endif
 
 #include <QtCore/QByteArray>
+#include <QtCore/QDateTime>
 #include <QtCore/QDebug>
 #include <QtCore/QDir>
+#include <QtCore/QDirIterator>
 #include <QtCore/QFile>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/private/qconfig_p.h>
 #include <QtCore/QSet>
 #include <QtCore/QSysInfo>
+#include <QtCore/QTemporaryDir>
 
 #include <QtTest/QtTest>
 #include <QtTools/private/qttools-config_p.h>
@@ -36,6 +39,7 @@ private slots:
     void cleanupTestCase();
     void good_data();
     void good();
+    void parseCache();
 #if CHECK_SIMTEXTH
     void simtexth();
     void simtexth_data();
@@ -49,6 +53,7 @@ private:
 
     static void doCompare(QList<QStringView> actual, const QString &expectedFn, bool err);
     void doCompare(const QString &actualFn, const QString &expectedFn, bool err);
+    void runLupdate(const QString &workDir, const QStringList &arguments);
 };
 
 
@@ -266,6 +271,9 @@ void tst_lupdate::good_data()
         "parsecontexts"_L1,
         "parsecpp"_L1,
         "parsecpp2",
+        "parsecpp_namespace_reopen"_L1,
+        "parsecpp_parallel"_L1,
+        "parsecpp_parallel_messages"_L1,
         "parsecpp_template"_L1,
         "parseqrc_json"_L1,
         "prefix"_L1,
@@ -274,7 +282,8 @@ void tst_lupdate::good_data()
         "respfile"_L1, //@lst not supported with the new parser yet (include not properly set in the compile_command.json)
         "cmdline_deeppath"_L1, //no project file, new parser does not support (yet) this way of launching lupdate
         "cmdline_order"_L1, // no project, new parser do not pickup on macro defined but not used. Test not needed for new parser.
-        "cmdline_recurse"_L1 // recursive scan without project file not supported (yet) with the new parser
+        "cmdline_recurse"_L1, // recursive scan without project file not supported (yet) with the new parser
+        "update_ts_parallel"_L1 // no project file
     };
     for (const QString &dir : dirs) {
         if (ignoredTests.contains(dir))
@@ -418,6 +427,91 @@ void tst_lupdate::good()
     }
 }
 
+void tst_lupdate::runLupdate(const QString &workDir, const QStringList &arguments)
+{
+    QProcess proc;
+    proc.setWorkingDirectory(workDir);
+    proc.setProcessChannelMode(QProcess::MergedChannels);
+    proc.start(m_cmdLupdate, arguments, QIODevice::ReadWrite | QIODevice::Text);
+    QVERIFY2(proc.waitForStarted(), msgStartFailed(proc).constData());
+    if (!proc.waitForFinished(TIMEOUT)) {
+        const auto message = msgTimeout(proc);
+        proc.kill();
+        proc.waitForFinished(50);
+        QFAIL(message.constData());
+    }
+    const QByteArray output = proc.readAll();
+    QVERIFY2(proc.exitStatus() == QProcess::NormalExit, msgCrashed(proc, output).constData());
+    QVERIFY2(proc.exitCode() == 0, msgExitCode(proc, output).constData());
+}
+
+static QStringList cacheFiles(const QString &cacheDir)
+{
+    QStringList files;
+    QDirIterator it(cacheDir, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+        files << it.next();
+    files.sort();
+    return files;
+}
+
+void tst_lupdate::parseCache()
+{
+    const QString sourceDir = m_basePath + "parsecpp_cache/"_L1;
+    QTemporaryDir workDir;
+    QVERIFY2(workDir.isValid(), qPrintable(workDir.errorString()));
+    QTemporaryDir cacheDir;
+    QVERIFY2(cacheDir.isValid(), qPrintable(cacheDir.errorString()));
+    for (const QString &file : QDir(sourceDir).entryList(QDir::Files)) {
+        const QString target = workDir.filePath(file);
+        QVERIFY2(QFile::copy(sourceDir + file, target), qPrintable(target));
+        QFile::setPermissions(target, QFile::ReadOwner | QFile::WriteOwner);
+    }
+
+    const QStringList arguments = { "-silent"_L1, "-cache-dir"_L1, cacheDir.path(),
+                                    "project.pro"_L1 };
+    const QString tsFile = workDir.filePath("project.ts"_L1);
+    const QString tsResult = sourceDir + "project.ts.result"_L1;
+
+    // The first run stores the results of the headers.
+    runLupdate(workDir.path(), arguments);
+    if (QTest::currentTestFailed())
+        return;
+    doCompare(tsFile, tsResult, false);
+    const QStringList entries = cacheFiles(cacheDir.path());
+    QVERIFY(!entries.isEmpty());
+
+    // Entries that are loaded are not written again.
+    const QDateTime stale(QDate(2020, 1, 1), QTime(12, 0));
+    for (const QString &entry : entries) {
+        QFile file(entry);
+        QVERIFY2(file.open(QIODevice::ReadWrite), qPrintable(entry));
+        QVERIFY2(file.setFileTime(stale, QFileDevice::FileModificationTime), qPrintable(entry));
+    }
+    QFile::remove(tsFile);
+    runLupdate(workDir.path(), arguments);
+    if (QTest::currentTestFailed())
+        return;
+    doCompare(tsFile, tsResult, false);
+    QCOMPARE(cacheFiles(cacheDir.path()), entries);
+    for (const QString &entry : entries)
+        QCOMPARE(QFileInfo(entry).lastModified(), stale);
+
+    // Editing the header that the other one includes invalidates both entries.
+    QFile base(workDir.filePath("base.h"_L1));
+    QVERIFY(base.open(QIODevice::Append | QIODevice::Text));
+    base.write("\nnamespace Shapes {\nclass Circle : public Base\n{\n    Q_OBJECT\n};\n}\n");
+    base.close();
+    QFile::remove(tsFile);
+    runLupdate(workDir.path(), arguments);
+    if (QTest::currentTestFailed())
+        return;
+    doCompare(tsFile, tsResult, false);
+    QCOMPARE(cacheFiles(cacheDir.path()), entries);
+    for (const QString &entry : entries)
+        QVERIFY2(QFileInfo(entry).lastModified() != stale, qPrintable(entry));
+}
+
 #if CHECK_SIMTEXTH
 void tst_lupdate::simtexth()
 {
@@ -0,0 +1,244 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "phrase.h"
+#include "phraseindex.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QtTest>
+
+#include <algorithm>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_phraseindex : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void friendlyString();
+    void overlappingPhrases();
+    void repeatedPhrase();
+    void wholeWords();
+    void removedPhrases();
+    void rebuildAfterRemovals();
+    void editedPhrases();
+    void randomEdits();
+};
+
+static QStringList friendlyWords(const QString &text)
+{
+    return PhraseIndex::friendlyString(text).split(u' ');
+}
+
+// Tries every phrase at every word of the text.
+static QList<Phrase *> bruteForceFind(const QList<Phrase *> &phrases, const QString &text)
+{
+    const QStringList words = friendlyWords(text);
+    QList<Phrase *> found;
+    for (int i = 0; i < words.size(); ++i) {
+        for (Phrase *p : phrases) {
+            const QString source = PhraseIndex::friendlyString(p->source());
+            if (source.isEmpty())
+                continue;
+            const QStringList phraseWords = source.split(u' ');
+            if (words.mid(i, phraseWords.size()) == phraseWords)
+                found.append(p);
+        }
+    }
+    return found;
+}
+
+static QList<Phrase *> sorted(QList<Phrase *> phrases)
+{
+    std::sort(phrases.begin(), phrases.end());
+    return phrases;
+}
+
+static QList<Phrase *> find(const PhraseBook &book, const QString &text)
+{
+    return book.index().findPhrases(friendlyWords(text));
+}
+
+class TestBook : public PhraseBook
+{
+public:
+    ~TestBook() { qDeleteAll(m_removed); }
+
+    Phrase *add(const QString &source, const QString &target = QString())
+    {
+        auto *p = new Phrase(source, target, QString(), this);
+        append(p);
+        return p;
+    }
+
+    void drop(Phrase *p)
+    {
+        remove(p);
+        m_removed.append(p);
+    }
+
+    void restore(Phrase *p)
+    {
+        m_removed.removeOne(p);
+        append(p);
+    }
+
+private:
+    QList<Phrase *> m_removed;
+};
+
+void tst_phraseindex::friendlyString()
+{
+    QCOMPARE(PhraseIndex::friendlyString(u"&Open  File..."_s), u"open file"_s);
+    QCOMPARE(PhraseIndex::friendlyString(u"(Re-)Load: now!"_s), u"re load now"_s);
+    QCOMPARE(PhraseIndex::friendlyString(u" .;, "_s), QString());
+}
+
+void tst_phraseindex::overlappingPhrases()
+{
+    TestBook book;
+    Phrase *openFile = book.add(u"Open file"_s);
+    Phrase *file = book.add(u"File"_s);
+    Phrase *openFileDialog = book.add(u"Open file dialog"_s);
+    Phrase *fileDialog = book.add(u"file dialog"_s);
+    Phrase *dialog = book.add(u"Dialog"_s);
+    book.add(u"Save file"_s);
+
+    const QString text = u"&Open File Dialog..."_s;
+    const QList<Phrase *> expected{ openFile, openFileDialog, file, fileDialog, dialog };
+    QCOMPARE(find(book, text), expected);
+    QCOMPARE(bruteForceFind(book.phrases(), text), expected);
+}
+
+void tst_phraseindex::repeatedPhrase()
+{
+    TestBook book;
+    Phrase *aba = book.add(u"a b a"_s);
+    Phrase *a = book.add(u"a"_s);
+
+    const QString text = u"a b a b a"_s;
+    const QList<Phrase *> expected{ aba, a, aba, a, a };
+    QCOMPARE(find(book, text), expected);
+    QCOMPARE(bruteForceFind(book.phrases(), text), expected);
+}
+
+void tst_phraseindex::wholeWords()
+{
+    TestBook book;
+    book.add(u"open"_s);
+    book.add(u"file dialog"_s);
+
+    const QString text = u"Opens the file dialogs"_s;
+    QVERIFY(find(book, text).isEmpty());
+    QVERIFY(bruteForceFind(book.phrases(), text).isEmpty());
+}
+
+void tst_phraseindex::removedPhrases()
+{
+    TestBook book;
+    Phrase *openFile = book.add(u"open file"_s);
+    Phrase *file = book.add(u"file"_s);
+    Phrase *openFileDialog = book.add(u"open file dialog"_s);
+    Phrase *fileDialog = book.add(u"file dialog"_s);
+    const QString text = u"Open file dialog"_s;
+    QCOMPARE(find(book, text), bruteForceFind(book.phrases(), text));
+
+    // The index stays valid, so these are removed from it one by one
+    book.drop(file);
+    QCOMPARE(find(book, text), (QList<Phrase *>{ openFile, openFileDialog, fileDialog }));
+    QCOMPARE(find(book, text), bruteForceFind(book.phrases(), text));
+
+    book.drop(openFileDialog);
+    QCOMPARE(find(book, text), (QList<Phrase *>{ openFile, fileDialog }));
+    QCOMPARE(find(book, text), bruteForceFind(book.phrases(), text));
+
+    // A phrase that is added again is found again, after the others
+    book.restore(file);
+    QCOMPARE(find(book, text), (QList<Phrase *>{ openFile, fileDialog, file }));
+    QCOMPARE(sorted(find(book, text)), sorted(bruteForceFind(book.phrases(), text)));
+}
+
+void tst_phraseindex::rebuildAfterRemovals()
+{
+    TestBook book;
+    QList<Phrase *> phrases;
+    for (int i = 0; i < 10; ++i)
+        phrases.append(book.add(u"word%1 next"_s.arg(i)));
+    const QString text = u"word1 next word2 next word7 next word8 next"_s;
+    QCOMPARE(find(book, text), bruteForceFind(book.phrases(), text));
+
+    // Removing more than half of the phrases makes the index start over
+    for (int i = 0; i < 8; ++i) {
+        book.drop(phrases.at(i));
+        QCOMPARE(find(book, text), bruteForceFind(book.phrases(), text));
+    }
+    QCOMPARE(find(book, text), (QList<Phrase *>{ phrases.at(8) }));
+    QCOMPARE(book.index().friendlyTexts().size(), 2);
+
+    Phrase *added = book.add(u"word1 next"_s);
+    QCOMPARE(find(book, text), (QList<Phrase *>{ added, phrases.at(8) }));
+    QCOMPARE(find(book, text), bruteForceFind(book.phrases(), text));
+}
+
+void tst_phraseindex::editedPhrases()
+{
+    TestBook book;
+    Phrase *openFile = book.add(u"open file"_s, u"Datei öffnen"_s);
+    Phrase *file = book.add(u"file"_s, u"Datei"_s);
+    QCOMPARE(find(book, u"Open file"_s), (QList<Phrase *>{ openFile, file }));
+
+    openFile->setSource(u"Save file"_s);
+    QCOMPARE(find(book, u"Open file"_s), (QList<Phrase *>{ file }));
+    QCOMPARE(find(book, u"Save file"_s), (QList<Phrase *>{ openFile, file }));
+    QCOMPARE(find(book, u"Save file"_s), bruteForceFind(book.phrases(), u"Save file"_s));
+
+    openFile->setTarget(u"Datei speichern"_s);
+    const auto texts = book.index().friendlyTexts();
+    QVERIFY(texts.contains(std::pair(u"save file"_s, u"datei speichern"_s)));
+    QVERIFY(texts.contains(std::pair(u"file"_s, u"datei"_s)));
+    QCOMPARE(texts.size(), 2);
+
+    // A phrase without words is not indexed
+    file->setSource(u"..."_s);
+    QCOMPARE(find(book, u"Save file"_s), (QList<Phrase *>{ openFile }));
+    QCOMPARE(book.index().friendlyTexts().size(), 1);
+    file->setSource(u"Save"_s);
+    QCOMPARE(find(book, u"Save file"_s), (QList<Phrase *>{ openFile, file }));
+}
+
+void tst_phraseindex::randomEdits()
+{
+    static const char *const vocabulary[] = { "a", "b", "c", "d" };
+    QRandomGenerator rng(4711);
+    const auto randomText = [&rng](int maxWords) {
+        QStringList words;
+        const int count = rng.bounded(1, maxWords + 1);
+        for (int i = 0; i < count; ++i)
+            words.append(QLatin1StringView(vocabulary[rng.bounded(4)]));
+        return words.join(u' ');
+    };
+
+    TestBook book;
+    for (int step = 0; step < 2000; ++step) {
+        const QList<Phrase *> phrases = book.phrases();
+        const int op = rng.bounded(6);
+        if (op < 3 || phrases.isEmpty())
+            book.add(randomText(3));
+        else if (op < 5)
+            book.drop(phrases.at(rng.bounded(int(phrases.size()))));
+        else
+            phrases.at(rng.bounded(int(phrases.size())))->setSource(randomText(3));
+
+        // Edits reorder the index, so only the phrases found must agree
+        const QString text = randomText(10);
+        QCOMPARE(sorted(find(book, text)), sorted(bruteForceFind(book.phrases(), text)));
+
+        PhraseIndex rebuilt;
+        rebuilt.build(book.phrases());
+        QCOMPARE(book.index().friendlyTexts().size(), rebuilt.friendlyTexts().size());
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_phraseindex)
+#include "tst_phraseindex.moc"
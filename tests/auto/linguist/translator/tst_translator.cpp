@@ -0,0 +1,276 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qmreader.h"
+#include "translator.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QtTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_translator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void duplicatesAppended();
+    void duplicateInsertedBefore();
+    void duplicateReplaced();
+    void winnerRemoved();
+    void otherDuplicateRemoved();
+    void duplicateIds();
+    void resolvedDuplicates();
+    void randomEdits();
+    void qmReader_data();
+    void qmReader();
+};
+
+static TranslatorMessage message(const QString &context, const QString &source,
+                                 const QString &id = QString(), int line = -1,
+                                 TranslatorMessage::Type type = TranslatorMessage::Unfinished)
+{
+    TranslatorMessage msg(context, source, QString(), QString(), u"main.cpp"_s, line,
+                          QStringList(), type);
+    msg.setId(id);
+    return msg;
+}
+
+// What find() returned when the index was built from all messages at once:
+// the last message with a key wins.
+static int rebuiltFind(const Translator &tor, const TranslatorMessage &msg)
+{
+    int byKey = -1;
+    int byId = -1;
+    for (int i = 0; i < tor.messageCount(); ++i) {
+        const TranslatorMessage &m = tor.message(i);
+        if (m.context() == msg.context() && m.sourceText() == msg.sourceText()
+            && m.comment() == msg.comment()) {
+            byKey = i;
+        }
+        if (!m.id().isEmpty() && m.id() == msg.id())
+            byId = i;
+    }
+    if (msg.id().isEmpty())
+        return byKey;
+    if (byId >= 0)
+        return byId;
+    return byKey >= 0 && tor.message(byKey).id().isEmpty() ? byKey : -1;
+}
+
+static bool findsAsRebuilt(const Translator &tor, const QList<TranslatorMessage> &probes)
+{
+    for (const TranslatorMessage &probe : probes) {
+        const int found = tor.find(probe);
+        const int expected = rebuiltFind(tor, probe);
+        if (found != expected) {
+            qWarning() << "find" << probe.context() << probe.sourceText() << probe.id()
+                       << "returned" << found << "instead of" << expected;
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_translator::duplicatesAppended()
+{
+    Translator tor;
+    tor.append(message(u"C"_s, u"a"_s));
+    tor.append(message(u"C"_s, u"b"_s));
+    tor.append(message(u"C"_s, u"a"_s));
+    QCOMPARE(tor.find(message(u"C"_s, u"a"_s)), 2);
+    QVERIFY(findsAsRebuilt(tor, { message(u"C"_s, u"a"_s), message(u"C"_s, u"b"_s) }));
+}
+
+void tst_translator::duplicateInsertedBefore()
+{
+    Translator tor;
+    tor.appendSorted(message(u"C"_s, u"a"_s, QString(), 10));
+    tor.appendSorted(message(u"C"_s, u"b"_s, QString(), 30));
+    tor.appendSorted(message(u"C"_s, u"a"_s, QString(), 40));
+    // Goes between the first two, so the one at line 40 stays the last one.
+    tor.appendSorted(message(u"C"_s, u"a"_s, QString(), 20));
+    QCOMPARE(tor.messageCount(), 4);
+    QCOMPARE(tor.message(1).lineNumber(), 20);
+    QCOMPARE(tor.find(message(u"C"_s, u"a"_s)), 3);
+    QVERIFY(findsAsRebuilt(tor, { message(u"C"_s, u"a"_s), message(u"C"_s, u"b"_s) }));
+}
+
+void tst_translator::duplicateReplaced()
+{
+    Translator tor;
+    tor.append(message(u"C"_s, u"a"_s, QString(), 10));
+    tor.append(message(u"C"_s, u"a"_s, QString(), 20));
+    tor.replaceSorted(message(u"C"_s, u"a"_s, QString(), 30));
+    QCOMPARE(tor.messageCount(), 2);
+    QCOMPARE(tor.message(1).lineNumber(), 30);
+    QCOMPARE(tor.find(message(u"C"_s, u"a"_s)), 1);
+    QVERIFY(findsAsRebuilt(tor, { message(u"C"_s, u"a"_s) }));
+}
+
+void tst_translator::winnerRemoved()
+{
+    Translator tor;
+    tor.append(message(u"C"_s, u"a"_s));
+    tor.append(message(u"C"_s, u"b"_s));
+    tor.append(message(u"C"_s, u"a"_s, QString(), -1, TranslatorMessage::Finished));
+    tor.stripFinishedMessages();
+    QCOMPARE(tor.messageCount(), 2);
+    // The earlier duplicate takes over.
+    QCOMPARE(tor.find(message(u"C"_s, u"a"_s)), 0);
+    QVERIFY(findsAsRebuilt(tor, { message(u"C"_s, u"a"_s), message(u"C"_s, u"b"_s) }));
+}
+
+void tst_translator::otherDuplicateRemoved()
+{
+    Translator tor;
+    tor.append(message(u"C"_s, u"a"_s, QString(), -1, TranslatorMessage::Finished));
+    tor.append(message(u"C"_s, u"b"_s));
+    tor.append(message(u"C"_s, u"a"_s));
+    tor.stripFinishedMessages();
+    QCOMPARE(tor.messageCount(), 2);
+    QCOMPARE(tor.find(message(u"C"_s, u"a"_s)), 1);
+    QVERIFY(findsAsRebuilt(tor, { message(u"C"_s, u"a"_s), message(u"C"_s, u"b"_s) }));
+}
+
+void tst_translator::duplicateIds()
+{
+    Translator tor;
+    tor.append(message(u"C"_s, u"a"_s, u"id"_s));
+    tor.append(message(u"C"_s, u"b"_s, u"id"_s));
+    tor.append(message(u"C"_s, u"c"_s, u"id"_s, -1, TranslatorMessage::Finished));
+    QCOMPARE(tor.find(message(QString(), QString(), u"id"_s)), 2);
+    tor.stripFinishedMessages();
+    QCOMPARE(tor.find(message(QString(), QString(), u"id"_s)), 1);
+    // A message with an id is not found by key when looking for another id.
+    QCOMPARE(tor.find(message(u"C"_s, u"a"_s, u"other"_s)), -1);
+    QVERIFY(findsAsRebuilt(tor, { message(QString(), QString(), u"id"_s),
+                                  message(u"C"_s, u"a"_s, u"other"_s),
+                                  message(u"C"_s, u"b"_s) }));
+}
+
+void tst_translator::resolvedDuplicates()
+{
+    Translator tor;
+    tor.append(message(u"C"_s, u"a"_s));
+    tor.append(message(u"C"_s, u"b"_s));
+    tor.append(message(u"C"_s, u"a"_s, u"id"_s));
+    tor.append(message(u"C"_s, u"b"_s));
+    const Translator::Duplicates dups = tor.resolveDuplicates();
+    QCOMPARE(dups.byContents.size(), 2);
+    QCOMPARE(tor.messageCount(), 2);
+    QCOMPARE(tor.message(0).id(), u"id"_s);
+    QCOMPARE(tor.find(message(u"C"_s, u"a"_s)), 0);
+    QCOMPARE(tor.find(message(QString(), QString(), u"id"_s)), 0);
+    QCOMPARE(tor.find(message(u"C"_s, u"b"_s)), 1);
+}
+
+void tst_translator::randomEdits()
+{
+    const QStringList contexts = { u"A"_s, u"B"_s };
+    const QStringList sources = { u"x"_s, u"y"_s, u"z"_s };
+    const QStringList ids = { QString(), QString(), u"id1"_s, u"id2"_s };
+    QList<TranslatorMessage> probes;
+    for (const QString &context : contexts) {
+        for (const QString &source : sources) {
+            for (const QString &id : ids)
+                probes.append(message(context, source, id));
+        }
+    }
+
+    QRandomGenerator random(4711);
+    Translator tor;
+    for (int step = 0; step < 2000; ++step) {
+        const auto pick = [&random](const QStringList &list) {
+            return list.at(random.bounded(list.size()));
+        };
+        static const TranslatorMessage::Type types[] = {
+            TranslatorMessage::Unfinished, TranslatorMessage::Finished,
+            TranslatorMessage::Obsolete
+        };
+        const TranslatorMessage msg = message(pick(contexts), pick(sources), pick(ids),
+                                              random.bounded(100), types[random.bounded(3)]);
+        switch (random.bounded(8)) {
+        case 0:
+        case 1:
+            tor.append(msg);
+            break;
+        case 2:
+        case 3:
+            tor.appendSorted(msg);
+            break;
+        case 4:
+        case 5:
+            tor.replaceSorted(msg);
+            break;
+        case 6:
+            if (tor.messageCount() > 20)
+                tor.stripFinishedMessages();
+            break;
+        case 7:
+            if (tor.messageCount() > 20)
+                tor.stripObsoleteMessages();
+            break;
+        }
+        QVERIFY2(findsAsRebuilt(tor, probes), qPrintable(u"step %1"_s.arg(step)));
+    }
+}
+
+void tst_translator::qmReader_data()
+{
+    QTest::addColumn<bool>("stripped");
+
+    QTest::newRow("everything") << false;
+    QTest::newRow("stripped") << true;
+}
+
+// Looks the messages of a saved file up without loading it.
+void tst_translator::qmReader()
+{
+    QFETCH(bool, stripped);
+
+    Translator tor;
+    tor.setLanguageCode(u"de"_s);
+    const auto add = [&tor](const QString &context, const QString &source,
+                            const QString &comment, const QStringList &translations) {
+        TranslatorMessage msg(context, source, comment, QString(), u"main.cpp"_s, 1,
+                              translations, TranslatorMessage::Finished);
+        msg.setPlural(translations.size() > 1);
+        tor.append(msg);
+    };
+    add(u"Context"_s, u"Open"_s, QString(), { u"Öffnen"_s });
+    add(u"Context"_s, u"Open"_s, u"verb"_s, { u"Öffne"_s });
+    add(u"Context"_s, u"Close"_s, QString(), { u"Schließen"_s });
+    add(u"Other"_s, u"Open"_s, QString(), { u"Auf"_s });
+    add(u"Other"_s, u"%n file(s)"_s, QString(), { u"%n Datei"_s, u"%n Dateien"_s });
+
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    ConversionData cd;
+    cd.m_saveMode = stripped ? SaveStripped : SaveEverything;
+    QVERIFY2(saveQM(tor, buffer, cd), qPrintable(cd.error()));
+    buffer.close();
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QmReader reader;
+    QVERIFY2(reader.open(buffer), qPrintable(reader.errorString()));
+    QVERIFY(!reader.isMapped());
+    QCOMPARE(reader.language(), u"de"_s);
+    QCOMPARE(reader.messageCount(), qsizetype(tor.messageCount()));
+    QCOMPARE(std::distance(reader.begin(), reader.end()), reader.messageCount());
+
+    for (const TranslatorMessage &msg : tor.messages()) {
+        QmReader::Message found;
+        QVERIFY2(reader.find(msg.context(), msg.sourceText(), msg.comment(), &found),
+                 qPrintable(msg.sourceText()));
+        QCOMPARE(found.translations(), msg.translations());
+        QCOMPARE(found.translationCount(), int(msg.translations().size()));
+    }
+    QmReader::Message found;
+    QVERIFY(!reader.find(u"Context"_s, u"Save"_s, QString(), &found));
+    QVERIFY(!reader.find(u"Third"_s, u"Open"_s, QString(), &found));
+}
+
+QTEST_APPLESS_MAIN(tst_translator)
+#include "tst_translator.moc"
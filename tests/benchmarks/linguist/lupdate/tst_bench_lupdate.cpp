@@ -0,0 +1,239 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QLibraryInfo>
+#include <QtCore/QProcess>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
+#include <QtTest/QtTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_bench_lupdate : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void extract_data();
+    void extract();
+    void update_data();
+    void update();
+
+private:
+    void runLupdate(const QStringList &arguments);
+
+    QString m_cmdLupdate;
+    QTemporaryDir m_dir;
+};
+
+static const int FileCount = 400;
+static const int ClassesPerFile = 5;
+static const int MessagesPerClass = 10;
+
+// Every file holds its own classes, so the contexts don't depend on the
+// order in which the files are parsed.
+static void writeCpp(QTextStream &out, int file)
+{
+    out << "#include <QtCore/QCoreApplication>\n#include <QtCore/QObject>\n\n"
+        << "namespace Module" << file % 7 << " {\n\n";
+    for (int c = 0; c < ClassesPerFile; ++c) {
+        const QString name = u"Class%1_%2"_s.arg(file).arg(c);
+        out << "class " << name << " : public QObject\n{\n    Q_OBJECT\n\npublic:\n"
+            << "    explicit " << name << "(QObject *parent = nullptr) : QObject(parent) {}\n"
+            << "    QString text(int n) const;\n};\n\n"
+            << "QString " << name << "::text(int n) const\n{\n    switch (n) {\n";
+        for (int m = 0; m < MessagesPerClass; ++m) {
+            out << "    case " << m << ":\n";
+            switch (m % 4) {
+            case 0:
+                out << "        //: Comment for translators " << m << "\n"
+                    << "        return tr(\"Source text %1 of " << name << "\").arg(n);\n";
+                break;
+            case 1:
+                out << "        return tr(\"%n file(s) in " << name << "\", \"plural\", n);\n";
+                break;
+            case 2:
+                out << "        //~ meta value" << m << "\n"
+                    << "        return QCoreApplication::translate(\"Shared\", \"Shared text "
+                    << (file * ClassesPerFile + c) % 100 << "\");\n";
+                break;
+            default:
+                out << "        return tr(\"Message " << m << "\", \"disambiguation "
+                    << c << "\");\n";
+                break;
+            }
+        }
+        out << "    default:\n        return QString();\n    }\n}\n\n";
+    }
+    out << "} // namespace Module" << file % 7 << "\n";
+}
+
+static void writeQml(QTextStream &out, int file)
+{
+    out << "import QtQuick\n\nItem {\n    id: root" << file << "\n";
+    for (int m = 0; m < ClassesPerFile * MessagesPerClass; ++m) {
+        out << "    Text {\n";
+        switch (m % 3) {
+        case 0:
+            out << "        //: Comment for translators " << m << "\n"
+                << "        text: qsTr(\"Source text " << m << "\")\n";
+            break;
+        case 1:
+            out << "        text: qsTranslate(\"Shared\", \"Shared text " << m << "\")\n";
+            break;
+        default:
+            out << "        text: qsTr(\"%n item(s) in file " << file << "\", \"plural\", "
+                << m << ")\n";
+            break;
+        }
+        out << "    }\n";
+    }
+    out << "}\n";
+}
+
+static void writePython(QTextStream &out, int file)
+{
+    out << "from PySide6.QtCore import QCoreApplication, QObject\n\n";
+    for (int c = 0; c < ClassesPerFile; ++c) {
+        out << "\nclass Class" << file << '_' << c << "(QObject):\n"
+            << "    def text(self, n):\n";
+        for (int m = 0; m < MessagesPerClass; ++m) {
+            out << "        if n == " << m << ":\n";
+            if (m % 2) {
+                out << "            return QCoreApplication.translate(\"Shared\", \"Shared text "
+                    << m << "\")\n";
+            } else {
+                out << "            #: Comment for translators " << m << "\n"
+                    << "            return self.tr(\"Source text " << m << "\")\n";
+            }
+        }
+        out << "        return \"\"\n";
+    }
+}
+
+void tst_bench_lupdate::initTestCase()
+{
+    m_cmdLupdate = QLibraryInfo::path(QLibraryInfo::BinariesPath) + "/lupdate"_L1;
+    QVERIFY(m_dir.isValid());
+
+    const QDir root(m_dir.path());
+    const auto write = [&](const QString &language, const QString &extension,
+                           void (*writer)(QTextStream &, int)) {
+        for (int file = 0; file < FileCount; ++file) {
+            const QString dirName = u"%1/module%2"_s.arg(language).arg(file % 7);
+            QVERIFY(root.mkpath(dirName));
+            QFile f(root.filePath(u"%1/file%2.%3"_s.arg(dirName).arg(file).arg(extension)));
+            QVERIFY2(f.open(QIODevice::WriteOnly | QIODevice::Text),
+                     qPrintable(f.errorString()));
+            QTextStream out(&f);
+            writer(out, file);
+        }
+    };
+    write(u"cpp"_s, u"cpp"_s, writeCpp);
+    write(u"qml"_s, u"qml"_s, writeQml);
+    write(u"python"_s, u"py"_s, writePython);
+}
+
+void tst_bench_lupdate::runLupdate(const QStringList &arguments)
+{
+    QProcess proc;
+    proc.setWorkingDirectory(m_dir.path());
+    proc.setProcessChannelMode(QProcess::MergedChannels);
+    proc.start(m_cmdLupdate, arguments);
+    QVERIFY2(proc.waitForStarted(), qPrintable(proc.errorString()));
+    QVERIFY(proc.waitForFinished(600000));
+    const QByteArray output = proc.readAll();
+    if (output.contains("missing qml/javascript support"))
+        QSKIP("lupdate was built without QML support");
+    QVERIFY2(proc.exitStatus() == QProcess::NormalExit && proc.exitCode() == 0,
+             output.constData());
+}
+
+void tst_bench_lupdate::extract_data()
+{
+    QTest::addColumn<QStringList>("sources");
+    QTest::addColumn<QString>("jobs");
+
+    QTest::newRow("cpp") << QStringList{ u"cpp"_s } << u"1"_s;
+    QTest::newRow("cpp-parallel") << QStringList{ u"cpp"_s } << u"0"_s;
+    QTest::newRow("qml") << QStringList{ u"qml"_s } << u"1"_s;
+    QTest::newRow("qml-parallel") << QStringList{ u"qml"_s } << u"0"_s;
+    QTest::newRow("python") << QStringList{ u"python"_s } << u"1"_s;
+    QTest::newRow("all-parallel") << QStringList{ u"cpp"_s, u"qml"_s, u"python"_s } << u"0"_s;
+}
+
+// Extracts the messages of a generated source tree into a new TS file.
+void tst_bench_lupdate::extract()
+{
+    QFETCH(QStringList, sources);
+    QFETCH(QString, jobs);
+
+    const QString tsFile =
+            m_dir.filePath(u"extract_%1.ts"_s.arg(QLatin1StringView(QTest::currentDataTag())));
+    QStringList arguments{ u"-silent"_s, u"-no-obsolete"_s, u"-j"_s, jobs,
+                           u"-extensions"_s, u"cpp,qml,py"_s };
+    arguments += sources;
+    arguments << u"-ts"_s << tsFile;
+
+    QBENCHMARK {
+        QFile::remove(tsFile);
+        runLupdate(arguments);
+        if (QTest::currentTestFailed() || QTest::currentTestResolved())
+            return;
+    }
+    QVERIFY(QFileInfo(tsFile).size() > 0);
+}
+
+void tst_bench_lupdate::update_data()
+{
+    QTest::addColumn<bool>("similarText");
+
+    QTest::newRow("exact") << false;
+    QTest::newRow("similar-text") << true;
+}
+
+// Updates a TS file whose source texts all changed slightly, so that every
+// message goes through merge() and, optionally, the similar-text heuristic.
+void tst_bench_lupdate::update()
+{
+    QFETCH(bool, similarText);
+
+    const QString baseFile = m_dir.filePath(u"update_base.ts"_s);
+    if (!QFile::exists(baseFile)) {
+        runLupdate({ u"-silent"_s, u"-j"_s, u"0"_s, u"cpp"_s, u"-ts"_s, baseFile });
+        if (QTest::currentTestFailed() || QTest::currentTestResolved())
+            return;
+        QFile f(baseFile);
+        QVERIFY(f.open(QIODevice::ReadOnly | QIODevice::Text));
+        QString content = QString::fromUtf8(f.readAll());
+        f.close();
+        // Translate everything and edit the sources, which lupdate then
+        // finds in the sources again only by similarity.
+        content.replace(u"<translation type=\"unfinished\"></translation>"_s,
+                        u"<translation>Translated</translation>"_s);
+        content.replace(u"<source>Source text"_s, u"<source>Old source text"_s);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text));
+        f.write(content.toUtf8());
+    }
+
+    const QString tsFile = m_dir.filePath(u"update.ts"_s);
+    QStringList arguments{ u"-silent"_s, u"-j"_s, u"0"_s };
+    if (!similarText)
+        arguments << u"-disable-heuristic"_s << u"similartext"_s;
+    arguments << u"cpp"_s << u"-ts"_s << tsFile;
+
+    QBENCHMARK {
+        QFile::remove(tsFile);
+        QVERIFY(QFile::copy(baseFile, tsFile));
+        runLupdate(arguments);
+        if (QTest::currentTestFailed() || QTest::currentTestResolved())
+            return;
+    }
+}
+
+QTEST_MAIN(tst_bench_lupdate)
+
+#include "tst_bench_lupdate.moc"
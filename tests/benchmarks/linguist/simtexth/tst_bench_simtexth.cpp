@@ -0,0 +1,183 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "lupdate.h"
+#include "simtexth.h"
+#include "translator.h"
+
+#include <QtCore/QRandomGenerator>
+#include <QtTest/QtTest>
+
+#include <vector>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_bench_simtexth : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void score_data();
+    void score();
+    void candidates_data();
+    void candidates();
+    void merge_data();
+    void merge();
+
+private:
+    QStringList m_texts;
+    Translator m_tor;
+    Translator m_virginTor;
+};
+
+static const int MessageCount = 20000;
+static const int MessagesPerContext = 20;
+
+static QString randomText(QRandomGenerator &rng)
+{
+    static const char *const words[] = {
+        "open", "file", "save", "close", "the", "document", "could", "not", "be", "found",
+        "settings", "are", "invalid", "press", "any", "key", "to", "continue", "network",
+        "error", "while", "loading", "page", "select", "a", "directory", "for", "output",
+    };
+    const int wordCount = 3 + rng.bounded(8);
+    QString text;
+    for (int i = 0; i < wordCount; ++i) {
+        if (i)
+            text += u' ';
+        text += QLatin1StringView(words[rng.bounded(int(std::size(words)))]);
+    }
+    return text;
+}
+
+void tst_bench_simtexth::initTestCase()
+{
+    QRandomGenerator rng(4711);
+    m_texts.reserve(MessageCount);
+    for (int i = 0; i < MessageCount; ++i)
+        m_texts.append(randomText(rng));
+
+    // The vernacular translator is fully translated; every fourth source text
+    // was slightly edited since, so that merge() has to fall back to the
+    // similar-text heuristic for those.
+    for (int i = 0; i < MessageCount; ++i) {
+        const QString context = u"Context%1"_s.arg(i / MessagesPerContext);
+        const QString fileName = u"file%1.cpp"_s.arg(i / MessagesPerContext);
+        const int line = 10 + i % MessagesPerContext;
+        m_tor.append(TranslatorMessage(context, m_texts.at(i), QString(), QString(), fileName,
+                                       line, { m_texts.at(i).toUpper() },
+                                       TranslatorMessage::Finished));
+        const QString source = i % 4 ? m_texts.at(i) : m_texts.at(i) + u'.';
+        m_virginTor.append(TranslatorMessage(context, source, QString(), QString(), fileName,
+                                             line));
+    }
+}
+
+void tst_bench_simtexth::score_data()
+{
+    QTest::addColumn<QString>("mode");
+
+    QTest::newRow("strings") << u"strings"_s;
+    QTest::newRow("pairs") << u"pairs"_s;
+    QTest::newRow("batch") << u"batch"_s;
+}
+
+// Scores all texts against one, building their matrices on the fly, one
+// precomputed matrix at a time, or all precomputed matrices in one batch.
+void tst_bench_simtexth::score()
+{
+    QFETCH(QString, mode);
+
+    std::vector<CoMatrix> matrices;
+    std::vector<int> lengths;
+    std::vector<int> scores(m_texts.size());
+    matrices.reserve(m_texts.size());
+    lengths.reserve(m_texts.size());
+    for (const QString &text : std::as_const(m_texts)) {
+        matrices.emplace_back(text);
+        lengths.push_back(text.size());
+    }
+
+    StringSimilarityMatcher matcher(u"the document could not be saved"_s);
+    if (mode == "strings"_L1) {
+        QBENCHMARK {
+            for (qsizetype i = 0; i < m_texts.size(); ++i)
+                scores[i] = matcher.getSimilarityScore(m_texts.at(i));
+        }
+    } else if (mode == "pairs"_L1) {
+        QBENCHMARK {
+            for (size_t i = 0; i < matrices.size(); ++i)
+                scores[i] = matcher.getSimilarityScore(matrices[i], lengths[i]);
+        }
+    } else {
+        QBENCHMARK {
+            matcher.getSimilarityScores(matrices.data(), lengths.data(),
+                                        qsizetype(matrices.size()), scores.data());
+        }
+    }
+
+    for (qsizetype i = 0; i < m_texts.size(); ++i)
+        QCOMPARE(scores[i], matcher.getSimilarityScore(m_texts.at(i)));
+}
+
+void tst_bench_simtexth::candidates_data()
+{
+    QTest::addColumn<bool>("indexed");
+
+    QTest::newRow("translator") << false;
+    QTest::newRow("index") << true;
+}
+
+// Looks up the candidates for a hundred edited source texts, as the
+// similar-text heuristic of merge() does for each unmatched message. The
+// "translator" row indexes the translator again for every lookup.
+void tst_bench_simtexth::candidates()
+{
+    QFETCH(bool, indexed);
+
+    QStringList queries;
+    for (int i = 0; i < MessageCount; i += MessageCount / 100)
+        queries.append(m_texts.at(i) + u'.');
+
+    const SimilarTextIndex index(&m_tor);
+    qsizetype found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const QString &query : std::as_const(queries)) {
+            const CandidateList list = indexed
+                    ? index.candidates(query, 5)
+                    : similarTextHeuristicCandidates(&m_tor, query, 5);
+            found += list.size();
+        }
+    }
+    QVERIFY(found >= queries.size());
+}
+
+void tst_bench_simtexth::merge_data()
+{
+    QTest::addColumn<bool>("similarText");
+
+    QTest::newRow("exact") << false;
+    QTest::newRow("similar-text") << true;
+}
+
+void tst_bench_simtexth::merge()
+{
+    QFETCH(bool, similarText);
+
+    UpdateOptions options;
+    if (similarText)
+        options |= HeuristicSimilarText;
+
+    Translator out;
+    QBENCHMARK {
+        QString err;
+        out = ::merge(m_tor, m_virginTor, {}, options, err);
+    }
+    QVERIFY(out.messageCount() >= MessageCount);
+}
+
+QTEST_MAIN(tst_bench_simtexth)
+
+#include "tst_bench_simtexth.moc"
@@ -0,0 +1,249 @@
+// Copyright (C) 2026 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include "qmreader.h"
+#include "translator.h"
+
+#include <QtCore/QBuffer>
+#include <QtCore/QFile>
+#include <QtCore/QSet>
+#include <QtCore/QTemporaryDir>
+#include <QtTest/QtTest>
+
+using namespace Qt::Literals::StringLiterals;
+
+class tst_bench_translator : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void load_data();
+    void load();
+    void save_data();
+    void save();
+    void saveQm_data();
+    void saveQm();
+    void find();
+    void findQm();
+    void stringMemory_data();
+    void stringMemory();
+
+private:
+    QTemporaryDir m_dir;
+    Translator m_tor;
+};
+
+static const int MessageCount = 50000;
+static const int MessagesPerContext = 50;
+static const int MessagesPerFile = 10;
+
+// Every message gets freshly built strings, like the parsers produce them.
+static void appendMessages(Translator &tor)
+{
+    for (int i = 0; i < MessageCount; ++i) {
+        const int file = i / MessagesPerFile;
+        TranslatorMessage msg(u"Module%1::Context%2"_s.arg(i % 7).arg(i / MessagesPerContext),
+                              u"Source text %1"_s.arg(i), QString(), QString(),
+                              u"/home/user/project/src/module%1/file%2.cpp"_s.arg(i % 7).arg(file),
+                              10 + i % MessagesPerFile, { u"Quelltext %1"_s.arg(i) },
+                              TranslatorMessage::Finished);
+        msg.addReference(u"/home/user/project/src/module%1/file%2.h"_s.arg(i % 7).arg(file),
+                         20 + i % MessagesPerFile);
+        tor.append(msg);
+    }
+}
+
+#ifdef Q_OS_LINUX
+static bool resetPeakRss()
+{
+    QFile file(u"/proc/self/clear_refs"_s);
+    return file.open(QIODevice::WriteOnly) && file.write("5") == 1;
+}
+
+// Returns the peak resident set size of the process in bytes, or -1.
+static qint64 peakRss()
+{
+    QFile file(u"/proc/self/status"_s);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return -1;
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine();
+        if (line.startsWith("VmHWM:")) {
+            const QByteArray kb = line.sliced(6).trimmed();
+            return kb.endsWith(" kB") ? kb.chopped(3).toLongLong() * 1024 : -1;
+        }
+    }
+    return -1;
+}
+#endif
+
+void tst_bench_translator::initTestCase()
+{
+    QVERIFY(m_dir.isValid());
+
+    m_tor.setLanguageCode(u"de"_s);
+    appendMessages(m_tor);
+
+    for (const QString &format : { u"ts"_s, u"po"_s, u"qm"_s, u"xlf"_s }) {
+        ConversionData cd;
+        QVERIFY2(m_tor.save(m_dir.filePath(u"test."_s + format), cd, format),
+                 qPrintable(cd.error()));
+    }
+}
+
+void tst_bench_translator::load_data()
+{
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow("ts") << u"ts"_s;
+    QTest::newRow("po") << u"po"_s;
+    QTest::newRow("qm") << u"qm"_s;
+    QTest::newRow("xlf") << u"xlf"_s;
+}
+
+void tst_bench_translator::load()
+{
+    QFETCH(QString, format);
+
+    const QString fileName = m_dir.filePath(u"test."_s + format);
+    QBENCHMARK {
+        Translator tor;
+        ConversionData cd;
+        QVERIFY2(tor.load(fileName, cd, format), qPrintable(cd.error()));
+        QCOMPARE(tor.messageCount(), MessageCount);
+    }
+}
+
+void tst_bench_translator::save_data()
+{
+    load_data();
+}
+
+void tst_bench_translator::save()
+{
+    QFETCH(QString, format);
+
+    const QString fileName = m_dir.filePath(u"save."_s + format);
+    QBENCHMARK {
+        ConversionData cd;
+        QVERIFY2(m_tor.save(fileName, cd, format), qPrintable(cd.error()));
+    }
+}
+
+void tst_bench_translator::saveQm_data()
+{
+    QTest::addColumn<bool>("stripped");
+
+    QTest::newRow("everything") << false;
+    QTest::newRow("stripped") << true;
+}
+
+// Squeezing the messages into the hashed, deduplicated QM layout is the
+// bulk of lrelease's work.
+void tst_bench_translator::saveQm()
+{
+    QFETCH(bool, stripped);
+
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        ConversionData cd;
+        cd.m_saveMode = stripped ? SaveStripped : SaveEverything;
+        QVERIFY2(saveQM(m_tor, buffer, cd), qPrintable(cd.error()));
+        QVERIFY(buffer.size() > 0);
+    }
+}
+
+// Looks every message up by a copy of itself, as merge() and lupdate's
+// extend() do for each message they add.
+void tst_bench_translator::find()
+{
+    const QList<TranslatorMessage> messages = m_tor.messages();
+    QBENCHMARK {
+        for (int i = 0; i < messages.size(); ++i)
+            QCOMPARE(m_tor.find(messages.at(i)), i);
+    }
+}
+
+// Looks every message up in the saved .qm file in place, which is all a
+// tool that only needs lookups has to do instead of loading the file.
+void tst_bench_translator::findQm()
+{
+    QmReader reader;
+    QVERIFY2(reader.open(m_dir.filePath(u"test.qm"_s)), qPrintable(reader.errorString()));
+    const QList<TranslatorMessage> messages = m_tor.messages();
+    QBENCHMARK {
+        for (const TranslatorMessage &msg : messages) {
+            QmReader::Message found;
+            QVERIFY(reader.find(msg.context(), msg.sourceText(), msg.comment(), &found));
+        }
+    }
+}
+
+void tst_bench_translator::stringMemory_data()
+{
+    QTest::addColumn<QString>("format");
+
+    QTest::newRow("append") << QString();
+    QTest::newRow("ts") << u"ts"_s;
+    QTest::newRow("po") << u"po"_s;
+    QTest::newRow("qm") << u"qm"_s;
+    QTest::newRow("xlf") << u"xlf"_s;
+}
+
+// Reports the peak resident set size while the messages are built or
+// loaded, and checks that their context and file names are shared.
+// tst_bench_translator_nopool reports the same without the string pool.
+void tst_bench_translator::stringMemory()
+{
+#ifndef Q_OS_LINUX
+    QSKIP("The peak resident set size is only read on Linux.");
+#else
+    QFETCH(QString, format);
+
+    if (!resetPeakRss())
+        QSKIP("The peak resident set size cannot be reset.");
+    Translator tor;
+    if (format.isEmpty()) {
+        appendMessages(tor);
+    } else {
+        ConversionData cd;
+        QVERIFY2(tor.load(m_dir.filePath(u"test."_s + format), cd, format),
+                 qPrintable(cd.error()));
+    }
+    QCOMPARE(tor.messageCount(), MessageCount);
+    const qint64 peak = peakRss();
+    QVERIFY(peak > 0);
+
+#ifndef LINGUIST_NO_STRING_POOL
+    // Interned strings are counted once; unshared ones would be counted for
+    // every message.
+    QSet<const QChar *> seen;
+    qint64 sharedBytes = 0;
+    qint64 unsharedBytes = 0;
+    const auto count = [&](const QString &str) {
+        if (str.isEmpty())
+            return;
+        const qint64 bytes = (str.capacity() + 1) * qint64(sizeof(QChar));
+        unsharedBytes += bytes;
+        if (!seen.contains(str.constData())) {
+            seen.insert(str.constData());
+            sharedBytes += bytes;
+        }
+    };
+    for (const TranslatorMessage &msg : tor.messages()) {
+        count(msg.context());
+        count(msg.fileName());
+        for (const TranslatorMessage::Reference &ref : msg.extraReferences())
+            count(ref.fileName());
+    }
+    QVERIFY(sharedBytes * 2 <= unsharedBytes);
+#endif
+    QTest::setBenchmarkResult(peak, QTest::BytesAllocated);
+#endif
+}
+
+QTEST_MAIN(tst_bench_translator)
+
+#include "tst_bench_translator.moc"